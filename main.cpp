@@ -5,6 +5,9 @@
 #include "src/Parser/Parser.hpp"
 #include "src/Evaluator/Evaluator.hpp"
 #include "src/Typechecker/Typechecker.hpp"
+#include "src/Resolver/Resolver.hpp"
+#include "src/Compiler/Compiler.hpp"
+#include "src/VM/VM.hpp"
 
 enum Type
 {
@@ -16,6 +19,34 @@ Type type = Type::DEV;
 
 int main(int argc, char** argv)
 {
+    // --vm runs the program's top-level statements, and the if, while and
+    // for bodies among them, on the bytecode VM. Function, lambda and
+    // method bodies still run on the tree-walker. --stats reports runtime
+    // allocation counts once the program finishes
+
+    bool use_vm = false;
+    bool print_stats = false;
+    std::vector<std::string> args;
+
+    for (int i = 1; i < argc; i++)
+    {
+        std::string arg = argv[i];
+
+        if (arg == "--vm")
+        {
+            use_vm = true;
+            continue;
+        }
+
+        if (arg == "--stats")
+        {
+            print_stats = true;
+            continue;
+        }
+
+        args.push_back(arg);
+    }
+
     if (type == Type::DEV)
     {
         std::string buitins_path;
@@ -45,12 +76,38 @@ int main(int argc, char** argv)
         Typechecker tc(parser.file_name, parser.nodes);
         tc.builtins_path = lexer.builtins_path;
         tc.init(buitins_path);
+        tc.collect_cycles = true;
         tc.evaluate();
 
+        Resolver resolver(tc.file_name, tc.nodes);
+        resolver.resolve();
+
         Evaluator evaluator(tc.file_name, tc.nodes);
         evaluator.builtins_path = lexer.builtins_path;
+        evaluator.main_scope = true;
         evaluator.init(buitins_path);
-        evaluator.evaluate();
+        evaluator.collect_cycles = true;
+
+        if (use_vm)
+        {
+            Compiler compiler(evaluator.file_name, evaluator.nodes);
+            compiler.compile();
+
+            VM vm(evaluator, compiler.chunk);
+            vm.run();
+        }
+        else
+        {
+            evaluator.evaluate();
+        }
+
+        Output::get().flush();
+
+        if (print_stats)
+        {
+            Node_Pool::get().print_stats(std::cerr);
+            Collector::get().print_stats(std::cerr);
+        }
 
         std::cin.get();
         exit(0);
@@ -58,13 +115,13 @@ int main(int argc, char** argv)
 
     if (type == Type::INTERP)
     {
-        if (argc == 1)
+        if (args.size() == 0)
         {
             std::cout << "You must enter a source path e.g: glide \"main.gl\"\n";
             return 1;
         }
 
-        if (argc > 2)
+        if (args.size() > 1)
         {
             std::cout << "Compiler only accepts 1 argument: source path";
             return 1;
@@ -87,7 +144,7 @@ int main(int argc, char** argv)
             buitins_path = json["settings"]["builtins_path"];
         }
 
-        std::string path = argv[1];
+        std::string path = args[0];
 
         Lexer lexer(path);
         lexer.builtins_path = buitins_path;
@@ -99,12 +156,38 @@ int main(int argc, char** argv)
         Typechecker tc(parser.file_name, parser.nodes);
         tc.builtins_path = lexer.builtins_path;
         tc.init(buitins_path);
+        tc.collect_cycles = true;
         tc.evaluate();
 
+        Resolver resolver(tc.file_name, tc.nodes);
+        resolver.resolve();
+
         Evaluator evaluator(tc.file_name, tc.nodes);
         evaluator.builtins_path = lexer.builtins_path;
+        evaluator.main_scope = true;
         evaluator.init(buitins_path);
-        evaluator.evaluate();
+        evaluator.collect_cycles = true;
+
+        if (use_vm)
+        {
+            Compiler compiler(evaluator.file_name, evaluator.nodes);
+            compiler.compile();
+
+            VM vm(evaluator, compiler.chunk);
+            vm.run();
+        }
+        else
+        {
+            evaluator.evaluate();
+        }
+
+        Output::get().flush();
+
+        if (print_stats)
+        {
+            Node_Pool::get().print_stats(std::cerr);
+            Collector::get().print_stats(std::cerr);
+        }
 
         exit(0);
     }
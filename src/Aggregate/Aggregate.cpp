@@ -0,0 +1,284 @@
+#include "Aggregate.hpp"
+
+void Aggregate::add(long long value)
+{
+    if (is_float)
+    {
+        floats.push_back((double)value);
+        is_mixed = true;
+        return;
+    }
+
+    ints.push_back(value);
+}
+
+void Aggregate::add(double value)
+{
+    if (!is_float)
+    {
+        floats.reserve(ints.size() + 1);
+        floats.assign(ints.begin(), ints.end());
+        is_mixed = !ints.empty();
+        ints.clear();
+        is_float = true;
+    }
+
+    floats.push_back(value);
+}
+
+void Aggregate::add(const std::vector<long long>& values)
+{
+    if (is_float)
+    {
+        floats.insert(floats.end(), values.begin(), values.end());
+        is_mixed = is_mixed || !values.empty();
+        return;
+    }
+
+    ints.insert(ints.end(), values.begin(), values.end());
+}
+
+void Aggregate::add(const std::vector<double>& values)
+{
+    if (!is_float)
+    {
+        floats.assign(ints.begin(), ints.end());
+        is_mixed = !ints.empty() && !values.empty();
+        ints.clear();
+        is_float = true;
+    }
+
+    floats.insert(floats.end(), values.begin(), values.end());
+}
+
+size_t Aggregate::size() const
+{
+    return is_float ? floats.size() : ints.size();
+}
+
+// --- Int kernels --- //
+
+long long Aggregate::int_sum() const
+{
+    const long long* values = ints.data();
+    size_t size = ints.size();
+
+    // Wraps around on overflow the way adding Glide ints one at a time does
+    unsigned long long total = 0;
+
+    for (size_t i = 0; i < size; i++)
+    {
+        total += (unsigned long long)values[i];
+    }
+
+    return (long long)total;
+}
+
+long long Aggregate::int_min() const
+{
+    const long long* values = ints.data();
+    size_t size = ints.size();
+    long long result = values[0];
+
+    for (size_t i = 1; i < size; i++)
+    {
+        result = values[i] < result ? values[i] : result;
+    }
+
+    return result;
+}
+
+long long Aggregate::int_max() const
+{
+    const long long* values = ints.data();
+    size_t size = ints.size();
+    long long result = values[0];
+
+    for (size_t i = 1; i < size; i++)
+    {
+        result = values[i] > result ? values[i] : result;
+    }
+
+    return result;
+}
+
+// --- Float kernels --- //
+
+double Aggregate::float_sum() const
+{
+    const double* values = floats.data();
+    size_t size = floats.size();
+    double lanes[4] = {0, 0, 0, 0};
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        lanes[0] += values[i];
+        lanes[1] += values[i + 1];
+        lanes[2] += values[i + 2];
+        lanes[3] += values[i + 3];
+    }
+
+    double total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; i < size; i++)
+    {
+        total += values[i];
+    }
+
+    return total;
+}
+
+double Aggregate::float_min() const
+{
+    const double* values = floats.data();
+    size_t size = floats.size();
+    double lanes[4] = {values[0], values[0], values[0], values[0]};
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        lanes[0] = values[i] < lanes[0] ? values[i] : lanes[0];
+        lanes[1] = values[i + 1] < lanes[1] ? values[i + 1] : lanes[1];
+        lanes[2] = values[i + 2] < lanes[2] ? values[i + 2] : lanes[2];
+        lanes[3] = values[i + 3] < lanes[3] ? values[i + 3] : lanes[3];
+    }
+
+    double result = lanes[0];
+
+    for (int lane = 1; lane < 4; lane++)
+    {
+        result = lanes[lane] < result ? lanes[lane] : result;
+    }
+
+    for (; i < size; i++)
+    {
+        result = values[i] < result ? values[i] : result;
+    }
+
+    return result;
+}
+
+double Aggregate::float_max() const
+{
+    const double* values = floats.data();
+    size_t size = floats.size();
+    double lanes[4] = {values[0], values[0], values[0], values[0]};
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        lanes[0] = values[i] > lanes[0] ? values[i] : lanes[0];
+        lanes[1] = values[i + 1] > lanes[1] ? values[i + 1] : lanes[1];
+        lanes[2] = values[i + 2] > lanes[2] ? values[i + 2] : lanes[2];
+        lanes[3] = values[i + 3] > lanes[3] ? values[i + 3] : lanes[3];
+    }
+
+    double result = lanes[0];
+
+    for (int lane = 1; lane < 4; lane++)
+    {
+        result = lanes[lane] > result ? lanes[lane] : result;
+    }
+
+    for (; i < size; i++)
+    {
+        result = values[i] > result ? values[i] : result;
+    }
+
+    return result;
+}
+
+// --- Statistics --- //
+
+double Aggregate::mean() const
+{
+    if (is_float)
+    {
+        return float_sum() / floats.size();
+    }
+
+    // Summed as floats, so a large total can't wrap around
+
+    const long long* values = ints.data();
+    size_t size = ints.size();
+    double lanes[4] = {0, 0, 0, 0};
+    size_t i = 0;
+
+    for (; i + 4 <= size; i += 4)
+    {
+        lanes[0] += (double)values[i];
+        lanes[1] += (double)values[i + 1];
+        lanes[2] += (double)values[i + 2];
+        lanes[3] += (double)values[i + 3];
+    }
+
+    double total = (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+
+    for (; i < size; i++)
+    {
+        total += (double)values[i];
+    }
+
+    return total / size;
+}
+
+// The population variance, from the squared distances to the mean - a
+// second pass, but without the cancellation of summing squares
+
+double Aggregate::variance() const
+{
+    double average = mean();
+    size_t size = this->size();
+    double lanes[4] = {0, 0, 0, 0};
+    size_t i = 0;
+
+    if (is_float)
+    {
+        const double* values = floats.data();
+
+        for (; i + 4 <= size; i += 4)
+        {
+            double d0 = values[i] - average;
+            double d1 = values[i + 1] - average;
+            double d2 = values[i + 2] - average;
+            double d3 = values[i + 3] - average;
+
+            lanes[0] += d0 * d0;
+            lanes[1] += d1 * d1;
+            lanes[2] += d2 * d2;
+            lanes[3] += d3 * d3;
+        }
+
+        for (; i < size; i++)
+        {
+            double d = values[i] - average;
+            lanes[0] += d * d;
+        }
+    }
+    else
+    {
+        const long long* values = ints.data();
+
+        for (; i + 4 <= size; i += 4)
+        {
+            double d0 = (double)values[i] - average;
+            double d1 = (double)values[i + 1] - average;
+            double d2 = (double)values[i + 2] - average;
+            double d3 = (double)values[i + 3] - average;
+
+            lanes[0] += d0 * d0;
+            lanes[1] += d1 * d1;
+            lanes[2] += d2 * d2;
+            lanes[3] += d3 * d3;
+        }
+
+        for (; i < size; i++)
+        {
+            double d = (double)values[i] - average;
+            lanes[0] += d * d;
+        }
+    }
+
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) / size;
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+
+// The numbers behind sum, mean, variance, min and max, gathered into one
+// contiguous array of ints or floats. Each kernel is then a flat loop with
+// no branches the compiler has to keep, so it is vectorized. The float loops
+// keep four running results, since the compiler may not reorder floating
+// point arithmetic into lanes by itself.
+
+class Aggregate
+{
+public:
+
+    std::vector<long long> ints;
+    std::vector<double> floats;
+
+    // Set once a float is added - the ints gathered so far move over to floats
+    bool is_float = false;
+
+    // Set if ints and floats were both added
+    bool is_mixed = false;
+
+    void add(long long value);
+    void add(double value);
+    void add(const std::vector<long long>& values);
+    void add(const std::vector<double>& values);
+
+    size_t size() const;
+
+    long long int_sum() const;
+    long long int_min() const;
+    long long int_max() const;
+
+    double float_sum() const;
+    double float_min() const;
+    double float_max() const;
+
+    double mean() const;
+    double variance() const;
+};
@@ -0,0 +1,186 @@
+#include <cstring>
+#include <cstdint>
+#include <cctype>
+#include "CSV_Reader.hpp"
+
+CSV_Reader::CSV_Reader(const std::string& path, char delim) : file(path), delim(delim)
+{
+    is_open = file.is_open();
+    data = file.view();
+}
+
+// Finds the first a or b at or after from, testing eight bytes per step:
+// a byte of the word equals c exactly when the same byte of word ^ (c * ones)
+// is zero, and the lowest byte flagged by the zero test is always a real
+// match. Returns the size of the data if there is none
+
+size_t CSV_Reader::find_either(size_t from, char a, char b)
+{
+    const uint64_t ones = 0x0101010101010101ull;
+    const uint64_t highs = 0x8080808080808080ull;
+    const uint64_t pattern_a = ones * (unsigned char)a;
+    const uint64_t pattern_b = ones * (unsigned char)b;
+
+    const char* bytes = data.data();
+    size_t size = data.size();
+
+    while (from + 8 <= size)
+    {
+        uint64_t word;
+        std::memcpy(&word, bytes + from, 8);
+
+        uint64_t xa = word ^ pattern_a;
+        uint64_t xb = word ^ pattern_b;
+        uint64_t found = ((xa - ones) & ~xa & highs) | ((xb - ones) & ~xb & highs);
+
+        if (found != 0)
+        {
+            return from + (__builtin_ctzll(found) >> 3);
+        }
+
+        from += 8;
+    }
+
+    while (from < size && bytes[from] != a && bytes[from] != b)
+    {
+        from++;
+    }
+
+    return from;
+}
+
+void CSV_Reader::skip_blank_lines()
+{
+    while (pos < data.size())
+    {
+        size_t i = pos;
+
+        while (i < data.size() && (data[i] == ' ' || data[i] == '\t' || data[i] == '\r'))
+        {
+            i++;
+        }
+
+        if (i == data.size())
+        {
+            pos = i;
+            return;
+        }
+
+        if (data[i] != '\n')
+        {
+            return;
+        }
+
+        pos = i + 1;
+    }
+}
+
+void CSV_Reader::read_quoted(CSV_Field& field)
+{
+    field.quoted = true;
+    pos++;
+
+    while (true)
+    {
+        size_t quote = data.find('"', pos);
+
+        // An unterminated quote runs to the end of the file
+
+        if (quote == std::string_view::npos)
+        {
+            field.value.append(data, pos, std::string::npos);
+            pos = data.size();
+            return;
+        }
+
+        field.value.append(data, pos, quote - pos);
+        pos = quote + 1;
+
+        if (pos < data.size() && data[pos] == '"')
+        {
+            field.value += '"';
+            pos++;
+            continue;
+        }
+
+        break;
+    }
+
+    // Anything between the closing quote and the end of the field is dropped
+
+    pos = find_either(pos, delim, '\n');
+}
+
+void CSV_Reader::read_unquoted(CSV_Field& field)
+{
+    size_t end = find_either(pos, delim, '\n');
+    size_t last = end;
+
+    while (last > pos && std::isspace((unsigned char)data[last - 1]))
+    {
+        last--;
+    }
+
+    field.value.assign(data, pos, last - pos);
+    pos = end;
+}
+
+// Reads the next row into fields, reusing their storage. Returns false once
+// there are no rows left
+
+bool CSV_Reader::next_row(std::vector<CSV_Field>& fields)
+{
+    skip_blank_lines();
+
+    if (pos >= data.size())
+    {
+        fields.clear();
+        return false;
+    }
+
+    size_t count = 0;
+
+    while (true)
+    {
+        if (count == fields.size())
+        {
+            fields.emplace_back();
+        }
+
+        auto& field = fields[count++];
+        field.value.clear();
+        field.quoted = false;
+
+        while (pos < data.size() && data[pos] != delim && (data[pos] == ' ' || data[pos] == '\t'))
+        {
+            pos++;
+        }
+
+        if (pos < data.size() && data[pos] == '"')
+        {
+            read_quoted(field);
+        }
+        else
+        {
+            read_unquoted(field);
+        }
+
+        if (pos < data.size() && data[pos] == delim)
+        {
+            pos++;
+            continue;
+        }
+
+        // At a line break or the end of the file
+
+        if (pos < data.size())
+        {
+            pos++;
+        }
+
+        break;
+    }
+
+    fields.resize(count);
+    return true;
+}
@@ -0,0 +1,44 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <string_view>
+#include "../Mapped_File/Mapped_File.hpp"
+
+// Splits a CSV file into rows of fields for csv.load. The file is mapped
+// into memory and scanned in place, eight bytes at a time, for the next
+// delimiter, line break or quote. Quoted fields may contain delimiters, line
+// breaks and doubled quotes; unquoted fields are trimmed, and blank lines are
+// skipped.
+
+struct CSV_Field
+{
+    std::string value;
+    bool quoted = false;
+
+    // An unquoted field with nothing in it is a missing value
+    bool empty() const
+    {
+        return !quoted && value.empty();
+    }
+};
+
+class CSV_Reader
+{
+    Mapped_File file;
+    std::string_view data;
+    size_t pos = 0;
+    char delim;
+
+    size_t find_either(size_t from, char a, char b);
+    void skip_blank_lines();
+    void read_quoted(CSV_Field& field);
+    void read_unquoted(CSV_Field& field);
+
+public:
+
+    bool is_open = false;
+
+    CSV_Reader(const std::string& path, char delim);
+
+    bool next_row(std::vector<CSV_Field>& fields);
+};
@@ -0,0 +1,339 @@
+#include <algorithm>
+#include "Collector.hpp"
+
+// Calls f on every handle a node holds. Missing an edge here only makes the
+// collector more conservative; listing a pointer that is not a counted
+// handle would not, so only Node_Ptr members appear
+
+template <typename F>
+static void for_each_child(Node* node, F f)
+{
+    auto visit = [&](Node_Ptr& child)
+    {
+        if (child != nullptr && child->header.arena == nullptr)
+        {
+            f(child);
+        }
+    };
+
+    auto visit_all = [&](std::vector<Node_Ptr>& children)
+    {
+        for (auto& child : children)
+        {
+            visit(child);
+        }
+    };
+
+    visit(node->left);
+    visit(node->right);
+    visit(node->ID.type);
+    visit(node->TYPE.allowed_type);
+    visit_all(node->LIST.elements);
+
+    if (auto block = node->BLOCK.get())
+    {
+        for (auto& symbol : block->symbol_table)
+        {
+            visit(symbol.second);
+        }
+
+        visit_all(block->nodes);
+    }
+
+    if (auto object = node->OBJECT.get())
+    {
+        for (auto& prop : object->properties)
+        {
+            visit(prop.second.value);
+        }
+    }
+
+    if (auto func_call = node->FUNC_CALL.get())
+    {
+        visit(func_call->caller);
+        visit_all(func_call->args);
+    }
+
+    if (auto list = node->COMMA_LIST.get())
+    {
+        visit_all(list->nodes);
+    }
+
+    if (auto list = node->PIPE_LIST.get())
+    {
+        visit_all(list->nodes);
+    }
+
+    if (auto list = node->FUNC_LIST.get())
+    {
+        visit_all(list->nodes);
+    }
+
+    if (auto function = node->FUNCTION.get())
+    {
+        visit(function->return_type);
+        visit_all(function->params);
+        visit_all(function->args);
+        visit(function->body);
+
+        for (auto& symbol : function->closure)
+        {
+            visit(symbol.second);
+        }
+    }
+
+    if (auto if_statement = node->IF_STATEMENT.get())
+    {
+        visit(if_statement->conditional);
+        visit(if_statement->body);
+    }
+
+    if (auto if_block = node->IF_BLOCK.get())
+    {
+        visit_all(if_block->cases);
+    }
+
+    if (auto match_block = node->MATCH_BLOCK.get())
+    {
+        visit(match_block->value);
+        visit_all(match_block->cases);
+    }
+
+    if (auto for_loop = node->FOR_LOOP.get())
+    {
+        visit(for_loop->init_list);
+        visit(for_loop->body);
+    }
+
+    if (auto while_loop = node->WHILE_LOOP.get())
+    {
+        visit(while_loop->conditional);
+        visit(while_loop->body);
+    }
+}
+
+// The storage a node owns directly: itself and its allocated payloads
+
+static size_t node_bytes(Node* node)
+{
+    size_t bytes = sizeof(Node) + node->LIST.elements.capacity() * sizeof(Node_Ptr);
+
+    if (node->BLOCK.get()) bytes += sizeof(Block_Node);
+    if (node->OBJECT.get()) bytes += sizeof(Object_Node) + node->OBJECT->properties.size() * sizeof(Object_Prop);
+    if (node->FUNC_CALL.get()) bytes += sizeof(Func_Call_Node);
+    if (node->COMMA_LIST.get()) bytes += sizeof(List_Node);
+    if (node->PIPE_LIST.get()) bytes += sizeof(List_Node);
+    if (node->FUNC_LIST.get()) bytes += sizeof(List_Node);
+    if (node->FUNCTION.get()) bytes += sizeof(Function_Node) + node->FUNCTION->closure.size() * sizeof(Node_Ptr);
+    if (node->IF_STATEMENT.get()) bytes += sizeof(If_Statement_Node);
+    if (node->IF_BLOCK.get()) bytes += sizeof(If_Block_Node);
+    if (node->MATCH_BLOCK.get()) bytes += sizeof(Match_Block_Node);
+    if (node->FOR_LOOP.get()) bytes += sizeof(For_Loop_Node);
+    if (node->WHILE_LOOP.get()) bytes += sizeof(While_Loop_Node);
+
+    return bytes;
+}
+
+static unsigned int count(Node* node)
+{
+    return node->header.count;
+}
+
+static void set_count(Node* node, unsigned int value)
+{
+    node->header.count = value;
+}
+
+// A literal is its own type (see make_int and friends), so the most common
+// cycle is a value whose only remaining handle is its own allowed_type.
+// That one is freed on the spot instead of waiting for a collection
+
+void possible_root(Node* node)
+{
+    if (count(node) == 1 && node->TYPE.allowed_type.get() == node)
+    {
+        node->TYPE.allowed_type.detach();
+        set_count(node, 0);
+        release_node(node);
+        return;
+    }
+
+    Collector::get().add_root(node);
+}
+
+// --- Roots --- //
+
+// Never destroyed, like Node_Pool: nodes are still released after main
+// returns
+
+Collector& Collector::get()
+{
+    static Collector* collector = new Collector();
+    return *collector;
+}
+
+void Collector::add_root(Node* node)
+{
+    node->header.root_index = roots.size();
+    roots.push_back(node);
+}
+
+void Collector::remove_root(Node* node)
+{
+    int index = node->header.root_index;
+
+    roots[index] = roots.back();
+    roots[index]->header.root_index = index;
+    roots.pop_back();
+
+    node->header.root_index = -1;
+}
+
+// --- Trial deletion --- //
+
+void Collector::mark_gray(Node* node)
+{
+    if (node->header.color == GRAY)
+    {
+        return;
+    }
+
+    node->header.color = GRAY;
+
+    for_each_child(node, [&](Node_Ptr& child)
+    {
+        set_count(child.get(), count(child.get()) - 1);
+        mark_gray(child.get());
+    });
+}
+
+void Collector::scan(Node* node)
+{
+    if (node->header.color != GRAY)
+    {
+        return;
+    }
+
+    if (count(node) > 0)
+    {
+        scan_black(node);
+        return;
+    }
+
+    node->header.color = WHITE;
+
+    for_each_child(node, [&](Node_Ptr& child)
+    {
+        scan(child.get());
+    });
+}
+
+void Collector::scan_black(Node* node)
+{
+    node->header.color = BLACK;
+
+    for_each_child(node, [&](Node_Ptr& child)
+    {
+        set_count(child.get(), count(child.get()) + 1);
+
+        if (child->header.color != BLACK)
+        {
+            scan_black(child.get());
+        }
+    });
+}
+
+void Collector::collect_white(Node* node, std::vector<Node*>& garbage)
+{
+    if (node->header.color != WHITE)
+    {
+        return;
+    }
+
+    node->header.color = GARBAGE;
+    garbage.push_back(node);
+
+    for_each_child(node, [&](Node_Ptr& child)
+    {
+        collect_white(child.get(), garbage);
+    });
+}
+
+void Collector::collect()
+{
+    std::vector<Node*> candidates;
+    candidates.swap(roots);
+
+    for (auto node : candidates)
+    {
+        node->header.root_index = -1;
+        mark_gray(node);
+    }
+
+    for (auto node : candidates)
+    {
+        scan(node);
+    }
+
+    std::vector<Node*> garbage;
+
+    for (auto node : candidates)
+    {
+        collect_white(node, garbage);
+    }
+
+    // The counts of surviving nodes no longer include references from
+    // garbage, so those references are dropped without counting them down
+    // before the garbage is freed
+
+    for (auto node : garbage)
+    {
+        for_each_child(node, [&](Node_Ptr& child)
+        {
+            child.detach();
+        });
+    }
+
+    size_t bytes = 0;
+
+    for (auto node : garbage)
+    {
+        bytes += node_bytes(node);
+    }
+
+    for (auto node : garbage)
+    {
+        release_node(node);
+    }
+
+    stats.collections++;
+    stats.collected_nodes += garbage.size();
+    stats.collected_bytes += bytes;
+
+    // Back off while collections find little, so long-lived values that
+    // keep being recorded are not traversed over and over
+
+    if (garbage.size() < candidates.size() / 8)
+    {
+        threshold = std::min(threshold * 2, (size_t)max_threshold);
+    }
+    else
+    {
+        threshold = min_threshold;
+    }
+}
+
+void Collector::safe_point()
+{
+    if (roots.size() >= threshold)
+    {
+        collect();
+    }
+}
+
+void Collector::print_stats(std::ostream& out)
+{
+    out << "Cycle collections: " << stats.collections << "\n";
+    out << "Collected nodes: " << stats.collected_nodes << "\n";
+    out << "Collected bytes: " << stats.collected_bytes << "\n";
+}
@@ -0,0 +1,58 @@
+#pragma once
+#include <iostream>
+#include "../Node/Node.hpp"
+
+// Reclaims reference cycles between runtime values, such as an object and
+// the methods whose closures capture it as `this`, using synchronous trial
+// deletion. Every node whose count drops without reaching zero is recorded
+// as a possible root; a collection subtracts the references the recorded
+// nodes hold on each other, and whatever is left without outside references
+// is garbage. Arena nodes (the program's AST) are never candidates and are
+// not traversed.
+//
+// Collections only run at safe points, where no C++ frame holds an
+// uncounted reference into the heap: between top-level statements and
+// between iterations of top-level loops.
+
+struct Collector_Stats
+{
+    size_t collections = 0;
+    size_t collected_nodes = 0;
+    size_t collected_bytes = 0;
+};
+
+class Collector
+{
+    enum Color : unsigned char
+    {
+        BLACK,
+        GRAY,
+        WHITE,
+        GARBAGE
+    };
+
+    static constexpr size_t min_threshold = 10000;
+    static constexpr size_t max_threshold = 1 << 22;
+
+    std::vector<Node*> roots;
+    size_t threshold = min_threshold;
+
+    void mark_gray(Node* node);
+    void scan(Node* node);
+    void scan_black(Node* node);
+    void collect_white(Node* node, std::vector<Node*>& garbage);
+
+public:
+
+    Collector_Stats stats;
+
+    static Collector& get();
+
+    void add_root(Node* node);
+    void remove_root(Node* node);
+
+    void collect();
+    void safe_point();
+
+    void print_stats(std::ostream& out);
+};
@@ -0,0 +1,372 @@
+#include "Compiler.hpp"
+
+int Compiler::emit(OpCode op, int a, int b)
+{
+    Instruction instruction;
+    instruction.op = op;
+    instruction.a = a;
+    instruction.b = b;
+
+    chunk.code.push_back(instruction);
+    return chunk.code.size() - 1;
+}
+
+int Compiler::add_constant(Node_Ptr node)
+{
+    chunk.constants.push_back(node);
+    return chunk.constants.size() - 1;
+}
+
+// --- Expressions --- //
+
+// Only side-effect free expressions are compiled, so the VM can always
+// hand the whole expression back to the tree-walker when an operand is
+// something it does not handle natively
+
+bool Compiler::is_expression(Node_Ptr& node)
+{
+    if (node == nullptr)
+    {
+        return false;
+    }
+
+    if (node->type == NodeType::INT || node->type == NodeType::FLOAT || node->type == NodeType::BOOL || node->type == NodeType::STRING || node->type == NodeType::EMPTY)
+    {
+        return true;
+    }
+
+    if (node->type == NodeType::ID)
+    {
+        return true;
+    }
+
+    if (node->type != NodeType::OP)
+    {
+        return false;
+    }
+
+    auto op = node->OP.op_type;
+
+    if (op == NodeType::POS || op == NodeType::NEG || op == NodeType::NOT)
+    {
+        return is_expression(node->right);
+    }
+
+    if (op == NodeType::PLUS || op == NodeType::MINUS || op == NodeType::STAR || op == NodeType::SLASH || op == NodeType::PERCENT
+    ||  op == NodeType::L_ANGLE || op == NodeType::R_ANGLE || op == NodeType::LT_EQUAL || op == NodeType::GT_EQUAL
+    ||  op == NodeType::EQ_EQ || op == NodeType::NOT_EQUAL || op == NodeType::AND || op == NodeType::OR)
+    {
+        return is_expression(node->left) && is_expression(node->right);
+    }
+
+    return false;
+}
+
+void Compiler::compile_expression(Node_Ptr& node)
+{
+    int start = emit(OpCode::EXPR, add_constant(node));
+    compile_value(node);
+    chunk.code[start].b = chunk.code.size();
+}
+
+void Compiler::compile_value(Node_Ptr& node)
+{
+    if (node->type == NodeType::ID)
+    {
+        emit(OpCode::LOAD, add_constant(node));
+        return;
+    }
+
+    if (node->type != NodeType::OP)
+    {
+        emit(OpCode::CONST, add_constant(node));
+        return;
+    }
+
+    int index = add_constant(node);
+    auto op = node->OP.op_type;
+
+    if (op == NodeType::POS || op == NodeType::NEG)
+    {
+        compile_value(node->right);
+        emit(OpCode::POS_NEG, index);
+        return;
+    }
+
+    if (op == NodeType::NOT)
+    {
+        compile_value(node->right);
+        emit(OpCode::NOT, index);
+        return;
+    }
+
+    if (op == NodeType::AND)
+    {
+        compile_value(node->left);
+        int jump = emit(OpCode::AND_SHORT, index);
+        compile_value(node->right);
+        emit(OpCode::AND_OR, index);
+        chunk.code[jump].b = chunk.code.size();
+        return;
+    }
+
+    compile_value(node->left);
+    compile_value(node->right);
+
+    switch (op)
+    {
+        case NodeType::PLUS: emit(OpCode::ADD, index); break;
+        case NodeType::MINUS: emit(OpCode::SUB, index); break;
+        case NodeType::STAR: emit(OpCode::MUL, index); break;
+        case NodeType::SLASH: emit(OpCode::DIV, index); break;
+        case NodeType::PERCENT: emit(OpCode::MOD, index); break;
+        case NodeType::L_ANGLE: emit(OpCode::LESS, index); break;
+        case NodeType::R_ANGLE: emit(OpCode::GREATER, index); break;
+        case NodeType::LT_EQUAL: emit(OpCode::LESS_EQUAL, index); break;
+        case NodeType::GT_EQUAL: emit(OpCode::GREATER_EQUAL, index); break;
+        case NodeType::EQ_EQ: emit(OpCode::EQUAL, index); break;
+        case NodeType::NOT_EQUAL: emit(OpCode::NOT_EQUAL, index); break;
+        default: emit(OpCode::AND_OR, index); break;
+    }
+}
+
+// --- Statements --- //
+
+void Compiler::compile_statement(Node_Ptr& node)
+{
+    if (node->type == NodeType::IF_STATEMENT && node->IF_STATEMENT->body->type == NodeType::BLOCK)
+    {
+        compile_if_statement(node);
+        return;
+    }
+
+    if (node->type == NodeType::WHILE_LOOP && node->WHILE_LOOP->body->type == NodeType::BLOCK)
+    {
+        compile_while_loop(node);
+        return;
+    }
+
+    if (node->type == NodeType::FOR_LOOP && node->FOR_LOOP->body->type == NodeType::BLOCK)
+    {
+        auto& init_list = node->FOR_LOOP->init_list->LIST.nodes();
+
+        bool vars_ok = init_list.size() >= 1 && init_list.size() <= 3;
+
+        for (size_t i = 1; vars_ok && i < init_list.size(); i++)
+        {
+            vars_ok = init_list[i]->type == NodeType::ID;
+        }
+
+        if (vars_ok)
+        {
+            compile_for_loop(node);
+            return;
+        }
+    }
+
+    if (node->type == NodeType::OP && node->OP.op_type == NodeType::EQUAL && node->left->type == NodeType::ID && is_expression(node->right))
+    {
+        int index = add_constant(node);
+        emit(OpCode::BIND, index);
+
+        // The tree-walker adds the piece to the string where it is, rather
+        // than copying all of it; any other s = s + piece runs as compiled
+
+        auto& right = node->right;
+        int concat = -1;
+
+        if (right->type == NodeType::OP && right->OP.op_type == NodeType::PLUS && right->left->type == NodeType::ID && right->left->ID.value == node->left->ID.value)
+        {
+            concat = emit(OpCode::CONCAT, index);
+        }
+
+        compile_expression(node->right);
+        emit(OpCode::ASSIGN, index);
+
+        if (concat >= 0)
+        {
+            chunk.code[concat].b = chunk.code.size();
+        }
+    }
+    else if (is_expression(node))
+    {
+        compile_expression(node);
+    }
+    else
+    {
+        emit(OpCode::EVAL, add_constant(node));
+    }
+
+    emit(OpCode::SIGNAL, target);
+}
+
+void Compiler::compile_block(std::vector<Node_Ptr>& nodes)
+{
+    for (auto& node : nodes)
+    {
+        compile_statement(node);
+    }
+}
+
+void Compiler::compile_if_statement(Node_Ptr& node)
+{
+    auto& conditional = node->IF_STATEMENT->conditional;
+
+    if (is_expression(conditional))
+    {
+        compile_expression(conditional);
+    }
+    else
+    {
+        emit(OpCode::EVAL, add_constant(conditional));
+    }
+
+    emit(OpCode::CHECK_BOOL, 1);
+    int skip = emit(OpCode::JUMP_IF_FALSE);
+
+    emit(OpCode::ENTER_SCOPE);
+    depth++;
+    compile_block(node->IF_STATEMENT->body->BLOCK->nodes);
+    depth--;
+    emit(OpCode::LEAVE_SCOPE);
+
+    chunk.code[skip].a = chunk.code.size();
+}
+
+void Compiler::compile_while_loop(Node_Ptr& node)
+{
+    auto& conditional = node->WHILE_LOOP->conditional;
+    bool compiled = is_expression(conditional);
+    int index = add_constant(conditional);
+
+    // The conditional is checked once in the enclosing scope, then
+    // re-evaluated inside the loop scope before every iteration
+
+    if (compiled)
+    {
+        compile_expression(conditional);
+    }
+    else
+    {
+        emit(OpCode::EVAL, index);
+    }
+
+    emit(OpCode::CHECK_BOOL, 0);
+    emit(OpCode::POP);
+
+    emit(OpCode::ENTER_SCOPE);
+    depth++;
+
+    int loop = chunk.code.size();
+
+    if (compiled)
+    {
+        compile_expression(conditional);
+    }
+    else
+    {
+        emit(OpCode::EVAL, index);
+    }
+
+    int exit = emit(OpCode::JUMP_IF_FALSE);
+
+    Jump_Target loop_target;
+    loop_target.break_depth = depth;
+    loop_target.continue_ip = loop;
+    loop_target.continue_depth = depth;
+    chunk.targets.push_back(loop_target);
+
+    int outer_target = target;
+    target = chunk.targets.size() - 1;
+    int loop_target_index = target;
+    compile_block(node->WHILE_LOOP->body->BLOCK->nodes);
+    target = outer_target;
+
+    emit(OpCode::CLEAR_SCOPE);
+    emit(OpCode::JUMP, loop);
+
+    chunk.code[exit].a = chunk.code.size();
+    chunk.targets[loop_target_index].break_ip = chunk.code.size();
+
+    depth--;
+    emit(OpCode::LEAVE_SCOPE);
+}
+
+void Compiler::compile_for_loop(Node_Ptr& node)
+{
+    auto& iter = node->FOR_LOOP->init_list->LIST.nodes()[0];
+
+    if (is_expression(iter))
+    {
+        compile_expression(iter);
+    }
+    else
+    {
+        emit(OpCode::EVAL, add_constant(iter));
+    }
+
+    int index = add_constant(node);
+
+    emit(OpCode::FOR_INIT, index);
+    depth++;
+
+    int loop = emit(OpCode::FOR_NEXT, index);
+
+    Jump_Target loop_target;
+    loop_target.break_depth = depth;
+    loop_target.continue_depth = depth;
+    chunk.targets.push_back(loop_target);
+
+    int outer_target = target;
+    target = chunk.targets.size() - 1;
+    int loop_target_index = target;
+    compile_block(node->FOR_LOOP->body->BLOCK->nodes);
+    target = outer_target;
+
+    emit(OpCode::CLEAR_SCOPE);
+    chunk.targets[loop_target_index].continue_ip = emit(OpCode::FOR_STEP);
+    emit(OpCode::JUMP, loop);
+
+    chunk.code[loop].b = chunk.code.size();
+    chunk.targets[loop_target_index].break_ip = chunk.code.size();
+
+    depth--;
+    emit(OpCode::LEAVE_SCOPE);
+}
+
+void Compiler::compile()
+{
+    std::vector<NodeType> ignore_list = { NodeType::SEMICOLON };
+
+    for (auto& node : nodes)
+    {
+        if (
+            std::find(ignore_list.begin(), ignore_list.end(), node->type) != ignore_list.end() ||
+            std::find(ignore_list.begin(), ignore_list.end(), node->OP.op_type) != ignore_list.end()
+            )
+        {
+            continue;
+        }
+
+        // A break, continue or ret that escapes every loop in a top-level
+        // statement just ends that statement, as it does in evaluate()
+
+        chunk.targets.push_back(Jump_Target());
+        target = chunk.targets.size() - 1;
+        int first_target = target;
+
+        compile_statement(node);
+
+        int end = chunk.code.size();
+
+        for (size_t i = first_target; i < chunk.targets.size(); i++)
+        {
+            chunk.targets[i].return_ip = end;
+        }
+
+        chunk.targets[first_target].break_ip = end;
+        chunk.targets[first_target].continue_ip = end;
+    }
+
+    emit(OpCode::HALT);
+}
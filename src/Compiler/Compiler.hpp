@@ -0,0 +1,98 @@
+#pragma once
+#include <algorithm>
+#include "../Node/Node.hpp"
+
+// Lowers a typechecked program into a flat instruction stream for the VM.
+// Only top-level statements and the if, while and for bodies among them
+// are compiled: scalar expressions, assignments, ifs and loops. Anything
+// else, including every function body, is handed back to the tree-walker
+// through EVAL, so both engines always agree on semantics.
+
+enum class OpCode
+{
+    CONST,          // push a copy of constants[a]
+    LOAD,           // push the value of identifier constants[a]
+    EXPR,           // start of expression constants[a], resumed at b if it bails out
+    ADD,
+    SUB,
+    MUL,
+    DIV,
+    MOD,
+    LESS,
+    GREATER,
+    LESS_EQUAL,
+    GREATER_EQUAL,
+    EQUAL,
+    NOT_EQUAL,
+    POS_NEG,
+    NOT,
+    AND_SHORT,      // leave a false left operand of && and jump to b
+    AND_OR,
+    EVAL,           // evaluate constants[a] with the tree-walker
+    BIND,           // look up the target of assignment constants[a]
+    ASSIGN,         // pop a value into the last bound target
+    CONCAT,         // s = s + piece on a string s, left to the tree-walker, which resumes at b
+    POP,
+    SIGNAL,         // pop a statement result, routing break/continue/ret via targets[a]
+    CHECK_BOOL,     // error unless the top of the stack is a bool (a: 0 = while, 1 = if)
+    JUMP,
+    JUMP_IF_FALSE,  // pop, jump to a unless true
+    ENTER_SCOPE,
+    CLEAR_SCOPE,
+    LEAVE_SCOPE,
+    FOR_INIT,       // pop the iterator and open the scope of for loop constants[a]
+    FOR_NEXT,       // bind the loop variables, or jump to b when exhausted
+    FOR_STEP,
+    HALT
+};
+
+struct Instruction
+{
+    OpCode op;
+    int a = 0;
+    int b = 0;
+};
+
+// Where break, continue and ret land, and how many scopes stay open there
+
+struct Jump_Target
+{
+    int break_ip = 0, break_depth = 0;
+    int continue_ip = 0, continue_depth = 0;
+    int return_ip = 0;
+};
+
+struct Chunk
+{
+    std::vector<Instruction> code;
+    std::vector<Node_Ptr> constants;
+    std::vector<Jump_Target> targets;
+};
+
+class Compiler
+{
+    int depth = 0;
+    int target = -1;
+
+public:
+
+    std::string file_name;
+    std::vector<Node_Ptr> nodes;
+    Chunk chunk;
+
+    Compiler(std::string file_name, std::vector<Node_Ptr> nodes) : file_name(file_name), nodes(nodes) {}
+
+    int emit(OpCode op, int a = 0, int b = 0);
+    int add_constant(Node_Ptr node);
+
+    bool is_expression(Node_Ptr& node);
+    void compile_expression(Node_Ptr& node);
+    void compile_value(Node_Ptr& node);
+    void compile_statement(Node_Ptr& node);
+    void compile_block(std::vector<Node_Ptr>& nodes);
+    void compile_if_statement(Node_Ptr& node);
+    void compile_while_loop(Node_Ptr& node);
+    void compile_for_loop(Node_Ptr& node);
+
+    void compile();
+};
@@ -1,11 +1,54 @@
 #include "Evaluator.hpp"
 
-auto error_node = std::make_shared<Node>(NodeType::ERROR);
+auto error_node = make_pooled_node(NodeType::ERROR);
+
+// Symbol Table
+
+Symbol_Table& Symbol_Table::operator=(const Symbol_Table& other)
+{
+    table = other.table;
+    epoch++;
+    return *this;
+}
+
+void Symbol_Table::erase(const std::string& name)
+{
+    table.erase(name);
+    epoch++;
+}
+
+void Symbol_Table::clear()
+{
+    table.clear();
+    epoch++;
+}
+
+Node_Ptr* Symbol_Table::find_slot(int slot, const std::string& name)
+{
+    auto& cached = cache[slot % num_cached];
+
+    // A cached hit stays valid until something is erased, a cached
+    // miss only until the next insertion
+
+    if (cached.slot == slot && cached.epoch == epoch && (cached.value != nullptr || cached.size == table.size()))
+    {
+        return cached.value;
+    }
+
+    auto symbol = table.find(name);
+
+    cached.slot = slot;
+    cached.value = symbol != table.end() ? &symbol->second : nullptr;
+    cached.epoch = epoch;
+    cached.size = table.size();
+
+    return cached.value;
+}
 
 // Node Helpers
-std::shared_ptr<Node> Evaluator::make_int(long long value, bool literal)
+Node_Ptr Evaluator::make_int(long long value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::INT);
+    auto node = make_pooled_node(NodeType::INT);
     node->INT.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -13,9 +56,9 @@ std::shared_ptr<Node> Evaluator::make_int(long long value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_float(double value, bool literal)
+Node_Ptr Evaluator::make_float(double value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::FLOAT);
+    auto node = make_pooled_node(NodeType::FLOAT);
     node->FLOAT.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -23,19 +66,19 @@ std::shared_ptr<Node> Evaluator::make_float(double value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_string(std::string value, bool literal)
+Node_Ptr Evaluator::make_string(std::string value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::STRING);
-    node->STRING.value = value;
+    auto node = make_pooled_node(NodeType::STRING);
+    node->STRING.value = std::move(value);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_bool(bool value, bool literal)
+Node_Ptr Evaluator::make_bool(bool value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::BOOL);
+    auto node = make_pooled_node(NodeType::BOOL);
     node->BOOL.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -43,53 +86,53 @@ std::shared_ptr<Node> Evaluator::make_bool(bool value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_empty(bool literal)
+Node_Ptr Evaluator::make_empty(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::EMPTY);
+    auto node = make_pooled_node(NodeType::EMPTY);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_any(bool literal)
+Node_Ptr Evaluator::make_any(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::ANY);
+    auto node = make_pooled_node(NodeType::ANY);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_list(bool literal)
+Node_Ptr Evaluator::make_list(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::LIST);
+    auto node = make_pooled_node(NodeType::LIST);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_pipe_list(bool literal)
+Node_Ptr Evaluator::make_pipe_list(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::PIPE_LIST);
+    auto node = make_pooled_node(NodeType::PIPE_LIST);
     node->TYPE.is_literal = literal;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_object(bool literal)
+Node_Ptr Evaluator::make_object(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::OBJECT);
+    auto node = make_pooled_node(NodeType::OBJECT);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Evaluator::make_function(bool literal)
+Node_Ptr Evaluator::make_function(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::FUNCTION);
+    auto node = make_pooled_node(NodeType::FUNCTION);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
@@ -97,13 +140,13 @@ std::shared_ptr<Node> Evaluator::make_function(bool literal)
     return node;
 }
 
-void Evaluator::sort_and_unique(std::vector<std::shared_ptr<Node>>& list)
+void Evaluator::sort_and_unique(std::vector<Node_Ptr>& list)
 {
-    std::sort(list.begin(), list.end(), [] (std::shared_ptr<Node>& a, std::shared_ptr<Node>& b) {return int(a->type) < int(b->type);});
-    list.erase(std::unique(list.begin(), list.end(), [this] (std::shared_ptr<Node>& a, std::shared_ptr<Node>& b) {return match_types(a, b).result;}), list.end());
+    std::sort(list.begin(), list.end(), [] (Node_Ptr& a, Node_Ptr& b) {return int(a->type) < int(b->type);});
+    list.erase(std::unique(list.begin(), list.end(), [this] (Node_Ptr& a, Node_Ptr& b) {return match_types(a, b).result;}), list.end());
 }
 
-std::shared_ptr<Node> Evaluator::get_explicit_type(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::get_explicit_type(Node_Ptr& node)
 {
     auto result = make_any();
 
@@ -117,7 +160,7 @@ std::shared_ptr<Node> Evaluator::get_explicit_type(std::shared_ptr<Node>& node)
         if (result == nullptr)
         {
             auto ls = make_list();
-            ls->LIST.nodes.push_back(make_any());
+            ls->LIST.nodes().push_back(make_any());
             result = ls;
         }
     }
@@ -131,9 +174,9 @@ std::shared_ptr<Node> Evaluator::get_explicit_type(std::shared_ptr<Node>& node)
         result = make_any();
     }
 
-    if (result->type == NodeType::LIST && result->LIST.nodes.size() == 0)
+    if (result->type == NodeType::LIST && result->LIST.nodes().size() == 0)
     {
-        result->LIST.nodes.push_back(make_any());
+        result->LIST.nodes().push_back(make_any());
     }
 
     return result;
@@ -141,7 +184,7 @@ std::shared_ptr<Node> Evaluator::get_explicit_type(std::shared_ptr<Node>& node)
 
 // -- Built-in Functions -- //
 
-std::shared_ptr<Node> Evaluator::builtin_exit(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_exit(std::vector<Node_Ptr> args)
 {
     if (args.size() > 1)
     {
@@ -169,7 +212,7 @@ std::shared_ptr<Node> Evaluator::builtin_exit(std::vector<std::shared_ptr<Node>>
     exit(exit_code);
 }
 
-std::shared_ptr<Node> Evaluator::builtin_error(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_error(std::vector<Node_Ptr> args)
 {
     if (args.size() != 2)
     {
@@ -187,7 +230,7 @@ std::shared_ptr<Node> Evaluator::builtin_error(std::vector<std::shared_ptr<Node>
     error_and_exit("[" + type->STRING.value + "] " + message->STRING.value);
 }
 
-std::shared_ptr<Node> Evaluator::builtin_range(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_range(std::vector<Node_Ptr> args)
 {
     if (args.size() != 2)
     {
@@ -202,14 +245,14 @@ std::shared_ptr<Node> Evaluator::builtin_range(std::vector<std::shared_ptr<Node>
         error_and_exit("Built-in function 'range' expects 2 integer arguments");
     }
 
-    auto res = std::make_shared<Node>(NodeType::RANGE);
+    auto res = make_pooled_node(NodeType::RANGE);
     res->RANGE.start = start_node->INT.value;
     res->RANGE.end = end_node->INT.value;
 
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_print(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_print(std::vector<Node_Ptr> args)
 {
     if (args.size() < 1)
     {
@@ -218,15 +261,13 @@ std::shared_ptr<Node> Evaluator::builtin_print(std::vector<std::shared_ptr<Node>
 
     for (auto arg : args)
     {
-        std::cout << eval_node(arg)->repr();
+        Output::get().print(eval_node(arg)->repr());
     }
 
-    std::cout << std::flush;
-
     return make_empty();
 }
 
-std::shared_ptr<Node> Evaluator::builtin_delete(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_delete(std::vector<Node_Ptr> args)
 {
     for (auto arg : args)
     {
@@ -243,7 +284,7 @@ std::shared_ptr<Node> Evaluator::builtin_delete(std::vector<std::shared_ptr<Node
     return make_empty();
 }
 
-std::shared_ptr<Node> Evaluator::builtin_read(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_read(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -257,274 +298,2585 @@ std::shared_ptr<Node> Evaluator::builtin_read(std::vector<std::shared_ptr<Node>>
         error_and_exit("Built-in function 'read' expects one string argument");
     }
 
-    std::ifstream stream(file_path_node->STRING.value);
-    std::stringstream buffer;
-    buffer << stream.rdbuf();
+    Output::get().flush(file_path_node->STRING.value);
+
+    // The whole file ends up in the string anyway, so it is read straight
+    // into it, a block at a time, rather than mapped first
+
+    std::ifstream stream(file_path_node->STRING.value, std::ios::binary);
+    std::string text;
+    char block[1 << 16];
+
+    while (stream.read(block, sizeof(block)) || stream.gcount() > 0)
+    {
+        text.append(block, stream.gcount());
+    }
+
+#ifdef _WIN32
+    // As a file read in text mode would be
+    text.erase(std::remove(text.begin(), text.end(), '\r'), text.end());
+#endif
 
-    return make_string(buffer.str());
+    return make_string(std::move(text));
 }
 
-std::shared_ptr<Node> Evaluator::builtin_write(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_lines(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 2)
+    if (args.size() != 1)
     {
-       error_and_exit("Built-in function 'write' expects 2 arguments");
+       error_and_exit("Built-in function 'lines' expects one argument");
     }
 
     auto file_path_node = eval_node(args[0]);
-    auto value_node = eval_node(args[1]);
 
-    if (file_path_node->type != NodeType::STRING && value_node->type != NodeType::STRING)
+    if (file_path_node->type != NodeType::STRING)
     {
-        error_and_exit("Built-in function 'write' expects 2 string arguments");
+        error_and_exit("Built-in function 'lines' expects one string argument");
     }
 
-    auto file_path = file_path_node->STRING.value;
-    auto value = value_node->STRING.value;
+    Output::get().flush(file_path_node->STRING.value);
 
-    std::ofstream new_file(file_path);
-    new_file << value;
-    new_file.close();
+    if (!std::ifstream(file_path_node->STRING.value))
+    {
+        error_and_exit("Built-in function 'lines' cannot open file '" + file_path_node->STRING.value + "'");
+    }
 
-    return file_path_node;
+    // The file is read a line at a time by whatever walks the list
+
+    auto res = make_list();
+    res->LIST.set_lines(file_path_node->STRING.value);
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_string("", false));
+    return res;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_append(std::vector<std::shared_ptr<Node>> args)
+// --- JSON --- //
+
+// The value a JSON text describes; see JSON_Reader
+
+Node_Ptr Evaluator::builtin_json_parse(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 2)
+    if (args.size() != 1)
     {
-       error_and_exit("Built-in function 'append' expects 2 arguments");
+       error_and_exit("Built-in function 'json.parse' expects one argument");
     }
 
-    auto file_path_node = eval_node(args[0]);
-    auto value_node = eval_node(args[1]);
+    auto text_node = eval_node(args[0]);
 
-    if (file_path_node->type != NodeType::STRING && value_node->type != NodeType::STRING)
+    if (text_node->type != NodeType::STRING)
     {
-        error_and_exit("Built-in function 'append' expects 2 string arguments");
+        error_and_exit("Built-in function 'json.parse' expects one string argument");
     }
 
-    auto file_path = file_path_node->STRING.value;
-    auto value = value_node->STRING.value;
+    JSON_Reader reader;
+    auto value = reader.parse(text_node->STRING.value);
 
-    std::ofstream new_file(file_path, std::ios_base::app);
-    new_file << value;
-    new_file.close();
+    if (value == nullptr)
+    {
+        error_and_exit("Built-in function 'json.parse' could not parse its argument: " + reader.error);
+    }
 
-    return file_path_node;
+    return value;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_time(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_json_stringify(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 0)
+    if (args.size() != 2)
     {
-        error_and_exit("Built-in function 'time' expects 0 arguments");
+       error_and_exit("Built-in function 'json.stringify' expects two arguments");
     }
 
-    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
-    auto time_node = std::make_shared<Node>(NodeType::INT);
-    time_node->INT.value = time;
+    auto value = eval_node(args[0]);
+    auto indent_node = eval_node(args[1]);
 
-    return time_node;
+    if (indent_node->type != NodeType::INT)
+    {
+        error_and_exit("Built-in function 'json.stringify' expects an int indent");
+    }
+
+    JSON_Writer writer(indent_node->INT.value);
+
+    if (!writer.write(value))
+    {
+        error_and_exit("Built-in function 'json.stringify' " + writer.error);
+    }
+
+    return make_string(std::move(writer.out));
 }
 
-std::shared_ptr<Node> Evaluator::builtin_import(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::builtin_json_read(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
-        error_and_exit("Built-in function 'import' expects 1 argument");
+       error_and_exit("Built-in function 'json.read' expects one argument");
     }
 
-    auto path_node = eval_node(args[0]);
+    auto file_path_node = eval_node(args[0]);
 
-    if (path_node->type != NodeType::STRING)
+    if (file_path_node->type != NodeType::STRING)
     {
-        error_and_exit("Built-in function 'import' expects 1 string argument");
+        error_and_exit("Built-in function 'json.read' expects one string argument");
     }
 
-    std::string path = path_node->STRING.value;
-
-    Lexer lexer(path);
-    lexer.builtins_path = builtins_path;
-    lexer.tokenize();
-
-    Parser parser(lexer.file_name, lexer.nodes);
-    parser.parse();
+    Output::get().flush(file_path_node->STRING.value);
 
-    Typechecker typechecker(parser.file_name, parser.nodes);
-    typechecker.builtins_path = builtins_path;
-    typechecker.init(typechecker.builtins_path);
-    typechecker.evaluate();
+    Mapped_File file(file_path_node->STRING.value);
 
-    Evaluator evaluator(typechecker.file_name, typechecker.nodes);
-    evaluator.builtins_path = builtins_path;
-    evaluator.init(evaluator.builtins_path);
-    evaluator.evaluate();
+    if (!file.is_open())
+    {
+        error_and_exit("Built-in function 'json.read' cannot open file '" + file_path_node->STRING.value + "'");
+    }
 
-    auto import_obj = make_object();
+    JSON_Reader reader;
+    auto value = reader.parse(file.view());
 
-    for (auto symbol : evaluator.symbol_table)
+    if (value == nullptr)
     {
-        if (std::find(builtins_names.begin(), builtins_names.end(), symbol.first) != builtins_names.end())
-        {
-            continue;
-        }
-        import_obj->OBJECT.properties[symbol.first] = Object_Prop(true, symbol.second);
+        error_and_exit("Built-in function 'json.read' could not parse '" + file_path_node->STRING.value + "': " + reader.error);
     }
 
-    return import_obj;
+    return value;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_to_int(std::vector<std::shared_ptr<Node>> args)
+// Writes the JSON text straight to the file as it is made, a block at a time
+
+Node_Ptr Evaluator::builtin_json_write(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 1)
+    if (args.size() != 3)
     {
-       error_and_exit("Built-in function 'to_int' expects one argument");
+       error_and_exit("Built-in function 'json.write' expects three arguments");
     }
 
-    auto result = std::make_shared<Node>(NodeType::INT);
-    auto value = eval_node(args[0]);
+    auto file_path_node = eval_node(args[0]);
+    auto value = eval_node(args[1]);
+    auto indent_node = eval_node(args[2]);
 
-    if (value->type == NodeType::BOOL)
+    if (file_path_node->type != NodeType::STRING || indent_node->type != NodeType::INT)
     {
-        result->INT.value = (long long)value->BOOL.value;
+        error_and_exit("Built-in function 'json.write' expects a string path and an int indent");
     }
-    else if (value->type == NodeType::INT)
+
+    Output::get().close(file_path_node->STRING.value);
+    Mapped_File::detach(file_path_node->STRING.value);
+
+    std::ofstream stream(file_path_node->STRING.value, std::ios::binary);
+
+    if (!stream)
     {
-        result = value;
+        error_and_exit("Built-in function 'json.write' cannot open file '" + file_path_node->STRING.value + "'");
     }
-    else if (value->type == NodeType::FLOAT)
+
+    JSON_Writer writer(indent_node->INT.value, &stream);
+
+    if (!writer.write(value))
     {
-        result->INT.value = (long long)value->FLOAT.value;
+        error_and_exit("Built-in function 'json.write' " + writer.error);
     }
-    else if (value->type == NodeType::STRING)
+
+    writer.out += '\n';
+    writer.flush();
+
+    return file_path_node;
+}
+
+// Calls a function on each element of the top level array of a JSON file as
+// it is read, so the file can be larger than memory. Returns how many
+// elements there were
+
+Node_Ptr Evaluator::builtin_json_each(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
     {
-        try {
-            if (value->STRING.value.size() == 1 && !isdigit(value->STRING.value[0]))
-            {
-                char c = value->STRING.value[0];
-                result->INT.value = int(c);
-            }
-            else
-            {
-                result->INT.value = std::stol(value->STRING.value);
-            }
-        } catch(...) {
-            error_and_exit("Unable to cast '" + value->repr() + "' to an integer");
-        }
+       error_and_exit("Built-in function 'json.each' expects two arguments");
     }
-    else if (value->type == NodeType::ANY)
+
+    auto file_path_node = eval_node(args[0]);
+    auto func = eval_node(args[1]);
+
+    if (file_path_node->type != NodeType::STRING)
     {
-        return make_int(false);
+        error_and_exit("Built-in function 'json.each' expects a string path");
     }
-    else
+
+    if (func->type != NodeType::FUNCTION && func->type != NodeType::FUNC_LIST)
     {
-        error_and_exit("Unable to cast '" + value->repr() + "' to an integer");
+        error_and_exit("Built-in function 'json.each' expects a function");
     }
 
-    return result;
-}
+    Output::get().flush(file_path_node->STRING.value);
 
-std::shared_ptr<Node> Evaluator::builtin_to_float(std::vector<std::shared_ptr<Node>> args)
-{
-    if (args.size() != 1)
+    std::ifstream stream(file_path_node->STRING.value, std::ios::binary);
+
+    if (!stream)
     {
-       error_and_exit("Built-in function 'to_float' expects one argument");
+        error_and_exit("Built-in function 'json.each' cannot open file '" + file_path_node->STRING.value + "'");
     }
 
-    auto result = make_float(0);
-    auto value = eval_node(args[0]);
+    JSON_Reader reader;
+    size_t count = reader.each(stream, [this, &func](Node_Ptr& value) { eval_function_call(func, {value}); });
 
-    if (value->type == NodeType::BOOL)
+    if (!reader.error.empty())
     {
-        result->FLOAT.value = (double)value->BOOL.value;
+        error_and_exit("Built-in function 'json.each' could not parse '" + file_path_node->STRING.value + "': " + reader.error);
     }
-    else if (value->type == NodeType::FLOAT)
+
+    return make_int(count);
+}
+
+// --- NDJSON --- //
+
+// A lazy list of the values on each line of a file, read as it is walked.
+// With a list of keys, only those properties of each object are built
+
+Node_Ptr Evaluator::builtin_ndjson_lines(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1 && args.size() != 2)
     {
-        result = value;
+       error_and_exit("Built-in function 'ndjson.lines' expects one or two arguments");
     }
-    else if (value->type == NodeType::INT)
+
+    auto file_path_node = eval_node(args[0]);
+
+    if (file_path_node->type != NodeType::STRING)
     {
-        result->FLOAT.value = (double)value->INT.value;
+        error_and_exit("Built-in function 'ndjson.lines' expects a string path");
     }
-    else if (value->type == NodeType::STRING)
+
+    std::vector<std::string> keys;
+
+    if (args.size() == 2)
     {
-        try {
-            result->FLOAT.value = std::stof(value->STRING.value);
-        } catch(...) {
-            error_and_exit("Unable to cast '" + value->repr() + "' to a float");
+        auto keys_node = eval_node(args[1]);
+
+        if (keys_node->type != NodeType::LIST)
+        {
+            error_and_exit("Built-in function 'ndjson.lines' expects a list of keys");
+        }
+
+        for (auto& key : keys_node->LIST.nodes())
+        {
+            if (key->type != NodeType::STRING)
+            {
+                error_and_exit("Built-in function 'ndjson.lines' expects a list of string keys");
+            }
+
+            keys.push_back(key->STRING.value);
         }
     }
-    else if (value->type == NodeType::ANY)
-    {
-        return make_float(false);
-    }
-    else
+
+    Output::get().flush(file_path_node->STRING.value);
+
+    if (!std::ifstream(file_path_node->STRING.value))
     {
-        error_and_exit("Unable to cast '" + value->repr() + "' to a float");
+        error_and_exit("Built-in function 'ndjson.lines' cannot open file '" + file_path_node->STRING.value + "'");
     }
 
-    return result;
+    auto res = make_list();
+    res->LIST.set_json_lines(file_path_node->STRING.value, std::move(keys));
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+    return res;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_to_string(std::vector<std::shared_ptr<Node>> args)
+// Writes each element of a list as JSON on a line of its own. A lazy list is
+// written as it is walked, so a stream piped straight in is never held whole
+
+Node_Ptr Evaluator::builtin_ndjson_write(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 1)
+    if (args.size() != 3)
     {
-       error_and_exit("Built-in function 'to_string' expects one argument");
+       error_and_exit("Built-in function 'ndjson.write' expects three arguments");
     }
 
-    auto result = make_string("");
-    auto value = eval_node(args[0]);
+    auto file_path_node = eval_node(args[0]);
+    auto data = eval_node(args[1]);
+    auto append_node = eval_node(args[2]);
 
-    result->STRING.value = value->repr();
+    if (file_path_node->type != NodeType::STRING || data->type != NodeType::LIST || append_node->type != NodeType::BOOL)
+    {
+        error_and_exit("Built-in function 'ndjson.write' expects a string path and a list");
+    }
 
-    return result;
-}
+    Output::get().close(file_path_node->STRING.value);
 
-std::shared_ptr<Node> Evaluator::builtin_type(std::vector<std::shared_ptr<Node>> args)
-{
-    if (args.size() != 1)
+    if (!append_node->BOOL.value)
     {
-       error_and_exit("Built-in function 'type' expects one argument");
+        Mapped_File::detach(file_path_node->STRING.value);
     }
 
-    auto result = make_string("");
-    auto value = eval_node(args[0]);
+    auto mode = std::ios::binary | (append_node->BOOL.value ? std::ios::app : std::ios::trunc);
+    std::ofstream stream(file_path_node->STRING.value, mode);
 
-    switch (value->type)
+    if (!stream)
     {
-        case NodeType::STRING: result->STRING.value = "string"; break;
-        case NodeType::INT: result->STRING.value = "int"; break;
-        case NodeType::FLOAT: result->STRING.value = "float"; break;
-        case NodeType::BOOL: result->STRING.value = "bool"; break;
-        case NodeType::LIST: result->STRING.value = "list"; break;
-        case NodeType::PIPE_LIST: result->STRING.value = "pipe_list"; break;
-        case NodeType::COMMA_LIST: result->STRING.value = "comma_list"; break;
-        case NodeType::OBJECT: result->STRING.value = "object"; break;
-        case NodeType::RANGE: result->STRING.value = "range"; break;
-        case NodeType::FUNCTION: result->STRING.value = "function"; break;
-        case NodeType::OP: result->STRING.value = "op<" + value->OP.value + ">"; break;
-        case NodeType::PARTIAL_OP: result->STRING.value = "__op<" + value->OP.value + ">__"; break;
-        case NodeType::EMPTY: result->STRING.value = "empty"; break;
-        default: result->STRING.value = "<no type repr>";
+        error_and_exit("Built-in function 'ndjson.write' cannot open file '" + file_path_node->STRING.value + "'");
     }
 
-    return result;
+    JSON_Writer writer(0, &stream);
+
+    auto write_line = [&](const Node_Ptr& value)
+    {
+        if (!writer.write(value))
+        {
+            error_and_exit("Built-in function 'ndjson.write' " + writer.error);
+        }
+
+        writer.out += '\n';
+    };
+
+    if (data->LIST.lazy)
+    {
+        Sequence_Cursor cursor(data);
+
+        while (cursor.next())
+        {
+            write_line(cursor.value());
+        }
+    }
+    else
+    {
+        for (auto& elem : data->LIST.elements)
+        {
+            write_line(elem);
+        }
+    }
+
+    writer.flush();
+
+    return file_path_node;
 }
 
-std::shared_ptr<Node> Evaluator::builtin_shape(std::vector<std::shared_ptr<Node>> args)
+// ---- //
+
+Node_Ptr Evaluator::builtin_csv_load(std::vector<Node_Ptr> args)
 {
-    if (args.size() != 1)
+    if (args.size() != 3)
     {
-       error_and_exit("Built-in function 'shape' expects one argument");
+       error_at_call("Built-in function 'csv_load' expects three arguments");
     }
 
-    auto value = eval_node(args[0]);
-    return get_type(value);
-}
+    auto file_path_node = eval_node(args[0]);
+    auto delim_node = eval_node(args[1]);
+    auto schema_node = eval_node(args[2]);
 
-std::unordered_map<std::string, std::shared_ptr<Node> (Evaluator::*)(std::vector<std::shared_ptr<Node>>)> builtin_functions = {
+    if (file_path_node->type != NodeType::STRING || delim_node->type != NodeType::STRING || schema_node->type != NodeType::OBJECT)
+    {
+        error_at_call("Built-in function 'csv_load' expects a string path, a string delimiter and an object schema");
+    }
+
+    if (delim_node->STRING.value.size() != 1)
+    {
+        error_at_call("Built-in function 'csv_load' expects a single character delimiter");
+    }
+
+    Output::get().flush(file_path_node->STRING.value);
+
+    CSV_Reader reader(file_path_node->STRING.value, delim_node->STRING.value[0]);
+
+    if (!reader.is_open)
+    {
+        error_at_call("Built-in function 'csv_load' cannot open file '" + file_path_node->STRING.value + "'");
+    }
+
+    auto table = std::make_shared<Table_Node>();
+
+    auto res = make_list();
+    res->LIST.set_table(table);
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+
+    std::vector<CSV_Field> fields;
+
+    if (!reader.next_row(fields))
+    {
+        return res;
+    }
+
+    // What the schema asks for each column is worked out once, from the
+    // header row, rather than once per field
+
+    struct Column
+    {
+        int index = -1;
+        Node_Ptr convert;
+    };
+
+    std::vector<Column> columns;
+
+    for (auto& field : fields)
+    {
+        Column column;
+
+        if (!field.value.empty())
+        {
+            column.index = table->column_index(field.value);
+
+            if (column.index < 0)
+            {
+                column.index = table->add_column(field.value);
+            }
+        }
+
+        auto prop = schema_node->OBJECT->properties.find(field.value);
+
+        if (prop != schema_node->OBJECT->properties.end())
+        {
+            auto& value = prop->second.value;
+
+            if (value->type == NodeType::FUNCTION)
+            {
+                if (value->FUNCTION->params.size() == 1 || value->FUNCTION->params.size() == 2)
+                {
+                    column.convert = value;
+                }
+            }
+            else if (!value->TYPE.is_literal)
+            {
+                if (value->type == NodeType::INT || value->type == NodeType::FLOAT || value->type == NodeType::BOOL)
+                {
+                    column.convert = value;
+                }
+            }
+        }
+
+        columns.push_back(column);
+    }
+
+    // Cells are copied into the table's columns, so unconverted fields can
+    // all pass through one node
+
+    auto field_node = make_pooled_node(NodeType::STRING);
+
+    while (reader.next_row(fields))
+    {
+        table->push_row();
+        size_t row = table->rows - 1;
+
+        for (size_t i = 0; i < fields.size() && i < columns.size(); i++)
+        {
+            auto& column = columns[i];
+
+            // Unnamed columns and missing values leave the property unset
+
+            if (column.index < 0 || fields[i].empty())
+            {
+                continue;
+            }
+
+            field_node->STRING.value = fields[i].value;
+            Node_Ptr value = field_node;
+
+            if (column.convert == nullptr)
+            {
+                // Kept as the string it was read as
+            }
+            else if (column.convert->type == NodeType::INT)
+            {
+                value = builtin_to_int({field_node});
+            }
+            else if (column.convert->type == NodeType::FLOAT)
+            {
+                value = builtin_to_float({field_node});
+            }
+            else if (column.convert->type == NodeType::BOOL)
+            {
+                value = make_pooled_node(NodeType::BOOL);
+                value->BOOL.value = fields[i].value == "true";
+            }
+            else
+            {
+                auto field_value = make_pooled_node(NodeType::STRING);
+                field_value->STRING.value = fields[i].value;
+
+                if (column.convert->FUNCTION->params.size() == 1)
+                {
+                    value = eval_function_call(column.convert, {field_value});
+                }
+                else
+                {
+                    value = eval_function_call(column.convert, {field_value, table->row(row)});
+                }
+            }
+
+            table->set(row, column.index, value);
+        }
+    }
+
+    return res;
+}
+
+// The values of one column of a list of objects, null where a row does not
+// have it. A table hands the column over without building its rows
+
+Node_Ptr Evaluator::builtin_column(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'column' expects two arguments");
+    }
+
+    auto data = eval_node(args[0]);
+    auto name_node = eval_node(args[1]);
+
+    if (data->type != NodeType::LIST || name_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'column' expects a list and a string column name");
+    }
+
+    auto& name = name_node->STRING.value;
+    auto res = make_list();
+
+    if (data->LIST.is_table())
+    {
+        auto& table = *data->LIST.table;
+        int index = table.column_index(name);
+
+        res->LIST.nodes().reserve(table.rows);
+
+        for (size_t i = 0; i < table.rows; i++)
+        {
+            auto value = index < 0 ? nullptr : table.get(i, index);
+            res->LIST.nodes().push_back(value != nullptr ? value : make_empty());
+        }
+    }
+    else
+    {
+        Sequence_Cursor cursor(data);
+
+        while (cursor.next())
+        {
+            auto row = cursor.value();
+
+            if (row->type != NodeType::OBJECT)
+            {
+                error_and_exit("Built-in function 'column' expects a list of objects");
+            }
+
+            auto prop = row->OBJECT->properties.find(name);
+            res->LIST.nodes().push_back(prop != row->OBJECT->properties.end() ? prop->second.value : make_empty());
+        }
+    }
+
+    res->TYPE.allowed_type = get_type(res);
+
+    return res;
+}
+
+// Splits a list of objects into lists keyed by to_string of one column.
+// Rows are grouped by hashing the column's values, and the text of a key is
+// only made once per group. The groups of a table are tables themselves
+
+Node_Ptr Evaluator::builtin_group_rows(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'group_rows' expects two arguments");
+    }
+
+    auto name_node = eval_node(args[0]);
+    auto data = eval_node(args[1]);
+
+    if (name_node->type != NodeType::STRING || data->type != NodeType::LIST)
+    {
+        error_and_exit("Built-in function 'group_rows' expects a string column name and a list");
+    }
+
+    auto& name = name_node->STRING.value;
+    auto res = make_pooled_node(NodeType::OBJECT);
+
+    Group_Index index(1);
+    Key_Encoder encoder;
+    std::vector<uint64_t> key;
+    std::vector<std::vector<size_t>> groups;
+
+    bool is_table = data->LIST.is_table();
+    Table_Node* table = is_table ? data->LIST.table.get() : nullptr;
+    int column = is_table ? table->column_index(name) : -1;
+    auto& rows = is_table ? data->LIST.elements : data->LIST.nodes();
+    size_t row_count = is_table ? table->rows : rows.size();
+
+    for (size_t i = 0; i < row_count; i++)
+    {
+        key.clear();
+
+        if (is_table && column >= 0)
+        {
+            encoder.add(*table, i, column, key);
+        }
+        else if (is_table)
+        {
+            encoder.add(nullptr, key);
+        }
+        else
+        {
+            if (rows[i]->type != NodeType::OBJECT)
+            {
+                error_and_exit("Built-in function 'group_rows' expects a list of objects");
+            }
+
+            auto prop = rows[i]->OBJECT->properties.find(name);
+            encoder.add(prop != rows[i]->OBJECT->properties.end() ? prop->second.value.get() : nullptr, key);
+        }
+
+        size_t group = index.find_or_add(key.data());
+
+        if (group == groups.size())
+        {
+            groups.emplace_back();
+        }
+
+        groups[group].push_back(i);
+    }
+
+    // Groups are named by the text of their key. Values that differ but
+    // print the same, like 1 and "1", end up in one group as they used to
+
+    std::vector<std::string> texts;
+    std::unordered_map<std::string, size_t> named;
+
+    for (size_t group = 0; group < groups.size(); group++)
+    {
+        auto& first = groups[group][0];
+        std::string text;
+
+        if (is_table)
+        {
+            text = column < 0 ? "null" : table->key(first, column);
+        }
+        else
+        {
+            auto prop = rows[first]->OBJECT->properties.find(name);
+            text = prop != rows[first]->OBJECT->properties.end() ? prop->second.value->repr() : "null";
+        }
+
+        auto owner = named.find(text);
+
+        if (owner == named.end())
+        {
+            named[text] = group;
+            texts.push_back(text);
+            continue;
+        }
+
+        auto& merged = groups[owner->second];
+        merged.insert(merged.end(), groups[group].begin(), groups[group].end());
+        std::sort(merged.begin(), merged.end());
+    }
+
+    for (auto& text : texts)
+    {
+        auto& group = groups[named[text]];
+
+        auto value = make_list();
+        value->TYPE.allowed_type = make_list();
+        value->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+
+        if (is_table)
+        {
+            value->LIST.set_table(table->select(group));
+        }
+        else
+        {
+            value->LIST.nodes().reserve(group.size());
+
+            for (auto row : group)
+            {
+                value->LIST.nodes().push_back(rows[row]);
+            }
+        }
+
+        res->OBJECT->properties[text] = Object_Prop(true, value);
+    }
+
+    return res;
+}
+
+// Groups rows by the values of one or more key columns and works out each
+// group's aggregates in the same pass. Each aggregate is named by a list of
+// its kind - sum, count, min, max, avg, first, last or list - and the column
+// it reads; count with no column counts rows. Nulls are left out of all but
+// first, last and list. A table comes back as a table with a row per group,
+// and anything else as a list of objects
+
+Node_Ptr Evaluator::builtin_summarize(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'summarize' expects three arguments");
+    }
+
+    auto keys_node = eval_node(args[0]);
+    auto specs_node = eval_node(args[1]);
+    auto data = eval_node(args[2]);
+
+    std::vector<std::string> keys;
+
+    if (keys_node->type == NodeType::STRING)
+    {
+        keys.push_back(keys_node->STRING.value);
+    }
+    else if (keys_node->type == NodeType::LIST)
+    {
+        for (auto& key : keys_node->LIST.nodes())
+        {
+            if (key->type != NodeType::STRING)
+            {
+                error_and_exit("Built-in function 'summarize' expects key columns to be strings");
+            }
+
+            keys.push_back(key->STRING.value);
+        }
+    }
+
+    if (keys.empty() || specs_node->type != NodeType::OBJECT || data->type != NodeType::LIST)
+    {
+        error_and_exit("Built-in function 'summarize' expects key columns, an object of aggregates and a list");
+    }
+
+    enum class Summary_Kind { SUM, COUNT, MIN, MAX, AVG, FIRST, LAST, LIST };
+
+    struct Summary
+    {
+        std::string name;
+        Summary_Kind kind;
+        std::string column;
+        int index = -1;
+    };
+
+    std::vector<Summary> summaries;
+
+    for (auto& spec : specs_node->OBJECT->properties)
+    {
+        auto& value = spec.second.value;
+        std::vector<Node_Ptr> parts;
+
+        if (value->type == NodeType::STRING)
+        {
+            parts.push_back(value);
+        }
+        else if (value->type == NodeType::LIST)
+        {
+            parts = value->LIST.nodes();
+        }
+
+        if (parts.empty() || parts.size() > 2 || parts[0]->type != NodeType::STRING || (parts.size() == 2 && parts[1]->type != NodeType::STRING))
+        {
+            error_and_exit("Built-in function 'summarize' expects aggregate '" + spec.first + "' to be a kind and a column, like [\"sum\" \"salary\"]");
+        }
+
+        static const std::unordered_map<std::string, Summary_Kind> kinds = {
+            {"sum", Summary_Kind::SUM},
+            {"count", Summary_Kind::COUNT},
+            {"min", Summary_Kind::MIN},
+            {"max", Summary_Kind::MAX},
+            {"avg", Summary_Kind::AVG},
+            {"first", Summary_Kind::FIRST},
+            {"last", Summary_Kind::LAST},
+            {"list", Summary_Kind::LIST}
+        };
+
+        auto kind = kinds.find(parts[0]->STRING.value);
+
+        if (kind == kinds.end())
+        {
+            error_and_exit("Built-in function 'summarize' does not have an aggregate called '" + parts[0]->STRING.value + "'");
+        }
+
+        if (parts.size() == 1 && kind->second != Summary_Kind::COUNT)
+        {
+            error_and_exit("Built-in function 'summarize' expects aggregate '" + spec.first + "' to name a column");
+        }
+
+        Summary summary;
+        summary.name = spec.first;
+        summary.kind = kind->second;
+        summary.column = parts.size() == 2 ? parts[1]->STRING.value : "";
+        summaries.push_back(summary);
+    }
+
+    // Properties have no order, so the aggregates are put in one
+
+    std::sort(summaries.begin(), summaries.end(), [](const Summary& a, const Summary& b) { return a.name < b.name; });
+
+    bool is_table = data->LIST.is_table();
+    Table_Node* table = is_table ? data->LIST.table.get() : nullptr;
+    auto& rows = is_table ? data->LIST.elements : data->LIST.nodes();
+    size_t row_count = is_table ? table->rows : rows.size();
+
+    std::vector<int> key_indices;
+
+    if (is_table)
+    {
+        for (auto& key : keys)
+        {
+            key_indices.push_back(table->column_index(key));
+        }
+
+        for (auto& summary : summaries)
+        {
+            summary.index = summary.column.empty() ? -1 : table->column_index(summary.column);
+        }
+    }
+
+    // A cell read without making a node for it
+
+    struct Cell
+    {
+        NodeType type = NodeType::EMPTY;
+        long long int_value = 0;
+        double float_value = 0;
+        const std::string* string_value = nullptr;
+        Node* node = nullptr;
+    };
+
+    auto node_cell = [](Node* node)
+    {
+        Cell cell;
+
+        if (node == nullptr)
+        {
+            return cell;
+        }
+
+        cell.type = node->type;
+        cell.node = node;
+
+        switch (node->type)
+        {
+            case NodeType::INT: cell.int_value = node->INT.value; break;
+            case NodeType::BOOL: cell.int_value = node->BOOL.value; break;
+            case NodeType::FLOAT: cell.float_value = node->FLOAT.value; break;
+            case NodeType::STRING: cell.string_value = &node->STRING.value; break;
+            default: break;
+        }
+
+        return cell;
+    };
+
+    auto property = [&](size_t row, const std::string& name) -> Node*
+    {
+        auto& props = rows[row]->OBJECT->properties;
+        auto prop = props.find(name);
+        return prop != props.end() ? prop->second.value.get() : nullptr;
+    };
+
+    auto read = [&](size_t row, const Summary& summary)
+    {
+        if (!is_table)
+        {
+            return node_cell(property(row, summary.column));
+        }
+
+        Cell cell;
+
+        if (summary.index < 0 || table->columns[summary.index].missing[row])
+        {
+            return cell;
+        }
+
+        auto& column = table->columns[summary.index];
+
+        switch (column.type)
+        {
+            case Column_Type::INT: cell.type = NodeType::INT; cell.int_value = column.ints[row]; break;
+            case Column_Type::BOOL: cell.type = NodeType::BOOL; cell.int_value = column.ints[row]; break;
+            case Column_Type::FLOAT: cell.type = NodeType::FLOAT; cell.float_value = column.floats[row]; break;
+            case Column_Type::STRING: cell.type = NodeType::STRING; cell.string_value = &table->strings[column.strings[row]]; break;
+            default: cell = node_cell(column.values[row].get()); break;
+        }
+
+        return cell;
+    };
+
+    // The value a cell came from, as a node of the result
+
+    auto value_of = [&](size_t row, const std::string& name, int index) -> Node_Ptr
+    {
+        Node_Ptr value;
+
+        if (is_table)
+        {
+            value = index < 0 ? nullptr : table->get(row, index);
+        }
+        else
+        {
+            auto prop = property(row, name);
+            value = prop != nullptr ? Node_Ptr(prop) : nullptr;
+        }
+
+        return value != nullptr ? value : make_empty();
+    };
+
+    auto compare = make_pooled_node(NodeType::OP);
+    compare->OP.op_type = NodeType::L_ANGLE;
+    compare->OP.value = "<";
+
+    auto less = [&](const Cell& a, const Cell& b, size_t a_row, size_t b_row, const Summary& summary)
+    {
+        if (a.type == NodeType::INT && b.type == NodeType::INT)
+        {
+            return a.int_value < b.int_value;
+        }
+
+        if ((a.type == NodeType::INT || a.type == NodeType::FLOAT) && (b.type == NodeType::INT || b.type == NodeType::FLOAT))
+        {
+            double x = a.type == NodeType::INT ? a.int_value : a.float_value;
+            double y = b.type == NodeType::INT ? b.int_value : b.float_value;
+            return x < y;
+        }
+
+        if (a.type == NodeType::STRING && b.type == NodeType::STRING)
+        {
+            return *a.string_value < *b.string_value;
+        }
+
+        if (a.type == NodeType::BOOL && b.type == NodeType::BOOL)
+        {
+            return a.int_value < b.int_value;
+        }
+
+        compare->left = value_of(a_row, summary.column, summary.index);
+        compare->right = value_of(b_row, summary.column, summary.index);
+        return eval_equality(compare)->BOOL.value;
+    };
+
+    struct Summary_State
+    {
+        size_t count = 0;
+        unsigned long long int_sum = 0;
+        double float_sum = 0;
+        bool is_float = false;
+        long long best = -1;
+        std::vector<size_t> rows;
+    };
+
+    Group_Index index(keys.size());
+    Key_Encoder encoder;
+    std::vector<uint64_t> key;
+
+    std::vector<size_t> first_rows;
+    std::vector<size_t> last_rows;
+    std::vector<size_t> row_counts;
+    std::vector<Summary_State> states;
+
+    for (size_t row = 0; row < row_count; row++)
+    {
+        key.clear();
+
+        if (!is_table && rows[row]->type != NodeType::OBJECT)
+        {
+            error_and_exit("Built-in function 'summarize' expects a list of objects");
+        }
+
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            if (!is_table)
+            {
+                encoder.add(property(row, keys[k]), key);
+            }
+            else if (key_indices[k] >= 0)
+            {
+                encoder.add(*table, row, key_indices[k], key);
+            }
+            else
+            {
+                encoder.add(nullptr, key);
+            }
+        }
+
+        size_t group = index.find_or_add(key.data());
+
+        if (group == first_rows.size())
+        {
+            first_rows.push_back(row);
+            last_rows.push_back(row);
+            row_counts.push_back(0);
+            states.resize(states.size() + summaries.size());
+        }
+
+        last_rows[group] = row;
+        row_counts[group]++;
+
+        for (size_t s = 0; s < summaries.size(); s++)
+        {
+            auto& summary = summaries[s];
+            auto& state = states[group * summaries.size() + s];
+
+            switch (summary.kind)
+            {
+                case Summary_Kind::COUNT:
+                {
+                    if (summary.column.empty() || read(row, summary).type != NodeType::EMPTY)
+                    {
+                        state.count++;
+                    }
+
+                    break;
+                }
+                case Summary_Kind::SUM:
+                case Summary_Kind::AVG:
+                {
+                    auto cell = read(row, summary);
+
+                    if (cell.type == NodeType::INT)
+                    {
+                        state.int_sum += (unsigned long long)cell.int_value;
+                    }
+                    else if (cell.type == NodeType::FLOAT)
+                    {
+                        state.float_sum += cell.float_value;
+                        state.is_float = true;
+                    }
+                    else if (cell.type != NodeType::EMPTY)
+                    {
+                        error_and_exit("Built-in function 'summarize' can only take the " + std::string(summary.kind == Summary_Kind::SUM ? "sum" : "avg") + " of numbers, but '" + summary.column + "' holds other values");
+                    }
+                    else
+                    {
+                        break;
+                    }
+
+                    state.count++;
+                    break;
+                }
+                case Summary_Kind::MIN:
+                case Summary_Kind::MAX:
+                {
+                    auto cell = read(row, summary);
+
+                    if (cell.type == NodeType::EMPTY)
+                    {
+                        break;
+                    }
+
+                    if (state.best < 0)
+                    {
+                        state.best = row;
+                        break;
+                    }
+
+                    auto best = read(state.best, summary);
+                    bool better = summary.kind == Summary_Kind::MIN ? less(cell, best, row, state.best, summary) : less(best, cell, state.best, row, summary);
+
+                    if (better)
+                    {
+                        state.best = row;
+                    }
+
+                    break;
+                }
+                case Summary_Kind::LIST:
+                {
+                    state.rows.push_back(row);
+                    break;
+                }
+                default: break;
+            }
+        }
+    }
+
+    // One row per group: the key columns, then the aggregates
+
+    std::vector<std::string> names = keys;
+
+    for (auto& summary : summaries)
+    {
+        names.push_back(summary.name);
+    }
+
+    auto res = make_list();
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+
+    std::shared_ptr<Table_Node> result_table;
+
+    if (is_table)
+    {
+        result_table = std::make_shared<Table_Node>();
+
+        for (auto& name : names)
+        {
+            if (result_table->column_index(name) < 0)
+            {
+                result_table->add_column(name);
+            }
+        }
+
+        res->LIST.set_table(result_table);
+    }
+
+    for (size_t group = 0; group < first_rows.size(); group++)
+    {
+        std::vector<Node_Ptr> values;
+
+        for (size_t k = 0; k < keys.size(); k++)
+        {
+            values.push_back(value_of(first_rows[group], keys[k], is_table ? key_indices[k] : -1));
+        }
+
+        for (size_t s = 0; s < summaries.size(); s++)
+        {
+            auto& summary = summaries[s];
+            auto& state = states[group * summaries.size() + s];
+            double total = (double)(long long)state.int_sum + state.float_sum;
+
+            switch (summary.kind)
+            {
+                case Summary_Kind::COUNT: values.push_back(make_int(state.count)); break;
+                case Summary_Kind::SUM: values.push_back(state.is_float ? make_float(total) : make_int((long long)state.int_sum)); break;
+                case Summary_Kind::AVG: values.push_back(state.count == 0 ? make_empty() : make_float(total / state.count)); break;
+                case Summary_Kind::FIRST: values.push_back(value_of(first_rows[group], summary.column, summary.index)); break;
+                case Summary_Kind::LAST: values.push_back(value_of(last_rows[group], summary.column, summary.index)); break;
+                case Summary_Kind::MIN:
+                case Summary_Kind::MAX:
+                {
+                    values.push_back(state.best < 0 ? make_empty() : value_of(state.best, summary.column, summary.index));
+                    break;
+                }
+                case Summary_Kind::LIST:
+                {
+                    auto list = make_list();
+
+                    for (auto row : state.rows)
+                    {
+                        list->LIST.nodes().push_back(value_of(row, summary.column, summary.index));
+                    }
+
+                    list->TYPE.allowed_type = get_type(list);
+                    values.push_back(list);
+                    break;
+                }
+            }
+        }
+
+        if (is_table)
+        {
+            result_table->push_row();
+
+            for (size_t i = 0; i < names.size(); i++)
+            {
+                result_table->set(group, result_table->column_index(names[i]), values[i]);
+            }
+
+            continue;
+        }
+
+        auto object = make_pooled_node(NodeType::OBJECT);
+        object->TYPE.allowed_type = make_object(false);
+
+        for (size_t i = 0; i < names.size(); i++)
+        {
+            set_row_property(object, names[i], values[i]);
+        }
+
+        res->LIST.nodes().push_back(object);
+    }
+
+    return res;
+}
+
+// --- Joins --- //
+
+// The key words of one row's value of a column, from a table or a list of
+// objects. A row without the column is keyed as null
+
+static void encode_cell(Key_Encoder& encoder, Node_Ptr& data, size_t row, const std::string& name, int index, std::vector<uint64_t>& key)
+{
+    if (data->LIST.is_table())
+    {
+        if (index < 0)
+        {
+            encoder.add(nullptr, key);
+            return;
+        }
+
+        encoder.add(*data->LIST.table, row, index, key);
+        return;
+    }
+
+    auto& props = data->LIST.elements[row]->OBJECT->properties;
+    auto prop = props.find(name);
+    encoder.add(prop != props.end() ? prop->second.value.get() : nullptr, key);
+}
+
+// The text an index files a key under: to_string of the value, except that
+// a float with no fraction is filed with the int it equals
+
+static std::string key_text(const Node_Ptr& value)
+{
+    if (value->type == NodeType::FLOAT && std::trunc(value->FLOAT.value) == value->FLOAT.value && std::fabs(value->FLOAT.value) < 9.2e18)
+    {
+        return std::to_string((long long)value->FLOAT.value);
+    }
+
+    return value->repr();
+}
+
+// Checks that every element of a list is an object and returns how many
+// rows it has. Tables are left lazy
+
+size_t Evaluator::join_rows(Node_Ptr& data, const std::string& name)
+{
+    if (data->LIST.is_table())
+    {
+        return data->LIST.table->rows;
+    }
+
+    for (auto& row : data->LIST.nodes())
+    {
+        if (row->type != NodeType::OBJECT)
+        {
+            error_and_exit("Built-in function '" + name + "' expects lists of objects");
+        }
+    }
+
+    return data->LIST.elements.size();
+}
+
+// Joins two lists of objects on equal values of a column of each, as == sees
+// them; null never matches. "inner" pairs up every matching left and right
+// row, "left" also keeps left rows with no match, with every right column
+// set to null, and "semi" keeps the left rows that have one. The smaller
+// side is put in a hash table and the other side looked up in it, and
+// results follow the order of the left rows. A right column whose name the
+// left rows already use gets the suffix _right. Two tables give a table
+
+Node_Ptr Evaluator::builtin_join(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 5)
+    {
+       error_and_exit("Built-in function 'join' expects five arguments");
+    }
+
+    auto kind_node = eval_node(args[0]);
+    auto left = eval_node(args[1]);
+    auto right = eval_node(args[2]);
+    auto left_col_node = eval_node(args[3]);
+    auto right_col_node = eval_node(args[4]);
+
+    if (kind_node->type != NodeType::STRING || left->type != NodeType::LIST || right->type != NodeType::LIST
+    ||  left_col_node->type != NodeType::STRING || right_col_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'join' expects a kind, two lists and two string column names");
+    }
+
+    auto& kind = kind_node->STRING.value;
+    auto& left_col = left_col_node->STRING.value;
+    auto& right_col = right_col_node->STRING.value;
+
+    if (kind != "inner" && kind != "left" && kind != "semi")
+    {
+        error_and_exit("Built-in function 'join' does not know a '" + kind + "' join");
+    }
+
+    size_t left_count = join_rows(left, kind + "_join");
+    size_t right_count = join_rows(right, kind + "_join");
+
+    int left_index = left->LIST.is_table() ? left->LIST.table->column_index(left_col) : -1;
+    int right_index = right->LIST.is_table() ? right->LIST.table->column_index(right_col) : -1;
+
+    // A left join needs every left row, so it always looks them up
+
+    bool build_left = kind != "left" && left_count < right_count;
+
+    auto& build = build_left ? left : right;
+    auto& probe = build_left ? right : left;
+    auto& build_col = build_left ? left_col : right_col;
+    auto& probe_col = build_left ? right_col : left_col;
+    int build_index = build_left ? left_index : right_index;
+    int probe_index = build_left ? right_index : left_index;
+    size_t build_count = build_left ? left_count : right_count;
+    size_t probe_count = build_left ? right_count : left_count;
+
+    Group_Index index(1);
+    Key_Encoder encoder;
+    std::vector<uint64_t> key;
+    std::vector<std::vector<size_t>> matches;
+
+    for (size_t row = 0; row < build_count; row++)
+    {
+        key.clear();
+        encode_cell(encoder, build, row, build_col, build_index, key);
+
+        if (key[0] == KEY_NULL)
+        {
+            continue;
+        }
+
+        size_t group = index.find_or_add(key.data());
+
+        if (group == matches.size())
+        {
+            matches.emplace_back();
+        }
+
+        matches[group].push_back(row);
+    }
+
+    // Pairs of left and right rows, with no right row for an unmatched left
+    // row of a left join
+
+    const size_t no_row = (size_t)-1;
+    std::vector<std::pair<size_t, size_t>> pairs;
+    std::vector<bool> matched(kind == "semi" ? left_count : 0, false);
+
+    for (size_t row = 0; row < probe_count; row++)
+    {
+        key.clear();
+        encode_cell(encoder, probe, row, probe_col, probe_index, key);
+
+        long long group = key[0] == KEY_NULL ? -1 : index.find(key.data());
+
+        if (group < 0)
+        {
+            if (kind == "left")
+            {
+                pairs.push_back({row, no_row});
+            }
+
+            continue;
+        }
+
+        for (auto match : matches[group])
+        {
+            if (kind == "semi")
+            {
+                matched[build_left ? match : row] = true;
+            }
+            else
+            {
+                pairs.push_back(build_left ? std::make_pair(match, row) : std::make_pair(row, match));
+            }
+        }
+    }
+
+    if (build_left)
+    {
+        std::stable_sort(pairs.begin(), pairs.end(), [](const std::pair<size_t, size_t>& a, const std::pair<size_t, size_t>& b) { return a.first < b.first; });
+    }
+
+    auto res = make_list();
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+
+    if (kind == "semi")
+    {
+        std::vector<size_t> kept;
+
+        for (size_t row = 0; row < left_count; row++)
+        {
+            if (matched[row])
+            {
+                kept.push_back(row);
+            }
+        }
+
+        if (left->LIST.is_table())
+        {
+            res->LIST.set_table(left->LIST.table->select(kept));
+            return res;
+        }
+
+        for (auto row : kept)
+        {
+            res->LIST.nodes().push_back(left->LIST.elements[row]);
+        }
+
+        return res;
+    }
+
+    // Two tables are joined column by column
+
+    if (left->LIST.is_table() && right->LIST.is_table())
+    {
+        auto& from_left = *left->LIST.table;
+        auto& from_right = *right->LIST.table;
+        auto table = std::make_shared<Table_Node>();
+        std::vector<int> right_columns;
+
+        for (auto& column : from_left.columns)
+        {
+            table->add_column(column.name);
+        }
+
+        for (auto& column : from_right.columns)
+        {
+            if (from_left.column_index(column.name) < 0)
+            {
+                right_columns.push_back(table->add_column(column.name));
+            }
+            else if (column.name == right_col && right_col == left_col)
+            {
+                right_columns.push_back(-1);
+            }
+            else
+            {
+                right_columns.push_back(table->add_column(column.name + "_right"));
+            }
+        }
+
+        for (auto& pair : pairs)
+        {
+            table->push_row();
+            size_t row = table->rows - 1;
+
+            for (size_t i = 0; i < from_left.columns.size(); i++)
+            {
+                table->copy(row, i, from_left, pair.first, i);
+            }
+
+            if (pair.second == no_row)
+            {
+                for (auto column : right_columns)
+                {
+                    if (column >= 0)
+                    {
+                        table->set_null(row, column);
+                    }
+                }
+
+                continue;
+            }
+
+            for (size_t i = 0; i < from_right.columns.size(); i++)
+            {
+                if (right_columns[i] >= 0)
+                {
+                    table->copy(row, right_columns[i], from_right, pair.second, i);
+                }
+            }
+        }
+
+        res->LIST.set_table(table);
+        return res;
+    }
+
+    auto row_at = [](Node_Ptr& data, size_t row)
+    {
+        return data->LIST.is_table() ? data->LIST.table->row(row) : data->LIST.elements[row];
+    };
+
+    // A left row with no match gets every right column, as null
+
+    std::vector<std::pair<std::string, Node_Ptr>> no_match;
+
+    if (kind == "left")
+    {
+        std::set<std::string> seen;
+
+        auto add_null = [&](const std::string& name)
+        {
+            if (seen.insert(name).second)
+            {
+                no_match.push_back({name, make_empty()});
+            }
+        };
+
+        if (right->LIST.is_table())
+        {
+            for (auto& column : right->LIST.table->columns)
+            {
+                add_null(column.name);
+            }
+        }
+        else
+        {
+            for (auto& row : right->LIST.elements)
+            {
+                for (auto& prop : row->OBJECT->properties)
+                {
+                    add_null(prop.first);
+                }
+            }
+        }
+    }
+
+    for (auto& pair : pairs)
+    {
+        auto left_row = row_at(left, pair.first);
+        auto object = make_pooled_node(NodeType::OBJECT);
+        object->TYPE.allowed_type = make_object(false);
+
+        for (auto& prop : left_row->OBJECT->properties)
+        {
+            set_row_property(object, prop.first, prop.second.value);
+        }
+
+        auto add_right = [&](const std::string& name, const Node_Ptr& value)
+        {
+            if (left_row->OBJECT->properties.find(name) == left_row->OBJECT->properties.end())
+            {
+                set_row_property(object, name, value);
+            }
+            else if (name != right_col || right_col != left_col)
+            {
+                set_row_property(object, name + "_right", value);
+            }
+        };
+
+        if (pair.second != no_row)
+        {
+            auto right_row = row_at(right, pair.second);
+
+            for (auto& prop : right_row->OBJECT->properties)
+            {
+                add_right(prop.first, prop.second.value);
+            }
+        }
+        else
+        {
+            for (auto& prop : no_match)
+            {
+                add_right(prop.first, prop.second);
+            }
+        }
+
+        res->LIST.nodes().push_back(object);
+    }
+
+    return res;
+}
+
+// An object filing the rows of a list of objects under the text of their
+// value of a column, for lookups that don't scan the list. The first row
+// with a value keeps its place. Rows without the column are left out
+
+Node_Ptr Evaluator::builtin_index(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'index' expects two arguments");
+    }
+
+    auto data = eval_node(args[0]);
+    auto name_node = eval_node(args[1]);
+
+    if (data->type != NodeType::LIST || name_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'index' expects a list and a string column name");
+    }
+
+    auto& name = name_node->STRING.value;
+    size_t count = join_rows(data, "index");
+    auto res = make_object();
+
+    for (size_t row = 0; row < count; row++)
+    {
+        Node_Ptr value;
+
+        if (data->LIST.is_table())
+        {
+            int column = data->LIST.table->column_index(name);
+            value = column < 0 ? nullptr : data->LIST.table->get(row, column);
+        }
+        else
+        {
+            auto& props = data->LIST.elements[row]->OBJECT->properties;
+            auto prop = props.find(name);
+            value = prop != props.end() ? prop->second.value : nullptr;
+        }
+
+        if (value == nullptr || value->type == NodeType::EMPTY)
+        {
+            continue;
+        }
+
+        auto& entry = res->OBJECT->properties[key_text(value)];
+
+        if (entry.value == nullptr)
+        {
+            entry.value = data->LIST.is_table() ? data->LIST.table->row(row) : data->LIST.elements[row];
+        }
+    }
+
+    return res;
+}
+
+// The row an index filed under a value, or null
+
+Node_Ptr Evaluator::builtin_lookup(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'lookup' expects two arguments");
+    }
+
+    auto index = eval_node(args[0]);
+    auto value = eval_node(args[1]);
+
+    if (index->type != NodeType::OBJECT)
+    {
+        error_and_exit("Built-in function 'lookup' expects an index made by csv.index");
+    }
+
+    auto row = index->OBJECT->properties.find(key_text(value));
+
+    if (value->type == NodeType::EMPTY || row == index->OBJECT->properties.end())
+    {
+        return make_empty();
+    }
+
+    return row->second.value;
+}
+
+// The first row of a list of objects whose column equals a value, or null.
+// Compares keys in place, so the rows of a table are not built to be checked
+
+Node_Ptr Evaluator::builtin_ref(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'ref' expects three arguments");
+    }
+
+    auto data = eval_node(args[0]);
+    auto name_node = eval_node(args[1]);
+    auto value = eval_node(args[2]);
+
+    if (data->type != NodeType::LIST || name_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'ref' expects a list and a string column name");
+    }
+
+    auto& name = name_node->STRING.value;
+    size_t count = join_rows(data, "ref");
+    int column = data->LIST.is_table() ? data->LIST.table->column_index(name) : -1;
+
+    Key_Encoder encoder;
+    std::vector<uint64_t> wanted;
+    std::vector<uint64_t> key;
+
+    encoder.add(value.get(), wanted);
+
+    for (size_t row = 0; row < count; row++)
+    {
+        key.clear();
+        encode_cell(encoder, data, row, name, column, key);
+
+        if (key == wanted)
+        {
+            return data->LIST.is_table() ? data->LIST.table->row(row) : data->LIST.elements[row];
+        }
+    }
+
+    return make_empty();
+}
+
+// Calls a csv schema function with as many of the given arguments as it
+// has parameters
+
+Node_Ptr Evaluator::call_schema_function(const std::string& name, Node_Ptr& function, std::vector<Node_Ptr> args)
+{
+    if (function->type != NodeType::FUNCTION || function->FUNCTION->params.size() > args.size())
+    {
+        error_and_exit("[TypeError] Schema error: '" + name + "' is not a function");
+    }
+
+    args.resize(function->FUNCTION->params.size());
+
+    return eval_function_call(function, args);
+}
+
+// Assigns a property of an object, keeping its type in step as eval_equal
+// does, or the cell of a table row
+
+void Evaluator::set_row_property(Node_Ptr& row, const std::string& name, Node_Ptr value)
+{
+    if (row->OBJECT->row.table != nullptr)
+    {
+        row->OBJECT->row.table->write(row->OBJECT->row.index, name, value);
+    }
+
+    if (value->TYPE.allowed_type == nullptr)
+    {
+        value->TYPE.allowed_type = get_type(value);
+    }
+
+    row->OBJECT->properties[name] = Object_Prop(true, value);
+
+    if (row->TYPE.allowed_type == nullptr)
+    {
+        row->TYPE.allowed_type = make_object(false);
+    }
+
+    if (row->TYPE.allowed_type != row)
+    {
+        row->TYPE.allowed_type->OBJECT->properties[name] = Object_Prop(true, value->TYPE.allowed_type);
+    }
+}
+
+// csv.reshape: replaces each property named in the schema with what its
+// function makes of it, or fills it in when the row does not have it
+
+Node_Ptr Evaluator::builtin_reshape(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_at_call("Built-in function 'reshape' expects two arguments");
+    }
+
+    auto schema = eval_node(args[0]);
+    auto data = eval_node(args[1]);
+
+    if (schema->type != NodeType::OBJECT || data->type != NodeType::LIST)
+    {
+        error_at_call("Built-in function 'reshape' expects an object schema and a list");
+    }
+
+    auto has = [](Node_Ptr& row, const std::string& name)
+    {
+        auto prop = row->OBJECT->properties.find(name);
+        return prop != row->OBJECT->properties.end() && prop->second.value->type != NodeType::EMPTY;
+    };
+
+    Sequence_Cursor cursor(data);
+
+    while (cursor.next())
+    {
+        auto row = cursor.value();
+
+        if (row->type != NodeType::OBJECT)
+        {
+            error_at_call("Built-in function 'reshape' expects a list of objects");
+        }
+
+        for (auto& item : schema->OBJECT->properties)
+        {
+            auto& name = item.first;
+            auto& function = item.second.value;
+
+            if (has(row, name))
+            {
+                auto value = row->OBJECT->properties[name].value;
+                set_row_property(row, name, call_schema_function(name, function, {value, row}));
+            }
+
+            if (!has(row, name))
+            {
+                set_row_property(row, name, call_schema_function(name, function, {row}));
+            }
+        }
+    }
+
+    return data;
+}
+
+// csv.extract: a new row for each row, holding only the properties the
+// schema names. A table gives back a table
+
+Node_Ptr Evaluator::builtin_extract(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_at_call("Built-in function 'extract' expects two arguments");
+    }
+
+    auto schema = eval_node(args[0]);
+    auto data = eval_node(args[1]);
+
+    if (schema->type != NodeType::OBJECT || data->type != NodeType::LIST)
+    {
+        error_at_call("Built-in function 'extract' expects an object schema and a list");
+    }
+
+    auto res = make_list();
+    res->TYPE.allowed_type = make_list();
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_object(false));
+
+    std::shared_ptr<Table_Node> table;
+
+    if (data->LIST.is_table())
+    {
+        table = std::make_shared<Table_Node>();
+        res->LIST.set_table(table);
+    }
+
+    Sequence_Cursor cursor(data);
+
+    while (cursor.next())
+    {
+        auto row = cursor.value();
+
+        if (row->type != NodeType::OBJECT)
+        {
+            error_at_call("Built-in function 'extract' expects a list of objects");
+        }
+
+        Node_Ptr new_row;
+
+        if (table != nullptr)
+        {
+            table->push_row();
+            new_row = table->row(table->rows - 1);
+        }
+        else
+        {
+            new_row = make_pooled_node(NodeType::OBJECT);
+            new_row->TYPE.allowed_type = make_object(false);
+            res->LIST.nodes().push_back(new_row);
+        }
+
+        for (auto& item : schema->OBJECT->properties)
+        {
+            auto& name = item.first;
+            auto& function = item.second.value;
+            auto prop = row->OBJECT->properties.find(name);
+
+            if (prop != row->OBJECT->properties.end() && prop->second.value->type != NodeType::EMPTY)
+            {
+                set_row_property(new_row, name, call_schema_function(name, function, {prop->second.value, row}));
+            }
+            else
+            {
+                set_row_property(new_row, name, call_schema_function(name, function, {row, new_row}));
+            }
+        }
+    }
+
+    return res;
+}
+
+// Gathers the numbers of a list, or of one column of a list of objects, for
+// the aggregate kernels. Nulls are skipped. Returns false if anything else
+// is found. Ranges and typed table columns are copied without making nodes
+
+bool Evaluator::gather_numbers(Node_Ptr& data, const std::string* column, Aggregate& numbers)
+{
+    if (column == nullptr && data->LIST.lazy && !data->LIST.is_stream() && !data->LIST.is_table())
+    {
+        size_t size = data->LIST.size();
+        numbers.ints.reserve(size);
+
+        for (size_t i = 0; i < size; i++)
+        {
+            numbers.ints.push_back(data->LIST.value_at(i));
+        }
+
+        return true;
+    }
+
+    if (column != nullptr && data->LIST.is_table())
+    {
+        auto& table = *data->LIST.table;
+        int index = table.column_index(*column);
+
+        if (index < 0)
+        {
+            return true;
+        }
+
+        auto& cells = table.columns[index];
+        bool has_missing = std::find(cells.missing.begin(), cells.missing.end(), true) != cells.missing.end();
+
+        if (cells.type == Column_Type::INT || cells.type == Column_Type::FLOAT)
+        {
+            if (!has_missing && cells.type == Column_Type::INT)
+            {
+                numbers.add(cells.ints);
+            }
+            else if (!has_missing)
+            {
+                numbers.add(cells.floats);
+            }
+            else
+            {
+                for (size_t i = 0; i < table.rows; i++)
+                {
+                    if (cells.missing[i])
+                    {
+                        continue;
+                    }
+
+                    if (cells.type == Column_Type::INT)
+                    {
+                        numbers.add(cells.ints[i]);
+                    }
+                    else
+                    {
+                        numbers.add(cells.floats[i]);
+                    }
+                }
+            }
+
+            return true;
+        }
+
+        if (cells.type != Column_Type::NONE && cells.type != Column_Type::VALUE)
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < table.rows; i++)
+        {
+            auto value = table.get(i, index);
+
+            if (value == nullptr || value->type == NodeType::EMPTY)
+            {
+                continue;
+            }
+
+            if (value->type == NodeType::INT)
+            {
+                numbers.add(value->INT.value);
+            }
+            else if (value->type == NodeType::FLOAT)
+            {
+                numbers.add(value->FLOAT.value);
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    // Elements are looked at in place - taking a reference to each one would
+    // leave every element of the list for the collector to scan afterwards
+
+    auto add = [&](const Node_Ptr& elem)
+    {
+        Node* value = elem.get();
+
+        if (column != nullptr)
+        {
+            if (value->type != NodeType::OBJECT)
+            {
+                return false;
+            }
+
+            auto prop = value->OBJECT->properties.find(*column);
+
+            if (prop == value->OBJECT->properties.end())
+            {
+                return true;
+            }
+
+            value = prop->second.value.get();
+        }
+
+        if (value->type == NodeType::INT)
+        {
+            numbers.add(value->INT.value);
+        }
+        else if (value->type == NodeType::FLOAT)
+        {
+            numbers.add(value->FLOAT.value);
+        }
+        else if (value->type != NodeType::EMPTY)
+        {
+            return false;
+        }
+
+        return true;
+    };
+
+    if (!data->LIST.lazy)
+    {
+        for (auto& elem : data->LIST.elements)
+        {
+            if (!add(elem))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    Sequence_Cursor cursor(data);
+
+    while (cursor.next())
+    {
+        if (!add(cursor.value()))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// sum, mean, variance, count, min or max of a list of numbers, or of one
+// column of a list of objects. min and max of anything else compare the
+// values the way > and <= do, as the builtins.gl versions did
+
+Node_Ptr Evaluator::builtin_aggregate(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2 && args.size() != 3)
+    {
+       error_and_exit("Built-in function 'aggregate' expects two or three arguments");
+    }
+
+    auto kind_node = eval_node(args[0]);
+    auto data = eval_node(args[1]);
+    Node_Ptr column_node = args.size() == 3 ? eval_node(args[2]) : nullptr;
+
+    if (kind_node->type != NodeType::STRING || data->type != NodeType::LIST || (column_node != nullptr && column_node->type != NodeType::STRING))
+    {
+        error_and_exit("Built-in function 'aggregate' expects a kind, a list and an optional string column name");
+    }
+
+    auto& kind = kind_node->STRING.value;
+    const std::string* column = column_node != nullptr ? &column_node->STRING.value : nullptr;
+
+    if (kind != "sum" && kind != "mean" && kind != "variance" && kind != "count" && kind != "min" && kind != "max")
+    {
+        error_and_exit("Built-in function 'aggregate' does not know how to take the " + kind + " of a list");
+    }
+
+    Aggregate numbers;
+    bool is_numeric = gather_numbers(data, column, numbers);
+
+    if (!is_numeric && kind != "min" && kind != "max")
+    {
+        error_and_exit("Built-in function '" + kind + "' expects a list of numbers");
+    }
+
+    // min and max hand back one of the values, which the kernels can't do
+    // once ints have been turned into floats
+
+    if (!is_numeric || ((kind == "min" || kind == "max") && numbers.is_mixed))
+    {
+
+        auto values = column != nullptr ? builtin_column({data, column_node}) : data;
+
+        auto compare = make_pooled_node(NodeType::OP);
+        compare->OP.op_type = kind == "max" ? NodeType::R_ANGLE : NodeType::LT_EQUAL;
+        compare->OP.value = kind == "max" ? ">" : "<=";
+
+        Node_Ptr result = nullptr;
+        Sequence_Cursor cursor(values);
+
+        while (cursor.next())
+        {
+            auto value = cursor.value();
+
+            if (result == nullptr)
+            {
+                result = value;
+                continue;
+            }
+
+            compare->left = result;
+            compare->right = value;
+
+            if (!eval_equality(compare)->BOOL.value)
+            {
+                result = value;
+            }
+        }
+
+        return result != nullptr ? result : make_empty();
+    }
+
+    if (kind == "count")
+    {
+        return make_int(numbers.size());
+    }
+
+    if (kind == "sum")
+    {
+        return numbers.is_float ? make_float(numbers.float_sum()) : make_int(numbers.int_sum());
+    }
+
+    if (numbers.size() == 0)
+    {
+        return make_empty();
+    }
+
+    if (kind == "mean")
+    {
+        return make_float(numbers.mean());
+    }
+
+    if (kind == "variance")
+    {
+        return make_float(numbers.variance());
+    }
+
+    if (kind == "min")
+    {
+        return numbers.is_float ? make_float(numbers.float_min()) : make_int(numbers.int_min());
+    }
+
+    return numbers.is_float ? make_float(numbers.float_max()) : make_int(numbers.int_max());
+}
+
+// reduce[+] over a list holding nothing but numbers, added up by the sum
+// kernel. nullptr for anything else, which reduce then runs as usual
+
+Node_Ptr Evaluator::reduce_numbers(Node_Ptr& list)
+{
+    if (list->LIST.is_stream() || list->LIST.is_table() || list->LIST.size() == 0)
+    {
+        return nullptr;
+    }
+
+    Aggregate numbers;
+
+    if (!gather_numbers(list, nullptr, numbers) || numbers.size() != list->LIST.size())
+    {
+        return nullptr;
+    }
+
+    return numbers.is_float ? make_float(numbers.float_sum()) : make_int(numbers.int_sum());
+}
+
+Node_Ptr Evaluator::builtin_write(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'write' expects 2 arguments");
+    }
+
+    auto file_path_node = eval_node(args[0]);
+    auto value_node = eval_node(args[1]);
+
+    if (file_path_node->type != NodeType::STRING && value_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'write' expects 2 string arguments");
+    }
+
+    auto file_path = file_path_node->STRING.value;
+    auto value = value_node->STRING.value;
+
+    if (!Output::get().write(file_path, value, false))
+    {
+        error_and_exit("Built-in function 'write' cannot open file '" + file_path + "'");
+    }
+
+    return file_path_node;
+}
+
+Node_Ptr Evaluator::builtin_append(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'append' expects 2 arguments");
+    }
+
+    auto file_path_node = eval_node(args[0]);
+    auto value_node = eval_node(args[1]);
+
+    if (file_path_node->type != NodeType::STRING && value_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'append' expects 2 string arguments");
+    }
+
+    auto file_path = file_path_node->STRING.value;
+    auto value = value_node->STRING.value;
+
+    if (!Output::get().write(file_path, value, true))
+    {
+        error_and_exit("Built-in function 'append' cannot open file '" + file_path + "'");
+    }
+
+    return file_path_node;
+}
+
+// What print, write and append have held back is passed on now, for one
+// file or for everything
+
+Node_Ptr Evaluator::builtin_flush(std::vector<Node_Ptr> args)
+{
+    if (args.size() > 1)
+    {
+       error_and_exit("Built-in function 'flush' expects 0 or 1 arguments");
+    }
+
+    if (args.empty())
+    {
+        Output::get().flush();
+        return make_empty();
+    }
+
+    auto file_path_node = eval_node(args[0]);
+
+    if (file_path_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'flush' expects a string path");
+    }
+
+    Output::get().flush(file_path_node->STRING.value);
+    return make_empty();
+}
+
+Node_Ptr Evaluator::builtin_close(std::vector<Node_Ptr> args)
+{
+    if (args.size() > 1)
+    {
+       error_and_exit("Built-in function 'close' expects 0 or 1 arguments");
+    }
+
+    if (args.empty())
+    {
+        Output::get().close();
+        return make_empty();
+    }
+
+    auto file_path_node = eval_node(args[0]);
+
+    // A handle from open[path mode] is closed by its id
+
+    if (file_path_node->type == NodeType::INT)
+    {
+        Output::get().close((int)file_path_node->INT.value);
+        return make_empty();
+    }
+
+    if (file_path_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'close' expects a string path");
+    }
+
+    Output::get().close(file_path_node->STRING.value);
+    return make_empty();
+}
+
+// Opens a file to be written through the handle open[path mode] returns,
+// starting it over with mode "w" or adding to it with "a". Returns the id
+// the handle is known by
+
+Node_Ptr Evaluator::builtin_open(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'open' expects 2 arguments");
+    }
+
+    auto file_path_node = eval_node(args[0]);
+    auto mode_node = eval_node(args[1]);
+
+    if (file_path_node->type != NodeType::STRING || mode_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'open' expects 2 string arguments");
+    }
+
+    auto mode = mode_node->STRING.value;
+
+    if (mode != "w" && mode != "a")
+    {
+        error_and_exit("Built-in function 'open' expects mode 'w' or 'a', got '" + mode + "'");
+    }
+
+    int handle = Output::get().open(file_path_node->STRING.value, mode == "a");
+
+    if (handle < 0)
+    {
+        error_and_exit("Built-in function 'open' cannot open file '" + file_path_node->STRING.value + "'");
+    }
+
+    return make_int(handle);
+}
+
+// Writes a value through a handle from open[path mode]. Strings are written as
+// they are, other values as they print, and each element of a list in turn.
+// With newline set, every string or element is followed by one
+
+Node_Ptr Evaluator::builtin_file_write(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'file.write' expects 3 arguments");
+    }
+
+    auto handle_node = eval_node(args[0]);
+    auto value = eval_node(args[1]);
+    auto newline_node = eval_node(args[2]);
+
+    if (handle_node->type != NodeType::INT || newline_node->type != NodeType::BOOL)
+    {
+        error_and_exit("Built-in function 'file.write' expects a file handle");
+    }
+
+    int handle = (int)handle_node->INT.value;
+
+    if (!Output::get().is_open(handle))
+    {
+        error_and_exit("Built-in function 'file.write' cannot write to a file that is not open");
+    }
+
+    bool newline = newline_node->BOOL.value;
+
+    auto write_value = [&](const Node_Ptr& elem)
+    {
+        auto text = elem->type == NodeType::STRING ? elem->STRING.value : elem->repr();
+
+        if (newline)
+        {
+            text += '\n';
+        }
+
+        Output::get().write(handle, text);
+    };
+
+    if (value->type != NodeType::LIST)
+    {
+        write_value(value);
+    }
+    else if (value->LIST.lazy)
+    {
+        Sequence_Cursor cursor(value);
+
+        while (cursor.next())
+        {
+            write_value(cursor.value());
+        }
+    }
+    else
+    {
+        for (auto& elem : value->LIST.elements)
+        {
+            write_value(elem);
+        }
+    }
+
+    return make_empty();
+}
+
+Node_Ptr Evaluator::builtin_time(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 0)
+    {
+        error_and_exit("Built-in function 'time' expects 0 arguments");
+    }
+
+    auto time = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::system_clock::now().time_since_epoch()).count();
+    auto time_node = make_pooled_node(NodeType::INT);
+    time_node->INT.value = time;
+
+    return time_node;
+}
+
+Node_Ptr Evaluator::builtin_import(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+        error_and_exit("Built-in function 'import' expects 1 argument");
+    }
+
+    auto path_node = eval_node(args[0]);
+
+    if (path_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'import' expects 1 string argument");
+    }
+
+    std::string path = path_node->STRING.value;
+
+    // Only the program's own scope is sure to know where the builtins are
+    auto& builtins_path = global_scope()->builtins_path;
+
+    Lexer lexer(path);
+    lexer.builtins_path = builtins_path;
+    lexer.tokenize();
+
+    Parser parser(lexer.file_name, lexer.nodes);
+    parser.parse();
+
+    Typechecker typechecker(parser.file_name, parser.nodes);
+    typechecker.builtins_path = builtins_path;
+    typechecker.init(typechecker.builtins_path);
+    typechecker.evaluate();
+
+    Resolver resolver(typechecker.file_name, typechecker.nodes);
+    resolver.resolve();
+
+    Evaluator evaluator(typechecker.file_name, typechecker.nodes);
+    evaluator.builtins_path = builtins_path;
+    evaluator.init(evaluator.builtins_path);
+    evaluator.evaluate();
+
+    auto import_obj = make_object();
+
+    for (auto symbol : evaluator.symbol_table)
+    {
+        auto value = symbol.second;
+
+        // Functions a module defines under a built-in name are added to the
+        // built-in's overloads; only the module's own are exported
+
+        if (std::find(evaluator.builtins_names.begin(), evaluator.builtins_names.end(), symbol.first) != evaluator.builtins_names.end())
+        {
+            if (value->type != NodeType::FUNC_LIST)
+            {
+                continue;
+            }
+
+            value = make_pooled_node(NodeType::FUNC_LIST);
+
+            for (auto& func : symbol.second->FUNC_LIST->nodes)
+            {
+                if (!func->FUNCTION->is_builtin)
+                {
+                    value->FUNC_LIST->nodes.push_back(func);
+                }
+            }
+
+            if (value->FUNC_LIST->nodes.empty())
+            {
+                continue;
+            }
+        }
+
+        import_obj->OBJECT->properties[symbol.first] = Object_Prop(true, value);
+    }
+
+    return import_obj;
+}
+
+Node_Ptr Evaluator::builtin_to_int(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'to_int' expects one argument");
+    }
+
+    auto result = make_pooled_node(NodeType::INT);
+    auto value = eval_node(args[0]);
+
+    if (value->type == NodeType::BOOL)
+    {
+        result->INT.value = (long long)value->BOOL.value;
+    }
+    else if (value->type == NodeType::INT)
+    {
+        result = value;
+    }
+    else if (value->type == NodeType::FLOAT)
+    {
+        result->INT.value = (long long)value->FLOAT.value;
+    }
+    else if (value->type == NodeType::STRING)
+    {
+        try {
+            if (value->STRING.value.size() == 1 && !isdigit(value->STRING.value[0]))
+            {
+                char c = value->STRING.value[0];
+                result->INT.value = int(c);
+            }
+            else
+            {
+                result->INT.value = std::stol(value->STRING.value);
+            }
+        } catch(...) {
+            error_and_exit("Unable to cast '" + value->repr() + "' to an integer");
+        }
+    }
+    else if (value->type == NodeType::ANY)
+    {
+        return make_int(false);
+    }
+    else
+    {
+        error_and_exit("Unable to cast '" + value->repr() + "' to an integer");
+    }
+
+    return result;
+}
+
+Node_Ptr Evaluator::builtin_to_float(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'to_float' expects one argument");
+    }
+
+    auto result = make_float(0);
+    auto value = eval_node(args[0]);
+
+    if (value->type == NodeType::BOOL)
+    {
+        result->FLOAT.value = (double)value->BOOL.value;
+    }
+    else if (value->type == NodeType::FLOAT)
+    {
+        result = value;
+    }
+    else if (value->type == NodeType::INT)
+    {
+        result->FLOAT.value = (double)value->INT.value;
+    }
+    else if (value->type == NodeType::STRING)
+    {
+        try {
+            result->FLOAT.value = std::stof(value->STRING.value);
+        } catch(...) {
+            error_and_exit("Unable to cast '" + value->repr() + "' to a float");
+        }
+    }
+    else if (value->type == NodeType::ANY)
+    {
+        return make_float(false);
+    }
+    else
+    {
+        error_and_exit("Unable to cast '" + value->repr() + "' to a float");
+    }
+
+    return result;
+}
+
+Node_Ptr Evaluator::builtin_to_string(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'to_string' expects one argument");
+    }
+
+    auto result = make_string("");
+    auto value = eval_node(args[0]);
+
+    result->STRING.value = value->repr();
+
+    return result;
+}
+
+Node_Ptr Evaluator::builtin_type(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'type' expects one argument");
+    }
+
+    auto result = make_string("");
+    auto value = eval_node(args[0]);
+
+    switch (value->type)
+    {
+        case NodeType::STRING: result->STRING.value = "string"; break;
+        case NodeType::INT: result->STRING.value = "int"; break;
+        case NodeType::FLOAT: result->STRING.value = "float"; break;
+        case NodeType::BOOL: result->STRING.value = "bool"; break;
+        case NodeType::LIST: result->STRING.value = "list"; break;
+        case NodeType::PIPE_LIST: result->STRING.value = "pipe_list"; break;
+        case NodeType::COMMA_LIST: result->STRING.value = "comma_list"; break;
+        case NodeType::OBJECT: result->STRING.value = "object"; break;
+        case NodeType::RANGE: result->STRING.value = "range"; break;
+        case NodeType::FUNCTION: result->STRING.value = "function"; break;
+        case NodeType::OP: result->STRING.value = "op<" + value->OP.value + ">"; break;
+        case NodeType::PARTIAL_OP: result->STRING.value = "__op<" + value->OP.value + ">__"; break;
+        case NodeType::EMPTY: result->STRING.value = "empty"; break;
+        default: result->STRING.value = "<no type repr>";
+    }
+
+    return result;
+}
+
+Node_Ptr Evaluator::builtin_shape(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'shape' expects one argument");
+    }
+
+    auto value = eval_node(args[0]);
+    return get_type(value);
+}
+
+std::unordered_map<std::string, Node_Ptr (Evaluator::*)(std::vector<Node_Ptr>)> builtin_functions = {
     std::make_pair("__exit__", &Evaluator::builtin_exit),
     std::make_pair("__error__", &Evaluator::builtin_error),
     std::make_pair("__range__", &Evaluator::builtin_range),
@@ -533,8 +2885,31 @@ std::unordered_map<std::string, std::shared_ptr<Node> (Evaluator::*)(std::vector
     std::make_pair("__time__", &Evaluator::builtin_time),
     std::make_pair("__import__", &Evaluator::builtin_import),
     std::make_pair("__read__", &Evaluator::builtin_read),
+    std::make_pair("__lines__", &Evaluator::builtin_lines),
+    std::make_pair("__csv_load__", &Evaluator::builtin_csv_load),
+    std::make_pair("__column__", &Evaluator::builtin_column),
+    std::make_pair("__group_rows__", &Evaluator::builtin_group_rows),
+    std::make_pair("__reshape__", &Evaluator::builtin_reshape),
+    std::make_pair("__extract__", &Evaluator::builtin_extract),
+    std::make_pair("__aggregate__", &Evaluator::builtin_aggregate),
+    std::make_pair("__summarize__", &Evaluator::builtin_summarize),
+    std::make_pair("__join__", &Evaluator::builtin_join),
+    std::make_pair("__index__", &Evaluator::builtin_index),
+    std::make_pair("__lookup__", &Evaluator::builtin_lookup),
+    std::make_pair("__ref__", &Evaluator::builtin_ref),
+    std::make_pair("__json_parse__", &Evaluator::builtin_json_parse),
+    std::make_pair("__json_stringify__", &Evaluator::builtin_json_stringify),
+    std::make_pair("__json_read__", &Evaluator::builtin_json_read),
+    std::make_pair("__json_write__", &Evaluator::builtin_json_write),
+    std::make_pair("__json_each__", &Evaluator::builtin_json_each),
+    std::make_pair("__ndjson_lines__", &Evaluator::builtin_ndjson_lines),
+    std::make_pair("__ndjson_write__", &Evaluator::builtin_ndjson_write),
     std::make_pair("__write__", &Evaluator::builtin_write),
     std::make_pair("__append__", &Evaluator::builtin_append),
+    std::make_pair("__flush__", &Evaluator::builtin_flush),
+    std::make_pair("__close__", &Evaluator::builtin_close),
+    std::make_pair("__open__", &Evaluator::builtin_open),
+    std::make_pair("__file_write__", &Evaluator::builtin_file_write),
     std::make_pair("__to_int__", &Evaluator::builtin_to_int),
     std::make_pair("__to_float__", &Evaluator::builtin_to_float),
     std::make_pair("__to_string__", &Evaluator::builtin_to_string),
@@ -542,45 +2917,186 @@ std::unordered_map<std::string, std::shared_ptr<Node> (Evaluator::*)(std::vector
     std::make_pair("__shape__", &Evaluator::builtin_shape),
 };
 
-void Evaluator::init(std::string builtins_path)
+void Evaluator::init(std::string builtins_path)
+{
+    Lexer lexer(builtins_path);
+    lexer.tokenize();
+
+    Parser parser(lexer.file_name, lexer.nodes);
+    parser.parse();
+
+    Typechecker tc(parser.file_name, parser.nodes);
+    tc.evaluate();
+
+    Resolver resolver(parser.file_name, parser.nodes);
+    resolver.resolve();
+
+    Evaluator evaluator(parser.file_name, parser.nodes);
+    evaluator.runtime = runtime;
+    evaluator.evaluate();
+
+    for (auto symbol : evaluator.symbol_table)
+    {
+        if (symbol.second->type == NodeType::FUNC_LIST)
+        {
+            for (auto& func : symbol.second->FUNC_LIST->nodes)
+            {
+                func->FUNCTION->is_builtin = true;
+            }
+        }
+
+        symbol_table[symbol.first] = symbol.second;
+        builtins_names.push_back(symbol.first);
+    }
+}
+
+// --- HELPERS --- //
+
+bool Evaluator::compare(const Node_Ptr &lhs, const Node_Ptr &rhs)
+{
+    auto equality_node = make_pooled_node(NodeType::OP);
+    equality_node->OP.op_type = NodeType::L_ANGLE;
+    equality_node->left = lhs;
+    equality_node->right = rhs;
+
+    return eval_equality(equality_node)->BOOL.value;
+}
+
+// The positions of keys in sorted order, the first limit of them. Keys that
+// are all ints, all numbers or all strings are sorted as plain values, and
+// always stably; anything else is compared as < compares it
+
+std::vector<size_t> Evaluator::sort_order(const std::vector<Node_Ptr>& keys, bool stable, bool descending, size_t limit)
+{
+    Sort_Keys plain;
+
+    if (plain.gather(keys))
+    {
+        return plain.order(descending, limit);
+    }
+
+    std::vector<size_t> order(keys.size());
+    std::iota(order.begin(), order.end(), 0);
+
+    auto less = [this, &keys, descending](size_t a, size_t b) {
+        return descending ? this->compare(keys[b], keys[a]) : this->compare(keys[a], keys[b]);
+    };
+
+    if (limit < order.size())
+    {
+        std::partial_sort(order.begin(), order.begin() + limit, order.end(), less);
+        order.resize(limit);
+    }
+    else if (stable)
+    {
+        std::stable_sort(order.begin(), order.end(), less);
+    }
+    else
+    {
+        std::sort(order.begin(), order.end(), less);
+    }
+
+    return order;
+}
+
+void Evaluator::reorder(std::vector<Node_Ptr>& elements, const std::vector<size_t>& order)
+{
+    std::vector<Node_Ptr> sorted;
+    sorted.reserve(elements.size());
+
+    for (auto position : order)
+    {
+        sorted.push_back(std::move(elements[position]));
+    }
+
+    elements.swap(sorted);
+}
+
+// Sorts a list of objects or a table by one property, in place. Rows that
+// lack it or hold null in it go last, in the order they were in
+
+Node_Ptr Evaluator::sort_by_column(Node_Ptr& list, const std::string& name, bool descending)
 {
-    Lexer lexer(builtins_path);
-    lexer.tokenize();
+    bool is_table = list->LIST.is_table();
+    size_t count = is_table ? list->LIST.table->rows : list->LIST.nodes().size();
+    int column = is_table ? list->LIST.table->column_index(name) : -1;
 
-    Parser parser(lexer.file_name, lexer.nodes);
-    parser.parse();
+    std::vector<Node_Ptr> keys;
+    std::vector<size_t> present, absent;
+    keys.reserve(count);
+    present.reserve(count);
 
-    Typechecker tc(parser.file_name, parser.nodes);
-    tc.evaluate();
+    for (size_t row = 0; row < count; row++)
+    {
+        Node_Ptr value;
 
-    Evaluator evaluator(parser.file_name, parser.nodes);
-    evaluator.runtime = runtime;
-    evaluator.evaluate();
+        if (is_table)
+        {
+            value = column < 0 ? nullptr : list->LIST.table->get(row, column);
+        }
+        else
+        {
+            auto& elem = list->LIST.elements[row];
 
-    for (auto symbol : evaluator.symbol_table)
+            if (elem->type != NodeType::OBJECT)
+            {
+                error_and_exit("List built-in 'sort_by' expects a list of objects");
+            }
+
+            auto prop = elem->OBJECT->properties.find(name);
+            value = prop != elem->OBJECT->properties.end() ? prop->second.value : nullptr;
+        }
+
+        if (value == nullptr || value->type == NodeType::EMPTY)
+        {
+            absent.push_back(row);
+            continue;
+        }
+
+        keys.push_back(value);
+        present.push_back(row);
+    }
+
+    std::vector<size_t> order;
+    order.reserve(count);
+
+    for (auto position : sort_order(keys, true, descending, keys.size()))
     {
-        symbol_table[symbol.first] = symbol.second;
-        builtins_names.push_back(symbol.first);
+        order.push_back(present[position]);
+    }
+
+    order.insert(order.end(), absent.begin(), absent.end());
+
+    if (is_table)
+    {
+        list->LIST.set_table(list->LIST.table->select(order));
+    }
+    else
+    {
+        reorder(list->LIST.elements, order);
     }
+
+    return list;
 }
 
-// --- HELPERS --- //
+// A string like source holding part of its text. The node is copied with
+// its text set aside, so only the part is ever copied
 
-bool Evaluator::compare(const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs)
+Node_Ptr Evaluator::make_slice(Node_Ptr& source, size_t begin, size_t length)
 {
-    auto equality_node = std::make_shared<Node>(NodeType::OP);
-    equality_node->OP.op_type = NodeType::L_ANGLE;
-    equality_node->left = lhs;
-    equality_node->right = rhs;
+    std::string text = std::move(source->STRING.value);
+    auto slice = make_pooled_node(*source);
+    source->STRING.value = std::move(text);
 
-    return eval_equality(equality_node)->BOOL.value;
+    slice->STRING.value.assign(source->STRING.value, begin, length);
+    return slice;
 }
 
 // ---- //
 
 // --- Type Checking --- //
 
-Evaluator::Match_Result Evaluator::match_values(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
+Evaluator::Match_Result Evaluator::match_values(Node_Ptr a, Node_Ptr b)
 {
     if (a->type == NodeType::INT)
     {
@@ -602,7 +3118,7 @@ Evaluator::Match_Result Evaluator::match_values(std::shared_ptr<Node> a, std::sh
     return {false, ""};
 }
 
-Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::shared_ptr<Node> b, bool match_name)
+Evaluator::Match_Result Evaluator::match_types(Node_Ptr a, Node_Ptr b, bool match_name)
 {
     line = b->line;
     column = b->column;
@@ -628,7 +3144,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
     if (a->type == NodeType::PIPE_LIST)
     {
         // TODO: change to FUNC_LIST node probably
-        for (auto& elem : a->PIPE_LIST.nodes)
+        for (auto& elem : a->PIPE_LIST->nodes)
         {
             if (elem->type != NodeType::FUNCTION)
             {
@@ -644,7 +3160,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
     if (a->type == NodeType::FUNCTION && b->type == NodeType::PIPE_LIST)
     {
-        for (auto& elem : b->PIPE_LIST.nodes)
+        for (auto& elem : b->PIPE_LIST->nodes)
         {
             if (elem->type != NodeType::FUNCTION)
             {
@@ -652,7 +3168,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             }
         }
 
-        for (auto& func : b->PIPE_LIST.nodes)
+        for (auto& func : b->PIPE_LIST->nodes)
         {
             if (match_types(a, func, match_name).result)
             {
@@ -669,11 +3185,11 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
     {
         std::vector<int> null_arg_indices;
 
-        if (a->FUNCTION.params.size() != 1)
+        if (a->FUNCTION->params.size() != 1)
         {
-            for (int i = 0; i < a->FUNCTION.args.size(); i++)
+            for (int i = 0; i < a->FUNCTION->args.size(); i++)
             {
-                if (a->FUNCTION.args[i] == nullptr)
+                if (a->FUNCTION->args[i] == nullptr)
                 {
                     null_arg_indices.push_back(i);
                 }
@@ -691,12 +3207,12 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
         int param_index = null_arg_indices[0];
 
-        if (a->FUNCTION.params[param_index]->type != NodeType::ID)
+        if (a->FUNCTION->params[param_index]->type != NodeType::ID)
         {
             error_and_exit("Refinement type function must have one basic parameter");
         }
 
-        auto param = a->FUNCTION.params[param_index];
+        auto param = a->FUNCTION->params[param_index];
 
         if (param->ID.type == nullptr)
         {
@@ -712,19 +3228,19 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
         auto res = eval_function_call(a, {arg});
 
-        std::string refinement_error_message = "Value '" + arg->repr() + "' does not match refinement type '" + a->FUNCTION.name + "'";
+        std::string refinement_error_message = "Value '" + arg->repr() + "' does not match refinement type '" + a->FUNCTION->name + "'";
 
         if (res->BOOL.value)
         {
             return {true, ""};
         }
 
-        if (a->FUNCTION.body->BLOCK.nodes.size() > 0 && a->FUNCTION.body->BLOCK.nodes[0]->type == NodeType::BLOCK)
+        if (a->FUNCTION->body->BLOCK->nodes.size() > 0 && a->FUNCTION->body->BLOCK->nodes[0]->type == NodeType::BLOCK)
         {
-            auto str_block = a->FUNCTION.body->BLOCK.nodes[0];
-            if (str_block->BLOCK.nodes.size() == 1)
+            auto str_block = a->FUNCTION->body->BLOCK->nodes[0];
+            if (str_block->BLOCK->nodes.size() == 1)
             {
-                auto message = eval_node(str_block->BLOCK.nodes[0]);
+                auto message = eval_node(str_block->BLOCK->nodes[0]);
 
                 if (message->type == NodeType::STRING)
                 {
@@ -733,27 +3249,27 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             }
         }
 
-        return {false, "Value '" + b->repr() + "' does not match refinement type '" + a->FUNCTION.name + "'"};
+        return {false, "Value '" + b->repr() + "' does not match refinement type '" + a->FUNCTION->name + "'"};
     }
 
     if (a->type == NodeType::PIPE_LIST)
     {
         if (b->type == NodeType::PIPE_LIST)
         {
-            sort_and_unique(a->PIPE_LIST.nodes);
-            sort_and_unique(b->PIPE_LIST.nodes);
+            sort_and_unique(a->PIPE_LIST->nodes);
+            sort_and_unique(b->PIPE_LIST->nodes);
 
             bool match;
 
-            for (auto& b_type : b->PIPE_LIST.nodes)
+            for (auto& b_type : b->PIPE_LIST->nodes)
             {
                 match = false;
 
-                for (auto& a_type : a->PIPE_LIST.nodes)
+                for (auto& a_type : a->PIPE_LIST->nodes)
                 {
                     if (match_types(a_type, b_type, match_name).result)
                     {
-                        if (a_type->OBJECT.is_type)
+                        if (a_type->OBJECT->is_type)
                         {
                             b_type->TYPE.name = a_type->TYPE.name;
                         }
@@ -768,7 +3284,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
         std::string message = "";
 
-        for (auto& t : a->PIPE_LIST.nodes)
+        for (auto& t : a->PIPE_LIST->nodes)
         {
             auto match = match_types(t, b, match_name);
             message = match.message;
@@ -809,7 +3325,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
     {
         a->TYPE.is_literal = true;
 
-        int type_a_size = a->LIST.nodes.size();
+        int type_a_size = a->LIST.nodes().size();
 
         if (type_a_size > 1)
         {
@@ -818,12 +3334,26 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
         if (type_a_size == 0)
         {
-            a->LIST.nodes.push_back(make_any());
+            a->LIST.nodes().push_back(make_any());
             return {true, ""};
         }
 
         auto type_b = b;
-        int type_b_size = type_b->LIST.nodes.size();
+
+        // The elements of a lazy list share one type, so one of them is
+        // checked in place of building them all
+
+        if (type_b->LIST.is_stream() || (type_b->LIST.lazy && type_b->LIST.size() > 0))
+        {
+            if (a->LIST.nodes()[0]->type == NodeType::ANY)
+            {
+                return {true, ""};
+            }
+
+            return match_types(a->LIST.nodes()[0], type_b->LIST.sample(), match_name);
+        }
+
+        int type_b_size = type_b->LIST.nodes().size();
 
 
         if (type_b_size == 0)
@@ -831,18 +3361,18 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             return {true, ""};
         }
 
-        if (type_a_size > 0 && a->LIST.nodes[0]->type == NodeType::ANY)
+        if (type_a_size > 0 && a->LIST.nodes()[0]->type == NodeType::ANY)
         {
             return {true, ""};
         }
 
-        if (type_a_size == 1 && a->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+        if (type_a_size == 1 && a->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
         {
-            if (type_b->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+            if (type_b->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
             {
-                for (auto& elem : type_b->LIST.nodes[0]->PIPE_LIST.nodes)
+                for (auto& elem : type_b->LIST.nodes()[0]->PIPE_LIST->nodes)
                 {
-                    auto match = match_types(a->LIST.nodes[0], elem, match_name);
+                    auto match = match_types(a->LIST.nodes()[0], elem, match_name);
                     if (!match.result)
                     {
                         return {false, match.message};
@@ -852,9 +3382,9 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
                 return {true, ""};
             }
 
-            for (auto& elem : type_b->LIST.nodes)
+            for (auto& elem : type_b->LIST.nodes())
             {
-                auto match = match_types(a->LIST.nodes[0], elem, match_name);
+                auto match = match_types(a->LIST.nodes()[0], elem, match_name);
                 if (!match.result)
                 {
                     return {false, match.message};
@@ -866,9 +3396,9 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
         if (type_a_size == 1)
         {
-            for (auto& t : type_b->LIST.nodes)
+            for (auto& t : type_b->LIST.nodes())
             {
-                auto match = match_types(a->LIST.nodes[0], t, match_name);
+                auto match = match_types(a->LIST.nodes()[0], t, match_name);
                 if (!match.result)
                 {
                     return {false, match.message};
@@ -888,21 +3418,21 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             return {true, ""};
         }
 
-        if (a->OBJECT.properties.size() < b->OBJECT.properties.size())
+        if (a->OBJECT->properties.size() < b->OBJECT->properties.size())
         {
             return {false, ""};
         }
 
-        for (auto& prop : b->OBJECT.properties)
+        for (auto& prop : b->OBJECT->properties)
         {
-            if (a->OBJECT.properties.find(prop.first) == a->OBJECT.properties.end())
+            if (a->OBJECT->properties.find(prop.first) == a->OBJECT->properties.end())
             {
                 return {false, ""};
             }
         }
-        for (auto& prop : a->OBJECT.properties)
+        for (auto& prop : a->OBJECT->properties)
         {
-            if (b->OBJECT.properties.find(prop.first) == b->OBJECT.properties.end())
+            if (b->OBJECT->properties.find(prop.first) == b->OBJECT->properties.end())
             {
                 if (prop.second.required)
                 {
@@ -913,7 +3443,7 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             }
 
             auto a_prop = prop.second;
-            auto b_prop = b->OBJECT.properties[prop.first];
+            auto b_prop = b->OBJECT->properties[prop.first];
 
             auto match = match_types(a_prop.value, b_prop.value, match_name);
             if (!match.result)
@@ -932,23 +3462,23 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             return {true, ""};
         }
 
-        if (a->FUNCTION.params.size() != b->FUNCTION.params.size())
+        if (a->FUNCTION->params.size() != b->FUNCTION->params.size())
         {
             return {false, ""};
         }
 
-        for (int i = 0; i < a->FUNCTION.params.size(); i++)
+        for (int i = 0; i < a->FUNCTION->params.size(); i++)
         {
-            if (a->FUNCTION.params[i]->type != b->FUNCTION.params[i]->type)
+            if (a->FUNCTION->params[i]->type != b->FUNCTION->params[i]->type)
             {
                 return {false, ""};
             }
 
-            // auto a_type = std::make_shared<Node>();
-            // auto b_type = std::make_shared<Node>();
+            // auto a_type = make_pooled_node();
+            // auto b_type = make_pooled_node();
 
-            auto a_type = get_explicit_type(a->FUNCTION.params[i]);
-            auto b_type = get_explicit_type(b->FUNCTION.params[i]);
+            auto a_type = get_explicit_type(a->FUNCTION->params[i]);
+            auto b_type = get_explicit_type(b->FUNCTION->params[i]);
 
             auto match = match_types(a_type, b_type, match_name);
             if (!match.result)
@@ -957,8 +3487,8 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
             }
         }
 
-        auto a_ret = a->FUNCTION.return_type;
-        auto b_ret = b->FUNCTION.return_type;
+        auto a_ret = a->FUNCTION->return_type;
+        auto b_ret = b->FUNCTION->return_type;
 
         auto match = match_types(a_ret, b_ret, match_name);
         if (!match.result)
@@ -976,12 +3506,12 @@ Evaluator::Match_Result Evaluator::match_types(std::shared_ptr<Node> a, std::sha
 
 // --- OPERATIONS --- //
 
-std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_add(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::EMPTY)
@@ -1036,7 +3566,7 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+            res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             return res;
         }
 
@@ -1072,7 +3602,7 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+            res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             return res;
         }
 
@@ -1108,7 +3638,7 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+            res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             return res;
         }
 
@@ -1144,7 +3674,7 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes.insert(res->LIST.nodes.begin(), res->left);
+            res->LIST.nodes().insert(res->LIST.nodes().begin(), res->left);
             return res;
         }
 
@@ -1156,19 +3686,19 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes = left->LIST.nodes;
+            res->LIST.nodes() = left->LIST.nodes();
 
-            for (auto _node : right->LIST.nodes)
+            for (auto _node : right->LIST.nodes())
             {
-                res->LIST.nodes.push_back(_node);
+                res->LIST.nodes().push_back(_node);
             }
 
             return res;
         }
 
         res->type = NodeType::LIST;
-        res->LIST.nodes = left->LIST.nodes;
-        res->LIST.nodes.push_back(right);
+        res->LIST.nodes() = left->LIST.nodes();
+        res->LIST.nodes().push_back(right);
         return res;
     }
 
@@ -1177,11 +3707,11 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::OBJECT)
         {
             res->type = NodeType::OBJECT;
-            res->OBJECT.properties = left->OBJECT.properties;
+            res->OBJECT->properties = left->OBJECT->properties;
 
-            for (auto prop : right->OBJECT.properties)
+            for (auto prop : right->OBJECT->properties)
             {
-                res->OBJECT.properties[prop.first] = prop.second;
+                res->OBJECT->properties[prop.first] = prop.second;
             }
 
             return res;
@@ -1193,12 +3723,12 @@ std::shared_ptr<Node> Evaluator::eval_add(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Evaluator::eval_sub(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_sub(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::EMPTY)
@@ -1304,12 +3834,12 @@ std::shared_ptr<Node> Evaluator::eval_sub(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_mul(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::EMPTY)
@@ -1369,7 +3899,7 @@ std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < left->INT.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(right));
+                res->LIST.nodes().push_back(eval_copy(right));
             }
             return res;
         }
@@ -1435,7 +3965,7 @@ std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < left->BOOL.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(right));
+                res->LIST.nodes().push_back(eval_copy(right));
             }
             return res;
         }
@@ -1474,7 +4004,7 @@ std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < right->INT.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(left));
+                res->LIST.nodes().push_back(eval_copy(left));
             }
             return res;
         }
@@ -1484,7 +4014,7 @@ std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < right->BOOL.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(left));
+                res->LIST.nodes().push_back(eval_copy(left));
             }
             return res;
         }
@@ -1500,12 +4030,12 @@ std::shared_ptr<Node> Evaluator::eval_mul(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Evaluator::eval_div(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_div(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::EMPTY)
@@ -1621,12 +4151,12 @@ std::shared_ptr<Node> Evaluator::eval_div(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Evaluator::eval_mod(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_mod(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::EMPTY)
@@ -1677,11 +4207,11 @@ std::shared_ptr<Node> Evaluator::eval_mod(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Evaluator::eval_pos_neg(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_pos_neg(Node_Ptr& node)
 {
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (right->type == NodeType::EMPTY)
@@ -1759,13 +4289,13 @@ std::shared_ptr<Node> Evaluator::eval_pos_neg(std::shared_ptr<Node>& node)
         res->type = NodeType::LIST;
         if (res->OP.op_type == NodeType::POS)
         {
-            res->LIST.nodes = right->LIST.nodes;
+            res->LIST.nodes() = right->LIST.nodes();
         }
         else if (res->OP.op_type == NodeType::NEG)
         {
-            std::vector<std::shared_ptr<Node>> copy(right->LIST.nodes);
+            std::vector<Node_Ptr> copy(right->LIST.nodes());
             std::reverse(copy.begin(), copy.end());
-            res->LIST.nodes = copy;
+            res->LIST.nodes() = copy;
         } 
         return res;
     }
@@ -1773,11 +4303,11 @@ std::shared_ptr<Node> Evaluator::eval_pos_neg(std::shared_ptr<Node>& node)
     return right;
 }
 
-std::shared_ptr<Node> Evaluator::eval_not(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_not(Node_Ptr& node)
 {
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (right->type == NodeType::EMPTY)
@@ -1818,12 +4348,12 @@ std::shared_ptr<Node> Evaluator::eval_not(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::eval_equality(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_equality(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->type = NodeType::BOOL;
     res->TYPE.is_literal = true;
 
@@ -1999,18 +4529,18 @@ std::shared_ptr<Node> Evaluator::eval_equality(std::shared_ptr<Node>& node)
         }
         else if (left->type == NodeType::LIST && right->type == NodeType::LIST)
         {
-            if (left->LIST.nodes.size() != right->LIST.nodes.size())
+            if (left->LIST.nodes().size() != right->LIST.nodes().size())
             {
                 res->BOOL.value = false;
                 return res;
             }
 
-            for (int i = 0; i < left->LIST.nodes.size(); i++)
+            for (int i = 0; i < left->LIST.nodes().size(); i++)
             {
-                auto equality_node = std::make_shared<Node>(NodeType::OP);
+                auto equality_node = make_pooled_node(NodeType::OP);
                 equality_node->OP.op_type = NodeType::EQ_EQ;
-                equality_node->left = left->LIST.nodes[i];
-                equality_node->right = right->LIST.nodes[i];
+                equality_node->left = left->LIST.nodes()[i];
+                equality_node->right = right->LIST.nodes()[i];
 
                 auto result = eval_equality(equality_node);
                 if (result->BOOL.value == false)
@@ -2072,18 +4602,18 @@ std::shared_ptr<Node> Evaluator::eval_equality(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::eval_and_or(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_and_or(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     
     if (left->type == NodeType::BOOL && !left->BOOL.value && node->OP.op_type == NodeType::AND)
     {
-        auto res = std::make_shared<Node>(*left);
+        auto res = make_pooled_node(*left);
         return res;
     }
 
     auto right = eval_node(node->right);
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->TYPE.is_literal = true;
 
     if (left->type == NodeType::BOOL && right->type == NodeType::BOOL)
@@ -2105,42 +4635,42 @@ std::shared_ptr<Node> Evaluator::eval_and_or(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::eval_copy(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_copy(Node_Ptr& node)
 {
     // node is the right operand of #
     // we set it as the node beforehand so we can recurse
 
     auto value = eval_node(node);
-    auto res = std::make_shared<Node>(*value);
+    auto res = make_pooled_node(*value);
     res->TYPE.is_literal = true;
 
     if (res->type == NodeType::LIST)
     {
-        for (int i = 0; i < value->LIST.nodes.size(); i++)
+        for (int i = 0; i < value->LIST.nodes().size(); i++)
         {
-            res->LIST.nodes[i] = eval_copy(value->LIST.nodes[i]);
+            res->LIST.nodes()[i] = eval_copy(value->LIST.nodes()[i]);
         }
     }
 
     if (res->type == NodeType::OBJECT)
     {
-        for (auto prop : value->OBJECT.properties)
+        for (auto prop : value->OBJECT->properties)
         {
-            res->OBJECT.properties[prop.first] = Object_Prop(prop.second.required, eval_copy(prop.second.value));
+            res->OBJECT->properties[prop.first] = Object_Prop(prop.second.required, eval_copy(prop.second.value));
         }
     }
 
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_dot(Node_Ptr& node)
 {
     if (node->left->type == NodeType::FUNC_CALL)
     {
         if (node->right->type == NodeType::LIST)
         {
             auto l = eval_node(node->left);
-            return eval_function_call(l, eval_node(node->right)->LIST.nodes);
+            return eval_function_call(l, eval_node(node->right)->LIST.nodes());
         }
     }
 
@@ -2156,24 +4686,24 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
     {
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("List accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type != NodeType::INT)
             {
                 error_and_exit("List accessor expects an integer");
             }
 
-            if (accessor->INT.value < 0 || accessor->INT.value >= left->PIPE_LIST.nodes.size())
+            if (accessor->INT.value < 0 || accessor->INT.value >= left->PIPE_LIST->nodes.size())
             {
-                error_and_exit("List index out of range: List size is " + std::to_string(left->PIPE_LIST.nodes.size()) + " but provided index is " + std::to_string(accessor->INT.value));
+                error_and_exit("List index out of range: List size is " + std::to_string(left->PIPE_LIST->nodes.size()) + " but provided index is " + std::to_string(accessor->INT.value));
             }
 
-            return left->PIPE_LIST.nodes[accessor->INT.value];
+            return left->PIPE_LIST->nodes[accessor->INT.value];
         }
 
         error_and_exit("Cannot perform operation '" + node->repr() + "' on '" + left->repr() + "' and '" + right->repr() + "'");
@@ -2187,99 +4717,99 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("List accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type != NodeType::INT)
             {
                 error_and_exit("List accessor expects an integer");
             }
 
-            if (accessor->INT.value < 0 || accessor->INT.value >= left->LIST.nodes.size())
+            if (accessor->INT.value < 0 || accessor->INT.value >= left->LIST.size())
             {
-                error_and_exit("List index out of range: List size is " + std::to_string(left->LIST.nodes.size()) + " but provided index is " + std::to_string(accessor->INT.value));
+                error_and_exit("List index out of range: List size is " + std::to_string(left->LIST.size()) + " but provided index is " + std::to_string(accessor->INT.value));
             }
 
-            return left->LIST.nodes[accessor->INT.value];
+            return left->LIST.at(accessor->INT.value);
         }
 
         // List built-ins
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "flatten")
+            if (right->FUNC_CALL->name == "flatten")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
                 bool all = false;
 
-                if (right->FUNC_CALL.args.size() == 1)
+                if (right->FUNC_CALL->args.size() == 1)
                 {
-                    auto bool_node = eval_node(right->FUNC_CALL.args[0]);
+                    auto bool_node = eval_node(right->FUNC_CALL->args[0]);
                     if (bool_node->type != NodeType::BOOL)
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' a boolean argument");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' a boolean argument");
                     }
 
                     all = bool_node->BOOL.value;
                 }
 
-                std::function<std::shared_ptr<Node>(std::shared_ptr<Node>, bool)> flatten;
+                std::function<Node_Ptr(Node_Ptr, bool)> flatten;
 
-                flatten = [&flatten](std::shared_ptr<Node> node, bool all){
+                flatten = [&flatten](Node_Ptr node, bool all){
                     
                     if (node->type != NodeType::LIST)
                     {
                         return node;
                     }
 
-                    auto res = std::make_shared<Node>(NodeType::LIST);
+                    auto res = make_pooled_node(NodeType::LIST);
                     res->TYPE.is_literal = node->TYPE.is_literal;
 
-                    for (auto& elem : node->LIST.nodes)
+                    for (auto& elem : node->LIST.nodes())
                     {
                         if (elem->type == NodeType::LIST)
                         {
-                            for (auto& e : elem->LIST.nodes)
+                            for (auto& e : elem->LIST.nodes())
                             {
                                 if (all)
                                 {
                                     if (e->type != NodeType::LIST)
                                     {
-                                        res->LIST.nodes.push_back(e);
+                                        res->LIST.nodes().push_back(e);
                                     }
                                     else
                                     {
-                                        for (auto j : e->LIST.nodes)
+                                        for (auto j : e->LIST.nodes())
                                         {
                                             auto nested = flatten(j, true);
                                             if (nested->type != NodeType::LIST)
                                             {
-                                                res->LIST.nodes.push_back(nested);
+                                                res->LIST.nodes().push_back(nested);
                                             }
                                             else
                                             {
-                                                res->LIST.nodes.insert(res->LIST.nodes.end(), nested->LIST.nodes.begin(), nested->LIST.nodes.end());
+                                                res->LIST.nodes().insert(res->LIST.nodes().end(), nested->LIST.nodes().begin(), nested->LIST.nodes().end());
                                             }
                                         }
                                     }
                                 }
                                 else
                                 {
-                                    res->LIST.nodes.push_back(flatten(e, false));
+                                    res->LIST.nodes().push_back(flatten(e, false));
                                 }
                             }
                         }
                         else
                         {
-                            res->LIST.nodes.push_back(elem);
+                            res->LIST.nodes().push_back(elem);
                         }
                     }
 
@@ -2288,128 +4818,232 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 return flatten(left, all);
             }
-            if (right->FUNC_CALL.name == "sort")
+            if (right->FUNC_CALL->name == "sort" || right->FUNC_CALL->name == "stable_sort")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
-                if (right->FUNC_CALL.args.size() == 0)
+                bool stable = right->FUNC_CALL->name == "stable_sort";
+                auto& elements = left->LIST.nodes();
+
+                if (right->FUNC_CALL->args.size() == 0)
                 {
-                    std::sort(left->LIST.nodes.begin(), left->LIST.nodes.end(), [this](const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs) {return this->compare(lhs, rhs);});
+                    reorder(elements, sort_order(elements, stable, false, elements.size()));
                     return left;
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function");
                 }
 
-                std::sort(left->LIST.nodes.begin(), left->LIST.nodes.end(), [this, func](const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs) {
-                    auto left = eval_function_call(func, {lhs});
-                    auto right = eval_function_call(func, {rhs});
-                    return this->compare(left, right);
-                });
+                // Each element's key is worked out once, not once per comparison
+
+                std::vector<Node_Ptr> keys;
+                keys.reserve(elements.size());
+
+                for (auto& elem : elements)
+                {
+                    keys.push_back(eval_function_call(func, {elem}));
+                }
+
+                reorder(elements, sort_order(keys, stable, false, keys.size()));
                 return left;
             }
-            if (right->FUNC_CALL.name == "map")
+            if (right->FUNC_CALL->name == "sort_by")
+            {
+                if (right->FUNC_CALL->args.size() != 1 && right->FUNC_CALL->args.size() != 2)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 or 2 arguments");
+                }
+
+                auto name_node = eval_node(right->FUNC_CALL->args[0]);
+
+                if (name_node->type != NodeType::STRING)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the first argument to be a string");
+                }
+
+                bool descending = false;
+
+                if (right->FUNC_CALL->args.size() == 2)
+                {
+                    auto bool_node = eval_node(right->FUNC_CALL->args[1]);
+
+                    if (bool_node->type != NodeType::BOOL)
+                    {
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the second argument to be a boolean");
+                    }
+
+                    descending = bool_node->BOOL.value;
+                }
+
+                return sort_by_column(left, name_node->STRING.value, descending);
+            }
+            if (right->FUNC_CALL->name == "top_k")
+            {
+                if (right->FUNC_CALL->args.size() != 1 && right->FUNC_CALL->args.size() != 2)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 or 2 arguments");
+                }
+
+                auto k_node = eval_node(right->FUNC_CALL->args[0]);
+
+                if (k_node->type != NodeType::INT)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the first argument to be an int");
+                }
+
+                auto& elements = left->LIST.nodes();
+                size_t limit = std::min<size_t>(std::max<long long>(k_node->INT.value, 0), elements.size());
+                std::vector<size_t> order;
+
+                if (right->FUNC_CALL->args.size() == 1)
+                {
+                    order = sort_order(elements, true, true, limit);
+                }
+                else
+                {
+                    auto func = eval_node(right->FUNC_CALL->args[1]);
+
+                    if (func->type != NodeType::FUNCTION)
+                    {
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the second argument to be a function");
+                    }
+
+                    std::vector<Node_Ptr> keys;
+                    keys.reserve(elements.size());
+
+                    for (auto& elem : elements)
+                    {
+                        keys.push_back(eval_function_call(func, {elem}));
+                    }
+
+                    order = sort_order(keys, true, true, limit);
+                }
+
+                auto res = make_list(left->TYPE.is_literal);
+                res->TYPE.allowed_type = left->TYPE.allowed_type;
+                res->LIST.elements.reserve(order.size());
+
+                for (auto position : order)
+                {
+                    res->LIST.elements.push_back(elements[position]);
+                }
+
+                return res;
+            }
+            if (right->FUNC_CALL->name == "map")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
                 if (func->type == NodeType::PARTIAL_OP)
                 {
-                    for (int i = 0; i < left->LIST.nodes.size(); i++)
-                    {       
-                        auto arrow_node = std::make_shared<Node>(NodeType::OP);
+                    Sequence_Cursor cursor(left);
+
+                    for (int i = 0; cursor.next(); i++)
+                    {
+                        auto elem = cursor.value();
+
+                        auto arrow_node = make_pooled_node(NodeType::OP);
                         arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
-                        arrow_node->left = left->LIST.nodes[i];
-                        arrow_node->right = std::make_shared<Node>(*func);
-                        res->LIST.nodes.push_back(eval_double_arrow(arrow_node));
+                        arrow_node->left = elem;
+                        arrow_node->right = make_pooled_node(*func);
+                        res->LIST.nodes().push_back(eval_double_arrow(arrow_node));
                     }
 
                     return res;
                 }
 
-                for (int i = 0; i < left->LIST.nodes.size(); i++)
+                Sequence_Cursor cursor(left);
+
+                for (int i = 0; cursor.next(); i++)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
+                    auto elem = cursor.value();
+
+                    std::vector<Node_Ptr> args;
 
-                    if (func->FUNCTION.params.size() == 1)
+                    if (func->FUNCTION->params.size() == 1)
                     {
-                        args = {eval_node(left->LIST.nodes[i])};
+                        args = {eval_node(elem)};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node};
+                        args = {eval_node(elem), index_node};
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node, left};
+                        args = {eval_node(elem), index_node, left};
                     }
                     else
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
 
-                    res->LIST.nodes.push_back(eval_function_call(func, args));
+                    res->LIST.nodes().push_back(eval_function_call(func, args));
                 }
 
                 res->TYPE.allowed_type = get_type(res);
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "flatmap")
+            if (right->FUNC_CALL->name == "flatmap")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
                 if (func->type == NodeType::PARTIAL_OP)
                 {
-                    for (int i = 0; i < left->LIST.nodes.size(); i++)
-                    {       
-                        auto arrow_node = std::make_shared<Node>(NodeType::OP);
+                    Sequence_Cursor cursor(left);
+
+                    for (int i = 0; cursor.next(); i++)
+                    {
+                        auto elem = cursor.value();
+
+                        auto arrow_node = make_pooled_node(NodeType::OP);
                         arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
-                        arrow_node->left = left->LIST.nodes[i];
-                        arrow_node->right = std::make_shared<Node>(*func);
+                        arrow_node->left = elem;
+                        arrow_node->right = make_pooled_node(*func);
                         auto result = eval_double_arrow(arrow_node);
 
                         if (result->type == NodeType::LIST)
                         {
-                            res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+                            res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
                         }
                         else
                         {
-                            res->LIST.nodes.push_back(result);
+                            res->LIST.nodes().push_back(result);
                         }
                     }
 
@@ -2418,40 +5052,44 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     return res;
                 }
 
-                for (int i = 0; i < left->LIST.nodes.size(); i++)
+                Sequence_Cursor cursor(left);
+
+                for (int i = 0; cursor.next(); i++)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
+                    auto elem = cursor.value();
 
-                    if (func->FUNCTION.params.size() == 1)
+                    std::vector<Node_Ptr> args;
+
+                    if (func->FUNCTION->params.size() == 1)
                     {
-                        args = {eval_node(left->LIST.nodes[i])};
+                        args = {eval_node(elem)};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node};
+                        args = {eval_node(elem), index_node};
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node, left};
+                        args = {eval_node(elem), index_node, left};
                     }
                     else
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
 
                     auto result = eval_function_call(func, args);
 
                     if (result->type == NodeType::LIST)
                     {
-                        res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+                        res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
                     }
                     else
                     {
-                        res->LIST.nodes.push_back(result);
+                        res->LIST.nodes().push_back(result);
                     }
                 }
 
@@ -2459,35 +5097,39 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "filter")
+            if (right->FUNC_CALL->name == "filter")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
                 if (func->type == NodeType::PARTIAL_OP)
                 {
-                    for (int i = 0; i < left->LIST.nodes.size(); i++)
-                    {       
-                        auto arrow_node = std::make_shared<Node>(NodeType::OP);
+                    Sequence_Cursor cursor(left);
+
+                    for (int i = 0; cursor.next(); i++)
+                    {
+                        auto elem = cursor.value();
+
+                        auto arrow_node = make_pooled_node(NodeType::OP);
                         arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
-                        arrow_node->left = left->LIST.nodes[i];
-                        arrow_node->right = std::make_shared<Node>(*func);
+                        arrow_node->left = elem;
+                        arrow_node->right = make_pooled_node(*func);
                         auto cond_res = eval_double_arrow(arrow_node);
 
                         if (cond_res->BOOL.value)
                         {
-                            res->LIST.nodes.push_back(left->LIST.nodes[i]);
+                            res->LIST.nodes().push_back(elem);
                         }
                     }
 
@@ -2496,33 +5138,37 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     return res;
                 }
 
-                for (int i = 0; i < left->LIST.nodes.size(); i++)
+                Sequence_Cursor cursor(left);
+
+                for (int i = 0; cursor.next(); i++)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
-                    if (func->FUNCTION.params.size() == 1)
+                    auto elem = cursor.value();
+
+                    std::vector<Node_Ptr> args;
+                    if (func->FUNCTION->params.size() == 1)
                     {
-                        args = {eval_node(left->LIST.nodes[i])};
+                        args = {eval_node(elem)};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node};
+                        args = {eval_node(elem), index_node};
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = i;
-                        args = {eval_node(left->LIST.nodes[i]), index_node, left};
+                        args = {eval_node(elem), index_node, left};
                     }
                     else
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
                     
                     if (eval_function_call(func, args)->BOOL.value)
                     {
-                        res->LIST.nodes.push_back(left->LIST.nodes[i]);
+                        res->LIST.nodes().push_back(elem);
                     }
                 }
 
@@ -2530,42 +5176,46 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "foreach")
+            if (right->FUNC_CALL->name == "foreach")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
-                for (int i = 0; i < left->LIST.nodes.size(); i++)
+                Sequence_Cursor cursor(left);
+
+                for (int i = 0; cursor.next(); i++)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
-                    if (func->FUNCTION.params.size() == 1)
+                    auto elem = cursor.value();
+
+                    std::vector<Node_Ptr> args;
+                    if (func->FUNCTION->params.size() == 1)
                     {
-                        args = {eval_node(left->LIST.nodes[i])};
+                        args = {eval_node(elem)};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
                         auto index_node = make_int(i);
-                        args = {eval_node(left->LIST.nodes[i]), index_node};
+                        args = {eval_node(elem), index_node};
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
                         auto index_node = make_int(i);
-                        args = {eval_node(left->LIST.nodes[i]), index_node, left};
+                        args = {eval_node(elem), index_node, left};
                     }
                     else
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
 
                     eval_function_call(func, args);
@@ -2575,26 +5225,26 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "append")
+            if (right->FUNC_CALL->name == "append")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
                 if (typecheck)
                 {
-                    left->LIST.nodes.clear();
+                    left->LIST.nodes().clear();
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2603,7 +5253,7 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2613,29 +5263,29 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     error_and_exit("Cannot append element of type '" + value->type_repr() + "' to list of type " + left->TYPE.allowed_type->type_repr());
                 }
 
-                left->LIST.nodes.push_back(value);
+                left->LIST.nodes().push_back(value);
                 return left;
             }
-            if (right->FUNC_CALL.name == "prepend")
+            if (right->FUNC_CALL->name == "prepend")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
                 if (typecheck)
                 {
-                    left->LIST.nodes.clear();
+                    left->LIST.nodes().clear();
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2644,7 +5294,7 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2655,26 +5305,26 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 }
 
 
-                left->LIST.nodes.insert(left->LIST.nodes.begin(), value);
+                left->LIST.nodes().insert(left->LIST.nodes().begin(), value);
                 return left;
             }
-            if (right->FUNC_CALL.name == "insert")
+            if (right->FUNC_CALL->name == "insert")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 argument");
                 }
 
                 if (typecheck)
                 {
-                    left->LIST.nodes.clear();
+                    left->LIST.nodes().clear();
                 }
 
-                auto position_node = eval_node(right->FUNC_CALL.args[0]);
+                auto position_node = eval_node(right->FUNC_CALL->args[0]);
 
                 if (position_node->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects first argument to be an integer");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects first argument to be an integer");
                 }
                 
                 int position = position_node->INT.value;
@@ -2687,19 +5337,19 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 {
                     position = 0;
                 }
-                else if (position >= left->LIST.nodes.size())
+                else if (position >= left->LIST.nodes().size())
                 {
-                    position = left->LIST.nodes.size()-1;
+                    position = left->LIST.nodes().size()-1;
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[1]);
+                auto value = eval_node(right->FUNC_CALL->args[1]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2708,7 +5358,7 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2718,25 +5368,25 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     error_and_exit("Cannot insert element of type '" + value->type_repr() + "' to list of type " + left->TYPE.allowed_type->type_repr());
                 }
 
-                left->LIST.nodes.insert(left->LIST.nodes.begin() + position, value);
+                left->LIST.nodes().insert(left->LIST.nodes().begin() + position, value);
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "remove")
+            if (right->FUNC_CALL->name == "remove")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 integer argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 integer argument");
                 }
 
-                if (left->LIST.nodes.size() == 0)
+                if (left->LIST.nodes().size() == 0)
                 {
                     return left;
                 }
@@ -2748,42 +5398,42 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     pos = 0;
                 }
 
-                if (pos >= left->LIST.nodes.size())
+                if (pos >= left->LIST.nodes().size())
                 {
-                    pos = left->LIST.nodes.size() - 1;
+                    pos = left->LIST.nodes().size() - 1;
                 }
 
-                left->LIST.nodes.erase(left->LIST.nodes.begin() + pos);
+                left->LIST.nodes().erase(left->LIST.nodes().begin() + pos);
                 return left;
             }
-            if (right->FUNC_CALL.name == "clear")
+            if (right->FUNC_CALL->name == "clear")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
-                left->LIST.nodes.clear();
+                left->LIST.nodes().clear();
                 return left;
             }
-            if (right->FUNC_CALL.name == "subsection")
+            if (right->FUNC_CALL->name == "subsection")
             {
-                if (left->LIST.nodes.size() == 0)
+                if (left->LIST.nodes().size() == 0)
                 {
                     return left;
                 }
 
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto begin = eval_node(right->FUNC_CALL.args[0]);
-                auto end = eval_node(right->FUNC_CALL.args[1]);
+                auto begin = eval_node(right->FUNC_CALL->args[0]);
+                auto end = eval_node(right->FUNC_CALL->args[1]);
 
                 if (begin->type != NodeType::INT && end->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 integer arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 integer arguments");
                 }
 
                 int _begin = begin->INT.value;
@@ -2794,14 +5444,14 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     _begin = 0;
                 }
 
-                if (_begin >= left->LIST.nodes.size())
+                if (_begin >= left->LIST.nodes().size())
                 {
-                    _begin = left->LIST.nodes.size()-1;
+                    _begin = left->LIST.nodes().size()-1;
                 }
 
-                if (_end >= left->LIST.nodes.size())
+                if (_end >= left->LIST.nodes().size())
                 {
-                    _end = left->LIST.nodes.size()-1;
+                    _end = left->LIST.nodes().size()-1;
                 }
 
                 if (_end < 0)
@@ -2811,21 +5461,21 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 if (_begin > _end)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects first argument to be less than or equal to second argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects first argument to be less than or equal to second argument");
                 }
 
-                auto subsection = std::make_shared<Node>(*left);
-                subsection->LIST.nodes.clear();
+                auto subsection = make_pooled_node(*left);
+                subsection->LIST.nodes().clear();
 
                 for (int i = _begin; i <= _end; i++)
                 {
-                    subsection->LIST.nodes.push_back(left->LIST.nodes[i]);
+                    subsection->LIST.nodes().push_back(left->LIST.nodes()[i]);
                 }
 
                 return subsection;
             }
 
-            error_and_exit("List does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("List does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         // List properties
@@ -2834,15 +5484,15 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
         {
             if (right->ID.value == "length")
             {
-                auto res = make_int(left->LIST.nodes.size());
+                auto res = make_int(left->LIST.size());
                 res->TYPE.is_literal = runtime;
                 return res;
             }
             if (right->ID.value == "first")
             {
-                if (left->LIST.nodes.size() > 0)
+                if (left->LIST.nodes().size() > 0)
                 {
-                    return left->LIST.nodes[0];
+                    return left->LIST.nodes()[0];
                 }
 
                 return make_empty();
@@ -2850,16 +5500,16 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
             if (right->ID.value == "last")
             {
-                if (left->LIST.nodes.size() > 0)
+                if (left->LIST.nodes().size() > 0)
                 {
-                    return left->LIST.nodes[left->LIST.nodes.size()-1];
+                    return left->LIST.nodes()[left->LIST.nodes().size()-1];
                 }
 
                 return make_empty();
             }
             if (right->ID.value == "empty")
             {
-                auto res = make_bool(left->LIST.nodes.size() == 0);
+                auto res = make_bool(left->LIST.size() == 0);
                 return res;
             }
         }
@@ -2875,12 +5525,12 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("String accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type != NodeType::INT)
             {
@@ -2892,7 +5542,7 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 error_and_exit("String index out of range: String length is " + std::to_string(left->STRING.value.length()) + " but provided index is " + std::to_string(accessor->INT.value));
             }
 
-            auto res = std::make_shared<Node>(*node);
+            auto res = make_pooled_node(*node);
 
             res->type = NodeType::STRING;
             res->STRING.value = std::string(1, left->STRING.value[accessor->INT.value]);
@@ -2903,34 +5553,36 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "chars")
+            if (right->FUNC_CALL->name == "chars")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
-                auto res = std::make_shared<Node>(*node);
+                auto res = make_pooled_node(*node);
 
                 res->type = NodeType::LIST;
+                res->LIST.nodes().reserve(left->STRING.value.size());
+
                 for (char c : left->STRING.value)
                 {
-                    auto char_str_node = std::make_shared<Node>(NodeType::STRING);
+                    auto char_str_node = make_pooled_node(NodeType::STRING);
                     char_str_node->STRING.value = std::string(1, c);
-                    res->LIST.nodes.push_back(char_str_node);
+                    res->LIST.nodes().push_back(char_str_node);
                 }
 
                 res->TYPE.allowed_type = make_list();
-                res->TYPE.allowed_type->LIST.nodes.push_back(make_string("", false));
+                res->TYPE.allowed_type->LIST.nodes().push_back(make_string("", false));
 
                 return res;
             }
 
-            if (right->FUNC_CALL.name == "lower")
+            if (right->FUNC_CALL->name == "lower")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 std::transform(left->STRING.value.begin(), left->STRING.value.end(), 
@@ -2939,11 +5591,11 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "upper")
+            if (right->FUNC_CALL->name == "upper")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 std::transform(left->STRING.value.begin(), left->STRING.value.end(), 
@@ -2952,24 +5604,24 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "subsection")
+            if (right->FUNC_CALL->name == "subsection")
             {
                 if (left->STRING.value.length() == 0)
                 {
                     return left;
                 }
 
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto begin = eval_node(right->FUNC_CALL.args[0]);
-                auto end = eval_node(right->FUNC_CALL.args[1]);
+                auto begin = eval_node(right->FUNC_CALL->args[0]);
+                auto end = eval_node(right->FUNC_CALL->args[1]);
 
                 if (begin->type != NodeType::INT && end->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 integer arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 integer arguments");
                 }
 
                 int _begin = begin->INT.value;
@@ -2997,40 +5649,32 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
                 if (_begin > _end)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be less than or equal to second argument");
-                }
-
-                auto subsection = std::make_shared<Node>(*left);
-                subsection->STRING.value.clear();
-
-                for (int i = _begin; i <= _end; i++)
-                {
-                    subsection->STRING.value.push_back(left->STRING.value[i]);
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be less than or equal to second argument");
                 }
 
-                return subsection;
+                return make_slice(left, _begin, _end - _begin + 1);
             }
 
-            if (right->FUNC_CALL.name == "split")
+            if (right->FUNC_CALL->name == "split")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
                 std::string delim;
 
-                if (right->FUNC_CALL.args.size() == 0)
+                if (right->FUNC_CALL->args.size() == 0)
                 {
                     delim = " ";
                 }
                 else
                 {
-                    auto delim_node = eval_node(right->FUNC_CALL.args[0]);
+                    auto delim_node = eval_node(right->FUNC_CALL->args[0]);
 
                     if (delim_node->type != NodeType::STRING)
                     {
-                        error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                        error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                     }
 
                     delim = delim_node->STRING.value;
@@ -3041,60 +5685,65 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     }
                 }
 
+                auto& text = left->STRING.value;
                 size_t pos_start = 0, pos_end, delim_len = delim.length();
-                std::string token;
 
-                auto res = std::make_shared<Node>(NodeType::LIST);
+                auto res = make_pooled_node(NodeType::LIST);
                 res->line = node->line;
                 res->column = node->column;
 
-                while ((pos_end = left->STRING.value.find(delim, pos_start)) != std::string::npos) {
-                    token = left->STRING.value.substr (pos_start, pos_end - pos_start);
-                    pos_start = pos_end + delim_len;
+                // Each piece is copied straight out of the text
 
-                    auto str_node = std::make_shared<Node>(NodeType::STRING);
-                    str_node->STRING.value = token;
+                auto& pieces = res->LIST.nodes();
+
+                while ((pos_end = text.find(delim, pos_start)) != std::string::npos)
+                {
+                    auto str_node = make_pooled_node(NodeType::STRING);
+                    str_node->STRING.value.assign(text, pos_start, pos_end - pos_start);
+                    pieces.push_back(str_node);
 
-                    res->LIST.nodes.push_back(str_node);
+                    pos_start = pos_end + delim_len;
                 }
 
-                auto last_str_node = std::make_shared<Node>(NodeType::STRING);
-                last_str_node->STRING.value = left->STRING.value.substr(pos_start);
+                auto last_str_node = make_pooled_node(NodeType::STRING);
+                last_str_node->STRING.value.assign(text, pos_start, std::string::npos);
 
-                res->LIST.nodes.push_back(last_str_node);
+                pieces.push_back(last_str_node);
                 return res;
             }
 
-            if (right->FUNC_CALL.name == "trim")
+            if (right->FUNC_CALL->name == "trim")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
-                left->STRING.value.erase(left->STRING.value.begin(), std::find_if(left->STRING.value.begin(), left->STRING.value.end(), [](unsigned char ch) {
-                    return !std::isspace(ch);
-                }));
+                // The end is trimmed first, so less is moved when the start is
 
                 left->STRING.value.erase(std::find_if(left->STRING.value.rbegin(), left->STRING.value.rend(), [](unsigned char ch) {
                     return !std::isspace(ch);
                 }).base(), left->STRING.value.end());
 
+                left->STRING.value.erase(left->STRING.value.begin(), std::find_if(left->STRING.value.begin(), left->STRING.value.end(), [](unsigned char ch) {
+                    return !std::isspace(ch);
+                }));
+
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "append")
+            if (right->FUNC_CALL->name == "append")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                 }
 
                 left->STRING.value += value->STRING.value;
@@ -3102,18 +5751,18 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "prepend")
+            if (right->FUNC_CALL->name == "prepend")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                 }
 
                 left->STRING.value = value->STRING.value + left->STRING.value;
@@ -3121,24 +5770,24 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "insert")
+            if (right->FUNC_CALL->name == "insert")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
-                auto value_node = eval_node(right->FUNC_CALL.args[1]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
+                auto value_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be of type int");
                 }
 
                 if (value_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects second argument to be of type string");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects second argument to be of type string");
                 }
 
                 int pos = pos_node->INT.value;
@@ -3158,24 +5807,24 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace_at")
+            if (right->FUNC_CALL->name == "replace_at")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
-                auto value_node = eval_node(right->FUNC_CALL.args[1]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
+                auto value_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be of type int");
                 }
 
                 if (value_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects second argument to be of type string");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects second argument to be of type string");
                 }
 
                 int pos = pos_node->INT.value;
@@ -3195,18 +5844,18 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "remove")
+            if (right->FUNC_CALL->name == "remove")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects argument to be of type int");
                 }
 
                 if (left->STRING.value.length() == 0)
@@ -3231,19 +5880,19 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace")
+            if (right->FUNC_CALL->name == "replace")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 argument");
                 }
 
-                auto from_node = eval_node(right->FUNC_CALL.args[0]);
-                auto to_node = eval_node(right->FUNC_CALL.args[1]);
+                auto from_node = eval_node(right->FUNC_CALL->args[0]);
+                auto to_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (from_node->type != NodeType::STRING && to_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 string arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 string arguments");
                 }
 
                 if (from_node->STRING.value.length() == 0)
@@ -3263,19 +5912,19 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace_all")
+            if (right->FUNC_CALL->name == "replace_all")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto from_node = eval_node(right->FUNC_CALL.args[0]);
-                auto to_node = eval_node(right->FUNC_CALL.args[1]);
+                auto from_node = eval_node(right->FUNC_CALL->args[0]);
+                auto to_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (from_node->type != NodeType::STRING && to_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 string arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 string arguments");
                 }
 
                 if (from_node->STRING.value.length() == 0)
@@ -3293,14 +5942,14 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            error_and_exit("String does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("String does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         // String properties
 
         if (right->type == NodeType::ID)
         {
-            auto res = std::make_shared<Node>(*node);
+            auto res = make_pooled_node(*node);
 
             if (right->ID.value == "length")
             {
@@ -3357,18 +6006,18 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
     if (left->type == NodeType::OBJECT)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
 
         // Property access
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("Object accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type == NodeType::ANY)
             {
@@ -3382,13 +6031,13 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
             auto prop_name = accessor->STRING.value;
 
-            if (left->OBJECT.properties.find(prop_name) == left->OBJECT.properties.end())
+            if (left->OBJECT->properties.find(prop_name) == left->OBJECT->properties.end())
             {
                 res->type = NodeType::EMPTY;
                 return res;
             }
 
-            return left->OBJECT.properties[prop_name].value;
+            return left->OBJECT->properties[prop_name].value;
         }
 
         if (right->type == NodeType::ID)
@@ -3401,11 +6050,11 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
             {
                 res->type = NodeType::LIST;
 
-                for (auto prop : left->OBJECT.properties)
+                for (auto prop : left->OBJECT->properties)
                 {
-                    auto prop_name_node = std::make_shared<Node>(NodeType::STRING);
+                    auto prop_name_node = make_pooled_node(NodeType::STRING);
                     prop_name_node->STRING.value = prop.first;
-                    res->LIST.nodes.insert(res->LIST.nodes.begin(), prop_name_node);
+                    res->LIST.nodes().insert(res->LIST.nodes().begin(), prop_name_node);
                 }
 
                 return res;
@@ -3415,9 +6064,9 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
             {
                 res->type = NodeType::LIST;
 
-                for (auto prop : left->OBJECT.properties)
+                for (auto prop : left->OBJECT->properties)
                 {
-                    res->LIST.nodes.insert(res->LIST.nodes.begin(), prop.second.value);
+                    res->LIST.nodes().insert(res->LIST.nodes().begin(), prop.second.value);
                 }
 
                 return res;
@@ -3427,10 +6076,10 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
             {
                 res->type = NodeType::LIST;
 
-                for (auto prop : left->OBJECT.properties)
+                for (auto prop : left->OBJECT->properties)
                 {
-                    auto item_node = std::make_shared<Node>(NodeType::OBJECT);
-                    auto prop_name_node = std::make_shared<Node>(NodeType::STRING);
+                    auto item_node = make_pooled_node(NodeType::OBJECT);
+                    auto prop_name_node = make_pooled_node(NodeType::STRING);
                     prop_name_node->STRING.value = prop.first;
 
                     Object_Prop key_prop;
@@ -3439,97 +6088,123 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                     key_prop.value = prop_name_node;
                     value_prop.value = prop.second.value;
 
-                    item_node->OBJECT.properties["key"] = key_prop;
-                    item_node->OBJECT.properties["value"] = value_prop;
+                    item_node->OBJECT->properties["key"] = key_prop;
+                    item_node->OBJECT->properties["value"] = value_prop;
 
-                    res->LIST.nodes.push_back(item_node);
+                    res->LIST.nodes().push_back(item_node);
                 }
 
                 return res;
             }
 
-            if (left->OBJECT.properties.find(prop_name) == left->OBJECT.properties.end())
+            if (left->OBJECT->properties.find(prop_name) == left->OBJECT->properties.end())
             {
                 res->type = NodeType::EMPTY;
                 return res;
             }
 
-            if (typecheck && left->OBJECT.properties[prop_name].value->type == NodeType::FUNCTION && left->OBJECT.properties[prop_name].value->FUNCTION.is_type)
+            if (typecheck && left->OBJECT->properties[prop_name].value->type == NodeType::FUNCTION && left->OBJECT->properties[prop_name].value->FUNCTION->is_type)
             {
-                return get_explicit_type(left->OBJECT.properties[prop_name].value);
+                return get_explicit_type(left->OBJECT->properties[prop_name].value);
             }
 
-            return left->OBJECT.properties[prop_name].value;
+            return left->OBJECT->properties[prop_name].value;
         }
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            auto name = right->FUNC_CALL.name;
+            auto name = right->FUNC_CALL->name;
 
             // built-ins
 
             if (name == "delete")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
                     error_and_exit("Object function '" + name + "' expects 1 argument");
                 }
 
-                auto prop_name = eval_node(right->FUNC_CALL.args[0]);
+                auto prop_name = eval_node(right->FUNC_CALL->args[0]);
 
                 if (prop_name->type != NodeType::STRING)
                 {
                     error_and_exit("Object function '" + name + "' expects an argument of type string");
                 }
 
-                left->OBJECT.properties.erase(prop_name->STRING.value);
+                left->OBJECT->properties.erase(prop_name->STRING.value);
+
+                if (left->OBJECT->row.table != nullptr)
+                {
+                    left->OBJECT->row.table->write(left->OBJECT->row.index, prop_name->STRING.value, nullptr);
+                }
 
                 return left;
             }
 
             if (name == "clear")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
                     error_and_exit("Object function '" + name + "' expects 0 arguments");
                 }
 
-                left->OBJECT.properties.clear();
+                if (left->OBJECT->row.table != nullptr)
+                {
+                    for (auto& prop : left->OBJECT->properties)
+                    {
+                        left->OBJECT->row.table->write(left->OBJECT->row.index, prop.first, nullptr);
+                    }
+                }
+
+                left->OBJECT->properties.clear();
 
                 return left;
             }
             if (name == "add")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
                     error_and_exit("Object function '" + name + "' expects 2 arguments");
                 }
 
-                auto prop_name = eval_node(right->FUNC_CALL.args[0]);
-                auto value = eval_node(right->FUNC_CALL.args[1]);
+                auto prop_name = eval_node(right->FUNC_CALL->args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[1]);
 
                 if (prop_name->type != NodeType::STRING)
                 {
                     error_and_exit("Object function '" + name + "' expects name argument to be of type string");
                 }
 
-                left->OBJECT.properties[prop_name->STRING.value] = Object_Prop(true, value);
+                left->OBJECT->properties[prop_name->STRING.value] = Object_Prop(true, value);
+
+                if (left->OBJECT->row.table != nullptr)
+                {
+                    left->OBJECT->row.table->write(left->OBJECT->row.index, prop_name->STRING.value, value);
+                }
 
                 return left;
             }
 
             // function properties
 
-            if (left->OBJECT.properties.find(name) == left->OBJECT.properties.end())
+            if (left->OBJECT->properties.find(name) == left->OBJECT->properties.end())
             {
                 error_and_exit("Function '" + name + "' does not exist on object");
             }
 
-            auto function = left->OBJECT.properties[name].value;
+            auto function = left->OBJECT->properties[name].value;
+
+            // A method is shared by every object its literal made, so this
+            // is bound to the object it is called on at each call
+
+            if (function->type == NodeType::FUNCTION)
+            {
+                function->FUNCTION->closure["this"] = left;
+            }
 
             // call function
 
-            return eval_function_call(function, right->FUNC_CALL.args);
+            return eval_function_call(function, right->FUNC_CALL->args);
         }
     }
 
@@ -3537,54 +6212,54 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
     {
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "patch")
+            if (right->FUNC_CALL->name == "patch")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("Function function '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("Function function '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                if (left->FUNCTION.body->type != NodeType::BLOCK)
+                if (left->FUNCTION->body->type != NodeType::BLOCK)
                 {
-                    left->FUNCTION.body->BLOCK.nodes.push_back(std::make_shared<Node>(*left->FUNCTION.body));
-                    left->FUNCTION.body->type = NodeType::BLOCK;
+                    left->FUNCTION->body->BLOCK->nodes.push_back(make_pooled_node(*left->FUNCTION->body));
+                    left->FUNCTION->body->type = NodeType::BLOCK;
                 }
 
-                auto patch = right->FUNC_CALL.args[0];
+                auto patch = right->FUNC_CALL->args[0];
 
                 if (patch->type == NodeType::BLOCK)
                 {
-                    for (auto expr : patch->BLOCK.nodes)
+                    for (auto expr : patch->BLOCK->nodes)
                     {
-                        left->FUNCTION.body->BLOCK.nodes.push_back(expr);
+                        left->FUNCTION->body->BLOCK->nodes.push_back(expr);
                     }
                 }
                 else
                 {
-                    left->FUNCTION.body->BLOCK.nodes.push_back(right->FUNC_CALL.args[0]);
+                    left->FUNCTION->body->BLOCK->nodes.push_back(right->FUNC_CALL->args[0]);
                 }
 
                 return left;
             }
 
-            error_and_exit("Function does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("Function does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         if (right->type == NodeType::ID)
         {
             if (right->ID.value == "name")
             {
-                auto name = std::make_shared<Node>(NodeType::STRING);
-                name->STRING.value = left->FUNCTION.name;
+                auto name = make_pooled_node(NodeType::STRING);
+                name->STRING.value = left->FUNCTION->name;
                 return name;
             }
 
             if (right->ID.value == "params")
             {
-                auto params = std::make_shared<Node>(NodeType::LIST);
-                for (auto param : left->FUNCTION.params)
+                auto params = make_pooled_node(NodeType::LIST);
+                for (auto param : left->FUNCTION->params)
                 {
-                    auto name_node = std::make_shared<Node>(NodeType::STRING);
+                    auto name_node = make_pooled_node(NodeType::STRING);
 
                     if (param->type == NodeType::ID)
                     {
@@ -3599,7 +6274,7 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
                         name_node->STRING.value = param->left->ID.value;
                     }
 
-                    params->LIST.nodes.push_back(name_node);
+                    params->LIST.nodes().push_back(name_node);
                 }
 
                 return params;
@@ -3607,12 +6282,12 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
 
             if (right->ID.value == "args")
             {
-                auto args = std::make_shared<Node>(NodeType::LIST);
-                for (auto arg : left->FUNCTION.args)
+                auto args = make_pooled_node(NodeType::LIST);
+                for (auto arg : left->FUNCTION->args)
                 {
                     if (arg != nullptr)
                     {
-                        args->LIST.nodes.push_back(arg);
+                        args->LIST.nodes().push_back(arg);
                     }
                 }
 
@@ -3626,174 +6301,238 @@ std::shared_ptr<Node> Evaluator::eval_dot(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform operation '" + node->repr() + "' on '" + left->repr() + "' and '" + right->repr() + "'");
 }
 
-std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_assign(Node_Ptr& node, Node_Ptr& var, Node_Ptr value)
 {
-    // check if ID first, because evaluating an ID could return an error
-
-    if (node->left->type == NodeType::ID)
+    if (var->type == NodeType::ERROR)
     {
-        auto& var = eval_look_up(node->left->ID.value);
-        auto value = eval_node(node->right);
-
-        if (var->type == NodeType::ERROR)
+        // Check if type is explicit
+        if (node->left->ID.type == nullptr)
         {
-            // Check if type is explicit
-            if (node->left->ID.type == nullptr)
-            {
-                auto val = std::make_shared<Node>(*value);
-
-                // EXPERIMENTAL
-
-                if (val->TYPE.allowed_type == nullptr)
-                {
-                    val->TYPE.allowed_type = std::make_shared<Node>(*get_type(val));
-                }
+            auto val = make_pooled_node(*value);
 
-                if (val->type == NodeType::FUNCTION)
-                {
-                    val->FUNCTION.name = node->left->ID.value;
+            // EXPERIMENTAL
 
-                    auto func_list = std::make_shared<Node>(NodeType::FUNC_LIST);
-                    func_list->FUNC_LIST.nodes.push_back(val);
-                    symbol_table[node->left->ID.value] = func_list;
-                    return val;
-                }
+            if (val->TYPE.allowed_type == nullptr)
+            {
+                val->TYPE.allowed_type = make_pooled_node(*get_type(val));
+            }
 
-                symbol_table[node->left->ID.value] = val;
+            if (val->type == NodeType::FUNCTION)
+            {
+                val->FUNCTION->name = node->left->ID.value;
 
+                auto func_list = make_pooled_node(NodeType::FUNC_LIST);
+                func_list->FUNC_LIST->nodes.push_back(val);
+                symbol_table[node->left->ID.value] = func_list;
                 return val;
             }
 
-            if (value->TYPE.allowed_type == nullptr)
-            {
-                value->TYPE.allowed_type = get_type(value);
-            }
+            symbol_table[node->left->ID.value] = val;
 
-            auto explicit_type = eval_node(node->left->ID.type);
+            return val;
+        }
 
-            if (explicit_type->type == NodeType::TYPE)
-            {
-                value->TYPE.name = node->left->ID.value;
-                value->OBJECT.is_type = true;
-                value->FUNCTION.is_type = true;
-            }
+        if (value->TYPE.allowed_type == nullptr)
+        {
+            value->TYPE.allowed_type = get_type(value);
+        }
+
+        auto explicit_type = eval_node(node->left->ID.type);
+
+        if (explicit_type->type == NodeType::TYPE)
+        {
+            value->TYPE.name = node->left->ID.value;
+            value->OBJECT->is_type = true;
+            value->FUNCTION->is_type = true;
+        }
+
+        if (explicit_type->type == NodeType::FUNCTION)
+        {
+            explicit_type->FUNCTION->is_type = true;
+        }
 
+        if (value->TYPE.name == "")
+        {
             if (explicit_type->type == NodeType::FUNCTION)
             {
-                explicit_type->FUNCTION.is_type = true;
+                value->TYPE.name = explicit_type->FUNCTION->name;
             }
-
-            if (value->TYPE.name == "")
+            else if (explicit_type->type == NodeType::OBJECT)
             {
-                if (explicit_type->type == NodeType::FUNCTION)
-                {
-                    value->TYPE.name = explicit_type->FUNCTION.name;
-                }
-                else if (explicit_type->type == NodeType::OBJECT)
-                {
-                    value->TYPE.name = explicit_type->TYPE.name;
-                }
+                value->TYPE.name = explicit_type->TYPE.name;
             }
-            
-            auto match = match_types(explicit_type, value);
+        }
+        
+        auto match = match_types(explicit_type, value);
 
-            if (!match.result)
-            {
-                value->TYPE.name.clear();
-                error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + explicit_type->repr() + "'. " + match.message );
-            }
+        if (!match.result)
+        {
+            value->TYPE.name.clear();
+            error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + explicit_type->repr() + "'. " + match.message );
+        }
 
-            auto val = std::make_shared<Node>(*value);
-            val->TYPE.allowed_type = explicit_type;
+        auto val = make_pooled_node(*value);
+        val->TYPE.allowed_type = explicit_type;
 
-            if (val->type == NodeType::FUNCTION)
-            {
-                val->FUNCTION.name = node->left->ID.value;
-            }
+        if (val->type == NodeType::FUNCTION)
+        {
+            val->FUNCTION->name = node->left->ID.value;
+        }
+
+        symbol_table[node->left->ID.value] = val;
+
+        return val;
+    }
+
+    // Check that we are not re-assigning the type
+
+    if (node->left->ID.type != nullptr && node->left->ID.type->type != NodeType::ANY)
+    {
+        error_and_exit("[TypeError] Cannot re-assign type of variable '" + node->left->ID.value + "'");
+    }
+
+    if (node->left->ID.type != nullptr && node->left->ID.type->type == NodeType::ANY)
+    {
+        var->TYPE.allowed_type = node->left->ID.type;
+    }
+
+    // Check if we are adding a function to a multiple dispatch list
+    if (var->type == NodeType::FUNC_LIST)
+    {
+        auto val = make_pooled_node(*value);
+
+        if (val->type == NodeType::FUNCTION)
+        {
+            val->FUNCTION->name = node->left->ID.value;
+            var->FUNC_LIST->nodes.push_back(val);
+            symbol_table[node->left->ID.value] = var;
+            return val;
+        }
+    }
+
+    if (var->TYPE.allowed_type == nullptr)
+    {
+        var->TYPE.allowed_type = make_pooled_node(NodeType::ANY);
+    }
+
+    // Check allowed types
+    if (var->TYPE.allowed_type->type == NodeType::ANY)
+    {
+        auto val = make_pooled_node(*value);
+
+        if (val->type == NodeType::FUNCTION)
+        {
+            val->FUNCTION->name = node->left->ID.value;
+        }
+
+        val->TYPE.allowed_type = var->TYPE.allowed_type;
+
+        // symbol_table[node->left->ID.value] = val;
+        *var = *val;
+
+        return val;
+    }
+
+    auto match = match_types(var->TYPE.allowed_type, value);
+
+    if (!match.result)
+    {
+        error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + var->TYPE.allowed_type->repr() + "'. " + match.message);
+    }
+
+    auto val = make_pooled_node(*value);
+    val->TYPE.allowed_type = var->TYPE.allowed_type;
+
+    if (val->type == NodeType::FUNCTION)
+    {
+        val->FUNCTION->name = node->left->ID.value;
+    }
 
-            symbol_table[node->left->ID.value] = val;
+    // symbol_table[node->left->ID.value] = val;
+    *var = *val;
 
-            return val;
-        }
+    return val;
+}
 
-        // Check that we are not re-assigning the type
+// Whether s = s + piece or s += piece can add to s's text where it is. The
+// assignment writes over s's node in place anyway, so only the copies of
+// the text that s + piece and the assignment would make are saved, and
+// building a string a piece at a time stops costing its length each time.
+// A variable typed to one literal string still goes through the checks
 
-        if (node->left->ID.type != nullptr && node->left->ID.type->type != NodeType::ANY)
-        {
-            error_and_exit("[TypeError] Cannot re-assign type of variable '" + node->left->ID.value + "'");
-        }
+bool Evaluator::can_append(Node_Ptr& node, Node_Ptr& var)
+{
+    if (node->left->ID.type != nullptr || var->type != NodeType::STRING || var->TYPE.allowed_type == nullptr)
+    {
+        return false;
+    }
 
-        if (node->left->ID.type != nullptr && node->left->ID.type->type == NodeType::ANY)
-        {
-            var->TYPE.allowed_type = node->left->ID.type;
-        }
+    auto& allowed = var->TYPE.allowed_type;
 
-        // Check if we are adding a function to a multiple dispatch list
-        if (var->type == NodeType::FUNC_LIST)
-        {
-            auto val = std::make_shared<Node>(*value);
+    return allowed->type == NodeType::ANY || (allowed->type == NodeType::STRING && !allowed->TYPE.is_literal);
+}
 
-            if (val->type == NodeType::FUNCTION)
-            {
-                val->FUNCTION.name = node->left->ID.value;
-                var->FUNC_LIST.nodes.push_back(val);
-                symbol_table[node->left->ID.value] = var;
-                return val;
-            }
-        }
+Node_Ptr Evaluator::eval_append(Node_Ptr& node, Node_Ptr& var, Node_Ptr piece)
+{
+    // Working out the piece may have assigned something else to s
 
-        if (var->TYPE.allowed_type == nullptr)
-        {
-            var->TYPE.allowed_type = std::make_shared<Node>(NodeType::ANY);
-        }
+    if (var->type == NodeType::STRING)
+    {
+        auto& text = var->STRING.value;
 
-        // Check allowed types
-        if (var->TYPE.allowed_type->type == NodeType::ANY)
+        switch (piece->type)
         {
-            auto val = std::make_shared<Node>(*value);
+            case NodeType::STRING: text += piece->STRING.value; return var;
+            case NodeType::INT: text += std::to_string(piece->INT.value); return var;
+            case NodeType::FLOAT: text += std::to_string(piece->FLOAT.value); return var;
+            case NodeType::BOOL: text += std::to_string(piece->BOOL.value); return var;
+            case NodeType::EMPTY: return var;
+            default: break;
+        }
+    }
 
-            if (val->type == NodeType::FUNCTION)
-            {
-                val->FUNCTION.name = node->left->ID.value;
-            }
+    // Otherwise s is added to as s + piece would be. The sum is built from
+    // the variable's name rather than its node, which the assignment
+    // overwrites, so the new value can never hold itself
 
-            val->TYPE.allowed_type = var->TYPE.allowed_type;
+    auto op_node = make_pooled_node(NodeType::OP);
+    op_node->left = node->left;
+    op_node->right = piece;
 
-            // symbol_table[node->left->ID.value] = val;
-            *var = *val;
+    return eval_assign(node, var, eval_add(op_node));
+}
 
-            return val;
-        }
+Node_Ptr Evaluator::eval_equal(Node_Ptr& node)
+{
+    // check if ID first, because evaluating an ID could return an error
 
-        auto match = match_types(var->TYPE.allowed_type, value);
+    if (node->left->type == NodeType::ID)
+    {
+        auto& var = eval_look_up(node->left->ID.value, node->left->ID.slot);
 
-        if (!match.result)
-        {
-            error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + var->TYPE.allowed_type->repr() + "'. " + match.message);
-        }
+        // s = s + piece
 
-        auto val = std::make_shared<Node>(*value);
-        val->TYPE.allowed_type = var->TYPE.allowed_type;
+        auto& right = node->right;
 
-        if (val->type == NodeType::FUNCTION)
+        if (right->type == NodeType::OP && right->OP.op_type == NodeType::PLUS && right->left->type == NodeType::ID
+        &&  right->left->ID.value == node->left->ID.value && can_append(node, var))
         {
-            val->FUNCTION.name = node->left->ID.value;
+            return eval_append(node, var, eval_node(right->right));
         }
 
-        // symbol_table[node->left->ID.value] = val;
-        *var = *val;
+        auto value = eval_node(node->right);
 
-        return val;
+        return eval_assign(node, var, value);
     }
 
     if (node->left->type == NodeType::LIST)
     {
-        if (node->left->LIST.nodes.size() != 1)
+        if (node->left->LIST.nodes().size() != 1)
         {
             error_and_exit("Dynamic variable creation list expects 1 argument");
         }
 
-        auto name = eval_node(node->left->LIST.nodes[0]);
+        auto name = eval_node(node->left->LIST.nodes()[0]);
 
         if (name->type != NodeType::STRING)
         {
@@ -3802,10 +6541,23 @@ std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
 
         auto value = eval_node(node->right);
 
-        symbol_table[name->STRING.value] = std::make_shared<Node>(*value);
+        symbol_table[name->STRING.value] = make_pooled_node(*value);
         return value;
     }
 
+    // Indexing a lazy range hands out a fresh element, so a range about to
+    // be assigned through is materialized first
+
+    if (node->left->OP.op_type == NodeType::DOT && node->left->right->type == NodeType::LIST && node->left->left->type == NodeType::ID)
+    {
+        auto& list = eval_look_up(node->left->left->ID.value, node->left->left->ID.slot);
+
+        if (list->type == NodeType::LIST)
+        {
+            list->LIST.nodes();
+        }
+    }
+
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
@@ -3823,12 +6575,12 @@ std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
             }
             else if (node->left->right->type == NodeType::LIST)
             {
-                if (node->left->right->LIST.nodes.size() == 0)
+                if (node->left->right->LIST.nodes().size() == 0)
                 {
                     error_and_exit("Cannot assign an empty property name");
                 }
 
-                auto prop_name_node = eval_node(node->left->right->LIST.nodes[0]);
+                auto prop_name_node = eval_node(node->left->right->LIST.nodes()[0]);
 
                 if (prop_name_node->type == NodeType::ANY)
                 {
@@ -3843,40 +6595,55 @@ std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
                 prop_name = prop_name_node->STRING.value;
             }
 
-            if (obj->OBJECT.properties.find(prop_name) != obj->OBJECT.properties.end())
+            // An object whose type is any, as one returned by a function
+            // declared to return any is, puts no type on its properties
+
+            Node_Ptr prop_type;
+
+            if (obj->TYPE.allowed_type != nullptr && obj->TYPE.allowed_type->type == NodeType::OBJECT)
+            {
+                auto prop = obj->TYPE.allowed_type->OBJECT->properties.find(prop_name);
+
+                if (prop != obj->TYPE.allowed_type->OBJECT->properties.end())
+                {
+                    prop_type = prop->second.value;
+                }
+            }
+
+            if (obj->OBJECT->properties.find(prop_name) != obj->OBJECT->properties.end())
             {
                 if (left->type == NodeType::FUNC_LIST && right->type == NodeType::FUNCTION)
                 {
-                    right->FUNCTION.name = prop_name;
-                    left->FUNC_LIST.nodes.push_back(right);
-                    obj->OBJECT.properties[prop_name].value = left;
+                    right->FUNCTION->name = prop_name;
+                    left->FUNC_LIST->nodes.push_back(right);
+                    obj->OBJECT->properties[prop_name].value = left;
                     return left;
                 }
 
                 if (left->type == NodeType::FUNCTION && right->type == NodeType::FUNCTION)
                 {
-                    auto func_list = std::make_shared<Node>(NodeType::FUNC_LIST);
-                    func_list->FUNC_LIST.nodes.push_back(left);
-                    right->FUNCTION.name = prop_name;
-                    func_list->FUNC_LIST.nodes.push_back(right);
-                    obj->OBJECT.properties[prop_name].value = func_list;
+                    auto func_list = make_pooled_node(NodeType::FUNC_LIST);
+                    func_list->FUNC_LIST->nodes.push_back(left);
+                    right->FUNCTION->name = prop_name;
+                    func_list->FUNC_LIST->nodes.push_back(right);
+                    obj->OBJECT->properties[prop_name].value = func_list;
                     return left;
                 }
 
-                if (obj->TYPE.allowed_type != nullptr)
+                if (prop_type != nullptr)
                 {
-                    if (!match_types(obj->TYPE.allowed_type->OBJECT.properties[prop_name].value, right).result)
+                    if (!match_types(prop_type, right).result)
                     {
-                        error_and_exit("Cannot assign value of type '" + right->type_repr() + "' to object property of type '" + obj->TYPE.allowed_type->OBJECT.properties[prop_name].value->repr() + "'");
+                        error_and_exit("Cannot assign value of type '" + right->type_repr() + "' to object property of type '" + prop_type->repr() + "'");
                     }
                 }
             }
 
             if (right->TYPE.allowed_type == nullptr)
             {
-                if (obj->TYPE.allowed_type != nullptr)
+                if (prop_type != nullptr)
                 {
-                    right->TYPE.allowed_type = obj->TYPE.allowed_type->OBJECT.properties[prop_name].value;
+                    right->TYPE.allowed_type = prop_type;
                 }
                 else
                 {
@@ -3884,14 +6651,22 @@ std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
                 }
             }
 
-            obj->OBJECT.properties[prop_name] = Object_Prop(true, right);
+            obj->OBJECT->properties[prop_name] = Object_Prop(true, right);
+
+            if (obj->OBJECT->row.table != nullptr)
+            {
+                obj->OBJECT->row.table->write(obj->OBJECT->row.index, prop_name, right);
+            }
 
             if (obj->TYPE.allowed_type == nullptr)
             {
                 obj->TYPE.allowed_type = make_object(false);
             }
 
-            obj->TYPE.allowed_type->OBJECT.properties[prop_name] = Object_Prop(true, right->TYPE.allowed_type);
+            if (obj->TYPE.allowed_type->type == NodeType::OBJECT)
+            {
+                obj->TYPE.allowed_type->OBJECT->properties[prop_name] = Object_Prop(true, right->TYPE.allowed_type);
+            }
 
             return left;
         }
@@ -3901,12 +6676,12 @@ std::shared_ptr<Node> Evaluator::eval_equal(std::shared_ptr<Node>& node)
     return left;
 }
 
-std::shared_ptr<Node> Evaluator::eval_double_dot(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_double_dot(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (left->type != NodeType::INT && right->type != NodeType::INT)
     {
@@ -3915,35 +6690,29 @@ std::shared_ptr<Node> Evaluator::eval_double_dot(std::shared_ptr<Node>& node)
 
     res->type = NodeType::LIST;
     res->TYPE.allowed_type = make_list();
-    res->TYPE.allowed_type->LIST.nodes.push_back(make_int(0, false));
+    res->TYPE.allowed_type->LIST.nodes().push_back(make_int(0, false));
 
-    int start = left->INT.value;
-    int end = right->INT.value;
+    res->LIST.set_range(left->INT.value, right->INT.value);
 
-    if (start <= end)
-    {
-        for (int i = start; i < end; i++)
-        {
-            auto int_node = std::make_shared<Node>(NodeType::INT);
-            int_node->INT.value = i;
-            res->LIST.nodes.push_back(int_node);
-        }
-    }
-    else
+    return res;
+}
+
+Node_Ptr Evaluator::eval_double_arrow(Node_Ptr& node)
+{
+    // A reduce stage goes through eval_pipeline even on its own, so reduce[+]
+    // over numbers reaches the sum kernel
+
+    if (is_pipeline_stage(node))
     {
-        for (int i = start; i > end; i--)
+        bool is_reduce = node->right->FUNC_CALL->name == "reduce" && node->left->type != NodeType::COMMA_LIST;
+        bool is_chain = is_pipeline_stage(node->left) && node->left->right->FUNC_CALL->name != "reduce";
+
+        if (is_reduce || is_chain)
         {
-            auto int_node = std::make_shared<Node>(NodeType::INT);
-            int_node->INT.value = i;
-            res->LIST.nodes.push_back(int_node);
+            return eval_pipeline(node);
         }
     }
 
-    return res;
-}
-
-std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
-{
     auto left = eval_node(node->left);
 
     // Built-in function intercept
@@ -3953,11 +6722,11 @@ std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
         if (builtin_functions.find(node->right->ID.value) != builtin_functions.end())
         {
             auto func = builtin_functions[node->right->ID.value];
-            std::vector<std::shared_ptr<Node>> args;
+            std::vector<Node_Ptr> args;
 
             // if (left->type == NodeType::COMMA_LIST)
             // {
-            //     args = eval_node(left->COMMA_LIST.nodes);
+            //     args = eval_node(left->COMMA_LIST->nodes);
             // }
             // else
             // {
@@ -3965,7 +6734,7 @@ std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
             // }
             if (left->type == NodeType::COMMA_LIST)
             {
-                for (auto arg : left->COMMA_LIST.nodes)
+                for (auto arg : left->COMMA_LIST->nodes)
                 {
                     args.push_back(eval_node(arg));
                 }
@@ -3981,15 +6750,15 @@ std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
 
     if (node->right->type == NodeType::FUNC_CALL)
     {
-        if (builtin_functions.find(node->right->FUNC_CALL.name) != builtin_functions.end())
+        if (builtin_functions.find(node->right->FUNC_CALL->name) != builtin_functions.end())
         {
-            auto func = builtin_functions[node->right->FUNC_CALL.name];
+            auto func = builtin_functions[node->right->FUNC_CALL->name];
 
-            std::vector<std::shared_ptr<Node>> args = node->right->FUNC_CALL.args;
+            std::vector<Node_Ptr> args = node->right->FUNC_CALL->args;
 
             if (left->type == NodeType::COMMA_LIST)
             {
-                for (auto arg : left->COMMA_LIST.nodes)
+                for (auto arg : left->COMMA_LIST->nodes)
                 {
                     args.push_back(eval_node(arg));
                 }
@@ -4002,14 +6771,14 @@ std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
             return (this->*func)(args);
         }
 
-        auto func = eval_look_up(node->right->FUNC_CALL.name);
+        auto func = eval_look_up(node->right->FUNC_CALL->name, node->right->FUNC_CALL->slot);
 
         if (func->type == NodeType::ERROR)
         {
-            error_and_exit("Function '" + node->right->FUNC_CALL.name + "' is undefined");
+            error_and_exit("Function '" + node->right->FUNC_CALL->name + "' is undefined");
         }
 
-        auto args = node->right->FUNC_CALL.args;
+        auto args = node->right->FUNC_CALL->args;
 
         for (auto& arg : args)
         {
@@ -4018,237 +6787,525 @@ std::shared_ptr<Node> Evaluator::eval_double_arrow(std::shared_ptr<Node>& node)
 
         if (left->type == NodeType::COMMA_LIST)
         {
-            for (auto elem : left->COMMA_LIST.nodes)
+            for (auto elem : left->COMMA_LIST->nodes)
             {
                 args.push_back(eval_node(elem));
             }
         }
         else
         {
-            args.push_back(eval_node(left));
+            args.push_back(eval_node(left));
+        }
+
+        return eval_function_call(func, args);
+    }
+
+    auto right = eval_node(node->right);
+
+    auto res = make_pooled_node(*right);
+
+    if (right->type != NodeType::PARTIAL_OP && right->type != NodeType::FUNCTION && right->type != NodeType::FUNC_LIST)
+    {
+        error_and_exit("Cannot perform operation '" + node->repr() + "' on '" + left->repr() + "' and '" + right->repr() + "'");
+    }
+
+    if (right->type == NodeType::PARTIAL_OP)
+    {
+        int missing_operand_count = 0;
+
+        if (right->left->type == NodeType::EMPTY)
+        {
+            missing_operand_count++;
+        }
+        if (right->right->type == NodeType::EMPTY)
+        {
+            missing_operand_count++;
+        }
+
+        if (left->type == NodeType::COMMA_LIST)
+        {
+            auto elements = left->COMMA_LIST->nodes;
+
+            if (elements.size() != 2)
+            {
+                error_and_exit("Cannot inject more than 2 values into a partial operator");
+            }
+
+            if (missing_operand_count != 2)
+            {
+                error_and_exit("Cannot inject multiple values into a partial operator with one missing operand");
+            }
+
+            res->left = elements[0];
+            res->right = elements[1];
+
+            res->type = NodeType::OP;
+
+            return eval_node(res);
+        }
+
+        if (right->left->type == NodeType::EMPTY)
+        {
+            res->left = left;
+        }
+        else if (right->right->type == NodeType::EMPTY)
+        {
+            res->right = left;
+        }
+
+        if (res->left->type != NodeType::EMPTY && res->right->type != NodeType::EMPTY)
+        {
+            res->type = NodeType::OP;
+        }
+
+        return eval_node(res);
+    }
+
+    if (right->type == NodeType::FUNCTION || right->type == NodeType::FUNC_LIST && right->FUNC_LIST->nodes.size() == 1)
+    {
+        if (right->type == NodeType::FUNC_LIST)
+        {
+            right = right->FUNC_LIST->nodes[0];
+        }
+
+        auto args = right->FUNCTION->args;
+
+        if (args.size() == 0)
+        {
+            error_and_exit("Function '" + right->FUNCTION->name + "' expects 0 arguments, and cannot be injected");
+        }
+        
+        if (left->type == NodeType::COMMA_LIST)
+        {
+            for (int i = 0; i < left->COMMA_LIST->nodes.size(); i++)
+            {
+                int arg_index = 0;
+
+                while (args[arg_index] != nullptr)
+                {
+                    arg_index++;
+
+                    if (arg_index >= args.size())
+                    {
+                        error_and_exit("Injecting too many arguments into a function");
+                    }
+                }
+
+                args[arg_index] = left->COMMA_LIST->nodes[i];
+            }
+        }
+        else
+        {
+
+            int arg_index = 0;
+
+            while (args[arg_index] != nullptr)
+            {
+                arg_index++;
+
+                if (arg_index >= args.size())
+                {
+                    error_and_exit("Injecting too many arguments into a function");
+                }
+            }
+
+            args[arg_index] = left;
+        }
+
+        std::vector<Node_Ptr> flat_args;
+
+        auto func_copy = make_pooled_node(*right);
+
+        for (int i = 0; i < args.size(); i++)
+        {
+            // Remove the arg value here because
+            // it's going to get re-injected in
+            // eval_function_call 
+
+            func_copy->FUNCTION->args[i] = nullptr;
+
+            if (args[i] != nullptr)
+            {
+                flat_args.push_back(eval_node(args[i]));
+            }
+        }
+
+        // Default values just evaluated moved line and column to where the
+        // function was defined; the call is here
+
+        line = node->line;
+        column = node->column;
+
+        return eval_function_call(func_copy, flat_args);
+    }
+
+    if (right->type == NodeType::FUNC_LIST)
+    {
+        std::vector<Node_Ptr> args;
+        
+        if (left->type == NodeType::COMMA_LIST)
+        {
+            for (int i = 0; i < left->COMMA_LIST->nodes.size(); i++)
+            {
+                args.push_back(eval_node(left->COMMA_LIST->nodes[i]));
+            }
+        }
+        else
+        {
+            args.push_back(eval_node(left));
+        }
+
+        return eval_function_call(right, args);
+    }
+}
+
+// --- Pipelines --- //
+
+// A stage of a >> chain that can take part in fusion: a one-argument call to
+// map, filter or reduce as defined in builtins.gl. Overloading one of them
+// adds a function that is not a builtin, which turns fusion off for it
+
+bool Evaluator::is_pipeline_stage(Node_Ptr& node)
+{
+    if (node->type != NodeType::OP || node->OP.op_type != NodeType::DOUBLE_ARROW)
+    {
+        return false;
+    }
+
+    auto& call = node->right;
+
+    if (call->type != NodeType::FUNC_CALL || call->FUNC_CALL->args.size() != 1)
+    {
+        return false;
+    }
+
+    auto& name = call->FUNC_CALL->name;
+
+    if (name != "map" && name != "filter" && name != "reduce")
+    {
+        return false;
+    }
+
+    auto& stage = eval_look_up(name, call->FUNC_CALL->slot);
+
+    if (stage->type != NodeType::FUNC_LIST)
+    {
+        return false;
+    }
+
+    for (auto& func : stage->FUNC_LIST->nodes)
+    {
+        if (!func->FUNCTION->is_builtin)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Whether a stage's function can be applied one element at a time - the
+// three parameter form is handed the whole input list, so it can't
+
+static bool is_fusable(Node_Ptr& call, Node_Ptr& func)
+{
+    auto& name = call->FUNC_CALL->name;
+
+    if (func->type == NodeType::PARTIAL_OP)
+    {
+        if (name == "reduce")
+        {
+            return func->left->type == NodeType::EMPTY && func->right->type == NodeType::EMPTY;
         }
 
-        return eval_function_call(func, args);
+        return true;
     }
 
-    auto right = eval_node(node->right);
+    if (func->type != NodeType::FUNCTION)
+    {
+        return false;
+    }
 
-    auto res = std::make_shared<Node>(*right);
+    if (name == "reduce")
+    {
+        return func->FUNCTION->params.size() == 2;
+    }
 
-    if (right->type != NodeType::PARTIAL_OP && right->type != NodeType::FUNCTION && right->type != NodeType::FUNC_LIST)
+    return func->FUNCTION->params.size() == 1 || func->FUNCTION->params.size() == 2;
+}
+
+// Applying a partial operator copies the operator into its result, operands
+// included. A plain value has no use for them, and dropping them keeps each
+// stage's output from holding on to its input
+
+static void drop_operands(Node_Ptr& result)
+{
+    if (result->type == NodeType::INT || result->type == NodeType::FLOAT || result->type == NodeType::BOOL || result->type == NodeType::STRING)
     {
-        error_and_exit("Cannot perform operation '" + node->repr() + "' on '" + left->repr() + "' and '" + right->repr() + "'");
+        result->left = nullptr;
+        result->right = nullptr;
     }
+}
 
-    if (right->type == NodeType::PARTIAL_OP)
+// Runs a stage the way an unfused >> would, through the builtins.gl function,
+// except that reduce[+] over a list of numbers is summed natively
+
+Node_Ptr Evaluator::eval_pipeline_stage(Node_Ptr& call, Node_Ptr& func, Node_Ptr value)
+{
+    bool is_sum = func->type == NodeType::PARTIAL_OP && func->OP.op_type == NodeType::PLUS
+        && func->left->type == NodeType::EMPTY && func->right->type == NodeType::EMPTY;
+
+    if (is_sum && value->type == NodeType::LIST && call->FUNC_CALL->name == "reduce")
     {
-        int missing_operand_count = 0;
+        auto sum = reduce_numbers(value);
 
-        if (right->left->type == NodeType::EMPTY)
+        if (sum != nullptr)
         {
-            missing_operand_count++;
-        }
-        if (right->right->type == NodeType::EMPTY)
-        {
-            missing_operand_count++;
+            return sum;
         }
+    }
 
-        if (left->type == NodeType::COMMA_LIST)
-        {
-            auto elements = left->COMMA_LIST.nodes;
+    auto& stage = eval_look_up(call->FUNC_CALL->name, call->FUNC_CALL->slot);
+    return eval_function_call(stage, {func, eval_node(value)});
+}
 
-            if (elements.size() != 2)
-            {
-                error_and_exit("Cannot inject more than 2 values into a partial operator");
-            }
+// Evaluates a chain like `ls >> map[f] >> filter[g] >> reduce[+]`. Runs of
+// fusable map and filter stages pass each element through every stage in
+// turn and only build the list the last one produces, or fold it straight
+// into a trailing reduce, so no intermediate list is created
 
-            if (missing_operand_count != 2)
-            {
-                error_and_exit("Cannot inject multiple values into a partial operator with one missing operand");
-            }
+Node_Ptr Evaluator::eval_pipeline(Node_Ptr& node)
+{
+    std::vector<Node_Ptr> calls = {node->right};
+    Node_Ptr source = node->left;
 
-            res->left = elements[0];
-            res->right = elements[1];
+    while (is_pipeline_stage(source) && source->right->FUNC_CALL->name != "reduce")
+    {
+        calls.push_back(source->right);
+        source = source->left;
+    }
 
-            res->type = NodeType::OP;
+    std::reverse(calls.begin(), calls.end());
 
-            return eval_node(res);
-        }
+    auto value = eval_node(source);
 
-        if (right->left->type == NodeType::EMPTY)
-        {
-            res->left = left;
-        }
-        else if (right->right->type == NodeType::EMPTY)
-        {
-            res->right = left;
-        }
+    std::vector<Node_Ptr> funcs;
 
-        if (res->left->type != NodeType::EMPTY && res->right->type != NodeType::EMPTY)
-        {
-            res->type = NodeType::OP;
-        }
+    for (auto& call : calls)
+    {
+        funcs.push_back(eval_node(call->FUNC_CALL->args[0]));
+    }
 
-        return eval_node(res);
+    // Elements that pass through a stage leave their garbage behind one at
+    // a time, so a pipeline run from the top level collects as it goes
+
+    bool safe_point = false;
+
+    for (Evaluator* scope = this; scope != nullptr; scope = scope->outer_scope)
+    {
+        safe_point = safe_point || scope->collect_cycles;
     }
 
-    if (right->type == NodeType::FUNCTION || right->type == NodeType::FUNC_LIST && right->FUNC_LIST.nodes.size() == 1)
+    size_t stage = 0;
+
+    while (stage < calls.size())
     {
-        if (right->type == NodeType::FUNC_LIST)
+        size_t end = stage;
+
+        while (end < calls.size() && calls[end]->FUNC_CALL->name != "reduce" && is_fusable(calls[end], funcs[end]))
         {
-            right = right->FUNC_LIST.nodes[0];
+            end++;
         }
 
-        auto args = right->FUNCTION.args;
-
-        if (args.size() == 0)
+        if (value->type != NodeType::LIST || end == stage)
         {
-            error_and_exit("Function '" + right->FUNCTION.name + "' expects 0 arguments, and cannot be injected");
+            value = eval_pipeline_stage(calls[stage], funcs[stage], value);
+            stage++;
+            continue;
         }
-        
-        if (left->type == NodeType::COMMA_LIST)
-        {
-            for (int i = 0; i < left->COMMA_LIST.nodes.size(); i++)
-            {
-                int arg_index = 0;
 
-                while (args[arg_index] != nullptr)
-                {
-                    arg_index++;
+        bool fold = end < calls.size() && is_fusable(calls[end], funcs[end]);
 
-                    if (arg_index >= args.size())
-                    {
-                        error_and_exit("Injecting too many arguments into a function");
-                    }
-                }
+        auto res = make_list(value->TYPE.is_literal);
+        Node_Ptr acc = nullptr;
+        std::vector<int> indices(end - stage, 0);
 
-                args[arg_index] = left->COMMA_LIST.nodes[i];
-            }
-        }
-        else
-        {
+        Sequence_Cursor cursor(value);
 
-            int arg_index = 0;
+        while (cursor.next())
+        {
+            auto elem = cursor.value();
+            bool keep = true;
 
-            while (args[arg_index] != nullptr)
+            for (size_t s = stage; s < end && keep; s++)
             {
-                arg_index++;
+                auto& func = funcs[s];
+                bool is_map = calls[s]->FUNC_CALL->name == "map";
+                Node_Ptr result;
 
-                if (arg_index >= args.size())
+                if (func->type == NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("Injecting too many arguments into a function");
+                    auto arrow_node = make_pooled_node(NodeType::OP);
+                    arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
+                    arrow_node->left = elem;
+                    arrow_node->right = make_pooled_node(*func);
+                    result = eval_double_arrow(arrow_node);
+                    drop_operands(result);
+                }
+                else if (func->FUNCTION->params.size() == 1)
+                {
+                    result = eval_function_call(func, {eval_node(elem)});
+                }
+                else
+                {
+                    auto index_node = make_pooled_node(NodeType::INT);
+                    index_node->INT.value = indices[s - stage];
+                    result = eval_function_call(func, {eval_node(elem), index_node});
                 }
-            }
-
-            args[arg_index] = left;
-        }
 
-        std::vector<std::shared_ptr<Node>> flat_args;
+                indices[s - stage]++;
 
-        auto func_copy = std::make_shared<Node>(*right);
+                if (is_map)
+                {
+                    elem = result;
+                }
+                else
+                {
+                    keep = result->BOOL.value;
+                }
+            }
 
-        for (int i = 0; i < args.size(); i++)
-        {
-            // Remove the arg value here because
-            // it's going to get re-injected in
-            // eval_function_call 
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
 
-            func_copy->FUNCTION.args[i] = nullptr;
+            if (!keep)
+            {
+                continue;
+            }
 
-            if (args[i] != nullptr)
+            if (!fold)
             {
-                flat_args.push_back(eval_node(args[i]));
+                res->LIST.nodes().push_back(elem);
+            }
+            else if (acc == nullptr)
+            {
+                acc = elem;
+            }
+            else if (funcs[end]->type == NodeType::PARTIAL_OP)
+            {
+                auto op = make_pooled_node(*funcs[end]);
+                op->left = acc;
+                op->right = elem;
+                op->type = NodeType::OP;
+                acc = eval_node(op);
+                drop_operands(acc);
+            }
+            else
+            {
+                acc = eval_function_call(funcs[end], {acc, elem});
             }
         }
 
-        return eval_function_call(func_copy, flat_args);
-    }
+        // Reducing nothing reports the same error the builtin does
 
-    if (right->type == NodeType::FUNC_LIST)
-    {
-        std::vector<std::shared_ptr<Node>> args;
-        
-        if (left->type == NodeType::COMMA_LIST)
+        if (fold && acc == nullptr)
         {
-            for (int i = 0; i < left->COMMA_LIST.nodes.size(); i++)
-            {
-                args.push_back(eval_node(left->COMMA_LIST.nodes[i]));
-            }
+            return eval_pipeline_stage(calls[end], funcs[end], res);
         }
-        else
+
+        if (fold)
         {
-            args.push_back(eval_node(left));
+            return acc;
         }
 
-        return eval_function_call(right, args);
+        res->TYPE.allowed_type = get_type(res);
+        value = res;
+        stage = end;
     }
+
+    return value;
 }
 
 // --- END OPERATIONS --- //
 
-std::shared_ptr<Node>& Evaluator::eval_look_up(std::string name)
+Node_Ptr& Evaluator::eval_look_up(const std::string& name, int slot)
 {
-    auto evaluator = std::make_shared<Evaluator>(*this);
+    // Walk the chain of enclosing scopes - each one is a live
+    // evaluator further up the stack, so nothing is copied
 
-    if (symbol_table.find(name) == symbol_table.end())
+    for (Evaluator* scope = this; scope != nullptr; scope = scope->outer_scope)
     {
-        evaluator = outer_scope;
-
-        while (evaluator != nullptr)
+        if (slot >= 0)
         {
-            auto& res = evaluator->eval_look_up(name);
+            auto symbol = scope->symbol_table.find_slot(slot, name);
 
-            if (res->type != NodeType::ERROR)
+            if (symbol != nullptr)
             {
-                return res;
+                return *symbol;
             }
 
-            evaluator = evaluator->outer_scope;
+            continue;
         }
 
-        return error_node;
+        auto symbol = scope->symbol_table.find(name);
+
+        if (symbol != scope->symbol_table.end())
+        {
+            return symbol->second;
+        }
     }
 
-    auto& res = symbol_table[name];
+    return error_node;
+}
 
-    return res;
+Evaluator* Evaluator::global_scope()
+{
+    Evaluator* scope = this;
+
+    while (scope->outer_scope != nullptr)
+    {
+        scope = scope->outer_scope;
+    }
+
+    return scope;
 }
 
-std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::match_function(Node_Ptr function, std::vector<Node_Ptr> args)
 {
-    auto func = std::make_shared<Node>(*function);
+    auto func = make_pooled_node(*function);
 
     if (func->type == NodeType::FUNCTION)
     {
         return func;
     }
 
-    std::vector<std::shared_ptr<Node>> potential_functions;
+    std::vector<Node_Ptr> potential_functions;
 
     if (function->type == NodeType::FUNC_LIST)
     {
-        if (function->FUNC_LIST.nodes.size() == 1)
+        if (function->FUNC_LIST->nodes.size() == 1)
         {
-            func = std::make_shared<Node>(*function->FUNC_LIST.nodes[0]);
+            func = make_pooled_node(*function->FUNC_LIST->nodes[0]);
             return func;
         }
 
         Evaluator tc;
         tc.runtime = runtime;
         tc.builtins_path = builtins_path;
-        tc.outer_scope = std::make_shared<Evaluator>(*this);
+        tc.outer_scope = this;
         tc.line = line;
         tc.column = column;
         tc.file_name = file_name;
-        tc.builtins_names = builtins_names;
 
         int func_num = -1;
 
-        for (auto f : function->FUNC_LIST.nodes)
+        for (auto f : function->FUNC_LIST->nodes)
         {
             func_num++;
 
-            if (args.size() > f->FUNCTION.params.size())
+            if (args.size() > f->FUNCTION->params.size())
             {
                 continue;
             }
@@ -4257,31 +7314,31 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
 
             // Inject closure into symbol table
 
-            for (auto symbol : f->FUNCTION.closure)
+            for (auto symbol : f->FUNCTION->closure)
             {
                 tc.symbol_table[symbol.first] = symbol.second;
             }
 
             for (int i = 0; i < args.size(); i++)
             {
-                auto& param = f->FUNCTION.params[i];
+                auto& param = f->FUNCTION->params[i];
 
                 auto param_type = tc.get_explicit_type(param);
 
-                if (param_type->type == NodeType::PIPE_LIST && param_type->PIPE_LIST.nodes.size() == 1)
+                if (param_type->type == NodeType::PIPE_LIST && param_type->PIPE_LIST->nodes.size() == 1)
                 {
-                    param_type = param_type->PIPE_LIST.nodes[0];
+                    param_type = param_type->PIPE_LIST->nodes[0];
                 }
 
-                if (param_type->type == NodeType::FUNC_LIST && param_type->FUNC_LIST.nodes.size() == 1)
+                if (param_type->type == NodeType::FUNC_LIST && param_type->FUNC_LIST->nodes.size() == 1)
                 {
-                    param_type = param_type->FUNC_LIST.nodes[0];
+                    param_type = param_type->FUNC_LIST->nodes[0];
                 }
 
                 auto arg = tc.eval_node(args[i]);
 
                 if (arg->type == NodeType::ANY 
-                && func_num < function->FUNC_LIST.nodes.size()-1)
+                && func_num < function->FUNC_LIST->nodes.size()-1)
                 {
                     goto next;
                 }
@@ -4292,7 +7349,7 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
                 }
             }
 
-            for (auto& arg : f->FUNCTION.args)
+            for (auto& arg : f->FUNCTION->args)
             {
                 if (arg == nullptr)
                 {
@@ -4305,17 +7362,17 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
                 // if we match on something here, we assign and break
                 // no need to keep looking
 
-                func = std::make_shared<Node>(*f);
+                func = make_pooled_node(*f);
                 return func;
             }
 
-            potential_functions.push_back(std::make_shared<Node>(*f));
+            potential_functions.push_back(make_pooled_node(*f));
 
             next:
 
                 // Remove closure from symbol table
 
-                for (auto symbol : f->FUNCTION.closure)
+                for (auto symbol : f->FUNCTION->closure)
                 {
                     tc.symbol_table.erase(symbol.first);
                 }
@@ -4331,9 +7388,9 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
     {
         std::string potentials;
 
-        for (auto& func : function->FUNC_LIST.nodes)
+        for (auto& func : function->FUNC_LIST->nodes)
         {
-            potentials += func->FUNCTION.name + ": " + func->type_repr() + "\n";
+            potentials += func->FUNCTION->name + ": " + func->type_repr() + "\n";
         }
 
         std::string args_str = "[ ";
@@ -4359,7 +7416,7 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
 
         for (auto& func : potential_functions)
         {
-            potentials += func->FUNCTION.name + ": " + func->type_repr() + "\n";
+            potentials += func->FUNCTION->name + ": " + func->type_repr() + "\n";
         }
 
         error_and_exit("Ambiguous function call - there are " + std::to_string(potential_functions.size()) + " potential functions this call could refer to:\n\n" + potentials);
@@ -4368,78 +7425,83 @@ std::shared_ptr<Node> Evaluator::match_function(std::shared_ptr<Node> function,
     return func;
 }
 
-std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Evaluator::eval_function_call(Node_Ptr function, std::vector<Node_Ptr> args)
 {
     if (function->type != NodeType::FUNCTION && function->type != NodeType::FUNC_LIST)
     {
         error_and_exit("Malformed function call - variable is not a function");
     }
 
-    auto func = std::make_shared<Node>(*function);
+    // Matching arguments to parameters moves line and column to each value
+    // checked, so where the call was made is kept for the body's errors
+
+    int call_line = line;
+    int call_column = column;
+
+    auto func = make_pooled_node(*function);
 
     if (func->type == NodeType::FUNC_LIST)
     {
         func = match_function(function, args);
     }
 
+    // A function the main program defined sits directly on the program's
+    // scope, where its globals and the builtins are found by walking the
+    // chain, so entering it costs only its closure. Other functions carry
+    // everything they captured
+
     Evaluator evaluator;
     evaluator.runtime = runtime;
-    evaluator.builtins_path = builtins_path;
+    evaluator.outer_scope = func->FUNCTION->globals;
     evaluator.line = line;
     evaluator.column = column;
-    evaluator.file_name = file_name + "/" + func->FUNCTION.name;
-    evaluator.builtins_names = builtins_names;
+    evaluator.caller = this;
+    evaluator.file_name = file_name + "/" + func->FUNCTION->name;
 
-    for (auto symbol : symbol_table)
+    if (evaluator.outer_scope == nullptr)
     {
-        if (std::find(builtins_names.begin(), builtins_names.end(), symbol.first) != builtins_names.end())
-        {
-            evaluator.symbol_table[symbol.first] = symbol.second;
-        }
+        evaluator.builtins_path = builtins_path;
     }
 
-    for (auto symbol : func->FUNCTION.closure)
+    auto global = global_scope();
+
+    for (auto symbol : func->FUNCTION->closure)
     {
-        if (symbol.second->type == NodeType::FUNC_LIST)
+        if (evaluator.outer_scope == nullptr && symbol.second->type == NodeType::FUNC_LIST)
         {
-            // check to see if it exists already
-            // if so, we check to see which list has more functions
+            // An overload list from before the function was defined gives
+            // way to a longer one the caller's global scope has since grown
 
-            if (evaluator.symbol_table.find(symbol.first) != evaluator.symbol_table.end())
-            {
-                if (evaluator.symbol_table[symbol.first]->FUNC_LIST.nodes.size() < symbol.second->FUNC_LIST.nodes.size())
-                {
-                    evaluator.symbol_table[symbol.first] = symbol.second;
-                }
-            }
-            else
+            auto current = global->symbol_table.find(symbol.first);
+
+            if (current != global->symbol_table.end() && current->second->type == NodeType::FUNC_LIST
+            &&  current->second->FUNC_LIST->nodes.size() > symbol.second->FUNC_LIST->nodes.size())
             {
-                evaluator.symbol_table[symbol.first] = symbol.second;
+                evaluator.symbol_table[symbol.first] = current->second;
+                continue;
             }
         }
-        else
-        {
-            evaluator.symbol_table[symbol.first] = symbol.second;
-        }
+
+        evaluator.symbol_table[symbol.first] = symbol.second;
     }
 
     for (int i = 0; i < args.size(); i++)
     {
-        if (i >= func->FUNCTION.args.size())
+        if (i >= func->FUNCTION->args.size())
         {
-            error_and_exit("Function '" + func->FUNCTION.name + "' expects " + std::to_string(func->FUNCTION.args.size()) + " arguments, but " + std::to_string(args.size()) + " were provided");
+            error_and_exit("Function '" + func->FUNCTION->name + "' expects " + std::to_string(func->FUNCTION->args.size()) + " arguments, but " + std::to_string(args.size()) + " were provided");
         }
 
-        if (func->FUNCTION.params[i]->OP.op_type == NodeType::TRIPLE_DOT)
+        if (func->FUNCTION->params[i]->OP.op_type == NodeType::TRIPLE_DOT)
         {
-            auto variable_arg = std::make_shared<Node>(NodeType::LIST);
+            auto variable_arg = make_pooled_node(NodeType::LIST);
 
             for (int j = i; j < args.size(); j++)
             {
-                variable_arg->LIST.nodes.push_back(eval_node(args[j]));
+                variable_arg->LIST.nodes().push_back(eval_node(args[j]));
             }
 
-            func->FUNCTION.args[i] = variable_arg;
+            func->FUNCTION->args[i] = variable_arg;
 
             break;
         }
@@ -4452,9 +7514,9 @@ std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> functi
             int index;
             bool match = false;
 
-            for (int p = 0; p < func->FUNCTION.params.size(); p++)
+            for (int p = 0; p < func->FUNCTION->params.size(); p++)
             {
-                auto param = func->FUNCTION.params[p];
+                auto param = func->FUNCTION->params[p];
 
                 if (param->type == NodeType::ID)
                 {
@@ -4478,10 +7540,10 @@ std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> functi
 
             if (!match)
             {
-                error_and_exit("Parameter '" + name + "' does not exist on function '" + func->FUNCTION.name + "'");
+                error_and_exit("Parameter '" + name + "' does not exist on function '" + func->FUNCTION->name + "'");
             }
 
-            func->FUNCTION.args[index] = value;
+            func->FUNCTION->args[index] = value;
         }
         else
         {
@@ -4489,11 +7551,11 @@ std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> functi
             
             while (true)
             {
-                bool arg_is_default = std::find(func->FUNCTION.default_arg_indices.begin(), func->FUNCTION.default_arg_indices.end(), i) != func->FUNCTION.default_arg_indices.end();
+                bool arg_is_default = std::find(func->FUNCTION->default_arg_indices.begin(), func->FUNCTION->default_arg_indices.end(), i) != func->FUNCTION->default_arg_indices.end();
 
-                if (func->FUNCTION.args[i] == nullptr || arg_is_default)
+                if (func->FUNCTION->args[i] == nullptr || arg_is_default)
                 {
-                    func->FUNCTION.args[i] = eval_node(args[current_index]);
+                    func->FUNCTION->args[i] = eval_node(args[current_index]);
                     break;
                 }
                 else
@@ -4504,73 +7566,76 @@ std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> functi
         }
     }
 
-    for (int i = 0; i < func->FUNCTION.args.size(); i++)
+    for (int i = 0; i < func->FUNCTION->args.size(); i++)
     {
-        if (func->FUNCTION.args[i] == nullptr)
+        if (func->FUNCTION->args[i] == nullptr)
         {
             return func;
         }
         else
         {
-            auto param = func->FUNCTION.params[i];
+            auto param = func->FUNCTION->params[i];
             auto param_type = evaluator.get_explicit_type(param);
 
             if (param->type == NodeType::ID)
             {
-                evaluator.symbol_table[param->ID.value] = func->FUNCTION.args[i];
+                evaluator.symbol_table[param->ID.value] = func->FUNCTION->args[i];
             }
             else if (param->OP.op_type == NodeType::EQUAL)
             {
-                evaluator.symbol_table[param->left->ID.value] = func->FUNCTION.args[i];
+                evaluator.symbol_table[param->left->ID.value] = func->FUNCTION->args[i];
             }
             else if (param->OP.op_type == NodeType::TRIPLE_DOT)
             {
-                evaluator.symbol_table[param->right->ID.value] = func->FUNCTION.args[i];
+                evaluator.symbol_table[param->right->ID.value] = func->FUNCTION->args[i];
             }
 
             // Typecheck arg against param type
 
             if (param_type->type == NodeType::FUNCTION)
             {
-                param_type->FUNCTION.is_type = true;
+                param_type->FUNCTION->is_type = true;
             }
 
             Evaluator::Match_Result match;
 
-            if (func->FUNCTION.args[i]->type == NodeType::FUNCTION && func->FUNCTION.args[i]->FUNCTION.is_type)
+            if (func->FUNCTION->args[i]->type == NodeType::FUNCTION && func->FUNCTION->args[i]->FUNCTION->is_type)
             {
-                match = match_types(func->FUNCTION.args[i], param_type);
+                match = match_types(func->FUNCTION->args[i], param_type);
             }
             else
             {
-                match = match_types(param_type, func->FUNCTION.args[i]);
+                match = match_types(param_type, func->FUNCTION->args[i]);
             }
 
             if (!match.result)
             {
-                error_and_exit("[ArgTypeError] Function '" + func->FUNCTION.name + "': Cannot assign value of type '" + func->FUNCTION.args[i]->repr() + "' to parameter of type '" + param_type->repr() + "'. " + match.message);
+                error_and_exit("[ArgTypeError] Function '" + func->FUNCTION->name + "': Cannot assign value of type '" + func->FUNCTION->args[i]->repr() + "' to parameter of type '" + param_type->repr() + "'. " + match.message);
             }
         }
     }
 
-    if (typecheck && !func->FUNCTION.is_type)
+    if (typecheck && !func->FUNCTION->is_type)
     {
-        return func->FUNCTION.return_type;
+        return func->FUNCTION->return_type;
     }
 
-    if (func->FUNCTION.body->type == NodeType::BLOCK)
+    line = call_line;
+    column = call_column;
+
+    if (func->FUNCTION->body->type == NodeType::BLOCK)
     {
-        auto eval_expr = std::make_shared<Node>(NodeType::EMPTY);
+        auto eval_expr = make_pooled_node(NodeType::EMPTY);
 
-        for (auto expr : func->FUNCTION.body->BLOCK.nodes)
+        for (auto expr : func->FUNCTION->body->BLOCK->nodes)
         {
             eval_expr = evaluator.eval_node(expr);
 
             if (eval_expr->type == NodeType::RETURN)
             {
-                if (func->FUNCTION.return_type->type != NodeType::EMPTY)
+                if (func->FUNCTION->return_type->type != NodeType::EMPTY)
                 {
-                    eval_expr->right->TYPE.allowed_type = func->FUNCTION.return_type;
+                    eval_expr->right->TYPE.allowed_type = func->FUNCTION->return_type;
                 }
                 return eval_expr->right;
             }
@@ -4579,25 +7644,25 @@ std::shared_ptr<Node> Evaluator::eval_function_call(std::shared_ptr<Node> functi
         return eval_expr;
     }
 
-    auto res = evaluator.eval_node(func->FUNCTION.body);
+    auto res = evaluator.eval_node(func->FUNCTION->body);
 
-    if (func->FUNCTION.return_type != nullptr && func->FUNCTION.return_type->type != NodeType::EMPTY)
+    if (func->FUNCTION->return_type != nullptr && func->FUNCTION->return_type->type != NodeType::EMPTY)
     {
-        res->TYPE.allowed_type = func->FUNCTION.return_type;
+        res->TYPE.allowed_type = func->FUNCTION->return_type;
     }
     return res;
 }
 
-std::shared_ptr<Node> Evaluator::eval_if_statement(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_if_statement(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
-    auto conditional = eval_node(res->IF_STATEMENT.conditional);
+    auto conditional = eval_node(res->IF_STATEMENT->conditional);
 
     Evaluator if_eval;
     if_eval.runtime = runtime;
     if_eval.file_name = file_name;
-    if_eval.outer_scope = std::make_shared<Evaluator>(*this);
+    if_eval.outer_scope = this;
 
     if (conditional->type != NodeType::BOOL)
     {
@@ -4606,28 +7671,28 @@ std::shared_ptr<Node> Evaluator::eval_if_statement(std::shared_ptr<Node>& node)
 
     if (conditional->BOOL.value)
     {
-        return if_eval.eval_nodes(node->IF_STATEMENT.body->BLOCK.nodes);
+        return if_eval.eval_nodes(node->IF_STATEMENT->body->BLOCK->nodes);
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-std::shared_ptr<Node> Evaluator::eval_if_block(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_if_block(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     Evaluator if_eval;
     if_eval.runtime = runtime;
     if_eval.file_name = file_name;
-    if_eval.outer_scope = std::make_shared<Evaluator>(*this);
+    if_eval.outer_scope = this;
 
-    for (auto _case : res->IF_BLOCK.cases)
+    for (auto _case : res->IF_BLOCK->cases)
     {
         if (_case->OP.op_type != NodeType::COLON)
         {
             if (_case->type == NodeType::BLOCK)
             {
-                return if_eval.eval_nodes(_case->BLOCK.nodes);
+                return if_eval.eval_nodes(_case->BLOCK->nodes);
             }
 
             return if_eval.eval_node(_case);
@@ -4644,7 +7709,7 @@ std::shared_ptr<Node> Evaluator::eval_if_block(std::shared_ptr<Node>& node)
         {
             if (_case->right->type == NodeType::BLOCK)
             {
-                return if_eval.eval_nodes(_case->right->BLOCK.nodes);
+                return if_eval.eval_nodes(_case->right->BLOCK->nodes);
             }
 
             return if_eval.eval_node(_case->right);
@@ -4653,10 +7718,10 @@ std::shared_ptr<Node> Evaluator::eval_if_block(std::shared_ptr<Node>& node)
         if_eval.symbol_table.clear();
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
+bool Evaluator::match_pattern(Node_Ptr a, Node_Ptr b)
 {
     if (a->OP.op_type == NodeType::DOUBLE_DOT)
     {
@@ -4688,42 +7753,42 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
             return false;
         }
 
-        auto left = std::make_shared<Node>(*a);
+        auto left = make_pooled_node(*a);
 
-        if (b->LIST.nodes.size() == 0)
+        if (b->LIST.nodes().size() == 0)
         {
-            return left->LIST.nodes.size() == 0;
+            return left->LIST.nodes().size() == 0;
         }
 
-        if (left->LIST.nodes.size() == 0)
+        if (left->LIST.nodes().size() == 0)
         {
-            return b->LIST.nodes.size() == 0;
+            return b->LIST.nodes().size() == 0;
         }
 
         int a_len = 0;
 
-        for (int i = 0; i < left->LIST.nodes.size(); i++)
+        for (int i = 0; i < left->LIST.nodes().size(); i++)
         {
             int index = i;
 
-            if (i >= b->LIST.nodes.size())
+            if (i >= b->LIST.nodes().size())
             {
                 return false;
             }
 
-            auto elem_a = left->LIST.nodes[i];
+            auto elem_a = left->LIST.nodes()[i];
             if (elem_a->OP.op_type == NodeType::TRIPLE_DOT)
             {
                 auto list = make_list();
 
-                int num_elems_right = (a->LIST.nodes.size()-1) - i;
-                left->LIST.nodes[i] = make_any();
-                list->LIST.nodes.push_back(b->LIST.nodes[index]);
-                int num_to_insert = b->LIST.nodes.size() - num_elems_right-i-1;
+                int num_elems_right = (a->LIST.nodes().size()-1) - i;
+                left->LIST.nodes()[i] = make_any();
+                list->LIST.nodes().push_back(b->LIST.nodes()[index]);
+                int num_to_insert = b->LIST.nodes().size() - num_elems_right-i-1;
                 for (int j = 0; j < num_to_insert; j++)
                 {
-                    left->LIST.nodes.insert(left->LIST.nodes.begin() + i, make_any());
-                    list->LIST.nodes.push_back(b->LIST.nodes[i+j+1]);
+                    left->LIST.nodes().insert(left->LIST.nodes().begin() + i, make_any());
+                    list->LIST.nodes().push_back(b->LIST.nodes()[i+j+1]);
                 }
 
                 if (elem_a->right != nullptr)
@@ -4731,7 +7796,7 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
                     symbol_table[elem_a->right->ID.value] = list;
                 }
 
-                elem_a = left->LIST.nodes[i];
+                elem_a = left->LIST.nodes()[i];
             }
             if (elem_a->type == NodeType::ID)
             {
@@ -4741,16 +7806,16 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
                 }
                 else
                 {
-                    symbol_table[elem_a->ID.value] = b->LIST.nodes[index];
-                    elem_a = b->LIST.nodes[index];
+                    symbol_table[elem_a->ID.value] = b->LIST.nodes()[index];
+                    elem_a = b->LIST.nodes()[index];
                 }
             }
             else if (elem_a->type == NodeType::BLOCK)
             {
-                elem_a = eval_nodes(elem_a->BLOCK.nodes);
+                elem_a = eval_nodes(elem_a->BLOCK->nodes);
             }
 
-            bool match = match_pattern(elem_a, b->LIST.nodes[index]);
+            bool match = match_pattern(elem_a, b->LIST.nodes()[index]);
 
             if (!match)
             {
@@ -4760,7 +7825,7 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
             a_len++;
         }
 
-        if (a_len < b->LIST.nodes.size())
+        if (a_len < b->LIST.nodes().size())
         {
             return false;
         }
@@ -4774,7 +7839,7 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
             return false;
         }
 
-        for (auto prop : a->OBJECT.properties)
+        for (auto prop : a->OBJECT->properties)
         {
             auto value = prop.second.value;
             if (value->type != NodeType::TRIPLE_DOT)
@@ -4784,11 +7849,11 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
 
             // If prop doesn't exist, fail check
 
-            if (b->OBJECT.properties.find(prop.first) == b->OBJECT.properties.end())
+            if (b->OBJECT->properties.find(prop.first) == b->OBJECT->properties.end())
             {
                 return false;
             }
-            auto match = match_pattern(value, b->OBJECT.properties[prop.first].value);
+            auto match = match_pattern(value, b->OBJECT->properties[prop.first].value);
 
             if (!match)
             {
@@ -4806,18 +7871,18 @@ bool Evaluator::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
     return false;
 }
 
-std::shared_ptr<Node> Evaluator::eval_match_block(std::shared_ptr<Node>& node, std::string name)
+Node_Ptr Evaluator::eval_match_block(Node_Ptr& node, std::string name)
 {
-    auto res = std::make_shared<Node>(*node);
-    auto value = eval_node(res->MATCH_BLOCK.value);
+    auto res = make_pooled_node(*node);
+    auto value = eval_node(res->MATCH_BLOCK->value);
     auto type = get_type(value);
 
     if (name == "")
     {
-        name = res->MATCH_BLOCK.value->ID.value;
+        name = res->MATCH_BLOCK->value->ID.value;
     }
 
-    for (auto _case : res->MATCH_BLOCK.cases)
+    for (auto _case : res->MATCH_BLOCK->cases)
     {
         if (_case->OP.op_type != NodeType::COLON)
         {
@@ -4835,11 +7900,11 @@ std::shared_ptr<Node> Evaluator::eval_match_block(std::shared_ptr<Node>& node, s
 
         if (match)
         {
-            std::shared_ptr<Node> res = make_empty();
+            Node_Ptr res = make_empty();
 
             if (_case->right->type == NodeType::BLOCK)
             {
-                res = eval_nodes(_case->right->BLOCK.nodes);
+                res = eval_nodes(_case->right->BLOCK->nodes);
             }
             else
             {
@@ -4848,7 +7913,7 @@ std::shared_ptr<Node> Evaluator::eval_match_block(std::shared_ptr<Node>& node, s
 
             // Cleanup, in case of list pattern with bindings
 
-            for (auto elem : pattern->LIST.nodes)
+            for (auto elem : pattern->LIST.nodes())
             {
                 if (elem->type == NodeType::ID)
                 {
@@ -4866,11 +7931,14 @@ std::shared_ptr<Node> Evaluator::eval_match_block(std::shared_ptr<Node>& node, s
     error_and_exit("Missing match case for type '" + value->repr() + "'");
 }
 
-std::shared_ptr<Node> Evaluator::eval_while_loop(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_while_loop(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
+
+    auto cond_node = node->WHILE_LOOP->conditional;
 
-    auto cond_node = node->WHILE_LOOP.conditional;
+    bool safe_point = loop_safe_point;
+    loop_safe_point = false;
 
     auto cond = eval_node(cond_node);
 
@@ -4882,11 +7950,11 @@ std::shared_ptr<Node> Evaluator::eval_while_loop(std::shared_ptr<Node>& node)
     Evaluator while_eval;
     while_eval.runtime = runtime;
     while_eval.file_name = file_name;
-    while_eval.outer_scope = std::make_shared<Evaluator>(*this);
+    while_eval.outer_scope = this;
 
     while (while_eval.eval_node(cond_node)->BOOL.value)
     {
-        auto expr = while_eval.eval_nodes(node->WHILE_LOOP.body->BLOCK.nodes);
+        auto expr = while_eval.eval_nodes(node->WHILE_LOOP->body->BLOCK->nodes);
 
         if (expr->type == NodeType::BREAK)
         {
@@ -4904,16 +7972,24 @@ std::shared_ptr<Node> Evaluator::eval_while_loop(std::shared_ptr<Node>& node)
         }
 
         while_eval.symbol_table.clear();
+
+        if (safe_point)
+        {
+            Collector::get().safe_point();
+        }
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_for_loop(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
+
+    bool safe_point = loop_safe_point;
+    loop_safe_point = false;
 
-    auto init_list = res->FOR_LOOP.init_list->LIST.nodes;
+    auto init_list = res->FOR_LOOP->init_list->LIST.nodes();
 
     auto iter = eval_node(init_list[0]);
 
@@ -4923,28 +7999,24 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
     }
 
     int begin = 0;
-    int end = 0;
 
-    if (iter->type == NodeType::LIST)
-    {
-        end = iter->LIST.nodes.size();
-    }
-    else
+    if (iter->type == NodeType::RANGE)
     {
         begin = iter->RANGE.start;
-        end = iter->RANGE.end;
     }
 
-    auto body = res->FOR_LOOP.body->BLOCK.nodes;
+    Sequence_Cursor cursor(iter);
+
+    auto body = res->FOR_LOOP->body->BLOCK->nodes;
 
     Evaluator for_eval;
     for_eval.runtime = runtime;
     for_eval.file_name = file_name;
-    for_eval.outer_scope = std::make_shared<Evaluator>(*this);
+    for_eval.outer_scope = this;
 
     if (init_list.size() == 1)
     {
-        for (int i = begin; i < end; i++)
+        for (int i = begin; cursor.next(); i++)
         {
             auto expr = for_eval.eval_nodes(body);
 
@@ -4964,9 +8036,14 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
     if (init_list.size() == 2)
     {
@@ -4978,12 +8055,14 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
         }
 
         auto index_var_name = index_var->ID.value;
-        auto index_node = make_int(0);
 
-        for (int i = begin; i < end; i++)
+        // Each iteration's index is a node of its own, so whatever keeps
+        // hold of it, such as an object made in the body, keeps that
+        // iteration's value
+
+        for (int i = begin; cursor.next(); i++)
         {
-            index_node->INT.value = i;
-            for_eval.symbol_table[index_var_name] = index_node;
+            for_eval.symbol_table[index_var_name] = make_int(i);
 
             auto expr = for_eval.eval_nodes(body);
 
@@ -5003,11 +8082,16 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
         for_eval.symbol_table.erase(index_var_name);
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
     if (init_list.size() == 3)
     {
@@ -5022,15 +8106,15 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
         auto index_var_name = index_var->ID.value;
         auto elem_var_name = elem_var->ID.value;
 
-        for (int i = begin; i < end; i++)
+        for (int i = begin; cursor.next(); i++)
         {
-            auto index_node = std::make_shared<Node>(NodeType::INT);
+            auto index_node = make_pooled_node(NodeType::INT);
             index_node->INT.value = i;
             for_eval.symbol_table[index_var_name] = index_node;
 
             if (iter->type == NodeType::LIST)
             {
-                for_eval.symbol_table[elem_var_name] = iter->LIST.nodes[i];
+                for_eval.symbol_table[elem_var_name] = cursor.value();
             }
             else if (iter->type == NodeType::RANGE)
             {
@@ -5055,16 +8139,21 @@ std::shared_ptr<Node> Evaluator::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
         for_eval.symbol_table.erase(index_var_name);
         for_eval.symbol_table.erase(elem_var_name);
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
 }
 
-std::shared_ptr<Node> Evaluator::get_type(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::get_type(Node_Ptr& node)
 {
     // if (node->TYPE.allowed_type != nullptr && node->TYPE.allowed_type->type != NodeType::TYPE)
     // {
@@ -5073,84 +8162,93 @@ std::shared_ptr<Node> Evaluator::get_type(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::LIST)
     {
-        std::shared_ptr<Node> type = make_pipe_list();
+        Node_Ptr type = make_pipe_list();
         auto type_list = make_list();
 
-        if (node->LIST.nodes.size() == 0)
+        // Every element of a lazy list has the same type
+
+        if (node->LIST.is_stream() || (node->LIST.lazy && node->LIST.size() > 0))
         {
-            type_list->LIST.nodes.push_back(make_any());
+            auto elem = node->LIST.sample();
+            type_list->LIST.nodes().push_back(get_type(elem));
             return type_list;
         }
 
-        for (auto& elem : node->LIST.nodes)
+        if (node->LIST.size() == 0)
         {
-            type->PIPE_LIST.nodes.push_back(get_type(elem));
+            type_list->LIST.nodes().push_back(make_any());
+            return type_list;
+        }
+
+        for (auto& elem : node->LIST.nodes())
+        {
+            type->PIPE_LIST->nodes.push_back(get_type(elem));
         }
 
-        sort_and_unique(type->PIPE_LIST.nodes);
+        sort_and_unique(type->PIPE_LIST->nodes);
 
-        if (type->PIPE_LIST.nodes.size() == 1)
+        if (type->PIPE_LIST->nodes.size() == 1)
         {
-            type = type->PIPE_LIST.nodes[0];
+            type = type->PIPE_LIST->nodes[0];
         }
 
-        type_list->LIST.nodes.push_back(type);
+        type_list->LIST.nodes().push_back(type);
 
         return type_list;
     }
     else if (node->type == NodeType::OBJECT)
     {
         auto type = make_object();
-        type->OBJECT.is_type = true;
+        type->OBJECT->is_type = true;
         type->TYPE.name = node->TYPE.name;
 
-        for (auto& prop : node->OBJECT.properties)
+        for (auto& prop : node->OBJECT->properties)
         {
-            type->OBJECT.properties[prop.first] = Object_Prop(prop.second.required, get_type(prop.second.value));
+            type->OBJECT->properties[prop.first] = Object_Prop(prop.second.required, get_type(prop.second.value));
         }
 
         return type;
     }
     else if (node->type == NodeType::FUNCTION)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->TYPE.is_literal = false;
-        res->FUNCTION.is_type = true;
+        res->FUNCTION->is_type = true;
         return res;
     }
     else if (node->is_type)
     {
-        return std::make_shared<Node>(*node);
+        return make_pooled_node(*node);
     }
     else
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->TYPE.is_literal = false;
         return res;
     }
 }
 
-std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
+Node_Ptr Evaluator::type_node(Node_Ptr node)
 {
     auto returns = make_pipe_list();
 
     Evaluator eval;
     eval.runtime = runtime;
     eval.file_name = file_name;
-    eval.outer_scope = std::make_shared<Evaluator>(*this);
+    eval.outer_scope = this;
     
     if (node->type == NodeType::IF_STATEMENT)
     {
-        auto cond = eval.eval_node(node->IF_STATEMENT.conditional);
+        auto cond = eval.eval_node(node->IF_STATEMENT->conditional);
 
-        for (auto if_expr : node->IF_STATEMENT.body->BLOCK.nodes)
+        for (auto if_expr : node->IF_STATEMENT->body->BLOCK->nodes)
         {
             auto eval_expr = eval.type_node(if_expr);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(expr);
+                    returns->PIPE_LIST->nodes.push_back(expr);
                     break;
                 }
             }
@@ -5158,7 +8256,7 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
     }
     else if (node->type == NodeType::IF_BLOCK)
     {
-        for (auto cond : node->IF_BLOCK.cases)
+        for (auto cond : node->IF_BLOCK->cases)
         {
             if (cond->type == NodeType::OP && cond->OP.op_type == NodeType::COLON)
             {
@@ -5166,7 +8264,7 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
                 auto eval_expr = eval.type_node(cond->right);
                 if (eval_expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(eval_expr->right);
+                    returns->PIPE_LIST->nodes.push_back(eval_expr->right);
                 }
             }
             else
@@ -5174,7 +8272,7 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
                 auto eval_expr = eval.type_node(cond);
                 if (eval_expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(eval_expr->right);
+                    returns->PIPE_LIST->nodes.push_back(eval_expr->right);
                     break;
                 }
             }
@@ -5185,19 +8283,19 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
     else if (node->type == NodeType::FOR_LOOP)
     {    
         auto index_node = make_int(0);
-        auto init_list = node->FOR_LOOP.init_list->LIST.nodes;
+        auto init_list = node->FOR_LOOP->init_list->LIST.nodes();
         auto iter = eval.eval_node(init_list[0]);
         auto item_node = make_int(0);
         if (iter->type == NodeType::LIST)
         {
             auto type = get_type(iter);
-            if (type->LIST.nodes.size() == 0)
+            if (type->LIST.nodes().size() == 0)
             {
                 item_node = make_any();
             }
             else
             {
-                item_node = type->LIST.nodes[0];
+                item_node = type->LIST.nodes()[0];
             }
         }
 
@@ -5211,14 +8309,14 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
             eval.symbol_table[init_list[2]->ID.value] = item_node;
         }
 
-        for (auto for_expr : node->FOR_LOOP.body->BLOCK.nodes)
+        for (auto for_expr : node->FOR_LOOP->body->BLOCK->nodes)
         {
             auto eval_expr = eval.type_node(for_expr);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(expr);
+                    returns->PIPE_LIST->nodes.push_back(expr);
                     break;
                 }
             }
@@ -5226,16 +8324,16 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
     }
     else if (node->type == NodeType::WHILE_LOOP)
     {
-        auto iter = eval.eval_node(node->WHILE_LOOP.conditional);
+        auto iter = eval.eval_node(node->WHILE_LOOP->conditional);
 
-        for (auto while_expr : node->WHILE_LOOP.body->BLOCK.nodes)
+        for (auto while_expr : node->WHILE_LOOP->body->BLOCK->nodes)
         {
             auto eval_expr = type_node(while_expr);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(expr);
+                    returns->PIPE_LIST->nodes.push_back(expr);
                     break;
                 }
             }
@@ -5248,50 +8346,50 @@ std::shared_ptr<Node> Evaluator::type_node(std::shared_ptr<Node> node)
     else
     {
         auto eval_expr = eval_node(node);
-        returns->PIPE_LIST.nodes.push_back(eval_expr);
+        returns->PIPE_LIST->nodes.push_back(eval_expr);
     }
 
     return returns;
 }
 
-std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
+Node_Ptr Evaluator::type_func(Node_Ptr node)
 {
     Evaluator func_eval;
     func_eval.runtime = false;
     func_eval.typecheck = true;
-    func_eval.file_name = file_name + "/" + node->FUNCTION.name;
+    func_eval.file_name = file_name + "/" + node->FUNCTION->name;
 
-    for (auto elem : node->FUNCTION.closure)
+    for (auto elem : node->FUNCTION->closure)
     {
         func_eval.symbol_table[elem.first] = elem.second;
     }
 
-    for (auto param : node->FUNCTION.params) 
+    for (auto param : node->FUNCTION->params) 
     {
         auto arg = get_explicit_type(param);
-        if (arg->type == NodeType::OBJECT && arg->OBJECT.is_type)
+        if (arg->type == NodeType::OBJECT && arg->OBJECT->is_type)
         {
             //error_and_exit("Cannot use literal objects as parameter types.");
             arg = get_type(arg);
         }
         if (arg->type == NodeType::PIPE_LIST)
         {
-            for (auto& t : arg->PIPE_LIST.nodes)
+            for (auto& t : arg->PIPE_LIST->nodes)
             {
-                if (t->type == NodeType::OBJECT && !t->OBJECT.is_type)
+                if (t->type == NodeType::OBJECT && !t->OBJECT->is_type)
                 {
                     error_and_exit("Cannot use literal objects as parameter types.");
                 }
             }
         }
-        if (arg->type == NodeType::FUNCTION && arg->FUNCTION.is_type)
+        if (arg->type == NodeType::FUNCTION && arg->FUNCTION->is_type)
         {
-            arg = get_explicit_type(arg->FUNCTION.params[0]);
+            arg = get_explicit_type(arg->FUNCTION->params[0]);
         }
-        arg->TYPE.allowed_type = std::make_shared<Node>(*arg);
+        arg->TYPE.allowed_type = make_pooled_node(*arg);
         // if (arg->type == NodeType::FUNCTION)
         // {
-        //     arg->FUNCTION.is_type = true;
+        //     arg->FUNCTION->is_type = true;
         // }
         if (param->type == NodeType::ID)
         {
@@ -5307,25 +8405,25 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
         }
     }
 
-    std::vector<std::shared_ptr<Node>> returns;
+    std::vector<Node_Ptr> returns;
 
     int index = 0;
-    int body_size = node->FUNCTION.body->BLOCK.nodes.size();
+    int body_size = node->FUNCTION->body->BLOCK->nodes.size();
     int num_if_exprs = 0;
-    std::shared_ptr<Node> last_expr = make_any();
+    Node_Ptr last_expr = make_any();
 
-    if (node->FUNCTION.body->type != NodeType::BLOCK)
+    if (node->FUNCTION->body->type != NodeType::BLOCK)
     {
         body_size = 1;
 
-        if (node->FUNCTION.body->type == NodeType::IF_STATEMENT || node->FUNCTION.body->type == NodeType::IF_BLOCK)
+        if (node->FUNCTION->body->type == NodeType::IF_STATEMENT || node->FUNCTION->body->type == NodeType::IF_BLOCK)
         {
             num_if_exprs = 1;
-            last_expr = node->FUNCTION.body;
+            last_expr = node->FUNCTION->body;
         }
 
-        auto res = func_eval.type_node(node->FUNCTION.body);
-        for (auto n : res->PIPE_LIST.nodes)
+        auto res = func_eval.type_node(node->FUNCTION->body);
+        for (auto n : res->PIPE_LIST->nodes)
         {
             if (n->type == NodeType::RETURN)
             {
@@ -5333,7 +8431,7 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
             }
             else
             {
-                auto ret = std::make_shared<Node>(NodeType::RETURN);
+                auto ret = make_pooled_node(NodeType::RETURN);
                 ret->right = n;
                 returns.push_back(ret);
             }
@@ -5341,7 +8439,7 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
     }
     else
     {
-        for (auto expr : node->FUNCTION.body->BLOCK.nodes)
+        for (auto expr : node->FUNCTION->body->BLOCK->nodes)
         {
             if (expr->type == NodeType::IF_STATEMENT)
             {
@@ -5353,7 +8451,7 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
                 }
 
                 auto ret = func_eval.type_node(expr);
-                for (auto& n : ret->PIPE_LIST.nodes)
+                for (auto& n : ret->PIPE_LIST->nodes)
                 {
                     returns.push_back(n);
                 }
@@ -5368,7 +8466,7 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
                 }
 
                 auto ret = func_eval.type_node(expr);
-                for (auto& n : ret->PIPE_LIST.nodes)
+                for (auto& n : ret->PIPE_LIST->nodes)
                 {
                     returns.push_back(n);
                 }
@@ -5376,13 +8474,13 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
             else
             {
                 auto eval_expr = func_eval.type_node(expr);
-                for (auto& n : eval_expr->PIPE_LIST.nodes)
+                for (auto& n : eval_expr->PIPE_LIST->nodes)
                 {
                     if (n->type == NodeType::RETURN || index == body_size-1)
                     {
                         if (n->type != NodeType::RETURN)
                         {
-                            auto ret = std::make_shared<Node>(NodeType::RETURN);
+                            auto ret = make_pooled_node(NodeType::RETURN);
                             ret->right = n;
                             returns.push_back(ret);
                             break;
@@ -5400,7 +8498,7 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
 
     if (num_if_exprs == body_size || last_expr->type == NodeType::IF_STATEMENT || last_expr->type == NodeType::IF_BLOCK)
     {
-        auto ret = std::make_shared<Node>(NodeType::RETURN);
+        auto ret = make_pooled_node(NodeType::RETURN);
         ret->right = make_empty();
         returns.push_back(ret);
     }
@@ -5415,46 +8513,46 @@ std::shared_ptr<Node> Evaluator::type_func(std::shared_ptr<Node> node)
         }
         if (res->type == NodeType::ANY)
         {
-            pipe_list->PIPE_LIST.nodes.clear();
-            pipe_list->PIPE_LIST.nodes.push_back(res);
+            pipe_list->PIPE_LIST->nodes.clear();
+            pipe_list->PIPE_LIST->nodes.push_back(res);
             break;
         }
-        pipe_list->PIPE_LIST.nodes.push_back(res);
+        pipe_list->PIPE_LIST->nodes.push_back(res);
     }
 
-    sort_and_unique(pipe_list->PIPE_LIST.nodes);
+    sort_and_unique(pipe_list->PIPE_LIST->nodes);
 
-    if (pipe_list->PIPE_LIST.nodes.size() == 1)
+    if (pipe_list->PIPE_LIST->nodes.size() == 1)
     {
-        pipe_list = pipe_list->PIPE_LIST.nodes[0];
+        pipe_list = pipe_list->PIPE_LIST->nodes[0];
     }
 
-    if (node->FUNCTION.return_type != nullptr)
+    if (node->FUNCTION->return_type != nullptr)
     {
         // check that the actual type matches explicit type
-        auto match = match_types(node->FUNCTION.return_type, pipe_list);
+        auto match = match_types(node->FUNCTION->return_type, pipe_list);
         if (!match.result)
         {
-            error_and_exit("Function '" + node->FUNCTION.name + "' expects to return a value of type '" + node->FUNCTION.return_type->type_repr() + "' but instead returns value of type '" + pipe_list->type_repr() + "'");
+            error_and_exit("Function '" + node->FUNCTION->name + "' expects to return a value of type '" + node->FUNCTION->return_type->type_repr() + "' but instead returns value of type '" + pipe_list->type_repr() + "'");
         }
         
     }
     else
     {
-        node->FUNCTION.return_type = pipe_list;
+        node->FUNCTION->return_type = pipe_list;
     }
 
     auto ret_list = make_pipe_list();
-    auto ret = std::make_shared<Node>(NodeType::RETURN);
+    auto ret = make_pooled_node(NodeType::RETURN);
     ret->right = node;
-    ret_list->PIPE_LIST.nodes.push_back(ret);
+    ret_list->PIPE_LIST->nodes.push_back(ret);
 
-    node->FUNCTION.typechecked = true;
+    node->FUNCTION->typechecked = true;
 
     return ret_list;
 }
 
-std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
+Node_Ptr Evaluator::eval_node(Node_Ptr& node)
 {
     if (node == nullptr)
     {
@@ -5466,23 +8564,23 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::INT || node->type == NodeType::FLOAT || node->type == NodeType::BOOL || node->type == NodeType::STRING || node->type == NodeType::EMPTY)
     {
-        return std::make_shared<Node>(*node);
+        return make_pooled_node(*node);
     }
 
     if (node->type == NodeType::OBJECT)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
 
         if (!res->TYPE.is_literal)
         {
             return res;
         }
 
-        for (auto& prop : res->OBJECT.properties)
+        for (auto& prop : res->OBJECT->properties)
         {
             if (prop.second.value->type == NodeType::FUNCTION)
             {
-                prop.second.value->FUNCTION.closure["this"] = res;
+                prop.second.value->FUNCTION->closure["this"] = res;
             }
 
             prop.second.value = eval_node(prop.second.value);
@@ -5491,9 +8589,9 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         return res;
     }
 
-    if (node->type == NodeType::BLOCK && node->BLOCK.nodes.size() == 0)
+    if (node->type == NodeType::BLOCK && node->BLOCK->nodes.size() == 0)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->type = NodeType::OBJECT;
 
         return res;
@@ -5501,34 +8599,49 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::LIST)
     {
-        auto res = std::make_shared<Node>(*node);
-        res->LIST.nodes.clear();
+        auto res = make_pooled_node(*node);
+
+        // A lazy list makes its elements afresh, so its copy stays lazy. The
+        // rows of a copied table are copies, as the objects of a copied list
+        // would be
+
+        if (res->LIST.lazy)
+        {
+            if (res->LIST.is_table())
+            {
+                res->LIST.table = std::make_shared<Table_Node>(*res->LIST.table);
+            }
+
+            return res;
+        }
+
+        res->LIST.nodes().clear();
 
         // // list comp
 
-        // if (node->LIST.nodes.size() == 1 && node->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+        // if (node->LIST.nodes().size() == 1 && node->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
         // {
-        //     auto pipe_list = node->LIST.nodes[0];
+        //     auto pipe_list = node->LIST.nodes()[0];
 
-        //     auto first_section = eval_node(pipe_list->PIPE_LIST.nodes[0]);
+        //     auto first_section = eval_node(pipe_list->PIPE_LIST->nodes[0]);
 
         //     if (first_section->type != NodeType::LIST)
         //     {
         //         goto list_comp_exit;
         //     }
 
-        //     if (pipe_list->PIPE_LIST.nodes.size() != 2 && pipe_list->PIPE_LIST.nodes.size() != 3)
+        //     if (pipe_list->PIPE_LIST->nodes.size() != 2 && pipe_list->PIPE_LIST->nodes.size() != 3)
         //     {
         //         error_and_exit("List comprehension requires 2 or 3 pipe separated arguments");
         //     }
 
-        //     auto list = eval_node(pipe_list->PIPE_LIST.nodes[0]);
-        //     auto func = eval_node(pipe_list->PIPE_LIST.nodes[1]);
-        //     auto cond_func = std::make_shared<Node>(NodeType::EMPTY);
+        //     auto list = eval_node(pipe_list->PIPE_LIST->nodes[0]);
+        //     auto func = eval_node(pipe_list->PIPE_LIST->nodes[1]);
+        //     auto cond_func = make_pooled_node(NodeType::EMPTY);
 
-        //     if (pipe_list->PIPE_LIST.nodes.size() == 3)
+        //     if (pipe_list->PIPE_LIST->nodes.size() == 3)
         //     {
-        //         cond_func = eval_node(pipe_list->PIPE_LIST.nodes[2]);
+        //         cond_func = eval_node(pipe_list->PIPE_LIST->nodes[2]);
         //     }
 
         //     if (list->type != NodeType::LIST)
@@ -5538,9 +8651,9 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
         //     if (func->type == NodeType::PIPE_LIST)
         //     {
-        //         if (func->PIPE_LIST.nodes.size() == 1)
+        //         if (func->PIPE_LIST->nodes.size() == 1)
         //         {
-        //             func = func->PIPE_LIST.nodes[0];
+        //             func = func->PIPE_LIST->nodes[0];
         //         }
         //         else
         //         {
@@ -5553,12 +8666,12 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         //         error_and_exit("Second element of list comprehension needs to be a function with a single basic parameter");
         //     }
 
-        //     if (func->FUNCTION.params.size() != 1)
+        //     if (func->FUNCTION->params.size() != 1)
         //     {
         //         error_and_exit("Second element of list comprehension needs to be a function with a single basic parameter");
         //     }
 
-        //     if(func->FUNCTION.params[0]->type != NodeType::ID)
+        //     if(func->FUNCTION->params[0]->type != NodeType::ID)
         //     {
         //         error_and_exit("Second element of list comprehension needs to be a function with a single basic parameter");
         //     }
@@ -5567,9 +8680,9 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         //     {
         //         if (cond_func->type == NodeType::PIPE_LIST)
         //         {
-        //             if (cond_func->PIPE_LIST.nodes.size() == 1)
+        //             if (cond_func->PIPE_LIST->nodes.size() == 1)
         //             {
-        //                 cond_func = cond_func->PIPE_LIST.nodes[0];
+        //                 cond_func = cond_func->PIPE_LIST->nodes[0];
         //             }
         //             else
         //             {
@@ -5581,18 +8694,18 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         //             error_and_exit("Third element of list comprehension needs to be a function with a single basic parameter");
         //         }
 
-        //         if (cond_func->FUNCTION.params.size() != 1)
+        //         if (cond_func->FUNCTION->params.size() != 1)
         //         {
         //             error_and_exit("Third element of list comprehension needs to be a function with a single basic parameter");
         //         }
 
-        //         if(cond_func->FUNCTION.params[0]->type != NodeType::ID)
+        //         if(cond_func->FUNCTION->params[0]->type != NodeType::ID)
         //         {
         //             error_and_exit("Third element of list comprehension needs to be a function with a single basic parameter");
         //         }
         //     }
 
-        //     auto id = func->FUNCTION.params[0];
+        //     auto id = func->FUNCTION->params[0];
 
         //     Evaluator evaluator;
         //     evaluator.runtime = runtime;
@@ -5605,10 +8718,10 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         //         evaluator.symbol_table[symbol.first] = symbol.second;
         //     }
 
-        //     for (int i = 0; i < list->LIST.nodes.size(); i++)
+        //     for (int i = 0; i < list->LIST.nodes().size(); i++)
         //     {
-        //         evaluator.symbol_table[id->ID.value] = list->LIST.nodes[i];
-        //         auto result = func->FUNCTION.body->type == NodeType::BLOCK ? evaluator.eval_nodes(func->FUNCTION.body->BLOCK.nodes) : evaluator.eval_node(func->FUNCTION.body);
+        //         evaluator.symbol_table[id->ID.value] = list->LIST.nodes()[i];
+        //         auto result = func->FUNCTION->body->type == NodeType::BLOCK ? evaluator.eval_nodes(func->FUNCTION->body->BLOCK->nodes) : evaluator.eval_node(func->FUNCTION->body);
 
         //         if (cond_func->type == NodeType::EMPTY)
         //         {
@@ -5617,19 +8730,19 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
         //             if (result->type == NodeType::LIST)
         //             {
-        //                 res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+        //                 res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
         //             }
         //             else
         //             {
-        //                 res->LIST.nodes.push_back(result);
+        //                 res->LIST.nodes().push_back(result);
         //             }
         //         }
         //         else
         //         {
-        //             auto cond_id = cond_func->FUNCTION.params[0];
+        //             auto cond_id = cond_func->FUNCTION->params[0];
 
-        //             evaluator.symbol_table[cond_id->ID.value] = list->LIST.nodes[i];
-        //             auto cond_result = cond_func->FUNCTION.body->type == NodeType::BLOCK ? evaluator.eval_nodes(cond_func->FUNCTION.body->BLOCK.nodes) : evaluator.eval_node(cond_func->FUNCTION.body);
+        //             evaluator.symbol_table[cond_id->ID.value] = list->LIST.nodes()[i];
+        //             auto cond_result = cond_func->FUNCTION->body->type == NodeType::BLOCK ? evaluator.eval_nodes(cond_func->FUNCTION->body->BLOCK->nodes) : evaluator.eval_node(cond_func->FUNCTION->body);
 
         //             if (cond_result->type == NodeType::RETURN)
         //             {
@@ -5643,11 +8756,11 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
         //                 if (result->type == NodeType::LIST)
         //                 {
-        //                     res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+        //                     res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
         //                 }
         //                 else
         //                 {
-        //                     res->LIST.nodes.push_back(result);
+        //                     res->LIST.nodes().push_back(result);
         //                 }
         //             }
         //         }
@@ -5659,9 +8772,9 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
         // list_comp_exit:
 
-        for (auto elem : node->LIST.nodes)
+        for (auto elem : node->LIST.nodes())
         {
-            res->LIST.nodes.push_back(eval_node(elem));
+            res->LIST.nodes().push_back(eval_node(elem));
         }
 
         return res;
@@ -5669,12 +8782,12 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::COMMA_LIST)
     {
-        auto res = std::make_shared<Node>(*node);
-        res->COMMA_LIST.nodes.clear();
+        auto res = make_pooled_node(*node);
+        res->COMMA_LIST->nodes.clear();
 
-        for (auto elem : node->COMMA_LIST.nodes)
+        for (auto elem : node->COMMA_LIST->nodes)
         {
-            res->COMMA_LIST.nodes.push_back(eval_node(elem));
+            res->COMMA_LIST->nodes.push_back(eval_node(elem));
         }
 
         return res;
@@ -5682,12 +8795,12 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::PIPE_LIST)
     {
-        auto res = std::make_shared<Node>(*node);
-        res->PIPE_LIST.nodes.clear();
+        auto res = make_pooled_node(*node);
+        res->PIPE_LIST->nodes.clear();
 
-        for (auto elem : node->PIPE_LIST.nodes)
+        for (auto elem : node->PIPE_LIST->nodes)
         {
-            res->PIPE_LIST.nodes.push_back(eval_node(elem));
+            res->PIPE_LIST->nodes.push_back(eval_node(elem));
         }
 
         return res;
@@ -5695,7 +8808,7 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::ID)
     {
-        auto& var = eval_look_up(node->ID.value);
+        auto& var = eval_look_up(node->ID.value, node->ID.slot);
 
         if (var->type == NodeType::ERROR)
         {
@@ -5706,7 +8819,7 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
                 auto val = make_object();
                 val->TYPE.allowed_type = type;
                 val->TYPE.name = node->ID.value;
-                val->OBJECT.is_type = true;
+                val->OBJECT->is_type = true;
 
                 symbol_table[node->ID.value] = val;
                 return val;
@@ -5715,14 +8828,14 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
             error_and_exit("Undefined variable '" + node->ID.value + "'");
         }
 
-        if (var->type == NodeType::PIPE_LIST && var->PIPE_LIST.nodes.size() == 1)
+        if (var->type == NodeType::PIPE_LIST && var->PIPE_LIST->nodes.size() == 1)
         {
-            return var->PIPE_LIST.nodes[0];
+            return var->PIPE_LIST->nodes[0];
         }
 
-        if (var->type == NodeType::FUNC_LIST && var->FUNC_LIST.nodes.size() == 1)
+        if (var->type == NodeType::FUNC_LIST && var->FUNC_LIST->nodes.size() == 1)
         {
-            return var->FUNC_LIST.nodes[0];
+            return var->FUNC_LIST->nodes[0];
         }
 
         return var;
@@ -5793,15 +8906,25 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
         {
             return eval_equal(node);
         }
+        if (node->OP.op_type == NodeType::PLUS_EQ && node->left->type == NodeType::ID)
+        {
+            auto& var = eval_look_up(node->left->ID.value, node->left->ID.slot);
+
+            if (can_append(node, var))
+            {
+                return eval_append(node, var, eval_node(node->right));
+            }
+        }
+
         if (node->OP.op_type == NodeType::PLUS_EQ || node->OP.op_type == NodeType::MINUS_EQ)
         {
-            auto op_node = std::make_shared<Node>(NodeType::OP);
+            auto op_node = make_pooled_node(NodeType::OP);
             op_node->left = eval_node(node->left);
             op_node->right = eval_node(node->right);
 
             auto op_res = node->OP.op_type == NodeType::PLUS_EQ ? eval_add(op_node) : eval_sub(op_node);
 
-            auto equal_node = std::make_shared<Node>(NodeType::OP);
+            auto equal_node = make_pooled_node(NodeType::OP);
             equal_node->left = node->left;
             equal_node->right = op_res;
 
@@ -5815,24 +8938,24 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
     {
         Evaluator evaluator;
         evaluator.runtime = runtime;
-        evaluator.outer_scope = std::make_shared<Evaluator>(*this);
+        evaluator.outer_scope = this;
         evaluator.line = line;
         evaluator.column = column;
         evaluator.file_name = file_name;
-        evaluator.nodes = node->BLOCK.nodes;
+        evaluator.nodes = node->BLOCK->nodes;
 
         evaluator.evaluate();
 
         if (evaluator.nodes.size() == 0)
         {
-            return std::make_shared<Node>(NodeType::EMPTY);
+            return make_pooled_node(NodeType::EMPTY);
         }
 
         return evaluator.nodes[evaluator.nodes.size()-1];
     }
     if (node->type == NodeType::FUNCTION)
     {
-        for (auto& arg : node->FUNCTION.args)
+        for (auto& arg : node->FUNCTION->args)
         {
             if (arg != nullptr)
             {
@@ -5840,7 +8963,7 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
             }
         }
 
-        for (auto& param : node->FUNCTION.params)
+        for (auto& param : node->FUNCTION->params)
         {
             if (param->type == NodeType::ID)
             {
@@ -5855,7 +8978,7 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
                 if (param->ID.value == "__type")
                 {
-                    node->FUNCTION.is_type = true;
+                    node->FUNCTION->is_type = true;
                 }
             }
             else if (param->type == NodeType::EQUAL)
@@ -5882,52 +9005,99 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
             }
         }
 
-        for (auto symbol : symbol_table)
+        // Calls reach the main program's global scope through the scope
+        // chain, so a function defined there captures only what the global
+        // scope does not already hold. Anything captured earlier under a
+        // name the global scope holds, as the typechecker does on the same
+        // node, would hide the global, so it is dropped
+
+        auto global = global_scope();
+        bool shared = global->main_scope;
+
+        if (shared)
         {
-            node->FUNCTION.closure[symbol.first] = symbol.second;
+            node->FUNCTION->globals = global;
+
+            auto& closure = node->FUNCTION->closure;
+
+            for (auto symbol = closure.begin(); symbol != closure.end();)
+            {
+                if (global->symbol_table.find(symbol->first) != global->symbol_table.end())
+                {
+                    symbol = closure.erase(symbol);
+                }
+                else
+                {
+                    symbol++;
+                }
+            }
         }
 
-        if (node->FUNCTION.closure.find(node->FUNCTION.name) != node->FUNCTION.closure.end())
+        if (!shared || global != this)
         {
-            if (node->FUNCTION.closure[node->FUNCTION.name]->type == NodeType::FUNC_LIST)
+            for (auto symbol : symbol_table)
             {
-                node->FUNCTION.closure[node->FUNCTION.name] = std::make_shared<Node>(*node->FUNCTION.closure[node->FUNCTION.name]);
-                node->FUNCTION.closure[node->FUNCTION.name]->FUNC_LIST.nodes.push_back(node);
+                if (shared)
+                {
+                    auto current = global->symbol_table.find(symbol.first);
+
+                    if (current != global->symbol_table.end() && current->second == symbol.second)
+                    {
+                        continue;
+                    }
+                }
+
+                node->FUNCTION->closure[symbol.first] = symbol.second;
             }
         }
-        else
+
+        // A function whose name the global scope holds finds itself, and
+        // any overloads of it, there too
+
+        if (!shared || global->symbol_table.find(node->FUNCTION->name) == global->symbol_table.end())
         {
-            node->FUNCTION.closure[node->FUNCTION.name] = node;
+            if (node->FUNCTION->closure.find(node->FUNCTION->name) != node->FUNCTION->closure.end())
+            {
+                if (node->FUNCTION->closure[node->FUNCTION->name]->type == NodeType::FUNC_LIST)
+                {
+                    node->FUNCTION->closure[node->FUNCTION->name] = make_pooled_node(*node->FUNCTION->closure[node->FUNCTION->name]);
+                    node->FUNCTION->closure[node->FUNCTION->name]->FUNC_LIST->nodes.push_back(node);
+                }
+            }
+            else
+            {
+                node->FUNCTION->closure[node->FUNCTION->name] = node;
+            }
         }
 
-        if (typecheck && node->FUNCTION.is_type)
+        if (typecheck && node->FUNCTION->is_type)
         {
-            return get_explicit_type(node->FUNCTION.params[0]);
+            return get_explicit_type(node->FUNCTION->params[0]);
         }
     }
     if (node->type == NodeType::FUNC_CALL)
     {
-        auto func_name = node->FUNC_CALL.name;
+        auto func_name = node->FUNC_CALL->name;
 
         // Built-in functions
 
         if (builtin_functions.find(func_name) != builtin_functions.end())
         {
             auto func = builtin_functions[func_name];
-            return (this->*func)(node->FUNC_CALL.args);
+            return (this->*func)(node->FUNC_CALL->args);
         }
 
-        auto func = eval_look_up(func_name);
+        auto func = eval_look_up(func_name, node->FUNC_CALL->slot);
 
         if (func->type == NodeType::ERROR)
         {
-            if (node->FUNC_CALL.caller->type == NodeType::FUNCTION)
+            if (node->FUNC_CALL->caller->type == NodeType::FUNCTION)
             {
-                func = eval_node(node->FUNC_CALL.caller);
+                func = eval_node(node->FUNC_CALL->caller);
             }
-            else if (node->FUNC_CALL.caller->OP.op_type == NodeType::DOT)
+            else if (node->FUNC_CALL->caller->OP.op_type == NodeType::DOT)
             {
-                func = eval_node(node->FUNC_CALL.caller);
+                func = eval_node(node->FUNC_CALL->caller);
             }
             else
             {
@@ -5935,7 +9105,7 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
             }
         }
 
-        return eval_function_call(func, node->FUNC_CALL.args);
+        return eval_function_call(func, node->FUNC_CALL->args);
     }
     if (node->type == NodeType::IF_STATEMENT)
     {
@@ -5960,17 +9130,17 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::KEYWORD && node->ID.value == "break")
     {
-        auto res = std::make_shared<Node>(NodeType::BREAK);
+        auto res = make_pooled_node(NodeType::BREAK);
         return res;
     }
     if (node->type == NodeType::KEYWORD && node->ID.value == "continue")
     {
-        auto res = std::make_shared<Node>(NodeType::CONTINUE);
+        auto res = make_pooled_node(NodeType::CONTINUE);
         return res;
     }
     if (node->type == NodeType::KEYWORD && node->ID.value == "ret")
     {
-        auto res = std::make_shared<Node>(NodeType::RETURN);
+        auto res = make_pooled_node(NodeType::RETURN);
         res->right = eval_node(node->right);
         return res;
     }
@@ -5978,9 +9148,9 @@ std::shared_ptr<Node> Evaluator::eval_node(std::shared_ptr<Node>& node)
     return node;
 }
 
-std::shared_ptr<Node> Evaluator::eval_nodes(std::vector<std::shared_ptr<Node>> nodes)
+Node_Ptr Evaluator::eval_nodes(std::vector<Node_Ptr> nodes)
 {
-    auto eval_expr = std::make_shared<Node>(NodeType::EMPTY);
+    auto eval_expr = make_pooled_node(NodeType::EMPTY);
 
     for (auto expr : nodes)
     {
@@ -6011,8 +9181,26 @@ void Evaluator::evaluate()
 
         line = node->line;
         column = node->column;
+
+        loop_safe_point = collect_cycles && (node->type == NodeType::FOR_LOOP || node->type == NodeType::WHILE_LOOP);
         auto res = eval_node(node);
+        loop_safe_point = false;
+
+        if (collect_cycles)
+        {
+            Collector::get().safe_point();
+        }
+    }
+}
+
+void Evaluator::error_at_call(std::string message)
+{
+    if (caller != nullptr)
+    {
+        caller->error_and_exit(message);
     }
+
+    error_and_exit(message);
 }
 
 void Evaluator::error_and_exit(std::string message)
@@ -6020,6 +9208,7 @@ void Evaluator::error_and_exit(std::string message)
     std::string type = "Runtime";
 
     std::string error_message = "\n\n" + type + " Error in '" + file_name + "' @ (" + std::to_string(line) + ", " + std::to_string(column) + "): " + message;
+    Output::get().flush();
 	std::cout << error_message << "\n";
 
     if (outer_scope != nullptr)
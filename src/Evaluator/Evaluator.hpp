@@ -7,7 +7,59 @@
 #include <cctype>
 #include <numeric>
 #include "../Parser/Parser.hpp"
+#include "../Node/Pool.hpp"
 #include "../Typechecker/Typechecker.hpp"
+#include "../Resolver/Resolver.hpp"
+#include "../Collector/Collector.hpp"
+#include "../CSV_Reader/CSV_Reader.hpp"
+#include "../Aggregate/Aggregate.hpp"
+#include "../Group_Index/Group_Index.hpp"
+#include "../Sort_Keys/Sort_Keys.hpp"
+#include "../JSON_Codec/JSON_Codec.hpp"
+#include "../Output/Output.hpp"
+#include "../Mapped_File/Mapped_File.hpp"
+
+// The bindings of one scope. Lookups by name hash as usual, lookups by the
+// slot the Resolver gave an identifier go through a small direct-mapped
+// array of pointers into the table instead. Erasing or clearing bumps the
+// epoch, which drops every cached slot at once; inserting only invalidates
+// cached misses
+
+class Symbol_Table
+{
+    struct Slot
+    {
+        int slot = -1;
+        size_t epoch = 0;
+        size_t size = 0;
+        Node_Ptr* value = nullptr;
+    };
+
+    static const int num_cached = 16;
+
+    std::unordered_map<std::string, Node_Ptr> table;
+    Slot cache[num_cached];
+    size_t epoch = 1;
+
+public:
+
+    using iterator = std::unordered_map<std::string, Node_Ptr>::iterator;
+
+    Symbol_Table() {}
+    Symbol_Table(const Symbol_Table& other) : table(other.table) {}
+    Symbol_Table& operator=(const Symbol_Table& other);
+
+    Node_Ptr& operator[](const std::string& name) { return table[name]; }
+    iterator find(const std::string& name) { return table.find(name); }
+    iterator begin() { return table.begin(); }
+    iterator end() { return table.end(); }
+    size_t size() { return table.size(); }
+
+    void erase(const std::string& name);
+    void clear();
+
+    Node_Ptr* find_slot(int slot, const std::string& name);
+};
 
 class Evaluator
 {
@@ -15,76 +67,130 @@ class Evaluator
 public:
 
     std::string file_name;
-    std::unordered_map<std::string, std::shared_ptr<Node>> symbol_table;
-    std::shared_ptr<Evaluator> outer_scope = nullptr;
+    Symbol_Table symbol_table;
+    Evaluator* outer_scope = nullptr;
     int line, column;
 
+    // The evaluator a function call was made from, while the call runs
+    Evaluator* caller = nullptr;
+
     Evaluator() {}
-    Evaluator(std::string file_name, std::vector<std::shared_ptr<Node>> nodes) : file_name(file_name), nodes(nodes) {}
+    Evaluator(std::string file_name, std::vector<Node_Ptr> nodes) : file_name(file_name), nodes(nodes) {}
 
-    std::vector<std::shared_ptr<Node>> nodes;
+    std::vector<Node_Ptr> nodes;
 
     std::string builtins_path;
 
     bool runtime = true;
     bool typecheck = false;
 
-    std::shared_ptr<Node> eval_node(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_nodes(std::vector<std::shared_ptr<Node>> nodes);
-
-    std::shared_ptr<Node> eval_add(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_sub(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_mul(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_div(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_mod(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_dot(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_double_dot(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_pos_neg(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_not(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_and_or(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_equality(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_equal(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_double_arrow(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_if_statement(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_if_block(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_match_block(std::shared_ptr<Node>& node, std::string name="");
-    std::shared_ptr<Node> eval_while_loop(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_for_loop(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_copy(std::shared_ptr<Node>& node);
-
-    std::shared_ptr<Node> eval_function_call(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args);
-
-    std::shared_ptr<Node> builtin_exit(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_error(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_range(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_print(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_delete(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_time(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_import(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_read(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_write(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_append(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_int(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_float(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_string(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_type(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_shape(std::vector<std::shared_ptr<Node>> args);
-
-    void sort_and_unique(std::vector<std::shared_ptr<Node>>& list);
-    std::shared_ptr<Node> get_explicit_type(std::shared_ptr<Node>& node);
-
-    bool compare(const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs);
-    std::shared_ptr<Node> match_function(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> get_type(std::shared_ptr<Node>& node);
-
-    std::shared_ptr<Node> type_func(std::shared_ptr<Node> node);
-    std::shared_ptr<Node> type_node(std::shared_ptr<Node> node);
+    // Set on the main program's evaluator: its statement boundaries, and
+    // the iterations of its top-level loops, are safe points for the
+    // cycle collector
+    bool collect_cycles = false;
+    bool loop_safe_point = false;
+
+    // Set on the main program's evaluator, which outlives every function
+    // the program defines. Those functions find its globals and builtins
+    // through the scope chain rather than capturing them. A module's
+    // evaluator ends with the import, so its functions keep their closures
+    bool main_scope = false;
+
+    Node_Ptr eval_node(Node_Ptr& node);
+    Node_Ptr eval_nodes(std::vector<Node_Ptr> nodes);
+
+    Node_Ptr eval_add(Node_Ptr& node);
+    Node_Ptr eval_sub(Node_Ptr& node);
+    Node_Ptr eval_mul(Node_Ptr& node);
+    Node_Ptr eval_div(Node_Ptr& node);
+    Node_Ptr eval_mod(Node_Ptr& node);
+    Node_Ptr eval_dot(Node_Ptr& node);
+    Node_Ptr eval_double_dot(Node_Ptr& node);
+    Node_Ptr eval_pos_neg(Node_Ptr& node);
+    Node_Ptr eval_not(Node_Ptr& node);
+    Node_Ptr eval_and_or(Node_Ptr& node);
+    Node_Ptr eval_equality(Node_Ptr& node);
+    Node_Ptr eval_equal(Node_Ptr& node);
+    Node_Ptr eval_assign(Node_Ptr& node, Node_Ptr& var, Node_Ptr value);
+    bool can_append(Node_Ptr& node, Node_Ptr& var);
+    Node_Ptr eval_append(Node_Ptr& node, Node_Ptr& var, Node_Ptr piece);
+    Node_Ptr eval_double_arrow(Node_Ptr& node);
+    bool is_pipeline_stage(Node_Ptr& node);
+    Node_Ptr eval_pipeline(Node_Ptr& node);
+    Node_Ptr eval_pipeline_stage(Node_Ptr& call, Node_Ptr& func, Node_Ptr value);
+    Node_Ptr eval_if_statement(Node_Ptr& node);
+    Node_Ptr eval_if_block(Node_Ptr& node);
+    Node_Ptr eval_match_block(Node_Ptr& node, std::string name="");
+    Node_Ptr eval_while_loop(Node_Ptr& node);
+    Node_Ptr eval_for_loop(Node_Ptr& node);
+    Node_Ptr eval_copy(Node_Ptr& node);
+
+    Node_Ptr eval_function_call(Node_Ptr function, std::vector<Node_Ptr> args);
+
+    Node_Ptr builtin_exit(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_error(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_range(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_print(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_delete(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_time(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_import(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_read(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_lines(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_parse(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_stringify(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_read(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_each(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ndjson_lines(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ndjson_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_csv_load(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_column(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_group_rows(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_summarize(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_join(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_index(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_lookup(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ref(std::vector<Node_Ptr> args);
+    size_t join_rows(Node_Ptr& data, const std::string& name);
+    Node_Ptr builtin_reshape(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_extract(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_aggregate(std::vector<Node_Ptr> args);
+    bool gather_numbers(Node_Ptr& data, const std::string* column, Aggregate& numbers);
+    Node_Ptr reduce_numbers(Node_Ptr& list);
+    Node_Ptr call_schema_function(const std::string& name, Node_Ptr& function, std::vector<Node_Ptr> args);
+    void set_row_property(Node_Ptr& row, const std::string& name, Node_Ptr value);
+    Node_Ptr builtin_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_append(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_flush(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_close(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_open(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_file_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_int(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_float(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_string(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_type(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_shape(std::vector<Node_Ptr> args);
+
+    void sort_and_unique(std::vector<Node_Ptr>& list);
+    Node_Ptr get_explicit_type(Node_Ptr& node);
+
+    bool compare(const Node_Ptr &lhs, const Node_Ptr &rhs);
+    std::vector<size_t> sort_order(const std::vector<Node_Ptr>& keys, bool stable, bool descending, size_t limit);
+    void reorder(std::vector<Node_Ptr>& elements, const std::vector<size_t>& order);
+    Node_Ptr sort_by_column(Node_Ptr& list, const std::string& name, bool descending);
+    Node_Ptr make_slice(Node_Ptr& source, size_t begin, size_t length);
+    Node_Ptr match_function(Node_Ptr function, std::vector<Node_Ptr> args);
+    Node_Ptr get_type(Node_Ptr& node);
+
+    Node_Ptr type_func(Node_Ptr node);
+    Node_Ptr type_node(Node_Ptr node);
 
     void init(std::string builtins_path);
     std::vector<std::string> builtins_names;
     void evaluate();
 
-    std::shared_ptr<Node>& eval_look_up(std::string name);
+    Node_Ptr& eval_look_up(const std::string& name, int slot = -1);
+    Evaluator* global_scope();
 
     // Dynamic Typing
 
@@ -94,21 +200,25 @@ public:
         std::string message;
     };
 
-    Match_Result match_types(std::shared_ptr<Node> a, std::shared_ptr<Node> b, bool match_name = true);
-    Match_Result match_values(std::shared_ptr<Node> a, std::shared_ptr<Node> b);
-    bool match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b);
+    Match_Result match_types(Node_Ptr a, Node_Ptr b, bool match_name = true);
+    Match_Result match_values(Node_Ptr a, Node_Ptr b);
+    bool match_pattern(Node_Ptr a, Node_Ptr b);
 
     // Node Helpers
-    std::shared_ptr<Node> make_int(long long value, bool literal = true);
-    std::shared_ptr<Node> make_float(double value, bool literal = true);
-    std::shared_ptr<Node> make_string(std::string value, bool literal = true);
-    std::shared_ptr<Node> make_bool(bool value, bool literal = true);
-    std::shared_ptr<Node> make_empty(bool literal = true);
-    std::shared_ptr<Node> make_any(bool literal = true);
-    std::shared_ptr<Node> make_list(bool literal = true);
-    std::shared_ptr<Node> make_pipe_list(bool literal = true);
-    std::shared_ptr<Node> make_object(bool literal = true);
-    std::shared_ptr<Node> make_function(bool literal = true);
+    Node_Ptr make_int(long long value, bool literal = true);
+    Node_Ptr make_float(double value, bool literal = true);
+    Node_Ptr make_string(std::string value, bool literal = true);
+    Node_Ptr make_bool(bool value, bool literal = true);
+    Node_Ptr make_empty(bool literal = true);
+    Node_Ptr make_any(bool literal = true);
+    Node_Ptr make_list(bool literal = true);
+    Node_Ptr make_pipe_list(bool literal = true);
+    Node_Ptr make_object(bool literal = true);
+    Node_Ptr make_function(bool literal = true);
 
     void error_and_exit(std::string message);
+
+    // For a native helper behind a library function, as csv.load is, whose
+    // errors belong at the line that called the library function
+    void error_at_call(std::string message);
 };
\ No newline at end of file
@@ -0,0 +1,232 @@
+#include <cstring>
+#include <cmath>
+#include "Group_Index.hpp"
+
+Group_Index::Group_Index(size_t values) : width(values * 2)
+{
+    slots.resize(16);
+    mask = 15;
+}
+
+uint64_t Group_Index::hash(const uint64_t* key) const
+{
+    uint64_t h = 0x9E3779B97F4A7C15ull;
+
+    for (size_t i = 0; i < width; i++)
+    {
+        h ^= key[i];
+        h *= 0xFF51AFD7ED558CCDull;
+        h ^= h >> 32;
+    }
+
+    return h;
+}
+
+void Group_Index::grow()
+{
+    slots.assign(slots.size() * 2, 0);
+    mask = slots.size() - 1;
+
+    for (size_t group = 0; group < hashes.size(); group++)
+    {
+        size_t slot = hashes[group] & mask;
+
+        while (slots[slot] != 0)
+        {
+            slot = (slot + 1) & mask;
+        }
+
+        slots[slot] = group + 1;
+    }
+}
+
+size_t Group_Index::find_or_add(const uint64_t* key)
+{
+    uint64_t h = hash(key);
+    size_t slot = h & mask;
+
+    while (slots[slot] != 0)
+    {
+        size_t group = slots[slot] - 1;
+
+        if (hashes[group] == h && std::memcmp(&keys[group * width], key, width * sizeof(uint64_t)) == 0)
+        {
+            return group;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    size_t group = hashes.size();
+
+    hashes.push_back(h);
+    keys.insert(keys.end(), key, key + width);
+    slots[slot] = group + 1;
+
+    if (hashes.size() * 2 > slots.size())
+    {
+        grow();
+    }
+
+    return group;
+}
+
+long long Group_Index::find(const uint64_t* key) const
+{
+    uint64_t h = hash(key);
+    size_t slot = h & mask;
+
+    while (slots[slot] != 0)
+    {
+        size_t group = slots[slot] - 1;
+
+        if (hashes[group] == h && std::memcmp(&keys[group * width], key, width * sizeof(uint64_t)) == 0)
+        {
+            return group;
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return -1;
+}
+
+// --- Key_Encoder --- //
+
+uint64_t Key_Encoder::intern(const std::string& value)
+{
+    auto id = ids.find(value);
+
+    if (id != ids.end())
+    {
+        return id->second;
+    }
+
+    uint64_t next = ids.size();
+    ids[value] = next;
+    return next;
+}
+
+void Key_Encoder::add_float(double value, std::vector<uint64_t>& key)
+{
+    if (std::trunc(value) == value && std::fabs(value) < 9.2e18)
+    {
+        key.push_back(KEY_INT);
+        key.push_back((uint64_t)(long long)value);
+        return;
+    }
+
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+
+    key.push_back(KEY_FLOAT);
+    key.push_back(bits);
+}
+
+void Key_Encoder::add(Node* value, std::vector<uint64_t>& key)
+{
+    if (value == nullptr)
+    {
+        key.push_back(KEY_NULL);
+        key.push_back(0);
+        return;
+    }
+
+    switch (value->type)
+    {
+        case NodeType::INT:
+        {
+            key.push_back(KEY_INT);
+            key.push_back((uint64_t)value->INT.value);
+            break;
+        }
+        case NodeType::FLOAT:
+        {
+            add_float(value->FLOAT.value, key);
+            break;
+        }
+        case NodeType::BOOL:
+        {
+            key.push_back(KEY_BOOL);
+            key.push_back(value->BOOL.value);
+            break;
+        }
+        case NodeType::STRING:
+        {
+            key.push_back(KEY_STRING);
+            key.push_back(intern(value->STRING.value));
+            break;
+        }
+        case NodeType::EMPTY:
+        {
+            key.push_back(KEY_NULL);
+            key.push_back(0);
+            break;
+        }
+        default:
+        {
+            key.push_back(KEY_OTHER);
+            key.push_back(intern(value->repr()));
+            break;
+        }
+    }
+}
+
+void Key_Encoder::add(Table_Node& table, size_t row, size_t column, std::vector<uint64_t>& key)
+{
+    auto& cells = table.columns[column];
+
+    if (cells.missing[row])
+    {
+        key.push_back(KEY_NULL);
+        key.push_back(0);
+        return;
+    }
+
+    switch (cells.type)
+    {
+        case Column_Type::INT:
+        {
+            key.push_back(KEY_INT);
+            key.push_back((uint64_t)cells.ints[row]);
+            break;
+        }
+        case Column_Type::FLOAT:
+        {
+            add_float(cells.floats[row], key);
+            break;
+        }
+        case Column_Type::BOOL:
+        {
+            key.push_back(KEY_BOOL);
+            key.push_back(cells.ints[row]);
+            break;
+        }
+        case Column_Type::STRING:
+        {
+            // Numbered by text once per pool id, plus one so zero means not yet
+
+            auto& mapped = pool_ids[&table];
+            unsigned int pool_id = cells.strings[row];
+
+            if (mapped.size() <= pool_id)
+            {
+                mapped.resize(table.strings.size(), 0);
+            }
+
+            if (mapped[pool_id] == 0)
+            {
+                mapped[pool_id] = intern(table.strings[pool_id]) + 1;
+            }
+
+            key.push_back(KEY_STRING);
+            key.push_back(mapped[pool_id] - 1);
+            break;
+        }
+        default:
+        {
+            add(cells.values[row].get(), key);
+            break;
+        }
+    }
+}
@@ -0,0 +1,70 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+#include "../Node/Node.hpp"
+
+// Numbers the distinct keys of a grouping in the order they are first seen.
+// A key is a fixed number of 64-bit words, two per value: what kind of value
+// it is, then the value itself. Keys are found by open addressing with linear
+// probing in a power of two slot array kept at most half full. Each group's
+// hash is kept next to its key, so most mismatches are rejected without
+// comparing the keys themselves.
+
+class Group_Index
+{
+    size_t width;
+    std::vector<uint64_t> keys;
+    std::vector<uint64_t> hashes;
+
+    // The group in each slot plus one, zero for an empty slot
+    std::vector<uint32_t> slots;
+    size_t mask;
+
+    uint64_t hash(const uint64_t* key) const;
+    void grow();
+
+public:
+
+    explicit Group_Index(size_t values);
+
+    size_t size() const
+    {
+        return hashes.size();
+    }
+
+    size_t find_or_add(const uint64_t* key);
+    long long find(const uint64_t* key) const;
+};
+
+// What kind of value the first word of each pair says it holds
+
+enum Key_Tag : uint64_t
+{
+    KEY_NULL,
+    KEY_INT,
+    KEY_FLOAT,
+    KEY_BOOL,
+    KEY_STRING,
+    KEY_OTHER
+};
+
+// Turns values into key words. Equal values get equal words wherever they
+// came from - a string is numbered by its text, whether it sits in a node or
+// in a table's string pool, and a float with no fraction is keyed as the int
+// it equals, since the two compare equal with ==.
+
+class Key_Encoder
+{
+    std::unordered_map<std::string, uint64_t> ids;
+
+    // Each table's pool ids mapped to ours, filled in as they are met
+    std::unordered_map<const Table_Node*, std::vector<uint64_t>> pool_ids;
+
+    uint64_t intern(const std::string& value);
+    void add_float(double value, std::vector<uint64_t>& key);
+
+public:
+
+    void add(Node* value, std::vector<uint64_t>& key);
+    void add(Table_Node& table, size_t row, size_t column, std::vector<uint64_t>& key);
+};
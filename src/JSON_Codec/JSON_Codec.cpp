@@ -0,0 +1,533 @@
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include "JSON_Codec.hpp"
+#include "../Node/Pool.hpp"
+#include "../libs/JSON/json.hpp"
+
+using json = nlohmann::json;
+
+// What a writer with a stream holds before passing it on
+static const size_t block_size = 1 << 20;
+
+// Receives the parser's events and builds the values they describe. The
+// lists and objects still being read are kept on a stack, each with the key
+// its next value goes under. While streaming, the top level array is on the
+// stack as null, and its elements go to visit instead. When only some keys
+// of a top level object are kept, the values under the others are read past
+// without being built.
+
+struct Node_Builder
+{
+    struct Frame
+    {
+        Node_Ptr container;
+        std::string key;
+    };
+
+    std::vector<Frame> frames;
+    Node_Ptr result;
+    std::string error;
+
+    const std::function<void(Node_Ptr&)>* visit = nullptr;
+    size_t visited = 0;
+
+    const std::vector<std::string>* keep = nullptr;
+    bool skipping = false;
+    size_t skip_depth = 0;
+
+    // Left without a type, as table cells are, rather than made their own
+    // type as literals are: that would tie each value to itself, and a
+    // streamed element could then only be freed by a collection
+
+    Node_Ptr make_value(NodeType type)
+    {
+        return make_pooled_node(type);
+    }
+
+    // Whether a value is part of one being skipped, which ends with it when
+    // it is not inside a list or object of its own
+
+    bool skipped()
+    {
+        if (!skipping)
+        {
+            return false;
+        }
+
+        if (skip_depth == 0)
+        {
+            skipping = false;
+        }
+
+        return true;
+    }
+
+    bool skip_start()
+    {
+        if (skipping)
+        {
+            skip_depth++;
+        }
+
+        return skipping;
+    }
+
+    bool skip_end()
+    {
+        if (!skipping)
+        {
+            return false;
+        }
+
+        if (--skip_depth == 0)
+        {
+            skipping = false;
+        }
+
+        return true;
+    }
+
+    bool kept(const std::string& name)
+    {
+        return std::find(keep->begin(), keep->end(), name) != keep->end();
+    }
+
+    bool add(Node_Ptr value)
+    {
+        if (frames.empty() || frames.back().container == nullptr)
+        {
+            if (visit == nullptr)
+            {
+                result = value;
+                return true;
+            }
+
+            (*visit)(value);
+            visited++;
+            return true;
+        }
+
+        auto& frame = frames.back();
+
+        if (frame.container->type == NodeType::LIST)
+        {
+            frame.container->LIST.elements.push_back(value);
+        }
+        else
+        {
+            frame.container->OBJECT->properties[frame.key] = Object_Prop(true, value);
+        }
+
+        return true;
+    }
+
+    bool null()
+    {
+        if (skipped())
+        {
+            return true;
+        }
+
+        return add(make_value(NodeType::EMPTY));
+    }
+
+    bool boolean(bool value)
+    {
+        if (skipped())
+        {
+            return true;
+        }
+
+        auto node = make_value(NodeType::BOOL);
+        node->BOOL.value = value;
+        return add(node);
+    }
+
+    bool number_integer(json::number_integer_t value)
+    {
+        if (skipped())
+        {
+            return true;
+        }
+
+        auto node = make_value(NodeType::INT);
+        node->INT.value = value;
+        return add(node);
+    }
+
+    // Too large for an int, so kept as near as a float can
+
+    bool number_unsigned(json::number_unsigned_t value)
+    {
+        if (value > (json::number_unsigned_t)LLONG_MAX)
+        {
+            return number_float((double)value, "");
+        }
+
+        return number_integer((json::number_integer_t)value);
+    }
+
+    bool number_float(json::number_float_t value, const json::string_t&)
+    {
+        if (skipped())
+        {
+            return true;
+        }
+
+        auto node = make_value(NodeType::FLOAT);
+        node->FLOAT.value = value;
+        return add(node);
+    }
+
+    bool string(json::string_t& value)
+    {
+        if (skipped())
+        {
+            return true;
+        }
+
+        auto node = make_value(NodeType::STRING);
+        node->STRING.value = std::move(value);
+        return add(node);
+    }
+
+    bool binary(json::binary_t&)
+    {
+        return false;
+    }
+
+    bool start_object(std::size_t)
+    {
+        if (skip_start())
+        {
+            return true;
+        }
+
+        frames.push_back({make_value(NodeType::OBJECT), ""});
+        return true;
+    }
+
+    bool key(json::string_t& value)
+    {
+        if (skipping)
+        {
+            return true;
+        }
+
+        if (keep != nullptr && frames.size() == 1 && !kept(value))
+        {
+            skipping = true;
+            return true;
+        }
+
+        frames.back().key = std::move(value);
+        return true;
+    }
+
+    bool end_object()
+    {
+        if (skip_end())
+        {
+            return true;
+        }
+
+        auto value = frames.back().container;
+        frames.pop_back();
+
+        // Kept keys the object does not have are read as null, so every
+        // object has the same properties
+
+        if (keep != nullptr && frames.empty())
+        {
+            for (auto& name : *keep)
+            {
+                if (value->OBJECT->properties.count(name) == 0)
+                {
+                    value->OBJECT->properties[name] = Object_Prop(true, make_value(NodeType::EMPTY));
+                }
+            }
+        }
+
+        return add(value);
+    }
+
+    bool start_array(std::size_t)
+    {
+        if (skip_start())
+        {
+            return true;
+        }
+
+        if (visit != nullptr && frames.empty())
+        {
+            frames.push_back({nullptr, ""});
+            return true;
+        }
+
+        frames.push_back({make_value(NodeType::LIST), ""});
+        return true;
+    }
+
+    bool end_array()
+    {
+        if (skip_end())
+        {
+            return true;
+        }
+
+        auto value = frames.back().container;
+        frames.pop_back();
+
+        if (value == nullptr)
+        {
+            return true;
+        }
+
+        return add(value);
+    }
+
+    bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception& exception)
+    {
+        error = exception.what();
+        return false;
+    }
+};
+
+// --- JSON_Reader --- //
+
+Node_Ptr JSON_Reader::parse(std::string_view text)
+{
+    Node_Builder builder;
+    builder.keep = keep;
+
+    if (!json::sax_parse(text.begin(), text.end(), &builder))
+    {
+        error = builder.error;
+        return nullptr;
+    }
+
+    return builder.result;
+}
+
+size_t JSON_Reader::each(std::istream& stream, const std::function<void(Node_Ptr&)>& visit)
+{
+    Node_Builder builder;
+    builder.visit = &visit;
+
+    if (!json::sax_parse(stream, &builder))
+    {
+        error = builder.error;
+    }
+
+    return builder.visited;
+}
+
+// --- JSON_Writer --- //
+
+JSON_Writer::JSON_Writer(int indent, std::ostream* stream) : indent(indent), stream(stream) {}
+
+void JSON_Writer::flush()
+{
+    if (stream != nullptr)
+    {
+        stream->write(out.data(), out.size());
+        out.clear();
+    }
+}
+
+void JSON_Writer::newline(int depth)
+{
+    if (indent > 0)
+    {
+        out += '\n';
+        out.append(depth * indent, ' ');
+    }
+}
+
+void JSON_Writer::write_string(const std::string& value)
+{
+    static const char* hex = "0123456789abcdef";
+
+    out += '"';
+
+    for (unsigned char c : value)
+    {
+        switch (c)
+        {
+            case '"': out += "\\\""; break;
+            case '\\': out += "\\\\"; break;
+            case '\b': out += "\\b"; break;
+            case '\f': out += "\\f"; break;
+            case '\n': out += "\\n"; break;
+            case '\r': out += "\\r"; break;
+            case '\t': out += "\\t"; break;
+            default:
+            {
+                if (c < 0x20)
+                {
+                    out += "\\u00";
+                    out += hex[c >> 4];
+                    out += hex[c & 15];
+                }
+                else
+                {
+                    out += c;
+                }
+            }
+        }
+    }
+
+    out += '"';
+}
+
+// Shortest text that reads back as the same double, as json.hpp writes it.
+// JSON has no infinities or NaN, so those are written as null
+
+void JSON_Writer::write_float(double value)
+{
+    if (!std::isfinite(value))
+    {
+        out += "null";
+        return;
+    }
+
+    char buffer[64];
+    char* end = nlohmann::detail::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, end);
+}
+
+bool JSON_Writer::write(const Node_Ptr& value, int depth)
+{
+    if (stream != nullptr && out.size() >= block_size)
+    {
+        flush();
+    }
+
+    if (value == nullptr)
+    {
+        out += "null";
+        return true;
+    }
+
+    switch (value->type)
+    {
+        case NodeType::EMPTY:
+        {
+            out += "null";
+            return true;
+        }
+        case NodeType::BOOL:
+        {
+            out += value->BOOL.value ? "true" : "false";
+            return true;
+        }
+        case NodeType::INT:
+        {
+            out += std::to_string(value->INT.value);
+            return true;
+        }
+        case NodeType::FLOAT:
+        {
+            write_float(value->FLOAT.value);
+            return true;
+        }
+        case NodeType::STRING:
+        {
+            write_string(value->STRING.value);
+            return true;
+        }
+        case NodeType::LIST:
+        {
+            bool first = true;
+
+            auto write_element = [&](const Node_Ptr& elem)
+            {
+                if (!first)
+                {
+                    out += ',';
+                }
+
+                first = false;
+                newline(depth + 1);
+                return write(elem, depth + 1);
+            };
+
+            out += '[';
+
+            if (value->LIST.lazy)
+            {
+                Sequence_Cursor cursor(value);
+
+                while (cursor.next())
+                {
+                    if (!write_element(cursor.value()))
+                    {
+                        return false;
+                    }
+                }
+            }
+            else
+            {
+                for (auto& elem : value->LIST.elements)
+                {
+                    if (!write_element(elem))
+                    {
+                        return false;
+                    }
+                }
+            }
+
+            if (!first)
+            {
+                newline(depth);
+            }
+
+            out += ']';
+            return true;
+        }
+        case NodeType::OBJECT:
+        {
+            std::vector<const std::pair<const std::string, Object_Prop>*> props;
+
+            for (auto& prop : value->OBJECT->properties)
+            {
+                props.push_back(&prop);
+            }
+
+            std::sort(props.begin(), props.end(), [](auto a, auto b) { return a->first < b->first; });
+
+            out += '{';
+
+            for (size_t i = 0; i < props.size(); i++)
+            {
+                if (i > 0)
+                {
+                    out += ',';
+                }
+
+                newline(depth + 1);
+                write_string(props[i]->first);
+                out += indent > 0 ? ": " : ":";
+
+                if (!write(props[i]->second.value, depth + 1))
+                {
+                    return false;
+                }
+            }
+
+            if (!props.empty())
+            {
+                newline(depth);
+            }
+
+            out += '}';
+            return true;
+        }
+        default:
+        {
+            error = "cannot write '" + value->repr() + "' as JSON";
+            return false;
+        }
+    }
+}
@@ -0,0 +1,59 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <ostream>
+#include <functional>
+#include "../Node/Node.hpp"
+
+// Turns JSON text into values and values into JSON text. Reading goes
+// through the SAX interface of the bundled json.hpp, so values are built
+// straight from the parser's events rather than copied out of a json
+// document. Arrays become lists, objects objects, whole numbers ints, other
+// numbers floats and null null. A parse error is left in error and nothing
+// is returned.
+
+class JSON_Reader
+{
+public:
+
+    std::string error;
+
+    // When set, only these keys of a top level object are read, and any of
+    // them it lacks are read as null
+    const std::vector<std::string>* keep = nullptr;
+
+    Node_Ptr parse(std::string_view text);
+
+    // Hands each element of a top level array to visit as soon as it has
+    // been read, and drops it afterwards, so the array is never held whole.
+    // Any other top level value is handed over by itself. Returns how many
+    // values were visited
+    size_t each(std::istream& stream, const std::function<void(Node_Ptr&)>& visit);
+};
+
+// Writes values as JSON, with the keys of objects in sorted order as json.hpp
+// writes them. An indent of zero writes everything on one line. When given a
+// stream, what has been written is passed on to it in large blocks instead of
+// being kept. A value that has no JSON form, such as a function, leaves an
+// error.
+
+class JSON_Writer
+{
+    int indent;
+    std::ostream* stream;
+
+    void write_string(const std::string& value);
+    void write_float(double value);
+    void newline(int depth);
+
+public:
+
+    std::string out;
+    std::string error;
+
+    explicit JSON_Writer(int indent = 0, std::ostream* stream = nullptr);
+
+    bool write(const Node_Ptr& value, int depth = 0);
+    void flush();
+};
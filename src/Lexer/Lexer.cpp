@@ -1,4 +1,5 @@
 #include "Lexer.hpp"
+#include "../Output/Output.hpp"
 
 void Lexer::load_source(std::string filename)
 {
@@ -11,6 +12,7 @@ void Lexer::load_source(std::string filename)
 void Lexer::error_and_exit(std::string message)
 {
 	std::string error_message = "\n\n[Lexer] Lexical Error in '" + file_name + "' @ (" + std::to_string(line) + ", " + std::to_string(column) + "): " + message;
+	Output::get().flush();
 	std::cout << error_message;
 	std::cout << "\nCompilation failed. Press any key to exit...";
 	std::cin.get();
@@ -37,6 +39,11 @@ void Lexer::advance()
 	}
 }
 
+Node_Ptr Lexer::make_node(NodeType type)
+{
+	return arena->make_node(type, line, column);
+}
+
 char Lexer::peek(int n)
 {
 	int peek_index = index + n;
@@ -52,7 +59,7 @@ char Lexer::peek(int n)
 
 void Lexer::build_identifier()
 {
-	std::shared_ptr<Node> node(new Node(NodeType::ID, line, column));
+	Node_Ptr node = make_node(NodeType::ID);
 
 	std::string name = std::string();
 
@@ -85,7 +92,7 @@ void Lexer::build_identifier()
 
 void Lexer::build_number()
 {
-	std::shared_ptr<Node> node(new Node(line, column));
+	Node_Ptr node = make_node(NodeType::INT);
 
 	std::string value;
 	int num_dots = 0;
@@ -134,7 +141,7 @@ void Lexer::build_number()
 
 void Lexer::build_string()
 {
-	std::shared_ptr<Node> node(new Node(NodeType::STRING, line, column));
+	Node_Ptr node = make_node(NodeType::STRING);
 
 	std::string str = std::string();
 
@@ -280,6 +287,7 @@ void Lexer::check_for_errors()
 {
 	if (errors.size() > 0)
 	{
+		Output::get().flush();
 		std::cout << "[Lexer] Lexing unsuccessful - " + std::to_string(errors.size()) + " error(s) found.\n";
 		for (std::string error_message : errors)
 		{
@@ -295,7 +303,7 @@ void Lexer::check_for_errors()
 
 void Lexer::tokenize()
 {
-	std::shared_ptr<Node> SOF(new Node(NodeType::START_OF_FILE, line, column));
+	Node_Ptr SOF = make_node(NodeType::START_OF_FILE);
 	nodes.push_back(SOF);
 
 	while (current_char != '\0')
@@ -332,7 +340,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '.' && peek() == '.' && peek(2) == '.')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::TRIPLE_DOT;
 			node->OP.value = "...";
 			nodes.push_back(node);
@@ -342,7 +350,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '.' && peek() == '.')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::DOUBLE_DOT;
 			node->OP.value = "..";
 			nodes.push_back(node);
@@ -351,7 +359,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '=' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::EQ_EQ;
 			node->OP.value = "==";
 			nodes.push_back(node);
@@ -360,7 +368,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '!' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::NOT_EQUAL;
 			node->OP.value = "!=";
 			nodes.push_back(node);
@@ -369,7 +377,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '<' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::LT_EQUAL;
 			node->OP.value = "<=";
 			nodes.push_back(node);
@@ -378,7 +386,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '>' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::GT_EQUAL;
 			node->OP.value = ">=";
 			nodes.push_back(node);
@@ -387,7 +395,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '+' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::PLUS_EQ;
 			node->OP.value = "+=";
 			nodes.push_back(node);
@@ -396,7 +404,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '-' && peek() == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::MINUS_EQ;
 			node->OP.value = "-=";
 			nodes.push_back(node);
@@ -405,7 +413,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '=' && peek() == '>')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::RIGHT_ARROW_DOUBLE;
 			node->OP.value = "=>";
 			nodes.push_back(node);
@@ -414,7 +422,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '-' && peek() == '>')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::RIGHT_ARROW_SINGLE;
 			node->OP.value = "->";
 			nodes.push_back(node);
@@ -423,7 +431,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '>' && peek() == '>')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::DOUBLE_ARROW;
 			node->OP.value = ">>";
 			nodes.push_back(node);
@@ -432,7 +440,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '&' && peek() == '&')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::AND;
 			node->OP.value = "&&";
 			nodes.push_back(node);
@@ -441,7 +449,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '|' && peek() == '|')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::OR;
 			node->OP.value = "||";
 			nodes.push_back(node);
@@ -450,7 +458,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == ':' && peek() == ':')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::DOUBLE_COLON;
 			node->OP.value = "::";
 			nodes.push_back(node);
@@ -459,7 +467,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '=')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::EQUAL;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -467,49 +475,49 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '(')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::L_PAREN, line, column));
+			Node_Ptr node = make_node(NodeType::L_PAREN);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == ')')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::R_PAREN, line, column));
+			Node_Ptr node = make_node(NodeType::R_PAREN);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == '{')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::L_BRACE, line, column));
+			Node_Ptr node = make_node(NodeType::L_BRACE);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == '}')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::R_BRACE, line, column));
+			Node_Ptr node = make_node(NodeType::R_BRACE);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == '[')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::L_BRACKET, line, column));
+			Node_Ptr node = make_node(NodeType::L_BRACKET);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == ']')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::R_BRACKET, line, column));
+			Node_Ptr node = make_node(NodeType::R_BRACKET);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == '<')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::L_ANGLE;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -517,7 +525,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '>')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::R_ANGLE;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -525,7 +533,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '.')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::DOT;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -533,7 +541,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '\\')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::BACKSLASH;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -541,7 +549,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '\'')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::APOSTROPHE;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -549,7 +557,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '!')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::EXCLAMATION;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -557,7 +565,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '@')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::AT;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -565,7 +573,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '#')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::HASH;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -573,7 +581,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '$')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::DOLLAR;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -581,7 +589,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '^')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::CARET;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -589,7 +597,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '?')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::QUESTION;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -597,7 +605,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '%')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::PERCENT;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -605,14 +613,14 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '"')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::DOUBLE_QUOTE, line, column));
+			Node_Ptr node = make_node(NodeType::DOUBLE_QUOTE);
 			node->OP.value = current_char;
 			nodes.push_back(node);
 			advance(); // consume symbol
 		}
 		else if (current_char == '-')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::MINUS;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -620,7 +628,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '+')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::PLUS;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -628,7 +636,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '/')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::SLASH;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -636,7 +644,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '*')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::STAR;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -644,7 +652,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == ',')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::COMMA;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -652,7 +660,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == '|')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::PIPE;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -660,7 +668,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == ':')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::COLON;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -668,7 +676,7 @@ void Lexer::tokenize()
 		}
 		else if (current_char == ';')
 		{
-			std::shared_ptr<Node> node(new Node(NodeType::OP, line, column));
+			Node_Ptr node = make_node(NodeType::OP);
 			node->OP.op_type = NodeType::SEMICOLON;
 			node->OP.value = current_char;
 			nodes.push_back(node);
@@ -677,13 +685,13 @@ void Lexer::tokenize()
 		else
 		{
 			error_and_continue("Unexpected node '" + std::string(1, current_char) + "'.");
-			std::shared_ptr<Node> node(new Node(NodeType::ERROR, line, column));
+			Node_Ptr node = make_node(NodeType::ERROR);
 			nodes.push_back(node);
 			advance();
 		}
 	}
 
-	std::shared_ptr<Node> node(new Node(NodeType::END_OF_FILE, line, column));
+	Node_Ptr node = make_node(NodeType::END_OF_FILE);
 	nodes.push_back(node);
 
 	check_for_errors();
@@ -692,7 +700,7 @@ void Lexer::tokenize()
 void Lexer::print_nodes()
 {
 	std::cout << "[ ";
-	for (std::shared_ptr<Node> node : nodes)
+	for (Node_Ptr node : nodes)
 	{
 		std::cout << node->repr();
 		std::cout << " ";
@@ -9,6 +9,7 @@
 #include <memory>
 
 #include "../Node/Node.hpp"
+#include "../Node/Arena.hpp"
 
 class Lexer
 {
@@ -21,6 +22,11 @@ class Lexer
 	std::vector<std::string> errors;
 	bool debug = false;
 
+	// Tokens are allocated from the module's arena
+	Arena_Ref arena;
+
+	Node_Ptr make_node(NodeType type);
+
 	void error_and_exit(std::string message);
 
 	void error_and_continue(std::string message);
@@ -71,7 +77,7 @@ public:
 
 	std::string file_name;
 	
-	std::vector<std::shared_ptr<Node>> nodes;
+	std::vector<Node_Ptr> nodes;
 
 	void init(std::string source);
 
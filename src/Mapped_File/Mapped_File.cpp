@@ -0,0 +1,228 @@
+#include <fstream>
+#include <sstream>
+#include <filesystem>
+#include <algorithm>
+#include "Mapped_File.hpp"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// The files mapped right now, to be detached before they are truncated
+
+std::vector<Mapped_File*>& Mapped_File::mappings()
+{
+    static std::vector<Mapped_File*> files;
+    return files;
+}
+
+void Mapped_File::detach(const std::string& path)
+{
+    auto& files = mappings();
+    bool unlinked = false;
+
+    for (size_t i = 0; i < files.size();)
+    {
+        auto file = files[i];
+        std::error_code error;
+
+        if (!std::filesystem::equivalent(path, file->path, error))
+        {
+            i++;
+            continue;
+        }
+
+        if (!unlinked && replace(file->path))
+        {
+            unlinked = true;
+        }
+
+        if (unlinked)
+        {
+            // The mapping stays valid, but is dropped from the list, as the
+            // file it is of is no longer at any path
+
+            files.erase(files.begin() + i);
+            continue;
+        }
+
+        std::string copy(file->bytes, file->length);
+        file->unmap();
+        file->owned = std::move(copy);
+        file->bytes = file->owned.data();
+    }
+}
+
+void Mapped_File::read_whole(const std::string& path)
+{
+    std::ifstream stream(path, std::ios::binary);
+
+    if (!stream)
+    {
+        return;
+    }
+
+    std::stringstream buffer;
+    buffer << stream.rdbuf();
+    owned = buffer.str();
+
+    bytes = owned.data();
+    length = owned.size();
+    opened = true;
+}
+
+#ifdef _WIN32
+
+Mapped_File::Mapped_File(const std::string& path)
+{
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+
+    if (file == INVALID_HANDLE_VALUE)
+    {
+        read_whole(path);
+        return;
+    }
+
+    LARGE_INTEGER size;
+
+    if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+    {
+        CloseHandle(file);
+        read_whole(path);
+        return;
+    }
+
+    // The view keeps the file open once the handles to it are closed
+
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    void* view = mapping != NULL ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : NULL;
+
+    if (mapping != NULL)
+    {
+        CloseHandle(mapping);
+    }
+
+    CloseHandle(file);
+
+    if (view == NULL)
+    {
+        read_whole(path);
+        return;
+    }
+
+    bytes = (const char*)view;
+    length = (size_t)size.QuadPart;
+    mapped = true;
+    opened = true;
+    this->path = path;
+    mappings().push_back(this);
+}
+
+// A mapped file cannot be deleted or truncated, so mappings are copied out
+
+bool Mapped_File::replace(const std::string& path)
+{
+    return false;
+}
+
+void Mapped_File::unmap()
+{
+    UnmapViewOfFile(bytes);
+    mapped = false;
+
+    auto& files = mappings();
+    files.erase(std::find(files.begin(), files.end(), this));
+}
+
+#else
+
+Mapped_File::Mapped_File(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY);
+
+    if (fd < 0)
+    {
+        return;
+    }
+
+    struct stat info;
+
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size == 0)
+    {
+        ::close(fd);
+        read_whole(path);
+        return;
+    }
+
+    // The mapping keeps the file open once the descriptor is closed
+
+    void* view = mmap(nullptr, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+
+    if (view == MAP_FAILED)
+    {
+        read_whole(path);
+        return;
+    }
+
+    bytes = (const char*)view;
+    length = info.st_size;
+    mapped = true;
+    opened = true;
+    this->path = path;
+    mappings().push_back(this);
+}
+
+// Swaps the file at path, found through any symlinks, for an empty one
+// with the same permissions. Mappings of the old file keep it alive until
+// they are unmapped
+
+bool Mapped_File::replace(const std::string& path)
+{
+    std::error_code error;
+    auto target = std::filesystem::canonical(path, error);
+    struct stat info;
+
+    if (error || stat(target.c_str(), &info) != 0 || unlink(target.c_str()) != 0)
+    {
+        return false;
+    }
+
+    int fd = ::open(target.c_str(), O_WRONLY | O_CREAT | O_EXCL, info.st_mode & 07777);
+
+    if (fd >= 0)
+    {
+        ::close(fd);
+    }
+
+    return true;
+}
+
+void Mapped_File::unmap()
+{
+    munmap((void*)bytes, length);
+    mapped = false;
+
+    auto& files = mappings();
+    auto it = std::find(files.begin(), files.end(), this);
+
+    if (it != files.end())
+    {
+        files.erase(it);
+    }
+}
+
+#endif
+
+Mapped_File::~Mapped_File()
+{
+    if (mapped)
+    {
+        unmap();
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+
+// A file's bytes, mapped into memory read-only rather than read into a
+// buffer, so opening even a very large file takes the same time and only the
+// pages actually looked at are read from disk. A file that cannot be mapped,
+// such as a pipe, is read into a buffer of its own instead. An empty file is
+// open with no bytes. Reading a page of a mapped file that has since been
+// truncated kills the process, so before the interpreter truncates a file it
+// detaches every mapping of it, which then keeps the bytes it had.
+
+class Mapped_File
+{
+    const char* bytes = nullptr;
+    size_t length = 0;
+    bool mapped = false;
+    bool opened = false;
+    std::string owned;
+    std::string path;
+
+    static std::vector<Mapped_File*>& mappings();
+
+    void read_whole(const std::string& path);
+    void unmap();
+
+    static bool replace(const std::string& path);
+
+public:
+
+    explicit Mapped_File(const std::string& path);
+    ~Mapped_File();
+
+    Mapped_File(const Mapped_File&) = delete;
+    Mapped_File& operator=(const Mapped_File&) = delete;
+
+    // Lets the file at path be truncated while mappings of it are still
+    // being read. Where the system allows it, the file is unlinked and made
+    // again empty with the same permissions, and the mappings keep the old
+    // one, so nothing is copied; a file with other hard links loses them
+    // this way. Otherwise, as on Windows, what each mapping holds is copied
+    // into a buffer of its own
+    static void detach(const std::string& path);
+
+    bool is_open() const
+    {
+        return opened;
+    }
+
+    const char* data() const
+    {
+        return bytes;
+    }
+
+    size_t size() const
+    {
+        return length;
+    }
+
+    std::string_view view() const
+    {
+        return std::string_view(bytes, length);
+    }
+};
@@ -0,0 +1,103 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <cstddef>
+
+#include "Node.hpp"
+
+// Bump allocator for the nodes a module's Lexer and Parser create. Each
+// node records its arena in its header and holds a reference to it, so
+// freeing a node is just a count decrement, and the arena releases all of
+// its blocks at once when the last node allocated from it goes away.
+
+class Arena
+{
+    static constexpr size_t block_size = 64 * 1024;
+
+    std::vector<std::unique_ptr<char[]>> blocks;
+    size_t used = block_size;
+
+public:
+
+    size_t refs = 0;
+
+    void* allocate(size_t size, size_t align)
+    {
+        // Large requests get a block of their own, behind the current one
+
+        if (size > block_size / 4)
+        {
+            auto block = std::make_unique<char[]>(size);
+            void* res = block.get();
+            blocks.insert(blocks.empty() ? blocks.end() : blocks.end() - 1, std::move(block));
+            return res;
+        }
+
+        used = (used + align - 1) & ~(align - 1);
+
+        if (used + size > block_size)
+        {
+            blocks.emplace_back(new char[block_size]);
+            used = 0;
+        }
+
+        void* res = blocks.back().get() + used;
+        used += size;
+        return res;
+    }
+
+    void release()
+    {
+        if (--refs == 0)
+        {
+            delete this;
+        }
+    }
+
+    template <typename... Args>
+    Node_Ptr make_node(Args&&... args)
+    {
+        auto node = new (allocate(sizeof(Node), alignof(Node))) Node(std::forward<Args>(args)...);
+        node->header.arena = this;
+        refs++;
+        return Node_Ptr(node);
+    }
+};
+
+// Owning handle to an arena, held by the Lexer or Parser filling it.
+// The interpreter is single threaded, so the count is a plain integer
+
+class Arena_Ref
+{
+    Arena* arena;
+
+public:
+
+    Arena_Ref() : arena(new Arena())
+    {
+        arena->refs++;
+    }
+
+    Arena_Ref(const Arena_Ref& other) : arena(other.arena)
+    {
+        arena->refs++;
+    }
+
+    Arena_Ref& operator=(const Arena_Ref& other)
+    {
+        other.arena->refs++;
+        arena->release();
+        arena = other.arena;
+        return *this;
+    }
+
+    ~Arena_Ref()
+    {
+        arena->release();
+    }
+
+    Arena* operator->() const
+    {
+        return arena;
+    }
+};
@@ -1,6 +1,756 @@
+#include <cstring>
 #include "Node.hpp"
+#include "Pool.hpp"
+#include "Arena.hpp"
+#include "../Collector/Collector.hpp"
+#include "../JSON_Codec/JSON_Codec.hpp"
+#include "../Output/Output.hpp"
 
-std::string repr_obj(std::shared_ptr<Node> obj, int depth = 0) {
+// Called when the last handle to a node goes away
+
+void release_node(Node* node)
+{
+    if (node->header.root_index >= 0)
+    {
+        Collector::get().remove_root(node);
+    }
+
+    Arena* arena = node->header.arena;
+    node->~Node();
+
+    if (arena != nullptr)
+    {
+        arena->release();
+    }
+    else
+    {
+        Node_Pool::get().deallocate(node, sizeof(Node));
+    }
+}
+
+// --- Lazy ranges --- //
+
+static Node_Ptr make_line(const std::string& line)
+{
+    auto node = make_pooled_node(NodeType::STRING);
+    node->STRING.value = line;
+    return node;
+}
+
+// Reads the line starting at offset and moves offset past it, dropping the
+// '\r' of a CRLF line ending
+
+static bool read_line(const Mapped_File& file, size_t& offset, std::string& line)
+{
+    if (offset >= file.size())
+    {
+        return false;
+    }
+
+    const char* start = file.data() + offset;
+    size_t left = file.size() - offset;
+    auto end = (const char*)std::memchr(start, '\n', left);
+    size_t length = end != nullptr ? end - start : left;
+
+    offset += end != nullptr ? length + 1 : length;
+
+    if (length > 0 && start[length - 1] == '\r')
+    {
+        length--;
+    }
+
+    line.assign(start, length);
+    return true;
+}
+
+static std::unique_ptr<Mapped_File> open_lines(const std::string& path)
+{
+    return std::make_unique<Mapped_File>(path);
+}
+
+// Lines with nothing but spaces on them hold no JSON, and are skipped
+
+static bool is_blank(const std::string& line)
+{
+    return line.find_first_not_of(" \t") == std::string::npos;
+}
+
+// A line of a stream as an element: the line itself, or the value the JSON
+// on it describes. A line that is not JSON ends the program, as a runtime
+// error would
+
+Node_Ptr Sequence_Node::line_value(const std::string& line, size_t number)
+{
+    if (keys == nullptr)
+    {
+        return make_line(line);
+    }
+
+    JSON_Reader reader;
+    reader.keep = keys->empty() ? nullptr : keys.get();
+
+    auto value = reader.parse(line);
+
+    if (value == nullptr)
+    {
+        Output::get().flush();
+        std::cout << "\n\nRuntime Error in '" << *path << "' @ line " << number << ": " << reader.error << "\n";
+        exit(1);
+    }
+
+    return value;
+}
+
+Node_Ptr Sequence_Node::at(size_t index)
+{
+    if (is_stream())
+    {
+        materialize();
+    }
+
+    if (is_table())
+    {
+        return table->row(index);
+    }
+
+    if (!lazy)
+    {
+        return elements[index];
+    }
+
+    auto node = make_pooled_node(NodeType::INT);
+    node->INT.value = value_at(index);
+    return node;
+}
+
+// An element standing in for all of a lazy list's elements, which share
+// one type
+
+Node_Ptr Sequence_Node::sample()
+{
+    if (is_stream() && keys != nullptr)
+    {
+        auto file = open_lines(*path);
+        size_t offset = 0;
+        std::string line;
+        size_t number = 0;
+
+        while (read_line(*file, offset, line))
+        {
+            number++;
+
+            if (!is_blank(line))
+            {
+                return line_value(line, number);
+            }
+        }
+
+        return make_pooled_node(NodeType::OBJECT);
+    }
+
+    if (is_stream())
+    {
+        return make_line("");
+    }
+
+    return at(0);
+}
+
+void Sequence_Node::set_range(long long start, long long end)
+{
+    elements.clear();
+    lazy = true;
+    materialized = std::make_shared<Materialized>();
+    this->start = start;
+    this->end = end;
+}
+
+void Sequence_Node::set_lines(const std::string& path)
+{
+    elements.clear();
+    lazy = true;
+    materialized = std::make_shared<Materialized>();
+    *this->path = path;
+}
+
+void Sequence_Node::set_json_lines(const std::string& path, std::vector<std::string> keys)
+{
+    set_lines(path);
+    this->keys = std::make_shared<const std::vector<std::string>>(std::move(keys));
+}
+
+void Sequence_Node::set_table(std::shared_ptr<Table_Node> table)
+{
+    elements.clear();
+    lazy = true;
+    materialized = std::make_shared<Materialized>();
+    this->table = table;
+}
+
+// A copy that was materialized first left its elements behind, and those
+// are taken over rather than built again. Otherwise the elements are built
+// and left for the copies that still share this list's state
+
+void Sequence_Node::materialize()
+{
+    if (materialized != nullptr && materialized->done)
+    {
+        elements = materialized->elements;
+        lazy = false;
+        table = nullptr;
+        materialized = nullptr;
+        return;
+    }
+
+    build();
+
+    if (materialized != nullptr && materialized.use_count() > 1)
+    {
+        materialized->elements = elements;
+        materialized->done = true;
+    }
+
+    materialized = nullptr;
+}
+
+void Sequence_Node::build()
+{
+    if (is_table())
+    {
+        lazy = false;
+        elements.reserve(table->rows);
+
+        for (size_t i = 0; i < table->rows; i++)
+        {
+            auto row = table->row(i);
+            row->OBJECT->row = Row_Link();
+            elements.push_back(row);
+        }
+
+        table = nullptr;
+        return;
+    }
+
+    if (is_stream())
+    {
+        lazy = false;
+
+        auto file = open_lines(*path);
+        size_t offset = 0;
+        std::string line;
+        size_t number = 0;
+
+        while (read_line(*file, offset, line))
+        {
+            number++;
+
+            if (keys == nullptr || !is_blank(line))
+            {
+                elements.push_back(line_value(line, number));
+            }
+        }
+
+        return;
+    }
+
+    size_t count = size();
+    lazy = false;
+    elements.reserve(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        auto node = make_pooled_node(NodeType::INT);
+        node->INT.value = value_at(i);
+        elements.push_back(node);
+    }
+}
+
+// --- Tables --- //
+
+int Table_Node::column_index(const std::string& name) const
+{
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        if (columns[i].name == name)
+        {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+// Adds a column with no type yet, missing in every row so far
+
+size_t Table_Node::add_column(const std::string& name)
+{
+    columns.emplace_back();
+    columns.back().name = name;
+    columns.back().missing.assign(rows, true);
+    return columns.size() - 1;
+}
+
+void Table_Node::push_row()
+{
+    rows++;
+
+    for (auto& column : columns)
+    {
+        column.missing.push_back(true);
+
+        if (!column.nulls.empty())
+        {
+            column.nulls.push_back(false);
+        }
+
+        switch (column.type)
+        {
+            case Column_Type::INT:
+            case Column_Type::BOOL: column.ints.push_back(0); break;
+            case Column_Type::FLOAT: column.floats.push_back(0); break;
+            case Column_Type::STRING: column.strings.push_back(0); break;
+            case Column_Type::VALUE: column.values.push_back(nullptr); break;
+            default: break;
+        }
+    }
+}
+
+unsigned int Table_Node::intern(const std::string& value)
+{
+    auto it = string_ids.find(value);
+
+    if (it != string_ids.end())
+    {
+        return it->second;
+    }
+
+    strings.push_back(value);
+    string_ids[value] = strings.size() - 1;
+    return strings.size() - 1;
+}
+
+// The value in a cell, or nullptr if it is missing
+
+Node_Ptr Table_Node::get(size_t row, size_t index)
+{
+    auto& column = columns[index];
+
+    if (column.missing[row])
+    {
+        if (!column.nulls.empty() && column.nulls[row])
+        {
+            return make_pooled_node(NodeType::EMPTY);
+        }
+
+        return nullptr;
+    }
+
+    Node_Ptr node;
+
+    switch (column.type)
+    {
+        case Column_Type::INT:
+        {
+            node = make_pooled_node(NodeType::INT);
+            node->INT.value = column.ints[row];
+            break;
+        }
+        case Column_Type::FLOAT:
+        {
+            node = make_pooled_node(NodeType::FLOAT);
+            node->FLOAT.value = column.floats[row];
+            break;
+        }
+        case Column_Type::BOOL:
+        {
+            node = make_pooled_node(NodeType::BOOL);
+            node->BOOL.value = column.ints[row];
+            break;
+        }
+        case Column_Type::STRING:
+        {
+            node = make_pooled_node(NodeType::STRING);
+            node->STRING.value = strings[column.strings[row]];
+            break;
+        }
+        default:
+        {
+            return column.values[row];
+        }
+    }
+
+    node->TYPE.allowed_type = column.value_type;
+    return node;
+}
+
+// The text to_string gives for a cell, without making a node for it
+
+std::string Table_Node::key(size_t row, size_t index)
+{
+    auto& column = columns[index];
+
+    if (column.missing[row])
+    {
+        return "null";
+    }
+
+    switch (column.type)
+    {
+        case Column_Type::INT: return std::to_string(column.ints[row]);
+        case Column_Type::FLOAT: return std::to_string(column.floats[row]);
+        case Column_Type::BOOL: return column.ints[row] ? "true" : "false";
+        case Column_Type::STRING: return strings[column.strings[row]];
+        default: return column.values[row]->repr();
+    }
+}
+
+void Table_Node::set_type(Table_Column& column, Column_Type type, NodeType node_type)
+{
+    column.type = type;
+    column.value_type = make_pooled_node(node_type);
+    column.value_type->TYPE.is_literal = false;
+
+    switch (type)
+    {
+        case Column_Type::INT:
+        case Column_Type::BOOL: column.ints.resize(rows); break;
+        case Column_Type::FLOAT: column.floats.resize(rows); break;
+        case Column_Type::STRING: column.strings.resize(rows); break;
+        default: break;
+    }
+}
+
+// Turns a typed column into one that holds any value, for a cell of
+// another type
+
+void Table_Node::box(Table_Column& column)
+{
+    size_t index = &column - &columns[0];
+    std::vector<Node_Ptr> values(rows);
+
+    for (size_t i = 0; i < rows; i++)
+    {
+        values[i] = get(i, index);
+    }
+
+    column.type = Column_Type::VALUE;
+    column.values.swap(values);
+    column.ints = {};
+    column.floats = {};
+    column.strings = {};
+    column.value_type = nullptr;
+}
+
+void Table_Node::set(size_t row, size_t index, const Node_Ptr& value)
+{
+    if (value == nullptr || value->type == NodeType::EMPTY)
+    {
+        set_missing(row, index);
+        return;
+    }
+
+    auto& column = columns[index];
+
+    if (column.type == Column_Type::NONE)
+    {
+        switch (value->type)
+        {
+            case NodeType::INT: set_type(column, Column_Type::INT, NodeType::INT); break;
+            case NodeType::FLOAT: set_type(column, Column_Type::FLOAT, NodeType::FLOAT); break;
+            case NodeType::BOOL: set_type(column, Column_Type::BOOL, NodeType::BOOL); break;
+            case NodeType::STRING: set_type(column, Column_Type::STRING, NodeType::STRING); break;
+            default:
+            {
+                column.type = Column_Type::VALUE;
+                column.values.resize(rows);
+                break;
+            }
+        }
+    }
+
+    if (column.type == Column_Type::INT && value->type == NodeType::INT)
+    {
+        column.ints[row] = value->INT.value;
+    }
+    else if (column.type == Column_Type::FLOAT && value->type == NodeType::FLOAT)
+    {
+        column.floats[row] = value->FLOAT.value;
+    }
+    else if (column.type == Column_Type::BOOL && value->type == NodeType::BOOL)
+    {
+        column.ints[row] = value->BOOL.value;
+    }
+    else if (column.type == Column_Type::STRING && value->type == NodeType::STRING)
+    {
+        column.strings[row] = intern(value->STRING.value);
+    }
+    else
+    {
+        if (column.type != Column_Type::VALUE)
+        {
+            box(column);
+        }
+
+        column.values[row] = value;
+    }
+
+    column.missing[row] = false;
+
+    if (!column.nulls.empty())
+    {
+        column.nulls[row] = false;
+    }
+}
+
+void Table_Node::set_missing(size_t row, size_t index)
+{
+    auto& column = columns[index];
+    column.missing[row] = true;
+
+    if (!column.nulls.empty())
+    {
+        column.nulls[row] = false;
+    }
+
+    if (column.type == Column_Type::VALUE)
+    {
+        column.values[row] = nullptr;
+    }
+}
+
+// A null cell is missing to everything that reads the columns directly, so
+// aggregates and keys treat it as they do a missing one, but its row has
+// the property, set to null
+
+void Table_Node::set_null(size_t row, size_t index)
+{
+    set_missing(row, index);
+
+    auto& column = columns[index];
+
+    if (column.nulls.empty())
+    {
+        column.nulls.assign(rows, false);
+    }
+
+    column.nulls[row] = true;
+}
+
+// Copies a cell of another table into one of this table's, with no node in
+// between when both columns hold the same type
+
+void Table_Node::copy(size_t row, size_t index, Table_Node& from, size_t from_row, size_t from_index)
+{
+    auto& source = from.columns[from_index];
+    auto& column = columns[index];
+
+    if (source.missing[from_row])
+    {
+        if (!source.nulls.empty() && source.nulls[from_row])
+        {
+            set_null(row, index);
+        }
+        else
+        {
+            set_missing(row, index);
+        }
+
+        return;
+    }
+
+    if (column.type == Column_Type::NONE && source.type != Column_Type::VALUE)
+    {
+        set_type(column, source.type, source.value_type->type);
+    }
+
+    if (column.type != source.type || column.type == Column_Type::VALUE)
+    {
+        set(row, index, from.get(from_row, from_index));
+        return;
+    }
+
+    switch (column.type)
+    {
+        case Column_Type::INT:
+        case Column_Type::BOOL: column.ints[row] = source.ints[from_row]; break;
+        case Column_Type::FLOAT: column.floats[row] = source.floats[from_row]; break;
+        case Column_Type::STRING: column.strings[row] = intern(from.strings[source.strings[from_row]]); break;
+        default: break;
+    }
+
+    column.missing[row] = false;
+
+    if (!column.nulls.empty())
+    {
+        column.nulls[row] = false;
+    }
+}
+
+// Assigns a property of a row, adding the column if no row has it yet.
+// A nullptr value removes the property
+
+void Table_Node::write(size_t row, const std::string& name, const Node_Ptr& value)
+{
+    int index = column_index(name);
+
+    if (index < 0)
+    {
+        if (value == nullptr)
+        {
+            return;
+        }
+
+        index = add_column(name);
+    }
+
+    set(row, index, value);
+}
+
+Node_Ptr Table_Node::row(size_t index)
+{
+    auto object = make_pooled_node(NodeType::OBJECT);
+    auto type = make_pooled_node(NodeType::OBJECT);
+    type->TYPE.is_literal = false;
+
+    for (size_t i = 0; i < columns.size(); i++)
+    {
+        auto value = get(index, i);
+
+        if (value == nullptr)
+        {
+            continue;
+        }
+
+        if (value->TYPE.allowed_type == nullptr)
+        {
+            value->TYPE.allowed_type = value;
+        }
+
+        object->OBJECT->properties[columns[i].name] = Object_Prop(true, value);
+        type->OBJECT->properties[columns[i].name] = Object_Prop(true, value->TYPE.allowed_type);
+    }
+
+    object->TYPE.allowed_type = type;
+    object->OBJECT->row.table = shared_from_this();
+    object->OBJECT->row.index = index;
+
+    return object;
+}
+
+// A new table holding copies of the given rows, in the order given
+
+std::shared_ptr<Table_Node> Table_Node::select(const std::vector<size_t>& selected)
+{
+    auto result = std::make_shared<Table_Node>();
+
+    for (auto& column : columns)
+    {
+        result->add_column(column.name);
+    }
+
+    for (auto row : selected)
+    {
+        result->push_row();
+
+        for (size_t i = 0; i < columns.size(); i++)
+        {
+            auto& from = columns[i];
+            auto& to = result->columns[i];
+
+            if (from.missing[row])
+            {
+                if (!from.nulls.empty() && from.nulls[row])
+                {
+                    result->set_null(result->rows - 1, i);
+                }
+
+                continue;
+            }
+
+            if (to.type == Column_Type::NONE)
+            {
+                to.type = from.type;
+                to.value_type = from.value_type;
+                to.ints.resize(from.type == Column_Type::INT || from.type == Column_Type::BOOL ? result->rows : 0);
+                to.floats.resize(from.type == Column_Type::FLOAT ? result->rows : 0);
+                to.strings.resize(from.type == Column_Type::STRING ? result->rows : 0);
+                to.values.resize(from.type == Column_Type::VALUE ? result->rows : 0);
+            }
+
+            size_t last = result->rows - 1;
+
+            switch (from.type)
+            {
+                case Column_Type::INT:
+                case Column_Type::BOOL: to.ints[last] = from.ints[row]; break;
+                case Column_Type::FLOAT: to.floats[last] = from.floats[row]; break;
+                case Column_Type::STRING: to.strings[last] = result->intern(strings[from.strings[row]]); break;
+                default: to.values[last] = from.values[row]; break;
+            }
+
+            to.missing[last] = false;
+        }
+    }
+
+    return result;
+}
+
+Sequence_Cursor::Sequence_Cursor(const Node_Ptr& iter) : iter(iter)
+{
+    if (iter->type == NodeType::RANGE)
+    {
+        count = iter->RANGE.start < iter->RANGE.end ? iter->RANGE.end - iter->RANGE.start : 0;
+    }
+    else if (iter->LIST.is_stream())
+    {
+        file = open_lines(*iter->LIST.path);
+    }
+    else
+    {
+        count = iter->LIST.size();
+    }
+}
+
+bool Sequence_Cursor::next()
+{
+    position++;
+
+    if (file)
+    {
+        while (read_line(*file, offset, line))
+        {
+            line_number++;
+
+            if (iter->LIST.keys == nullptr || !is_blank(line))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    return (size_t)position < count;
+}
+
+Node_Ptr Sequence_Cursor::value()
+{
+    if (file)
+    {
+        return iter->LIST.line_value(line, line_number);
+    }
+
+    if (iter->type == NodeType::RANGE)
+    {
+        auto node = make_pooled_node(NodeType::INT);
+        node->INT.value = iter->RANGE.start + position;
+        return node;
+    }
+
+    return iter->LIST.at(position);
+}
+
+std::string repr_obj(Node_Ptr obj, int depth = 0) {
                 
     if (obj->type != NodeType::OBJECT)
     {
@@ -8,7 +758,7 @@ std::string repr_obj(std::shared_ptr<Node> obj, int depth = 0) {
     }
 
     std::string repr = "{\n";
-    for (auto elem : obj->OBJECT.properties)
+    for (auto elem : obj->OBJECT->properties)
     {
         if (elem.second.value->type == NodeType::OBJECT)
         {
@@ -98,7 +848,7 @@ std::string Node::repr()
             }
 
             std::string repr = "[ ";
-            for (auto elem : LIST.nodes)
+            for (auto elem : LIST.nodes())
             {
                 std::string elem_repr = "";
                 if (elem->type == NodeType::STRING && elem->TYPE.is_literal)
@@ -118,7 +868,7 @@ std::string Node::repr()
         case NodeType::COMMA_LIST:
         {
             std::string repr = "( ";
-            for (auto elem : COMMA_LIST.nodes)
+            for (auto elem : COMMA_LIST->nodes)
             {
                 repr += (elem->repr() + " ");
             }
@@ -128,11 +878,11 @@ std::string Node::repr()
         case NodeType::PIPE_LIST:
         {
             std::string repr = "";
-            for (int i = 0; i < PIPE_LIST.nodes.size(); i++)
+            for (int i = 0; i < PIPE_LIST->nodes.size(); i++)
             {
-                auto elem = PIPE_LIST.nodes[i];
+                auto elem = PIPE_LIST->nodes[i];
                 repr += elem->repr();
-                if (i < PIPE_LIST.nodes.size()-1)
+                if (i < PIPE_LIST->nodes.size()-1)
                 {
                     repr += " | ";
                 }
@@ -154,7 +904,7 @@ std::string Node::repr()
             // return repr_obj(std::make_shared<Node>(*this));
 
             std::string repr = "{\n";
-            for (auto elem : OBJECT.properties)
+            for (auto elem : OBJECT->properties)
             {
                 repr += ("  " + elem.first + ": " + elem.second.value->repr() + "\n");
             }
@@ -168,13 +918,13 @@ std::string Node::repr()
                 return "function";
             }
 
-            if (FUNCTION.is_type && FUNCTION.name != "lambda")
+            if (FUNCTION->is_type && FUNCTION->name != "lambda")
             {
-                return FUNCTION.name;
+                return FUNCTION->name;
             }
 
             std::string repr = "[ ";
-            for (auto param : FUNCTION.params)
+            for (auto param : FUNCTION->params)
             {
                 std::string name;
 
@@ -218,7 +968,7 @@ std::string Node::repr()
                 
             }
 
-            auto ret_type = FUNCTION.return_type;
+            auto ret_type = FUNCTION->return_type;
             repr += "] => " + (ret_type == nullptr ? "any" : ret_type->type_repr()) ;
 
             return repr;
@@ -285,14 +1035,14 @@ std::string Node::type_repr()
             std::set<std::string> types;
             if (TYPE.allowed_type == nullptr)
             {
-                for (auto elem : LIST.nodes)
+                for (auto elem : LIST.nodes())
                 {
                     types.insert(elem->type_repr());
                 }
             }
             else
             {
-                for (auto elem : TYPE.allowed_type->LIST.nodes)
+                for (auto elem : TYPE.allowed_type->LIST.nodes())
                 {
                     types.insert(elem->type_repr());
                 }
@@ -316,11 +1066,11 @@ std::string Node::type_repr()
         case NodeType::PIPE_LIST:
         {
             std::string repr = "";
-            for (int i = 0; i < PIPE_LIST.nodes.size(); i++)
+            for (int i = 0; i < PIPE_LIST->nodes.size(); i++)
             {
-                auto elem = PIPE_LIST.nodes[i];
+                auto elem = PIPE_LIST->nodes[i];
                 repr += elem->repr();
-                if (i < PIPE_LIST.nodes.size()-1)
+                if (i < PIPE_LIST->nodes.size()-1)
                 {
                     repr += " | ";
                 }
@@ -335,7 +1085,7 @@ std::string Node::type_repr()
             }
 
             std::string repr = "{\n";
-            for (auto elem : OBJECT.properties)
+            for (auto elem : OBJECT->properties)
             {
                 repr += ("  " + elem.first + ": " + elem.second.value->repr() + "\n");
             }
@@ -344,13 +1094,13 @@ std::string Node::type_repr()
         }
         case NodeType::FUNCTION:
         {
-            if (FUNCTION.is_type && FUNCTION.name != "lambda")
+            if (FUNCTION->is_type && FUNCTION->name != "lambda")
             {
-                return FUNCTION.name;
+                return FUNCTION->name;
             }
             
             std::string repr = "[ ";
-            for (auto param : FUNCTION.params)
+            for (auto param : FUNCTION->params)
             {
                 std::string name;
 
@@ -394,17 +1144,17 @@ std::string Node::type_repr()
                 
             }
 
-            auto ret_type = FUNCTION.return_type;
+            auto ret_type = FUNCTION->return_type;
             if (ret_type == nullptr)
             {
-                ret_type = std::make_shared<Node>(NodeType::ANY);
+                ret_type = make_pooled_node(NodeType::ANY);
             }
 
             ret_type->TYPE.is_literal = false;
 
             if (ret_type->type == NodeType::PIPE_LIST)
             {
-                for (auto& t : ret_type->PIPE_LIST.nodes)
+                for (auto& t : ret_type->PIPE_LIST->nodes)
                 {
                     t->TYPE.is_literal = false;
                 }
@@ -5,6 +5,9 @@
 #include <iostream>
 #include <vector>
 #include <set>
+#include <algorithm>
+#include <fstream>
+#include "../Mapped_File/Mapped_File.hpp"
 
 enum class NodeType {
 	INT,
@@ -112,6 +115,180 @@ enum class NodeType {
 };
 
 struct Node;
+class Arena;
+class Evaluator;
+
+// Where a node's memory came from, how many handles point at it and its
+// state in the cycle collector. The header belongs to the allocation, so
+// copying a node never copies it.
+
+struct Ref_Header
+{
+	unsigned int count = 0;
+	int root_index = -1;
+	unsigned char color = 0;
+	Arena* arena = nullptr;
+
+	Ref_Header() = default;
+	Ref_Header(const Ref_Header&) {}
+	Ref_Header& operator=(const Ref_Header&) { return *this; }
+};
+
+void release_node(Node* node);
+void possible_root(Node* node);
+
+// Intrusive reference counted handle to a node. The interpreter runs on a
+// single thread, so the count is a plain integer and a handle must never
+// be shared between threads.
+
+template <typename T>
+class Ref
+{
+	T* ptr = nullptr;
+
+	void retain()
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		ptr->header.count++;
+	}
+
+	void release()
+	{
+		if (ptr == nullptr)
+		{
+			return;
+		}
+
+		if (--ptr->header.count == 0)
+		{
+			release_node(ptr);
+		}
+		else if (ptr->header.root_index < 0 && ptr->header.arena == nullptr)
+		{
+			// A node that survives a release may be kept alive only by a cycle
+			possible_root(ptr);
+		}
+	}
+
+public:
+
+	Ref() = default;
+	Ref(std::nullptr_t) {}
+	explicit Ref(T* ptr) : ptr(ptr) { retain(); }
+
+	Ref(const Ref& other) : ptr(other.ptr) { retain(); }
+	Ref(Ref&& other) noexcept : ptr(other.ptr) { other.ptr = nullptr; }
+
+	~Ref() { release(); }
+
+	Ref& operator=(const Ref& other)
+	{
+		T* old = ptr;
+		ptr = other.ptr;
+		retain();
+
+		if (old != nullptr)
+		{
+			Ref dropped;
+			dropped.ptr = old;
+		}
+
+		return *this;
+	}
+
+	Ref& operator=(Ref&& other) noexcept
+	{
+		if (this != &other)
+		{
+			Ref dropped;
+			dropped.ptr = ptr;
+			ptr = other.ptr;
+			other.ptr = nullptr;
+		}
+
+		return *this;
+	}
+
+	Ref& operator=(std::nullptr_t)
+	{
+		Ref dropped;
+		dropped.ptr = ptr;
+		ptr = nullptr;
+		return *this;
+	}
+
+	T* get() const { return ptr; }
+	T* operator->() const { return ptr; }
+
+	// Let go of the node without counting it down
+	T* detach()
+	{
+		T* old = ptr;
+		ptr = nullptr;
+		return old;
+	}
+
+	T& operator*() const { return *ptr; }
+	explicit operator bool() const { return ptr != nullptr; }
+
+	bool operator==(const Ref& other) const { return ptr == other.ptr; }
+	bool operator!=(const Ref& other) const { return ptr != other.ptr; }
+	bool operator==(std::nullptr_t) const { return ptr == nullptr; }
+	bool operator!=(std::nullptr_t) const { return ptr != nullptr; }
+};
+
+using Node_Ptr = Ref<Node>;
+
+// Storage for the payloads most nodes never use. The payload is only
+// allocated the first time it is touched, so tokens and scalar values do
+// not carry empty maps and vectors around, while copies of a node still
+// copy every payload it has.
+
+template <typename T>
+class Payload
+{
+	std::unique_ptr<T> data;
+
+public:
+	Payload() = default;
+	Payload(const Payload& other) : data(other.data ? std::make_unique<T>(*other.data) : nullptr) {}
+	Payload(Payload&& other) = default;
+
+	Payload& operator=(const Payload& other)
+	{
+		if (this != &other)
+		{
+			data = other.data ? std::make_unique<T>(*other.data) : nullptr;
+		}
+		return *this;
+	}
+
+	Payload& operator=(Payload&& other) = default;
+
+	T* operator->()
+	{
+		if (!data)
+		{
+			data = std::make_unique<T>();
+		}
+		return data.get();
+	}
+
+	T& operator*()
+	{
+		return *operator->();
+	}
+
+	// The payload if it has been allocated, without allocating it
+	T* get() const
+	{
+		return data.get();
+	}
+};
 
 struct Int_Node
 {
@@ -137,7 +314,8 @@ struct Bool_Node
 struct ID_Node
 {
 	std::string value = "";
-	std::shared_ptr<Node> type = nullptr;
+	Node_Ptr type = nullptr;
+	int slot = -1;
 	ID_Node() = default;
 	ID_Node(std::string value) : value(value) {}
 };
@@ -161,24 +339,189 @@ struct Op_Node
 
 struct Block_Node
 {
-	std::unordered_map<std::string, std::shared_ptr<Node>> symbol_table;
-	std::vector<std::shared_ptr<Node>> nodes;
+	std::unordered_map<std::string, Node_Ptr> symbol_table;
+	std::vector<Node_Ptr> nodes;
 	Block_Node() = default;
 };
 
 struct List_Node
 {
-	std::vector<std::shared_ptr<Node>> nodes;
+	std::vector<Node_Ptr> nodes;
 	List_Node() = default;
 };
 
+// Rows that share one set of columns, as csv.load returns them. Each column
+// keeps its cells in a vector of their own type, with strings stored once
+// in the table's pool, so a row costs a few bytes per column rather than an
+// object. row() builds the object for one row on demand; assigning to its
+// properties writes back to the table through Row_Link.
+
+enum class Column_Type
+{
+	NONE,
+	INT,
+	FLOAT,
+	BOOL,
+	STRING,
+	VALUE
+};
+
+struct Table_Column
+{
+	std::string name;
+	Column_Type type = Column_Type::NONE;
+	std::vector<long long> ints;
+	std::vector<double> floats;
+	std::vector<unsigned int> strings;
+	std::vector<Node_Ptr> values;
+	std::vector<bool> missing;
+
+	// Missing cells that read as an explicit null rather than as no
+	// property at all. Empty until the first one is set
+	std::vector<bool> nulls;
+
+	// The type every cell of a typed column is given
+	Node_Ptr value_type;
+};
+
+struct Table_Node : std::enable_shared_from_this<Table_Node>
+{
+	std::vector<Table_Column> columns;
+	std::vector<std::string> strings;
+	std::unordered_map<std::string, unsigned int> string_ids;
+	size_t rows = 0;
+
+	int column_index(const std::string& name) const;
+	size_t add_column(const std::string& name);
+	void push_row();
+	unsigned int intern(const std::string& value);
+
+	Node_Ptr get(size_t row, size_t column);
+	std::string key(size_t row, size_t column);
+	void set(size_t row, size_t column, const Node_Ptr& value);
+	void set_missing(size_t row, size_t column);
+	void set_null(size_t row, size_t column);
+	void copy(size_t row, size_t column, Table_Node& from, size_t from_row, size_t from_column);
+	void write(size_t row, const std::string& name, const Node_Ptr& value);
+
+	Node_Ptr row(size_t index);
+	std::shared_ptr<Table_Node> select(const std::vector<size_t>& rows);
+
+private:
+	void set_type(Table_Column& column, Column_Type type, NodeType node_type);
+	void box(Table_Column& column);
+};
+
+// The elements of a list value. A list made by a..b starts out lazy and
+// only records its bounds, and one made by lines[path] only its file: for
+// loops, map, filter and foreach walk them with a Sequence_Cursor, and a
+// range is also indexed through size() and at(). Anything else goes through
+// nodes(), which builds the elements once and leaves a plain list behind.
+// A table is indexed the same way; copies of the list share it, as copies
+// of a list of objects share the objects. Copies of a lazy list share what
+// the first of them to be materialized built, so that they alias the same
+// elements, as copies of a plain list do.
+
+struct Materialized
+{
+	bool done = false;
+	std::vector<Node_Ptr> elements;
+};
+
+struct Sequence_Node
+{
+	std::vector<Node_Ptr> elements;
+	bool lazy = false;
+	long long start = 0, end = 0;
+	Payload<std::string> path;
+	std::shared_ptr<Table_Node> table;
+	std::shared_ptr<Materialized> materialized;
+
+	// Set by ndjson.lines[path], which reads each line as JSON. When it
+	// names any keys, only those properties of each object are built
+	std::shared_ptr<const std::vector<std::string>> keys;
+
+	std::vector<Node_Ptr>& nodes()
+	{
+		if (lazy)
+		{
+			materialize();
+		}
+
+		return elements;
+	}
+
+	// A list made by lines[path] reads its file on every pass, so it has
+	// no size until it is materialized
+
+	bool is_stream() const
+	{
+		return lazy && path.get() != nullptr;
+	}
+
+	bool is_table() const
+	{
+		return lazy && table != nullptr;
+	}
+
+	size_t size()
+	{
+		if (is_stream())
+		{
+			materialize();
+		}
+
+		if (is_table())
+		{
+			return table->rows;
+		}
+
+		if (lazy)
+		{
+			return start <= end ? end - start : start - end;
+		}
+
+		return elements.size();
+	}
+
+	long long value_at(size_t index) const
+	{
+		return start <= end ? start + (long long)index : start - (long long)index;
+	}
+
+	Node_Ptr at(size_t index);
+	Node_Ptr sample();
+	void set_range(long long start, long long end);
+	void set_lines(const std::string& path);
+	void set_json_lines(const std::string& path, std::vector<std::string> keys);
+	Node_Ptr line_value(const std::string& line, size_t number);
+	void set_table(std::shared_ptr<Table_Node> table);
+	void materialize();
+
+private:
+	void build();
+};
+
 struct Object_Prop
 {
 	bool required = true;
-	std::shared_ptr<Node> value;
+	Node_Ptr value;
 
 	Object_Prop() {}
-	Object_Prop(bool required, std::shared_ptr<Node> value) : required(required), value(value) {}
+	Object_Prop(bool required, Node_Ptr value) : required(required), value(value) {}
+};
+
+// The table row an object was built from. A copy of the object is a new
+// object, so the link is not copied with it
+
+struct Row_Link
+{
+	std::shared_ptr<Table_Node> table;
+	size_t index = 0;
+
+	Row_Link() = default;
+	Row_Link(const Row_Link&) {}
+	Row_Link& operator=(const Row_Link&) { table = nullptr; return *this; }
 };
 
 struct Object_Node
@@ -186,66 +529,73 @@ struct Object_Node
 	std::string name;
 	std::unordered_map<std::string, Object_Prop> properties;
 	bool is_type = false;
+	Row_Link row;
 };
 
 struct Func_Call_Node
 {
 	std::string name;
-	std::shared_ptr<Node> caller;
-	std::vector<std::shared_ptr<Node>> args;
+	int slot = -1;
+	Node_Ptr caller;
+	std::vector<Node_Ptr> args;
 };
 
 struct Function_Node
 {
 	std::string name = "lambda";
-	std::shared_ptr<Node> return_type;
-	std::vector<std::shared_ptr<Node>> params;
-	std::vector<std::shared_ptr<Node>> args;
-	std::shared_ptr<Node> body;
-	std::unordered_map<std::string, std::shared_ptr<Node>> closure;
+	Node_Ptr return_type;
+	std::vector<Node_Ptr> params;
+	std::vector<Node_Ptr> args;
+	Node_Ptr body;
+	std::unordered_map<std::string, Node_Ptr> closure;
 	std::vector<int> default_arg_indices;
 	bool is_type = false;
 	bool typechecked = false;
+	bool is_builtin = false;
+
+	// The main program's scope, for a function defined in the program. Its
+	// calls find the program's globals there rather than in the closure
+	Evaluator* globals = nullptr;
 };
 
 struct If_Statement_Node
 {
-	std::shared_ptr<Node> conditional;
-	std::shared_ptr<Node> body;
+	Node_Ptr conditional;
+	Node_Ptr body;
 };
 
 struct If_Block_Node
 {
-	std::vector<std::shared_ptr<Node>> cases;
+	std::vector<Node_Ptr> cases;
 };
 
 struct Match_Block_Node
 {
-	std::shared_ptr<Node> value;
-	std::vector<std::shared_ptr<Node>> cases;
+	Node_Ptr value;
+	std::vector<Node_Ptr> cases;
 };
 
 struct For_Loop_Node
 {
-	std::shared_ptr<Node> init_list;
-	std::shared_ptr<Node> body;
+	Node_Ptr init_list;
+	Node_Ptr body;
 };
 
 struct While_Loop_Node
 {
-	std::shared_ptr<Node> conditional;
-	std::shared_ptr<Node> body;
+	Node_Ptr conditional;
+	Node_Ptr body;
 };
 
 struct Range_Node
 {
-	int start, end = 0;
+	int start = 0, end = 0;
 };
 
 struct Type_Node
 {
 	bool is_literal = true;
-	std::shared_ptr<Node> allowed_type;
+	Node_Ptr allowed_type;
 	std::string name;
 };
 
@@ -256,13 +606,15 @@ struct Error_Node
 
 struct Node
 {
+	Ref_Header header;
+
 	NodeType type;
 
 	int column = 1;
 	int line = 1;
 
-	std::shared_ptr<Node> left = nullptr;
-	std::shared_ptr<Node> right = nullptr;
+	Node_Ptr left = nullptr;
+	Node_Ptr right = nullptr;
 
 	Node() = default;
 	Node(NodeType type) : type(type) {}
@@ -270,30 +622,55 @@ struct Node
 	Node(NodeType type, int line, int column) : type(type), line(line), column(column) {}
 
 
-	Int_Node				INT;
-	Float_Node				FLOAT;
-	Bool_Node				BOOL;
-	ID_Node					ID;
-	String_Node				STRING;
-	Op_Node					OP;
-	Block_Node				BLOCK;
-	Object_Node				OBJECT;
-	List_Node				LIST;
-	Func_Call_Node			FUNC_CALL;
-	Error_Node				ERROR;
-	List_Node				COMMA_LIST;
-	List_Node				PIPE_LIST;
-	List_Node				FUNC_LIST;
-	Function_Node			FUNCTION;
-	If_Statement_Node		IF_STATEMENT;
-	If_Block_Node			IF_BLOCK;
-	Match_Block_Node		MATCH_BLOCK;
-	For_Loop_Node			FOR_LOOP;
-	While_Loop_Node			WHILE_LOOP;
-	Range_Node				RANGE;
-	Type_Node				TYPE;
+	Int_Node							INT;
+	Float_Node							FLOAT;
+	Bool_Node							BOOL;
+	ID_Node								ID;
+	String_Node							STRING;
+	Op_Node								OP;
+	Sequence_Node						LIST;
+	Range_Node							RANGE;
+	Type_Node							TYPE;
+
+	Payload<Block_Node>					BLOCK;
+	Payload<Object_Node>				OBJECT;
+	Payload<Func_Call_Node>				FUNC_CALL;
+	Payload<Error_Node>					ERROR;
+	Payload<List_Node>					COMMA_LIST;
+	Payload<List_Node>					PIPE_LIST;
+	Payload<List_Node>					FUNC_LIST;
+	Payload<Function_Node>				FUNCTION;
+	Payload<If_Statement_Node>			IF_STATEMENT;
+	Payload<If_Block_Node>				IF_BLOCK;
+	Payload<Match_Block_Node>			MATCH_BLOCK;
+	Payload<For_Loop_Node>				FOR_LOOP;
+	Payload<While_Loop_Node>			WHILE_LOOP;
 	bool					is_type = false;
 
 	std::string repr();
 	std::string type_repr();
+};
+
+// Walks the elements of a list or range in order. Lazy lists are not
+// materialized: a range produces its values as it goes and lines[path]
+// reads its file a line at a time. The number of elements is fixed when
+// the walk starts, as it always has been for loops.
+
+class Sequence_Cursor
+{
+	Node_Ptr iter;
+	long long position = -1;
+	size_t count = 0;
+	std::unique_ptr<Mapped_File> file;
+	size_t offset = 0;
+	std::string line;
+	size_t line_number = 0;
+
+public:
+
+	Sequence_Cursor() = default;
+	explicit Sequence_Cursor(const Node_Ptr& iter);
+
+	bool next();
+	Node_Ptr value();
 };
\ No newline at end of file
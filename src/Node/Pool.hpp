@@ -0,0 +1,126 @@
+#pragma once
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <iostream>
+
+#include "Node.hpp"
+
+// Free lists for the values created while a program runs. Intermediate
+// results are allocated and dropped on every iteration of a loop or
+// pipeline, so released blocks are kept per size class and handed straight
+// back out instead of going through malloc.
+
+struct Pool_Stats
+{
+    size_t allocations = 0;
+    size_t reused = 0;
+    size_t released = 0;
+    size_t live = 0;
+    size_t peak = 0;
+    size_t reserved_bytes = 0;
+};
+
+class Node_Pool
+{
+    static constexpr size_t granularity = 16;
+    static constexpr size_t max_size = 1024;
+    static constexpr size_t chunk_count = 64;
+
+    struct Free_Block
+    {
+        Free_Block* next;
+    };
+
+    Free_Block* free_lists[max_size / granularity + 1] = {};
+
+public:
+
+    Pool_Stats stats;
+
+    // Never destroyed: pooled values may still be released by other
+    // statics after main returns
+
+    static Node_Pool& get()
+    {
+        static Node_Pool* pool = new Node_Pool();
+        return *pool;
+    }
+
+    void* allocate(size_t size)
+    {
+        stats.allocations++;
+        stats.live++;
+
+        if (stats.live > stats.peak)
+        {
+            stats.peak = stats.live;
+        }
+
+        if (size > max_size)
+        {
+            return ::operator new(size);
+        }
+
+        size_t size_class = (size + granularity - 1) / granularity;
+        auto& list = free_lists[size_class];
+
+        if (list != nullptr)
+        {
+            stats.reused++;
+            auto block = list;
+            list = block->next;
+            return block;
+        }
+
+        // Carve a fresh chunk into blocks of this size class
+
+        size_t block_size = size_class * granularity;
+        char* chunk = static_cast<char*>(::operator new(block_size * chunk_count));
+        stats.reserved_bytes += block_size * chunk_count;
+
+        for (size_t i = 1; i < chunk_count; i++)
+        {
+            auto block = reinterpret_cast<Free_Block*>(chunk + i * block_size);
+            block->next = list;
+            list = block;
+        }
+
+        return chunk;
+    }
+
+    void deallocate(void* ptr, size_t size)
+    {
+        stats.released++;
+        stats.live--;
+
+        if (size > max_size)
+        {
+            ::operator delete(ptr);
+            return;
+        }
+
+        auto& list = free_lists[(size + granularity - 1) / granularity];
+        auto block = static_cast<Free_Block*>(ptr);
+        block->next = list;
+        list = block;
+    }
+
+    void print_stats(std::ostream& out)
+    {
+        out << "Allocations: " << stats.allocations << "\n";
+        out << "Reused: " << stats.reused << "\n";
+        out << "Released: " << stats.released << "\n";
+        out << "Live: " << stats.live << "\n";
+        out << "Peak live: " << stats.peak << "\n";
+        out << "Reserved bytes: " << stats.reserved_bytes << "\n";
+    }
+};
+
+// Drop-in replacement for std::make_shared<Node> for runtime values
+
+template <typename... Args>
+Node_Ptr make_pooled_node(Args&&... args)
+{
+    return Node_Ptr(new (Node_Pool::get().allocate(sizeof(Node))) Node(std::forward<Args>(args)...));
+}
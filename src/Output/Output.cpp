@@ -0,0 +1,243 @@
+#include <iostream>
+#include <cstdlib>
+#include "Output.hpp"
+#include "../Mapped_File/Mapped_File.hpp"
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+// What is held for the console or a file before it is passed on
+static const size_t block_size = 1 << 16;
+
+// What is held for a file opened by open[path mode]
+static const size_t handle_size = 1 << 20;
+
+// Past this many files open for writes by path, they are all closed before
+// another is opened. Handles from open[path mode] don't count
+static const size_t max_open = 64;
+
+// Never destroyed, like the collector; what it holds is flushed at exit
+
+Output& Output::get()
+{
+    static Output* output = nullptr;
+
+    if (output == nullptr)
+    {
+        output = new Output();
+        std::atexit([]() { Output::get().close(); });
+
+#ifdef _WIN32
+        output->interactive = _isatty(_fileno(stdout));
+#else
+        output->interactive = isatty(STDOUT_FILENO);
+#endif
+    }
+
+    return *output;
+}
+
+void Output::print(const std::string& text)
+{
+    console += text;
+
+    if (console.size() >= block_size || (interactive && text.find('\n') != std::string::npos))
+    {
+        std::cout.write(console.data(), console.size());
+        std::cout << std::flush;
+        console.clear();
+    }
+}
+
+// --- Files --- //
+
+std::unique_ptr<Output::Sink> Output::open_sink(const std::string& path, bool append)
+{
+    if (!append)
+    {
+        Mapped_File::detach(path);
+    }
+
+    auto sink = std::make_unique<Sink>();
+    sink->path = path;
+    sink->file.open(path, std::ios::binary | (append ? std::ios::app : std::ios::trunc));
+    sink->capacity = block_size;
+
+    if (!sink->file)
+    {
+        return nullptr;
+    }
+
+    return sink;
+}
+
+// A write starts the file over, so whatever it had open for writes by path
+// is closed first
+
+Output::Sink* Output::sink(const std::string& path, bool append)
+{
+    auto it = files.find(path);
+
+    if (it != files.end())
+    {
+        if (append)
+        {
+            return it->second.get();
+        }
+
+        close(path);
+    }
+
+    if (files.size() >= max_open)
+    {
+        for (auto& file : files)
+        {
+            flush(*file.second);
+        }
+
+        files.clear();
+    }
+
+    auto sink = open_sink(path, append);
+
+    if (sink == nullptr)
+    {
+        return nullptr;
+    }
+
+    auto result = sink.get();
+    files[path] = std::move(sink);
+    return result;
+}
+
+int Output::open(const std::string& path, bool append)
+{
+    auto sink = open_sink(path, append);
+
+    if (sink == nullptr)
+    {
+        return -1;
+    }
+
+    sink->capacity = handle_size;
+    sink->buffer.reserve(handle_size);
+
+    int handle = next_handle++;
+    handles[handle] = std::move(sink);
+    return handle;
+}
+
+bool Output::is_open(int handle)
+{
+    return handles.find(handle) != handles.end();
+}
+
+void Output::add(Sink& sink, const std::string& text)
+{
+    sink.buffer += text;
+
+    if (sink.buffer.size() >= sink.capacity)
+    {
+        flush(sink);
+    }
+}
+
+bool Output::write(const std::string& path, const std::string& text, bool append)
+{
+    auto opened = sink(path, append);
+
+    if (opened == nullptr)
+    {
+        return false;
+    }
+
+    add(*opened, text);
+    return true;
+}
+
+bool Output::write(int handle, const std::string& text)
+{
+    auto it = handles.find(handle);
+
+    if (it == handles.end())
+    {
+        return false;
+    }
+
+    add(*it->second, text);
+    return true;
+}
+
+void Output::flush(Sink& sink)
+{
+    sink.file.write(sink.buffer.data(), sink.buffer.size());
+    sink.file.flush();
+    sink.buffer.clear();
+}
+
+void Output::flush()
+{
+    for (auto& file : files)
+    {
+        flush(*file.second);
+    }
+
+    for (auto& handle : handles)
+    {
+        flush(*handle.second);
+    }
+
+    std::cout.write(console.data(), console.size());
+    std::cout << std::flush;
+    console.clear();
+}
+
+// Everything written to a file so far, by path or through any handle to it
+
+void Output::flush(const std::string& path)
+{
+    auto it = files.find(path);
+
+    if (it != files.end())
+    {
+        flush(*it->second);
+    }
+
+    for (auto& handle : handles)
+    {
+        if (handle.second->path == path)
+        {
+            flush(*handle.second);
+        }
+    }
+}
+
+void Output::close()
+{
+    flush();
+    files.clear();
+    handles.clear();
+}
+
+// Closes what was opened for writes by path. Handles to the file stay open,
+// but what they hold is passed on first
+
+void Output::close(const std::string& path)
+{
+    flush(path);
+    files.erase(path);
+}
+
+void Output::close(int handle)
+{
+    auto it = handles.find(handle);
+
+    if (it != handles.end())
+    {
+        flush(*it->second);
+        handles.erase(it);
+    }
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include <string>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+
+// Holds what a program prints and writes to files until there is enough of
+// it to be worth passing on, so many small writes cost one system call
+// rather than one each. When the console is a terminal, what is printed is
+// passed on at the end of each line instead, so a person watching sees it
+// as it happens. Files written to stay open, and later writes and
+// appends to the same path go to the same handle. Everything is flushed when
+// the program exits, and before a runtime error is reported; a file is
+// flushed before it is read back. A file opened by open[path mode] gets a
+// handle of its own, with a larger buffer, known by its id rather than its
+// path: writes and closes by path never reach it, and it stays open until
+// it is closed by its id. What such a handle holds is still passed on
+// before the file is written whole by path, as json.write and ndjson.write
+// do, but the handle keeps writing at its own offset afterwards, so it is
+// closed first by a program that mixes the two.
+
+class Output
+{
+    struct Sink
+    {
+        std::string path;
+        std::ofstream file;
+        std::string buffer;
+        size_t capacity;
+    };
+
+    std::string console;
+    bool interactive = false;
+    std::unordered_map<std::string, std::unique_ptr<Sink>> files;
+    std::unordered_map<int, std::unique_ptr<Sink>> handles;
+    int next_handle = 1;
+
+    std::unique_ptr<Sink> open_sink(const std::string& path, bool append);
+    Sink* sink(const std::string& path, bool append);
+    void flush(Sink& sink);
+    void add(Sink& sink, const std::string& text);
+
+public:
+
+    static Output& get();
+
+    // Returns the id of the new handle, or -1 when the file cannot be opened
+    int open(const std::string& path, bool append);
+    bool is_open(int handle);
+
+    void print(const std::string& text);
+
+    // Returns false when the file cannot be opened
+    bool write(const std::string& path, const std::string& text, bool append);
+
+    // Returns false when the handle is not open
+    bool write(int handle, const std::string& text);
+
+    void flush();
+    void flush(const std::string& path);
+
+    void close();
+    void close(const std::string& path);
+    void close(int handle);
+};
@@ -1,16 +1,17 @@
 #include "Parser.hpp"
-
-auto parser_error_node = std::make_shared<Node>(NodeType::ERROR);
-auto parser_empty_node = std::make_shared<Node>(NodeType::EMPTY);
-auto parser_string_node = std::make_shared<Node>(NodeType::STRING);
-auto parser_int_node = std::make_shared<Node>(NodeType::INT);
-auto parser_float_node = std::make_shared<Node>(NodeType::FLOAT);
-auto parser_bool_node = std::make_shared<Node>(NodeType::BOOL);
-auto parser_list_node = std::make_shared<Node>(NodeType::LIST);
-auto parser_object_node = std::make_shared<Node>(NodeType::OBJECT);
-auto parser_range_node = std::make_shared<Node>(NodeType::RANGE);
-auto parser_function_node = std::make_shared<Node>(NodeType::FUNCTION);
-auto parser_any_node = std::make_shared<Node>(NodeType::ANY);
+#include "../Output/Output.hpp"
+
+auto parser_error_node = make_pooled_node(NodeType::ERROR);
+auto parser_empty_node = make_pooled_node(NodeType::EMPTY);
+auto parser_string_node = make_pooled_node(NodeType::STRING);
+auto parser_int_node = make_pooled_node(NodeType::INT);
+auto parser_float_node = make_pooled_node(NodeType::FLOAT);
+auto parser_bool_node = make_pooled_node(NodeType::BOOL);
+auto parser_list_node = make_pooled_node(NodeType::LIST);
+auto parser_object_node = make_pooled_node(NodeType::OBJECT);
+auto parser_range_node = make_pooled_node(NodeType::RANGE);
+auto parser_function_node = make_pooled_node(NodeType::FUNCTION);
+auto parser_any_node = make_pooled_node(NodeType::ANY);
 
 std::vector<std::string> keywords = {
     "ret",
@@ -37,6 +38,11 @@ std::vector<NodeType> end_types = {
     NodeType::END_OF_FILE
 };
 
+Node_Ptr Parser::make_node(NodeType type)
+{
+    return arena->make_node(type);
+}
+
 void Parser::advance(int n)
 {
     if ((index + n) >= nodes.size())
@@ -57,7 +63,7 @@ void Parser::advance(int n)
     column = current_node->column; 
 }
 
-std::shared_ptr<Node>& Parser::peek(int n)
+Node_Ptr& Parser::peek(int n)
 {
     if ((index + n) >= nodes.size())
     {
@@ -115,7 +121,7 @@ void Parser::parse_block()
     auto _start = nodes.begin() + start + 1;
     auto _end = nodes.begin() + end;
 
-    nodes[start]->BLOCK.nodes = std::vector<std::shared_ptr<Node>>(_start, _end);
+    nodes[start]->BLOCK->nodes = std::vector<Node_Ptr>(_start, _end);
 
     nodes.erase(_start, _end + 1);
 
@@ -143,7 +149,7 @@ void Parser::parse_list()
     auto _start = nodes.begin() + start + 1;
     auto _end = nodes.begin() + end;
 
-    nodes[start]->LIST.nodes = std::vector<std::shared_ptr<Node>>(_start, _end);
+    nodes[start]->LIST.nodes() = std::vector<Node_Ptr>(_start, _end);
 
     nodes.erase(_start, _end + 1);
 
@@ -197,28 +203,28 @@ void Parser::parse_function_call()
     auto previous_node_type = current_node_type;
     current_node_type = NodeType::FUNC_CALL;
 
-    auto func_call_node = std::make_shared<Node>(NodeType::FUNC_CALL);
+    auto func_call_node = make_node(NodeType::FUNC_CALL);
     func_call_node->line = current_node->line;
     func_call_node->column = current_node->column;
 
     if (current_node->type == NodeType::ID)
     {
-        func_call_node->FUNC_CALL.name = current_node->ID.value;
+        func_call_node->FUNC_CALL->name = current_node->ID.value;
     }
     else if (current_node->type == NodeType::FUNCTION)
     {
-        func_call_node->FUNC_CALL.name = current_node->FUNCTION.name;
+        func_call_node->FUNC_CALL->name = current_node->FUNCTION->name;
     }
     else
     {
-        func_call_node->FUNC_CALL.name = current_node->FUNC_CALL.name;
+        func_call_node->FUNC_CALL->name = current_node->FUNC_CALL->name;
     }
 
-    // func_call_node->FUNC_CALL.name = current_node->type == NodeType::ID ? current_node->ID.value : current_node->FUNCTION.name;
-    func_call_node->FUNC_CALL.caller = current_node;
-    func_call_node->FUNC_CALL.args = peek()->LIST.nodes;
+    // func_call_node->FUNC_CALL->name = current_node->type == NodeType::ID ? current_node->ID.value : current_node->FUNCTION->name;
+    func_call_node->FUNC_CALL->caller = current_node;
+    func_call_node->FUNC_CALL->args = peek()->LIST.nodes();
 
-    // for (auto arg : func_call_node->FUNC_CALL.args)
+    // for (auto arg : func_call_node->FUNC_CALL->args)
     // {
     //     if (arg->type == NodeType::ID && arg->ID.type != nullptr)
     //     {
@@ -238,7 +244,7 @@ void Parser::parse_function_def()
     auto previous_node_type = current_node_type;
     current_node_type = NodeType::FUNCTION;
 
-    auto func_node = std::make_shared<Node>(NodeType::FUNCTION);
+    auto func_node = make_node(NodeType::FUNCTION);
     func_node->line = current_node->line;
     func_node->column = current_node->column;
 
@@ -251,30 +257,30 @@ void Parser::parse_function_def()
     
     if (params->type == NodeType::ID)
     {
-        func_node->FUNCTION.params.push_back(params);
+        func_node->FUNCTION->params.push_back(params);
     }
     else
     {
-        func_node->FUNCTION.params = params->type == NodeType::LIST ? params->LIST.nodes : params->left->LIST.nodes;
+        func_node->FUNCTION->params = params->type == NodeType::LIST ? params->LIST.nodes() : params->left->LIST.nodes();
     }
     
     // add nullptrs where the args should be, to maintain positions
 
-    for (int i = 0; i < func_node->FUNCTION.params.size(); i++)
+    for (int i = 0; i < func_node->FUNCTION->params.size(); i++)
     {
-        if (func_node->FUNCTION.params[i]->OP.op_type == NodeType::EQUAL)
+        if (func_node->FUNCTION->params[i]->OP.op_type == NodeType::EQUAL)
         {
-            func_node->FUNCTION.args.push_back(func_node->FUNCTION.params[i]->right);
-            func_node->FUNCTION.default_arg_indices.push_back(i);
+            func_node->FUNCTION->args.push_back(func_node->FUNCTION->params[i]->right);
+            func_node->FUNCTION->default_arg_indices.push_back(i);
         }
         else
         {
-            func_node->FUNCTION.args.push_back(nullptr);
+            func_node->FUNCTION->args.push_back(nullptr);
         }
     }
 
-    func_node->FUNCTION.return_type = params->type == NodeType::LIST || params->type == NodeType::ID ? nullptr : params->right;
-    func_node->FUNCTION.body = peek();
+    func_node->FUNCTION->return_type = params->type == NodeType::LIST || params->type == NodeType::ID ? nullptr : params->right;
+    func_node->FUNCTION->body = peek();
 
     nodes.erase(nodes.begin() + index + 1);
     nodes.erase(nodes.begin() + index - 1);
@@ -368,7 +374,7 @@ void Parser::parse_bin_op()
     || (prev->type == NodeType::OP && prev->OP.is_binary && (prev->left == nullptr || prev->right == nullptr)))
     {
         current_node->type = NodeType::PARTIAL_OP;
-        current_node->left = std::make_shared<Node>(NodeType::EMPTY);
+        current_node->left = make_node(NodeType::EMPTY);
 
         if (prev->ID.value == "_")
         {
@@ -385,7 +391,7 @@ void Parser::parse_bin_op()
     || (next->type == NodeType::OP && next->OP.is_binary && (next->left == nullptr || next->right == nullptr)))
     {
         current_node->type = NodeType::PARTIAL_OP;
-        current_node->right = std::make_shared<Node>(NodeType::EMPTY);
+        current_node->right = make_node(NodeType::EMPTY);
 
         if (next->ID.value == "_")
         {
@@ -451,12 +457,12 @@ void Parser::parse_bin_op()
 
         if (current_node->right->type == NodeType::OBJECT)
         {
-            current_node->right->OBJECT.name = current_node->left->type == NodeType::ID ? current_node->left->ID.value : "";
+            current_node->right->OBJECT->name = current_node->left->type == NodeType::ID ? current_node->left->ID.value : "";
         }
 
         if (current_node->right->type == NodeType::FUNCTION)
         {
-            current_node->right->FUNCTION.name = current_node->left->type == NodeType::ID ? current_node->left->ID.value : "";
+            current_node->right->FUNCTION->name = current_node->left->type == NodeType::ID ? current_node->left->ID.value : "";
         }
     }
 
@@ -471,7 +477,7 @@ void Parser::parse(NodeType end_node_type, int start)
         {
             if (current_node->ID.value == "int")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::INT);
+                nodes[index] = make_node(NodeType::INT);
                 nodes[index]->INT.value = NULL;
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
@@ -480,7 +486,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "float")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::FLOAT);
+                nodes[index] = make_node(NodeType::FLOAT);
                 nodes[index]->FLOAT.value = NULL;
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
@@ -489,7 +495,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "string")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::STRING);
+                nodes[index] = make_node(NodeType::STRING);
                 nodes[index]->STRING.value = "___string::default";
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
@@ -498,7 +504,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "bool")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::BOOL);
+                nodes[index] = make_node(NodeType::BOOL);
                 nodes[index]->BOOL.value = NULL;
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
@@ -507,7 +513,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "list")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::LIST);
+                nodes[index] = make_node(NodeType::LIST);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -515,8 +521,8 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "object")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::OBJECT);
-                nodes[index]->OBJECT.is_type = true;
+                nodes[index] = make_node(NodeType::OBJECT);
+                nodes[index]->OBJECT->is_type = true;
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -524,16 +530,16 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "function")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::FUNCTION);
+                nodes[index] = make_node(NodeType::FUNCTION);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
-                nodes[index]->FUNCTION.return_type = std::make_shared<Node>(NodeType::ANY);
+                nodes[index]->FUNCTION->return_type = make_node(NodeType::ANY);
                 nodes[index]->line = current_node->line;
                 nodes[index]->column = current_node->column;
             }
             else if (current_node->ID.value == "type")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::TYPE);
+                nodes[index] = make_node(NodeType::TYPE);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -541,7 +547,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "any")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::ANY);
+                nodes[index] = make_node(NodeType::ANY);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -549,7 +555,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "null")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::EMPTY);
+                nodes[index] = make_node(NodeType::EMPTY);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -557,7 +563,7 @@ void Parser::parse(NodeType end_node_type, int start)
             }
             else if (current_node->ID.value == "partial")
             {
-                nodes[index] = std::make_shared<Node>(NodeType::PARTIAL_OP);
+                nodes[index] = make_node(NodeType::PARTIAL_OP);
                 nodes[index]->TYPE.is_literal = false;
                 nodes[index]->TYPE.allowed_type = nodes[index];
                 nodes[index]->line = current_node->line;
@@ -613,7 +619,7 @@ void Parser::parse(NodeType end_node_type, int start)
             auto conditional = peek(1);
             auto body = peek(2);
 
-            if (conditional->LIST.nodes.size() != 1)
+            if (conditional->LIST.nodes().size() != 1)
             {
                 error_and_exit("If statement expects a boolean conditional");
             }
@@ -624,8 +630,8 @@ void Parser::parse(NodeType end_node_type, int start)
             }
 
             current_node->type = NodeType::IF_STATEMENT;
-            current_node->IF_STATEMENT.conditional = conditional->LIST.nodes[0];
-            current_node->IF_STATEMENT.body = body;
+            current_node->IF_STATEMENT->conditional = conditional->LIST.nodes()[0];
+            current_node->IF_STATEMENT->body = body;
 
             nodes.erase(nodes.begin() + index + 2);
             nodes.erase(nodes.begin() + index + 1);
@@ -634,7 +640,7 @@ void Parser::parse(NodeType end_node_type, int start)
         if (current_node->type == NodeType::ID && current_node->ID.value == "if" && peek(1)->type == NodeType::BLOCK)
         {
             current_node->type = NodeType::IF_BLOCK;
-            current_node->IF_BLOCK.cases = peek(1)->BLOCK.nodes;
+            current_node->IF_BLOCK->cases = peek(1)->BLOCK->nodes;
 
             nodes.erase(nodes.begin() + index + 1);
         }
@@ -644,7 +650,7 @@ void Parser::parse(NodeType end_node_type, int start)
             auto value_list = peek(1);
             auto body = peek(2);
 
-            if (value_list->LIST.nodes.size() != 1)
+            if (value_list->LIST.nodes().size() != 1)
             {
                 error_and_exit("Match statement expects a value to match against");
             }
@@ -655,13 +661,13 @@ void Parser::parse(NodeType end_node_type, int start)
             }
 
             current_node->type = NodeType::MATCH_BLOCK;
-            current_node->MATCH_BLOCK.value = value_list->LIST.nodes[0];
-            //current_node->MATCH_BLOCK.cases = body->BLOCK.nodes;
-            for (auto elem : body->BLOCK.nodes)
+            current_node->MATCH_BLOCK->value = value_list->LIST.nodes()[0];
+            //current_node->MATCH_BLOCK->cases = body->BLOCK->nodes;
+            for (auto elem : body->BLOCK->nodes)
             {
                 if (elem->OP.op_type != NodeType::SEMICOLON)
                 {
-                    current_node->MATCH_BLOCK.cases.push_back(elem);
+                    current_node->MATCH_BLOCK->cases.push_back(elem);
                 }
             }
 
@@ -679,11 +685,11 @@ void Parser::parse(NodeType end_node_type, int start)
             {
                 error_and_exit("Incorrect for loop syntax, missing initializer list");
             }
-            if (for_list->LIST.nodes.size() == 0)
+            if (for_list->LIST.nodes().size() == 0)
             {
                 error_and_exit("Incorrect for loop syntax, empty initializer list");
             }
-            if (for_list->LIST.nodes.size() > 3)
+            if (for_list->LIST.nodes().size() > 3)
             {
                 error_and_exit("Incorrect for loop syntax, too many arguments in initializer list - maximum arguments count is 3 [iterator index value]");
             }
@@ -693,8 +699,8 @@ void Parser::parse(NodeType end_node_type, int start)
             }
 
             current_node->type = NodeType::FOR_LOOP;
-            current_node->FOR_LOOP.init_list = for_list;
-            current_node->FOR_LOOP.body = for_body;
+            current_node->FOR_LOOP->init_list = for_list;
+            current_node->FOR_LOOP->body = for_body;
 
             nodes.erase(nodes.begin() + index + 2);
             nodes.erase(nodes.begin() + index + 1);
@@ -709,11 +715,11 @@ void Parser::parse(NodeType end_node_type, int start)
             {
                 error_and_exit("Incorrect while loop syntax, missing conditional");
             }
-            if (conditional->LIST.nodes.size() == 0)
+            if (conditional->LIST.nodes().size() == 0)
             {
                 error_and_exit("Incorrect while loop syntax, empty conditional");
             }
-            if (conditional->LIST.nodes.size() != 1)
+            if (conditional->LIST.nodes().size() != 1)
             {
                 error_and_exit("While loop expects a boolean conditional");
             }
@@ -723,8 +729,8 @@ void Parser::parse(NodeType end_node_type, int start)
             }
 
             current_node->type = NodeType::WHILE_LOOP;
-            current_node->WHILE_LOOP.conditional = conditional->LIST.nodes[0];
-            current_node->WHILE_LOOP.body = body;
+            current_node->WHILE_LOOP->conditional = conditional->LIST.nodes()[0];
+            current_node->WHILE_LOOP->body = body;
 
             nodes.erase(nodes.begin() + index + 2);
             nodes.erase(nodes.begin() + index + 1);
@@ -739,11 +745,11 @@ void Parser::parse(NodeType end_node_type, int start)
     {
         if (current_node->type == NodeType::BLOCK)
         {
-            if (nodes[index]->BLOCK.nodes.size() > 0 && nodes[index]->BLOCK.nodes[0]->type == NodeType::OP && nodes[index]->BLOCK.nodes[0]->OP.op_type == NodeType::COLON)
+            if (nodes[index]->BLOCK->nodes.size() > 0 && nodes[index]->BLOCK->nodes[0]->type == NodeType::OP && nodes[index]->BLOCK->nodes[0]->OP.op_type == NodeType::COLON)
             {
                 nodes[index]->type = NodeType::OBJECT;
 
-                for (auto& node : nodes[index]->BLOCK.nodes)
+                for (auto& node : nodes[index]->BLOCK->nodes)
                 {
                     if (node->type != NodeType::OP && node->OP.op_type != NodeType::COLON)
                     {
@@ -776,33 +782,33 @@ void Parser::parse(NodeType end_node_type, int start)
 
                     if (right->type == NodeType::FUNCTION)
                     {
-                        right->FUNCTION.name = left->type == NodeType::ID ? left->ID.value : left->STRING.value;
+                        right->FUNCTION->name = left->type == NodeType::ID ? left->ID.value : left->STRING.value;
 
                         // If function already exists of the same name
                         // We create a pipe list for multiple dispatch
 
-                        if (nodes[index]->OBJECT.properties.find(prop_name) != nodes[index]->OBJECT.properties.end())
+                        if (nodes[index]->OBJECT->properties.find(prop_name) != nodes[index]->OBJECT->properties.end())
                         {
-                            if (nodes[index]->OBJECT.properties[prop_name].value->type == NodeType::FUNCTION)
+                            if (nodes[index]->OBJECT->properties[prop_name].value->type == NodeType::FUNCTION)
                             {
-                                auto func_list = std::make_shared<Node>(NodeType::PIPE_LIST);
-                                func_list->PIPE_LIST.nodes.push_back(nodes[index]->OBJECT.properties[prop_name].value);
-                                func_list->PIPE_LIST.nodes.push_back(property.value);
-                                nodes[index]->OBJECT.properties[prop_name].value = func_list;
+                                auto func_list = make_node(NodeType::PIPE_LIST);
+                                func_list->PIPE_LIST->nodes.push_back(nodes[index]->OBJECT->properties[prop_name].value);
+                                func_list->PIPE_LIST->nodes.push_back(property.value);
+                                nodes[index]->OBJECT->properties[prop_name].value = func_list;
                                 continue;
                             }
-                            else if (nodes[index]->OBJECT.properties[prop_name].value->type == NodeType::PIPE_LIST)
+                            else if (nodes[index]->OBJECT->properties[prop_name].value->type == NodeType::PIPE_LIST)
                             {
-                                nodes[index]->OBJECT.properties[prop_name].value->PIPE_LIST.nodes.push_back(property.value);
+                                nodes[index]->OBJECT->properties[prop_name].value->PIPE_LIST->nodes.push_back(property.value);
                                 continue;
                             }
                         }
                     }
 
-                    nodes[index]->OBJECT.properties[prop_name] = property;
+                    nodes[index]->OBJECT->properties[prop_name] = property;
                 }
 
-                nodes[index]->BLOCK.nodes.clear();
+                nodes[index]->BLOCK->nodes.clear();
             }
         }
 
@@ -1168,7 +1174,7 @@ void Parser::parse(NodeType end_node_type, int start)
             {
                 if (std::find(end_types.begin(), end_types.end(), peek()->type) != end_types.end())
                 {
-                    current_node->right = std::make_shared<Node>(NodeType::EMPTY);
+                    current_node->right = make_node(NodeType::EMPTY);
                 }
                 else
                 {
@@ -1225,7 +1231,7 @@ void Parser::parse(NodeType end_node_type, int start)
     }
 }
 
-void Parser::flatten_comma_list(std::shared_ptr<Node>& node)
+void Parser::flatten_comma_list(Node_Ptr& node)
 {
     if (node->OP.op_type == NodeType::COMMA)
     {
@@ -1237,18 +1243,18 @@ void Parser::flatten_comma_list(std::shared_ptr<Node>& node)
         }
         else
         {
-            node->COMMA_LIST.nodes.push_back(node->left);
+            node->COMMA_LIST->nodes.push_back(node->left);
         }
 
         if (node->left->type == NodeType::COMMA_LIST)
         {
-            for (auto elem : node->left->COMMA_LIST.nodes)
+            for (auto elem : node->left->COMMA_LIST->nodes)
             {
-                node->COMMA_LIST.nodes.push_back(elem);
+                node->COMMA_LIST->nodes.push_back(elem);
             }
 
-            node->left = std::make_shared<Node>(NodeType::EMPTY);
-            node->left->COMMA_LIST.nodes.clear();
+            node->left = make_node(NodeType::EMPTY);
+            node->left->COMMA_LIST->nodes.clear();
         }
 
         if (node->right->OP.op_type == NodeType::COMMA)
@@ -1257,18 +1263,18 @@ void Parser::flatten_comma_list(std::shared_ptr<Node>& node)
         }
         else
         {
-            node->COMMA_LIST.nodes.push_back(node->right);
+            node->COMMA_LIST->nodes.push_back(node->right);
         }
 
         if (node->right->type == NodeType::COMMA_LIST)
         {
-            for (auto elem : node->right->COMMA_LIST.nodes)
+            for (auto elem : node->right->COMMA_LIST->nodes)
             {
-                node->COMMA_LIST.nodes.push_back(elem);
+                node->COMMA_LIST->nodes.push_back(elem);
             }
 
-            node->right = std::make_shared<Node>(NodeType::EMPTY);
-            node->right->COMMA_LIST.nodes.clear();
+            node->right = make_node(NodeType::EMPTY);
+            node->right->COMMA_LIST->nodes.clear();
         }
 
         node->left = nullptr;
@@ -1276,7 +1282,7 @@ void Parser::flatten_comma_list(std::shared_ptr<Node>& node)
     }
 }
 
-void Parser::flatten_pipe_list(std::shared_ptr<Node>& node)
+void Parser::flatten_pipe_list(Node_Ptr& node)
 {
     if (node->OP.op_type == NodeType::PIPE)
     {
@@ -1288,18 +1294,18 @@ void Parser::flatten_pipe_list(std::shared_ptr<Node>& node)
         }
         else
         {
-            node->PIPE_LIST.nodes.push_back(node->left);
+            node->PIPE_LIST->nodes.push_back(node->left);
         }
 
         if (node->left->type == NodeType::PIPE_LIST)
         {
-            for (auto elem : node->left->PIPE_LIST.nodes)
+            for (auto elem : node->left->PIPE_LIST->nodes)
             {
-                node->PIPE_LIST.nodes.push_back(elem);
+                node->PIPE_LIST->nodes.push_back(elem);
             }
 
-            node->left = std::make_shared<Node>(NodeType::EMPTY);
-            node->left->PIPE_LIST.nodes.clear();
+            node->left = make_node(NodeType::EMPTY);
+            node->left->PIPE_LIST->nodes.clear();
         }
 
         if (node->right->OP.op_type == NodeType::PIPE)
@@ -1308,18 +1314,18 @@ void Parser::flatten_pipe_list(std::shared_ptr<Node>& node)
         }
         else
         {
-            node->PIPE_LIST.nodes.push_back(node->right);
+            node->PIPE_LIST->nodes.push_back(node->right);
         }
 
         if (node->right->type == NodeType::PIPE_LIST)
         {
-            for (auto elem : node->right->PIPE_LIST.nodes)
+            for (auto elem : node->right->PIPE_LIST->nodes)
             {
-                node->PIPE_LIST.nodes.push_back(elem);
+                node->PIPE_LIST->nodes.push_back(elem);
             }
 
-            node->right = std::make_shared<Node>(NodeType::EMPTY);
-            node->right->PIPE_LIST.nodes.clear();
+            node->right = make_node(NodeType::EMPTY);
+            node->right->PIPE_LIST->nodes.clear();
         }
 
         node->left = nullptr;
@@ -1330,6 +1336,7 @@ void Parser::flatten_pipe_list(std::shared_ptr<Node>& node)
 void Parser::error_and_exit(std::string message)
 {
     std::string error_message = "Parsing Error in '" + file_name + "' @ (" + std::to_string(line) + ", " + std::to_string(column) + "): " + message;
+    Output::get().flush();
 	std::cout << error_message << "\n";
     exit(1);
 }
\ No newline at end of file
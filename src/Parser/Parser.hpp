@@ -1,20 +1,24 @@
 #pragma once
 #include "../Lexer/Lexer.hpp"
+#include "../Node/Pool.hpp"
 
 class Parser
 {
     int index = 0;
-    std::shared_ptr<Node> current_node;
+    Node_Ptr current_node;
     int line, column = 1;
     NodeType current_node_type = NodeType::START_OF_FILE;
 
+    // Nodes built while parsing are allocated from the module's arena
+    Arena_Ref arena;
+
 public:
 
     std::string file_name;
-    std::vector<std::shared_ptr<Node>> nodes;
+    std::vector<Node_Ptr> nodes;
     std::vector<std::string> errors;
 
-    Parser(std::string& file_name, std::vector<std::shared_ptr<Node>>& nodes) : file_name(file_name), nodes(nodes) 
+    Parser(std::string& file_name, std::vector<Node_Ptr>& nodes) : file_name(file_name), nodes(nodes) 
     {
         if (nodes.size() == 0)
         {
@@ -25,8 +29,10 @@ public:
         current_node = nodes[0];
     }
 
+    Node_Ptr make_node(NodeType type);
+
     void advance(int n = 1);
-    std::shared_ptr<Node>& peek(int n = 1);
+    Node_Ptr& peek(int n = 1);
     void reset(int n = 0);
 
     void parse(NodeType end_node_type = NodeType::END_OF_FILE, int start = 0);
@@ -41,8 +47,8 @@ public:
     void parse_un_op();
     void parse_bin_op();
 
-    void flatten_comma_list(std::shared_ptr<Node>& node);
-    void flatten_pipe_list(std::shared_ptr<Node>& node);
+    void flatten_comma_list(Node_Ptr& node);
+    void flatten_pipe_list(Node_Ptr& node);
 
     void error_and_exit(std::string message);
 };
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "Resolver.hpp"
+
+// Every distinct identifier gets one slot for the lifetime of the process,
+// so the builtins, the main file and any imports all agree on the numbering
+
+std::unordered_map<std::string, int> resolver_slots;
+
+int Resolver::slot(const std::string& name)
+{
+    auto symbol = resolver_slots.find(name);
+
+    if (symbol != resolver_slots.end())
+    {
+        return symbol->second;
+    }
+
+    int index = resolver_slots.size();
+    resolver_slots[name] = index;
+    return index;
+}
+
+void Resolver::resolve_nodes(std::vector<Node_Ptr>& nodes)
+{
+    for (auto& node : nodes)
+    {
+        resolve_node(node);
+    }
+}
+
+void Resolver::resolve_node(Node_Ptr& node)
+{
+    if (node == nullptr)
+    {
+        return;
+    }
+
+    resolve_node(node->left);
+    resolve_node(node->right);
+
+    if (node->type == NodeType::ID)
+    {
+        node->ID.slot = slot(node->ID.value);
+        resolve_node(node->ID.type);
+        return;
+    }
+
+    if (node->type == NodeType::FUNC_CALL)
+    {
+        node->FUNC_CALL->slot = slot(node->FUNC_CALL->name);
+        resolve_node(node->FUNC_CALL->caller);
+        resolve_nodes(node->FUNC_CALL->args);
+        return;
+    }
+
+    if (node->type == NodeType::BLOCK)
+    {
+        resolve_nodes(node->BLOCK->nodes);
+        return;
+    }
+
+    if (node->type == NodeType::LIST)
+    {
+        resolve_nodes(node->LIST.nodes());
+        return;
+    }
+
+    if (node->type == NodeType::COMMA_LIST)
+    {
+        resolve_nodes(node->COMMA_LIST->nodes);
+        return;
+    }
+
+    if (node->type == NodeType::PIPE_LIST)
+    {
+        resolve_nodes(node->PIPE_LIST->nodes);
+        return;
+    }
+
+    if (node->type == NodeType::OBJECT)
+    {
+        for (auto& prop : node->OBJECT->properties)
+        {
+            resolve_node(prop.second.value);
+        }
+        return;
+    }
+
+    if (node->type == NodeType::FUNCTION)
+    {
+        // Closures and bound args are runtime values, not syntax
+
+        resolve_nodes(node->FUNCTION->params);
+        resolve_node(node->FUNCTION->return_type);
+        resolve_node(node->FUNCTION->body);
+        return;
+    }
+
+    if (node->type == NodeType::IF_STATEMENT)
+    {
+        resolve_node(node->IF_STATEMENT->conditional);
+        resolve_node(node->IF_STATEMENT->body);
+        return;
+    }
+
+    if (node->type == NodeType::IF_BLOCK)
+    {
+        resolve_nodes(node->IF_BLOCK->cases);
+        return;
+    }
+
+    if (node->type == NodeType::MATCH_BLOCK)
+    {
+        resolve_node(node->MATCH_BLOCK->value);
+        resolve_nodes(node->MATCH_BLOCK->cases);
+        return;
+    }
+
+    if (node->type == NodeType::FOR_LOOP)
+    {
+        resolve_node(node->FOR_LOOP->init_list);
+        resolve_node(node->FOR_LOOP->body);
+        return;
+    }
+
+    if (node->type == NodeType::WHILE_LOOP)
+    {
+        resolve_node(node->WHILE_LOOP->conditional);
+        resolve_node(node->WHILE_LOOP->body);
+        return;
+    }
+}
+
+void Resolver::resolve()
+{
+    resolve_nodes(nodes);
+}
@@ -0,0 +1,19 @@
+#pragma once
+#include "../Node/Node.hpp"
+
+class Resolver
+{
+
+public:
+
+    std::string file_name;
+    std::vector<Node_Ptr> nodes;
+
+    Resolver(std::string file_name, std::vector<Node_Ptr> nodes) : file_name(file_name), nodes(nodes) {}
+
+    static int slot(const std::string& name);
+
+    void resolve_node(Node_Ptr& node);
+    void resolve_nodes(std::vector<Node_Ptr>& nodes);
+    void resolve();
+};
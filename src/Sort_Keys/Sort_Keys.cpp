@@ -0,0 +1,263 @@
+#include <algorithm>
+#include <thread>
+#include <cmath>
+#include "Sort_Keys.hpp"
+
+// Lists shorter than this are not worth starting threads for
+static const size_t min_chunk = 1 << 15;
+
+template <typename Item, typename Less>
+static void parallel_sort(std::vector<Item>& items, Less less)
+{
+    size_t threads = std::thread::hardware_concurrency();
+    size_t chunks = std::min<size_t>(threads, items.size() / min_chunk);
+
+    if (chunks < 2)
+    {
+        std::sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    std::vector<size_t> bounds;
+
+    for (size_t i = 0; i <= chunks; i++)
+    {
+        bounds.push_back(items.size() * i / chunks);
+    }
+
+    auto begin = items.begin();
+    std::vector<std::thread> workers;
+
+    for (size_t i = 0; i < chunks; i++)
+    {
+        workers.emplace_back([&, i]() { std::sort(begin + bounds[i], begin + bounds[i + 1], less); });
+    }
+
+    for (auto& worker : workers)
+    {
+        worker.join();
+    }
+
+    // Neighbouring runs are merged in pairs, each pair on its own thread,
+    // until one run is left
+
+    while (bounds.size() > 2)
+    {
+        std::vector<size_t> merged = {0};
+        workers.clear();
+
+        for (size_t i = 0; i + 1 < bounds.size(); i += 2)
+        {
+            if (i + 2 < bounds.size())
+            {
+                workers.emplace_back([&, i]() { std::inplace_merge(begin + bounds[i], begin + bounds[i + 1], begin + bounds[i + 2], less); });
+                merged.push_back(bounds[i + 2]);
+            }
+            else
+            {
+                merged.push_back(bounds[i + 1]);
+            }
+        }
+
+        for (auto& worker : workers)
+        {
+            worker.join();
+        }
+
+        bounds = merged;
+    }
+}
+
+template <typename Item, typename Less>
+static std::vector<size_t> sorted_positions(std::vector<Item>& items, Less less, size_t limit)
+{
+    if (limit < items.size())
+    {
+        std::partial_sort(items.begin(), items.begin() + limit, items.end(), less);
+        items.resize(limit);
+    }
+    else
+    {
+        parallel_sort(items, less);
+    }
+
+    std::vector<size_t> positions;
+    positions.reserve(items.size());
+
+    for (auto& item : items)
+    {
+        positions.push_back(item.second);
+    }
+
+    return positions;
+}
+
+// Less than zero, zero or greater than zero as an int is below, equal to
+// or above a float, without rounding the int to a double on the way
+
+static int compare_int_float(long long a, double b)
+{
+    // 2^63, the first double no long long reaches
+    const double limit = 9223372036854775808.0;
+
+    if (b >= limit)
+    {
+        return -1;
+    }
+
+    if (b < -limit)
+    {
+        return 1;
+    }
+
+    double whole = std::floor(b);
+    long long truncated = (long long)whole;
+
+    if (a != truncated)
+    {
+        return a < truncated ? -1 : 1;
+    }
+
+    return whole < b ? -1 : 0;
+}
+
+int Sort_Keys::compare(const Number& a, const Number& b)
+{
+    if (a.is_int && b.is_int)
+    {
+        return a.int_value < b.int_value ? -1 : a.int_value > b.int_value;
+    }
+
+    if (a.is_int)
+    {
+        return compare_int_float(a.int_value, b.float_value);
+    }
+
+    if (b.is_int)
+    {
+        return -compare_int_float(b.int_value, a.float_value);
+    }
+
+    return a.float_value < b.float_value ? -1 : a.float_value > b.float_value;
+}
+
+bool Sort_Keys::gather(const std::vector<Node_Ptr>& keys)
+{
+    if (keys.empty())
+    {
+        return false;
+    }
+
+    auto type = keys[0]->type;
+
+    for (auto& key : keys)
+    {
+        if (key->type == NodeType::FLOAT && std::isnan(key->FLOAT.value))
+        {
+            return false;
+        }
+
+        if (key->type == type)
+        {
+            continue;
+        }
+
+        // Ints and floats together are sorted as numbers
+
+        if ((key->type == NodeType::INT || key->type == NodeType::FLOAT) && (type == NodeType::INT || type == NodeType::FLOAT))
+        {
+            type = NodeType::FLOAT;
+            continue;
+        }
+
+        return false;
+    }
+
+    if (type == NodeType::INT)
+    {
+        kind = Kind::INT;
+        ints.reserve(keys.size());
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            ints.push_back({keys[i]->INT.value, i});
+        }
+
+        return true;
+    }
+
+    if (type == NodeType::FLOAT)
+    {
+        kind = Kind::FLOAT;
+        floats.reserve(keys.size());
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            Number value;
+            value.is_int = keys[i]->type == NodeType::INT;
+            value.int_value = value.is_int ? keys[i]->INT.value : 0;
+            value.float_value = value.is_int ? 0 : keys[i]->FLOAT.value;
+            floats.push_back({value, i});
+        }
+
+        return true;
+    }
+
+    if (type == NodeType::STRING)
+    {
+        kind = Kind::STRING;
+        strings.reserve(keys.size());
+
+        for (size_t i = 0; i < keys.size(); i++)
+        {
+            strings.push_back({&keys[i]->STRING.value, i});
+        }
+
+        return true;
+    }
+
+    return false;
+}
+
+std::vector<size_t> Sort_Keys::order(bool descending, size_t limit)
+{
+    if (kind == Kind::INT)
+    {
+        return sorted_positions(ints, [descending](const std::pair<long long, size_t>& a, const std::pair<long long, size_t>& b)
+        {
+            if (a.first != b.first)
+            {
+                return descending ? b.first < a.first : a.first < b.first;
+            }
+
+            return a.second < b.second;
+        }, limit);
+    }
+
+    if (kind == Kind::FLOAT)
+    {
+        return sorted_positions(floats, [descending](const std::pair<Number, size_t>& a, const std::pair<Number, size_t>& b)
+        {
+            int difference = compare(a.first, b.first);
+
+            if (difference != 0)
+            {
+                return descending ? difference > 0 : difference < 0;
+            }
+
+            return a.second < b.second;
+        }, limit);
+    }
+
+    return sorted_positions(strings, [descending](const std::pair<const std::string*, size_t>& a, const std::pair<const std::string*, size_t>& b)
+    {
+        int difference = a.first->compare(*b.first);
+
+        if (difference != 0)
+        {
+            return descending ? difference > 0 : difference < 0;
+        }
+
+        return a.second < b.second;
+    }, limit);
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <string>
+#include "../Node/Node.hpp"
+
+// The keys a list is sorted by, once they are all ints, all numbers or all
+// strings. Each key is copied out of its node next to its element's
+// position, and the pairs are sorted as plain values. Ties are broken by
+// position, which keeps the order stable whatever sort is used, so large
+// lists are sorted in chunks on their own threads and the chunks merged.
+// Any other keys are left to the caller to compare.
+
+class Sort_Keys
+{
+    enum class Kind
+    {
+        INT,
+        FLOAT,
+        STRING
+    };
+
+    // A key among ints and floats sorted together. Ints keep their exact
+    // value, so two ints beyond 2^53 apart by one still order correctly
+
+    struct Number
+    {
+        bool is_int;
+        long long int_value;
+        double float_value;
+    };
+
+    static int compare(const Number& a, const Number& b);
+
+    Kind kind = Kind::INT;
+    std::vector<std::pair<long long, size_t>> ints;
+    std::vector<std::pair<Number, size_t>> floats;
+    std::vector<std::pair<const std::string*, size_t>> strings;
+
+public:
+
+    bool gather(const std::vector<Node_Ptr>& keys);
+
+    // Positions of the elements in sorted order, the first limit of them
+    std::vector<size_t> order(bool descending, size_t limit);
+};
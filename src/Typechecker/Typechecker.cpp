@@ -1,11 +1,12 @@
 #include "Typechecker.hpp"
+#include "../Output/Output.hpp"
 
-auto tc_error_node = std::make_shared<Node>(NodeType::ERROR);
+auto tc_error_node = make_pooled_node(NodeType::ERROR);
 
 // Node Helpers
-std::shared_ptr<Node> Typechecker::make_int(long long value, bool literal)
+Node_Ptr Typechecker::make_int(long long value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::INT);
+    auto node = make_pooled_node(NodeType::INT);
     node->INT.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -13,9 +14,9 @@ std::shared_ptr<Node> Typechecker::make_int(long long value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_float(double value, bool literal)
+Node_Ptr Typechecker::make_float(double value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::FLOAT);
+    auto node = make_pooled_node(NodeType::FLOAT);
     node->FLOAT.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -23,9 +24,9 @@ std::shared_ptr<Node> Typechecker::make_float(double value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_string(std::string value, bool literal)
+Node_Ptr Typechecker::make_string(std::string value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::STRING);
+    auto node = make_pooled_node(NodeType::STRING);
     node->STRING.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -33,9 +34,9 @@ std::shared_ptr<Node> Typechecker::make_string(std::string value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_bool(bool value, bool literal)
+Node_Ptr Typechecker::make_bool(bool value, bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::BOOL);
+    auto node = make_pooled_node(NodeType::BOOL);
     node->BOOL.value = value;
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
@@ -43,31 +44,31 @@ std::shared_ptr<Node> Typechecker::make_bool(bool value, bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_empty(bool literal)
+Node_Ptr Typechecker::make_empty(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::EMPTY);
+    auto node = make_pooled_node(NodeType::EMPTY);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_any(bool literal)
+Node_Ptr Typechecker::make_any(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::ANY);
+    auto node = make_pooled_node(NodeType::ANY);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_list(bool literal)
+Node_Ptr Typechecker::make_list(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::LIST);
+    auto node = make_pooled_node(NodeType::LIST);
     node->TYPE.is_literal = literal;
     if (!literal)
     {
-        node->LIST.nodes.push_back(make_any());
+        node->LIST.nodes().push_back(make_any());
         node->TYPE.allowed_type = node;
     }
     node->TYPE.allowed_type = node;
@@ -75,26 +76,26 @@ std::shared_ptr<Node> Typechecker::make_list(bool literal)
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_pipe_list(bool literal)
+Node_Ptr Typechecker::make_pipe_list(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::PIPE_LIST);
+    auto node = make_pooled_node(NodeType::PIPE_LIST);
     node->TYPE.is_literal = literal;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_object(bool literal)
+Node_Ptr Typechecker::make_object(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::OBJECT);
+    auto node = make_pooled_node(NodeType::OBJECT);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
     node->column = column;
     return node;
 }
-std::shared_ptr<Node> Typechecker::make_function(bool literal)
+Node_Ptr Typechecker::make_function(bool literal)
 {
-    auto node = std::make_shared<Node>(NodeType::FUNCTION);
+    auto node = make_pooled_node(NodeType::FUNCTION);
     node->TYPE.is_literal = literal;
     node->TYPE.allowed_type = node;
     node->line = line;
@@ -102,13 +103,13 @@ std::shared_ptr<Node> Typechecker::make_function(bool literal)
     return node;
 }
 
-void Typechecker::sort_and_unique(std::vector<std::shared_ptr<Node>>& list)
+void Typechecker::sort_and_unique(std::vector<Node_Ptr>& list)
 {
-    std::sort(list.begin(), list.end(), [] (std::shared_ptr<Node>& a, std::shared_ptr<Node>& b) {return int(a->type) < int(b->type);});
-    list.erase(std::unique(list.begin(), list.end(), [this] (std::shared_ptr<Node>& a, std::shared_ptr<Node>& b) {return match_types(a, b).result;}), list.end());
+    std::sort(list.begin(), list.end(), [] (Node_Ptr& a, Node_Ptr& b) {return int(a->type) < int(b->type);});
+    list.erase(std::unique(list.begin(), list.end(), [this] (Node_Ptr& a, Node_Ptr& b) {return match_types(a, b).result;}), list.end());
 }
 
-std::shared_ptr<Node> Typechecker::get_explicit_type(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::get_explicit_type(Node_Ptr& node)
 {
     auto result = make_any();
 
@@ -124,7 +125,7 @@ std::shared_ptr<Node> Typechecker::get_explicit_type(std::shared_ptr<Node>& node
         if (result == nullptr)
         {
             auto ls = make_list();
-            ls->LIST.nodes.push_back(make_any());
+            ls->LIST.nodes().push_back(make_any());
             result = ls;
         }
     }
@@ -144,15 +145,15 @@ std::shared_ptr<Node> Typechecker::get_explicit_type(std::shared_ptr<Node>& node
         result = eval_node(result);
     }
 
-    if (result->type == NodeType::FUNCTION && result->FUNCTION.return_type == nullptr)
+    if (result->type == NodeType::FUNCTION && result->FUNCTION->return_type == nullptr)
     {
         result = eval_node(result);
     }
 
-    if (result->type == NodeType::LIST && result->LIST.nodes.size() == 0)
+    if (result->type == NodeType::LIST && result->LIST.nodes().size() == 0)
     {
-        result->LIST.nodes.push_back(make_any());
-        result->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+        result->LIST.nodes().push_back(make_any());
+        result->TYPE.allowed_type->LIST.nodes().push_back(make_any());
     }
 
     return result;
@@ -160,7 +161,7 @@ std::shared_ptr<Node> Typechecker::get_explicit_type(std::shared_ptr<Node>& node
 
 // -- Built-in Functions -- //
 
-std::shared_ptr<Node> Typechecker::builtin_exit(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_exit(std::vector<Node_Ptr> args)
 {
     if (args.size() > 1)
     {
@@ -170,7 +171,7 @@ std::shared_ptr<Node> Typechecker::builtin_exit(std::vector<std::shared_ptr<Node
     return make_empty(false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_error(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_error(std::vector<Node_Ptr> args)
 {
     if (args.size() != 2)
     {
@@ -188,7 +189,7 @@ std::shared_ptr<Node> Typechecker::builtin_error(std::vector<std::shared_ptr<Nod
     return make_empty(false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_range(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_range(std::vector<Node_Ptr> args)
 {
     if (args.size() != 2)
     {
@@ -203,12 +204,12 @@ std::shared_ptr<Node> Typechecker::builtin_range(std::vector<std::shared_ptr<Nod
         error_and_exit("Built-in function 'range' expects 2 integer arguments");
     }
 
-    auto res = std::make_shared<Node>(NodeType::RANGE);
+    auto res = make_pooled_node(NodeType::RANGE);
 
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::builtin_print(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_print(std::vector<Node_Ptr> args)
 {
     if (args.size() < 1)
     {
@@ -218,7 +219,7 @@ std::shared_ptr<Node> Typechecker::builtin_print(std::vector<std::shared_ptr<Nod
     return make_empty(false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_delete(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_delete(std::vector<Node_Ptr> args)
 {
     for (auto arg : args)
     {
@@ -235,7 +236,7 @@ std::shared_ptr<Node> Typechecker::builtin_delete(std::vector<std::shared_ptr<No
     return make_empty();
 }
 
-std::shared_ptr<Node> Typechecker::builtin_read(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_read(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -252,7 +253,225 @@ std::shared_ptr<Node> Typechecker::builtin_read(std::vector<std::shared_ptr<Node
     return make_string("", false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_write(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_lines(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'lines' expects one argument");
+    }
+
+    auto file_path_node = eval_node(args[0]);
+
+    if (file_path_node->type != NodeType::STRING)
+    {
+        error_and_exit("Built-in function 'lines' expects one string argument");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_string("", false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_json_parse(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'json.parse' expects one argument");
+    }
+
+    return make_any();
+}
+
+Node_Ptr Typechecker::builtin_json_stringify(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'json.stringify' expects two arguments");
+    }
+
+    return make_string("", false);
+}
+
+Node_Ptr Typechecker::builtin_json_read(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1)
+    {
+       error_and_exit("Built-in function 'json.read' expects one argument");
+    }
+
+    return make_any();
+}
+
+Node_Ptr Typechecker::builtin_json_write(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'json.write' expects three arguments");
+    }
+
+    return make_string("", false);
+}
+
+Node_Ptr Typechecker::builtin_json_each(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'json.each' expects two arguments");
+    }
+
+    return make_int(0, false);
+}
+
+Node_Ptr Typechecker::builtin_ndjson_lines(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 1 && args.size() != 2)
+    {
+       error_and_exit("Built-in function 'ndjson.lines' expects one or two arguments");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_object(false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_ndjson_write(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'ndjson.write' expects three arguments");
+    }
+
+    return make_string("", false);
+}
+
+Node_Ptr Typechecker::builtin_csv_load(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_at_call("Built-in function 'csv_load' expects three arguments");
+    }
+
+    auto file_path_node = eval_node(args[0]);
+
+    if (file_path_node->type != NodeType::STRING)
+    {
+        error_at_call("Built-in function 'csv_load' expects a string path");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_object(false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_column(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'column' expects two arguments");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_any());
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_group_rows(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'group_rows' expects two arguments");
+    }
+
+    return make_object();
+}
+
+Node_Ptr Typechecker::builtin_summarize(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'summarize' expects three arguments");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_object(false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_join(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 5)
+    {
+       error_and_exit("Built-in function 'join' expects five arguments");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_object(false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_index(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'index' expects two arguments");
+    }
+
+    return make_object();
+}
+
+Node_Ptr Typechecker::builtin_lookup(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'lookup' expects two arguments");
+    }
+
+    return make_any();
+}
+
+Node_Ptr Typechecker::builtin_ref(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'ref' expects three arguments");
+    }
+
+    return make_any();
+}
+
+Node_Ptr Typechecker::builtin_reshape(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_at_call("Built-in function 'reshape' expects two arguments");
+    }
+
+    return eval_node(args[1]);
+}
+
+Node_Ptr Typechecker::builtin_extract(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_at_call("Built-in function 'extract' expects two arguments");
+    }
+
+    auto res = make_list();
+    res->LIST.nodes().push_back(make_object(false));
+    return res;
+}
+
+Node_Ptr Typechecker::builtin_aggregate(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2 && args.size() != 3)
+    {
+       error_and_exit("Built-in function 'aggregate' expects two or three arguments");
+    }
+
+    return make_any();
+}
+
+Node_Ptr Typechecker::builtin_write(std::vector<Node_Ptr> args)
 {
     if (args.size() != 2)
     {
@@ -270,7 +489,7 @@ std::shared_ptr<Node> Typechecker::builtin_write(std::vector<std::shared_ptr<Nod
     return make_empty(false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_append(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_append(std::vector<Node_Ptr> args)
 {
 
     if (args.size() != 2)
@@ -289,7 +508,47 @@ std::shared_ptr<Node> Typechecker::builtin_append(std::vector<std::shared_ptr<No
     return make_empty(false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_time(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_flush(std::vector<Node_Ptr> args)
+{
+    if (args.size() > 1)
+    {
+       error_and_exit("Built-in function 'flush' expects 0 or 1 arguments");
+    }
+
+    return make_empty(false);
+}
+
+Node_Ptr Typechecker::builtin_close(std::vector<Node_Ptr> args)
+{
+    if (args.size() > 1)
+    {
+       error_and_exit("Built-in function 'close' expects 0 or 1 arguments");
+    }
+
+    return make_empty(false);
+}
+
+Node_Ptr Typechecker::builtin_open(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 2)
+    {
+       error_and_exit("Built-in function 'open' expects 2 arguments");
+    }
+
+    return make_int(0, false);
+}
+
+Node_Ptr Typechecker::builtin_file_write(std::vector<Node_Ptr> args)
+{
+    if (args.size() != 3)
+    {
+       error_and_exit("Built-in function 'file.write' expects 3 arguments");
+    }
+
+    return make_empty(false);
+}
+
+Node_Ptr Typechecker::builtin_time(std::vector<Node_Ptr> args)
 {
     if (args.size() != 0)
     {
@@ -299,7 +558,7 @@ std::shared_ptr<Node> Typechecker::builtin_time(std::vector<std::shared_ptr<Node
     return make_int(0, false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_import(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_import(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -337,11 +596,35 @@ std::shared_ptr<Node> Typechecker::builtin_import(std::vector<std::shared_ptr<No
 
     for (auto symbol : typechecker.symbol_table)
     {
+        auto value = symbol.second;
+
+        // Functions a module defines under a built-in name are added to the
+        // built-in's overloads; only the module's own are exported
+
         if (std::find(builtins_names.begin(), builtins_names.end(), symbol.first) != builtins_names.end())
         {
-            continue;
+            if (value->type != NodeType::FUNC_LIST)
+            {
+                continue;
+            }
+
+            value = make_pooled_node(NodeType::FUNC_LIST);
+
+            for (auto& func : symbol.second->FUNC_LIST->nodes)
+            {
+                if (!func->FUNCTION->is_builtin)
+                {
+                    value->FUNC_LIST->nodes.push_back(func);
+                }
+            }
+
+            if (value->FUNC_LIST->nodes.empty())
+            {
+                continue;
+            }
         }
-        import_obj->OBJECT.properties[symbol.first] = Object_Prop(true, symbol.second);
+
+        import_obj->OBJECT->properties[symbol.first] = Object_Prop(true, value);
     }
 
     import_obj->TYPE.allowed_type = import_obj;
@@ -349,7 +632,7 @@ std::shared_ptr<Node> Typechecker::builtin_import(std::vector<std::shared_ptr<No
     return import_obj;
 }
 
-std::shared_ptr<Node> Typechecker::builtin_to_int(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_to_int(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -359,7 +642,7 @@ std::shared_ptr<Node> Typechecker::builtin_to_int(std::vector<std::shared_ptr<No
     return make_int(0, false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_to_float(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_to_float(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -369,7 +652,7 @@ std::shared_ptr<Node> Typechecker::builtin_to_float(std::vector<std::shared_ptr<
     return make_float(0, false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_to_string(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_to_string(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -379,7 +662,7 @@ std::shared_ptr<Node> Typechecker::builtin_to_string(std::vector<std::shared_ptr
     return make_string("", false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_type(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_type(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -389,7 +672,7 @@ std::shared_ptr<Node> Typechecker::builtin_type(std::vector<std::shared_ptr<Node
    return make_string("", false);
 }
 
-std::shared_ptr<Node> Typechecker::builtin_shape(std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::builtin_shape(std::vector<Node_Ptr> args)
 {
     if (args.size() != 1)
     {
@@ -400,7 +683,7 @@ std::shared_ptr<Node> Typechecker::builtin_shape(std::vector<std::shared_ptr<Nod
     return get_type(value);
 }
 
-std::unordered_map<std::string, std::shared_ptr<Node> (Typechecker::*)(std::vector<std::shared_ptr<Node>>)> tc_builtin_functions = {
+std::unordered_map<std::string, Node_Ptr (Typechecker::*)(std::vector<Node_Ptr>)> tc_builtin_functions = {
     std::make_pair("__exit__", &Typechecker::builtin_exit),
     std::make_pair("__error__", &Typechecker::builtin_error),
     std::make_pair("__range__", &Typechecker::builtin_range),
@@ -409,8 +692,31 @@ std::unordered_map<std::string, std::shared_ptr<Node> (Typechecker::*)(std::vect
     std::make_pair("__time__", &Typechecker::builtin_time),
     std::make_pair("__import__", &Typechecker::builtin_import),
     std::make_pair("__read__", &Typechecker::builtin_read),
+    std::make_pair("__lines__", &Typechecker::builtin_lines),
+    std::make_pair("__csv_load__", &Typechecker::builtin_csv_load),
+    std::make_pair("__column__", &Typechecker::builtin_column),
+    std::make_pair("__group_rows__", &Typechecker::builtin_group_rows),
+    std::make_pair("__summarize__", &Typechecker::builtin_summarize),
+    std::make_pair("__join__", &Typechecker::builtin_join),
+    std::make_pair("__index__", &Typechecker::builtin_index),
+    std::make_pair("__lookup__", &Typechecker::builtin_lookup),
+    std::make_pair("__ref__", &Typechecker::builtin_ref),
+    std::make_pair("__json_parse__", &Typechecker::builtin_json_parse),
+    std::make_pair("__json_stringify__", &Typechecker::builtin_json_stringify),
+    std::make_pair("__json_read__", &Typechecker::builtin_json_read),
+    std::make_pair("__json_write__", &Typechecker::builtin_json_write),
+    std::make_pair("__json_each__", &Typechecker::builtin_json_each),
+    std::make_pair("__ndjson_lines__", &Typechecker::builtin_ndjson_lines),
+    std::make_pair("__ndjson_write__", &Typechecker::builtin_ndjson_write),
+    std::make_pair("__reshape__", &Typechecker::builtin_reshape),
+    std::make_pair("__extract__", &Typechecker::builtin_extract),
+    std::make_pair("__aggregate__", &Typechecker::builtin_aggregate),
     std::make_pair("__write__", &Typechecker::builtin_write),
     std::make_pair("__append__", &Typechecker::builtin_append),
+    std::make_pair("__flush__", &Typechecker::builtin_flush),
+    std::make_pair("__close__", &Typechecker::builtin_close),
+    std::make_pair("__open__", &Typechecker::builtin_open),
+    std::make_pair("__file_write__", &Typechecker::builtin_file_write),
     std::make_pair("__to_int__", &Typechecker::builtin_to_int),
     std::make_pair("__to_float__", &Typechecker::builtin_to_float),
     std::make_pair("__to_string__", &Typechecker::builtin_to_string),
@@ -432,6 +738,14 @@ void Typechecker::init(std::string builtins_path)
 
     for (auto symbol : typechecker.symbol_table)
     {
+        if (symbol.second->type == NodeType::FUNC_LIST)
+        {
+            for (auto& func : symbol.second->FUNC_LIST->nodes)
+            {
+                func->FUNCTION->is_builtin = true;
+            }
+        }
+
         symbol_table[symbol.first] = symbol.second;
         builtins_names.push_back(symbol.first);
     }
@@ -439,9 +753,9 @@ void Typechecker::init(std::string builtins_path)
 
 // --- HELPERS --- //
 
-bool Typechecker::compare(const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs)
+bool Typechecker::compare(const Node_Ptr &lhs, const Node_Ptr &rhs)
 {
-    auto equality_node = std::make_shared<Node>(NodeType::OP);
+    auto equality_node = make_pooled_node(NodeType::OP);
     equality_node->OP.op_type = NodeType::L_ANGLE;
     equality_node->left = lhs;
     equality_node->right = rhs;
@@ -453,7 +767,7 @@ bool Typechecker::compare(const std::shared_ptr<Node> &lhs, const std::shared_pt
 
 // --- Type Checking --- //
 
-Typechecker::Match_Result Typechecker::match_values(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
+Typechecker::Match_Result Typechecker::match_values(Node_Ptr a, Node_Ptr b)
 {
     if (a->type == NodeType::INT)
     {
@@ -475,7 +789,7 @@ Typechecker::Match_Result Typechecker::match_values(std::shared_ptr<Node> a, std
     return {false, ""};
 }
 
-Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std::shared_ptr<Node> b, bool match_name)
+Typechecker::Match_Result Typechecker::match_types(Node_Ptr a, Node_Ptr b, bool match_name)
 {
     line = b->line;
     column = b->column;
@@ -516,7 +830,7 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             return {true, ""};
         }
 
-        for (auto& func : b->FUNC_LIST.nodes)
+        for (auto& func : b->FUNC_LIST->nodes)
         {
             if (match_types(a, func, match_name).result)
             {
@@ -527,15 +841,15 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
         return {false, "Cannot match against ambiguous function '" + b->repr()};
     }
 
-    if (a->type == NodeType::FUNCTION && a->FUNCTION.is_type)
+    if (a->type == NodeType::FUNCTION && a->FUNCTION->is_type)
     {
         std::vector<int> null_arg_indices;
 
-        if (a->FUNCTION.params.size() != 1)
+        if (a->FUNCTION->params.size() != 1)
         {
-            for (int i = 0; i < a->FUNCTION.args.size(); i++)
+            for (int i = 0; i < a->FUNCTION->args.size(); i++)
             {
-                if (a->FUNCTION.args[i] == nullptr)
+                if (a->FUNCTION->args[i] == nullptr)
                 {
                     null_arg_indices.push_back(i);
                 }
@@ -553,12 +867,12 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
         int param_index = null_arg_indices[0];
 
-        if (a->FUNCTION.params[param_index]->type != NodeType::ID)
+        if (a->FUNCTION->params[param_index]->type != NodeType::ID)
         {
             error_and_exit("Refinement type function must have one basic parameter");
         }
 
-        auto param = a->FUNCTION.params[param_index];
+        auto param = a->FUNCTION->params[param_index];
 
         if (param->ID.type == nullptr)
         {
@@ -586,19 +900,19 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
         auto res = eval_function_call(a, {arg});
 
-        std::string refinement_error_message = "Value '" + arg->repr() + "' does not match refinement type '" + a->FUNCTION.name + "'";
+        std::string refinement_error_message = "Value '" + arg->repr() + "' does not match refinement type '" + a->FUNCTION->name + "'";
 
         if (res->BOOL.value)
         {
             return {true, ""};
         }
 
-        if (a->FUNCTION.body->BLOCK.nodes.size() > 0 && a->FUNCTION.body->BLOCK.nodes[0]->type == NodeType::BLOCK)
+        if (a->FUNCTION->body->BLOCK->nodes.size() > 0 && a->FUNCTION->body->BLOCK->nodes[0]->type == NodeType::BLOCK)
         {
-            auto str_block = a->FUNCTION.body->BLOCK.nodes[0];
-            if (str_block->BLOCK.nodes.size() == 1)
+            auto str_block = a->FUNCTION->body->BLOCK->nodes[0];
+            if (str_block->BLOCK->nodes.size() == 1)
             {
-                auto message = eval_node(str_block->BLOCK.nodes[0]);
+                auto message = eval_node(str_block->BLOCK->nodes[0]);
 
                 if (message->type == NodeType::STRING)
                 {
@@ -607,27 +921,27 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             }
         }
 
-        return {false, "Value '" + b->repr() + "' does not match refinement type '" + a->FUNCTION.name + "'"};
+        return {false, "Value '" + b->repr() + "' does not match refinement type '" + a->FUNCTION->name + "'"};
     }
 
     if (a->type == NodeType::PIPE_LIST)
     {
         if (b->type == NodeType::PIPE_LIST)
         {
-            sort_and_unique(a->PIPE_LIST.nodes);
-            sort_and_unique(b->PIPE_LIST.nodes);
+            sort_and_unique(a->PIPE_LIST->nodes);
+            sort_and_unique(b->PIPE_LIST->nodes);
 
             bool match;
 
-            for (auto& b_type : b->PIPE_LIST.nodes)
+            for (auto& b_type : b->PIPE_LIST->nodes)
             {
                 match = false;
 
-                for (auto& a_type : a->PIPE_LIST.nodes)
+                for (auto& a_type : a->PIPE_LIST->nodes)
                 {
                     if (match_types(a_type, b_type, match_name).result)
                     {
-                        if (a_type->OBJECT.is_type)
+                        if (a_type->OBJECT->is_type)
                         {
                             b_type->TYPE.name = a_type->TYPE.name;
                         }
@@ -642,7 +956,7 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
         std::string message = "";
 
-        for (auto& t : a->PIPE_LIST.nodes)
+        for (auto& t : a->PIPE_LIST->nodes)
         {
             auto match = match_types(t, b, match_name);
             message = match.message;
@@ -682,14 +996,14 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
     if (a->type == NodeType::LIST)
     {
-        if (!a->TYPE.is_literal && a->LIST.nodes.size() == 0)
+        if (!a->TYPE.is_literal && a->LIST.nodes().size() == 0)
         {
             return {true, ""};
         }
 
         a->TYPE.is_literal = true;
 
-        int type_a_size = a->LIST.nodes.size();
+        int type_a_size = a->LIST.nodes().size();
 
         if (type_a_size > 1)
         {
@@ -698,12 +1012,12 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
         if (type_a_size == 0)
         {
-            a->LIST.nodes.push_back(make_any());
+            a->LIST.nodes().push_back(make_any());
             return {true, ""};
         }
 
         auto type_b = b;
-        int type_b_size = type_b->LIST.nodes.size();
+        int type_b_size = type_b->LIST.nodes().size();
 
 
         if (type_b_size == 0)
@@ -711,18 +1025,18 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             return {true, ""};
         }
 
-        if (type_a_size > 0 && a->LIST.nodes[0]->type == NodeType::ANY)
+        if (type_a_size > 0 && a->LIST.nodes()[0]->type == NodeType::ANY)
         {
             return {true, ""};
         }
 
-        if (type_a_size == 1 && a->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+        if (type_a_size == 1 && a->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
         {
-            if (type_b->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+            if (type_b->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
             {
-                for (auto& elem : type_b->LIST.nodes[0]->PIPE_LIST.nodes)
+                for (auto& elem : type_b->LIST.nodes()[0]->PIPE_LIST->nodes)
                 {
-                    auto match = match_types(a->LIST.nodes[0], elem, match_name);
+                    auto match = match_types(a->LIST.nodes()[0], elem, match_name);
                     if (!match.result)
                     {
                         return {false, match.message};
@@ -732,9 +1046,9 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
                 return {true, ""};
             }
 
-            for (auto& elem : type_b->LIST.nodes)
+            for (auto& elem : type_b->LIST.nodes())
             {
-                auto match = match_types(a->LIST.nodes[0], elem, match_name);
+                auto match = match_types(a->LIST.nodes()[0], elem, match_name);
                 if (!match.result)
                 {
                     return {false, match.message};
@@ -746,9 +1060,9 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
         if (type_a_size == 1)
         {
-            for (auto& t : type_b->LIST.nodes)
+            for (auto& t : type_b->LIST.nodes())
             {
-                auto match = match_types(a->LIST.nodes[0], t, match_name);
+                auto match = match_types(a->LIST.nodes()[0], t, match_name);
                 if (!match.result)
                 {
                     return {false, match.message};
@@ -763,28 +1077,28 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
     if (a->type == NodeType::OBJECT)
     {
-        if (!a->TYPE.is_literal && a->OBJECT.properties.size() == 0)
+        if (!a->TYPE.is_literal && a->OBJECT->properties.size() == 0)
         {
             return {true, ""};
         }
 
         a->TYPE.is_literal = true;
 
-        if (a->OBJECT.properties.size() < b->OBJECT.properties.size())
+        if (a->OBJECT->properties.size() < b->OBJECT->properties.size())
         {
             return {false, ""};
         }
 
-        for (auto& prop : b->OBJECT.properties)
+        for (auto& prop : b->OBJECT->properties)
         {
-            if (a->OBJECT.properties.find(prop.first) == a->OBJECT.properties.end())
+            if (a->OBJECT->properties.find(prop.first) == a->OBJECT->properties.end())
             {
                 return {false, ""};
             }
         }
-        for (auto& prop : a->OBJECT.properties)
+        for (auto& prop : a->OBJECT->properties)
         {
-            if (b->OBJECT.properties.find(prop.first) == b->OBJECT.properties.end())
+            if (b->OBJECT->properties.find(prop.first) == b->OBJECT->properties.end())
             {
                 if (prop.second.required)
                 {
@@ -795,7 +1109,7 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             }
 
             auto a_prop = prop.second;
-            auto b_prop = b->OBJECT.properties[prop.first];
+            auto b_prop = b->OBJECT->properties[prop.first];
 
             auto match = match_types(a_prop.value, b_prop.value, match_name);
             if (!match.result)
@@ -814,20 +1128,20 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             return {true, ""};
         }
 
-        if (a->FUNCTION.params.size() != b->FUNCTION.params.size())
+        if (a->FUNCTION->params.size() != b->FUNCTION->params.size())
         {
             return {false, ""};
         }
 
-        for (int i = 0; i < a->FUNCTION.params.size(); i++)
+        for (int i = 0; i < a->FUNCTION->params.size(); i++)
         {
-            if (a->FUNCTION.params[i]->type != b->FUNCTION.params[i]->type)
+            if (a->FUNCTION->params[i]->type != b->FUNCTION->params[i]->type)
             {
                 return {false, ""};
             }
 
-            auto a_type = get_explicit_type(a->FUNCTION.params[i]);
-            auto b_type = get_explicit_type(b->FUNCTION.params[i]);
+            auto a_type = get_explicit_type(a->FUNCTION->params[i]);
+            auto b_type = get_explicit_type(b->FUNCTION->params[i]);
 
             auto match = match_types(a_type, b_type, match_name);
             if (!match.result)
@@ -836,8 +1150,8 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
             }
         }
 
-        auto a_ret = a->FUNCTION.return_type;
-        auto b_ret = b->FUNCTION.return_type;
+        auto a_ret = a->FUNCTION->return_type;
+        auto b_ret = b->FUNCTION->return_type;
 
         auto match = match_types(a_ret, b_ret, match_name);
         if (!match.result)
@@ -855,12 +1169,12 @@ Typechecker::Match_Result Typechecker::match_types(std::shared_ptr<Node> a, std:
 
 // --- OPERATIONS --- //
 
-std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_add(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -888,30 +1202,30 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
     {
         auto res = make_pipe_list();
 
-        for (auto& elem : left->PIPE_LIST.nodes)
+        for (auto& elem : left->PIPE_LIST->nodes)
         {
-            auto op = std::make_shared<Node>(*node);
+            auto op = make_pooled_node(*node);
             op->left = elem;
             op->right = right;
             auto result = eval_node(op);
             if (result->type == NodeType::PIPE_LIST)
             {
-                for (auto& e : result->PIPE_LIST.nodes)
+                for (auto& e : result->PIPE_LIST->nodes)
                 {
-                    res->PIPE_LIST.nodes.push_back(e);
+                    res->PIPE_LIST->nodes.push_back(e);
                 }
             }
             else
             {
-                res->PIPE_LIST.nodes.push_back(result);
+                res->PIPE_LIST->nodes.push_back(result);
             }
         }
 
-        sort_and_unique(res->PIPE_LIST.nodes);
+        sort_and_unique(res->PIPE_LIST->nodes);
 
-        if (res->PIPE_LIST.nodes.size() == 1)
+        if (res->PIPE_LIST->nodes.size() == 1)
         {
-            return res->PIPE_LIST.nodes[0];
+            return res->PIPE_LIST->nodes[0];
         }
 
         return res;
@@ -921,30 +1235,30 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
     {
         auto res = make_pipe_list();
 
-        for (auto& elem : right->PIPE_LIST.nodes)
+        for (auto& elem : right->PIPE_LIST->nodes)
         {
-            auto op = std::make_shared<Node>(*node);
+            auto op = make_pooled_node(*node);
             op->left = left;
             op->right = elem;
             auto result = eval_node(op);
             if (result->type == NodeType::PIPE_LIST)
             {
-                for (auto& e : result->PIPE_LIST.nodes)
+                for (auto& e : result->PIPE_LIST->nodes)
                 {
-                    res->PIPE_LIST.nodes.push_back(e);
+                    res->PIPE_LIST->nodes.push_back(e);
                 }
             }
             else
             {
-                res->PIPE_LIST.nodes.push_back(result);
+                res->PIPE_LIST->nodes.push_back(result);
             }
         }
 
-        sort_and_unique(res->PIPE_LIST.nodes);
+        sort_and_unique(res->PIPE_LIST->nodes);
 
-        if (res->PIPE_LIST.nodes.size() == 1)
+        if (res->PIPE_LIST->nodes.size() == 1)
         {
-            return res->PIPE_LIST.nodes[0];
+            return res->PIPE_LIST->nodes[0];
         }
 
         return res;
@@ -984,21 +1298,21 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         }
         if (right->type == NodeType::LIST)
         {
-            res = std::make_shared<Node>(*right);
+            res = make_pooled_node(*right);
 
-            if (right->LIST.nodes.size() == 0)
+            if (right->LIST.nodes().size() == 0)
             {
-                res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             }
             else
             {
-                if (res->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+                if (res->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
                 {
-                    res->LIST.nodes[0]->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                    res->LIST.nodes()[0]->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), left);
                 }
                 else
                 {
-                    res->LIST.nodes[0] = left;
+                    res->LIST.nodes()[0] = left;
                 }
             }
 
@@ -1036,21 +1350,21 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         }
         if (right->type == NodeType::LIST)
         {
-            res = std::make_shared<Node>(*right);
+            res = make_pooled_node(*right);
 
-            if (right->LIST.nodes.size() == 0)
+            if (right->LIST.nodes().size() == 0)
             {
-                res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             }
             else
             {
-                if (res->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+                if (res->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
                 {
-                    res->LIST.nodes[0]->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                    res->LIST.nodes()[0]->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), left);
                 }
                 else
                 {
-                    res->LIST.nodes[0] = left;
+                    res->LIST.nodes()[0] = left;
                 }
             }
 
@@ -1059,7 +1373,7 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         // if (right->type == NodeType::LIST)
         // {
         //     res->type = NodeType::LIST;
-        //     res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+        //     res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
         //     return res;
         // }
 
@@ -1094,21 +1408,21 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         }
         if (right->type == NodeType::LIST)
         {
-            res = std::make_shared<Node>(*right);
+            res = make_pooled_node(*right);
 
-            if (right->LIST.nodes.size() == 0)
+            if (right->LIST.nodes().size() == 0)
             {
-                res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             }
             else
             {
-                if (res->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+                if (res->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
                 {
-                    res->LIST.nodes[0]->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                    res->LIST.nodes()[0]->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), left);
                 }
                 else
                 {
-                    res->LIST.nodes[0] = left;
+                    res->LIST.nodes()[0] = left;
                 }
             }
 
@@ -1117,7 +1431,7 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         // if (right->type == NodeType::LIST)
         // {
         //     res->type = NodeType::LIST;
-        //     res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+        //     res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
         //     return res;
         // }
 
@@ -1152,21 +1466,21 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         }
         if (right->type == NodeType::LIST)
         {
-            res = std::make_shared<Node>(*right);
+            res = make_pooled_node(*right);
 
-            if (right->LIST.nodes.size() == 0)
+            if (right->LIST.nodes().size() == 0)
             {
-                res->LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                res->LIST.nodes().insert(res->LIST.nodes().begin(), left);
             }
             else
             {
-                if (res->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+                if (res->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
                 {
-                    res->LIST.nodes[0]->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), left);
+                    res->LIST.nodes()[0]->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), left);
                 }
                 else
                 {
-                    res->LIST.nodes[0] = left;
+                    res->LIST.nodes()[0] = left;
                 }
             }
 
@@ -1175,7 +1489,7 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         // if (right->type == NodeType::LIST)
         // {
         //     res->type = NodeType::LIST;
-        //     res->LIST.nodes.insert(res->LIST.nodes.begin(), res->left);
+        //     res->LIST.nodes().insert(res->LIST.nodes().begin(), res->left);
         //     return res;
         // }
 
@@ -1187,32 +1501,32 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::LIST)
         {
             res->type = NodeType::LIST;
-            res->LIST.nodes = left->LIST.nodes;
+            res->LIST.nodes() = left->LIST.nodes();
 
-            for (auto _node : right->LIST.nodes)
+            for (auto _node : right->LIST.nodes())
             {
-                res->LIST.nodes.push_back(_node);
+                res->LIST.nodes().push_back(_node);
             }
 
             return res;
         }
         else
         {
-            res = std::make_shared<Node>(*left);
+            res = make_pooled_node(*left);
 
-            if (res->LIST.nodes.size() == 0)
+            if (res->LIST.nodes().size() == 0)
             {
-                res->LIST.nodes.insert(res->LIST.nodes.begin(), right);
+                res->LIST.nodes().insert(res->LIST.nodes().begin(), right);
             }
             else
             {
-                if (res->LIST.nodes[0]->type == NodeType::PIPE_LIST)
+                if (res->LIST.nodes()[0]->type == NodeType::PIPE_LIST)
                 {
-                    res->LIST.nodes[0]->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), right);
+                    res->LIST.nodes()[0]->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), right);
                 }
                 else
                 {
-                    res->LIST.nodes[0] = right;
+                    res->LIST.nodes()[0] = right;
                 }
             }
 
@@ -1220,8 +1534,8 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         }
 
         // res->type = NodeType::LIST;
-        // res->LIST.nodes = left->LIST.nodes;
-        // res->LIST.nodes.push_back(right);
+        // res->LIST.nodes() = left->LIST.nodes();
+        // res->LIST.nodes().push_back(right);
         // return res;
     }
 
@@ -1230,11 +1544,11 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
         if (right->type == NodeType::OBJECT)
         {
             res->type = NodeType::OBJECT;
-            res->OBJECT.properties = left->OBJECT.properties;
+            res->OBJECT->properties = left->OBJECT->properties;
 
-            for (auto prop : right->OBJECT.properties)
+            for (auto prop : right->OBJECT->properties)
             {
-                res->OBJECT.properties[prop.first] = prop.second;
+                res->OBJECT->properties[prop.first] = prop.second;
             }
 
             return res;
@@ -1246,12 +1560,12 @@ std::shared_ptr<Node> Typechecker::eval_add(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Typechecker::eval_sub(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_sub(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -1361,12 +1675,12 @@ std::shared_ptr<Node> Typechecker::eval_sub(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_mul(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -1430,7 +1744,7 @@ std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < left->INT.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(right));
+                res->LIST.nodes().push_back(eval_copy(right));
             }
             return res;
         }
@@ -1496,7 +1810,7 @@ std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < left->BOOL.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(right));
+                res->LIST.nodes().push_back(eval_copy(right));
             }
             return res;
         }
@@ -1535,7 +1849,7 @@ std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < right->INT.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(left));
+                res->LIST.nodes().push_back(eval_copy(left));
             }
             return res;
         }
@@ -1545,7 +1859,7 @@ std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
             res->type = NodeType::LIST;
             for (int i = 0; i < right->BOOL.value; i++)
             {
-                res->LIST.nodes.push_back(eval_copy(left));
+                res->LIST.nodes().push_back(eval_copy(left));
             }
             return res;
         }
@@ -1561,12 +1875,12 @@ std::shared_ptr<Node> Typechecker::eval_mul(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Typechecker::eval_div(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_div(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -1686,12 +2000,12 @@ std::shared_ptr<Node> Typechecker::eval_div(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Typechecker::eval_mod(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_mod(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -1746,7 +2060,7 @@ std::shared_ptr<Node> Typechecker::eval_mod(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform '" + node->repr() + "' on " + left->repr() + " and " + right->repr());
 }
 
-std::shared_ptr<Node> Typechecker::eval_pos_neg(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_pos_neg(Node_Ptr& node)
 {
     auto right = eval_node(node->right);
 
@@ -1755,7 +2069,7 @@ std::shared_ptr<Node> Typechecker::eval_pos_neg(std::shared_ptr<Node>& node)
         return right;
     }
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (right->type == NodeType::EMPTY)
     {
@@ -1832,13 +2146,13 @@ std::shared_ptr<Node> Typechecker::eval_pos_neg(std::shared_ptr<Node>& node)
         res->type = NodeType::LIST;
         if (res->OP.op_type == NodeType::POS)
         {
-            res->LIST.nodes = right->LIST.nodes;
+            res->LIST.nodes() = right->LIST.nodes();
         }
         else if (res->OP.op_type == NodeType::NEG)
         {
-            std::vector<std::shared_ptr<Node>> copy(right->LIST.nodes);
+            std::vector<Node_Ptr> copy(right->LIST.nodes());
             std::reverse(copy.begin(), copy.end());
-            res->LIST.nodes = copy;
+            res->LIST.nodes() = copy;
         } 
         return res;
     }
@@ -1846,7 +2160,7 @@ std::shared_ptr<Node> Typechecker::eval_pos_neg(std::shared_ptr<Node>& node)
     return right;
 }
 
-std::shared_ptr<Node> Typechecker::eval_not(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_not(Node_Ptr& node)
 {
     auto right = eval_node(node->right);
 
@@ -1855,7 +2169,7 @@ std::shared_ptr<Node> Typechecker::eval_not(std::shared_ptr<Node>& node)
         return right;
     }
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (right->type == NodeType::EMPTY)
     {
@@ -1895,7 +2209,7 @@ std::shared_ptr<Node> Typechecker::eval_not(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_equality(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_equality(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
@@ -1905,7 +2219,7 @@ std::shared_ptr<Node> Typechecker::eval_equality(std::shared_ptr<Node>& node)
         return make_bool(true, false);
     }
 
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
     res->type = NodeType::BOOL;
 
     if (left->type == NodeType::ANY || right->type == NodeType::ANY)
@@ -2085,18 +2399,18 @@ std::shared_ptr<Node> Typechecker::eval_equality(std::shared_ptr<Node>& node)
         }
         else if (left->type == NodeType::LIST && right->type == NodeType::LIST)
         {
-            if (left->LIST.nodes.size() != right->LIST.nodes.size())
+            if (left->LIST.nodes().size() != right->LIST.nodes().size())
             {
                 res->BOOL.value = false;
                 return res;
             }
 
-            for (int i = 0; i < left->LIST.nodes.size(); i++)
+            for (int i = 0; i < left->LIST.nodes().size(); i++)
             {
-                auto equality_node = std::make_shared<Node>(NodeType::OP);
+                auto equality_node = make_pooled_node(NodeType::OP);
                 equality_node->OP.op_type = NodeType::EQ_EQ;
-                equality_node->left = left->LIST.nodes[i];
-                equality_node->right = right->LIST.nodes[i];
+                equality_node->left = left->LIST.nodes()[i];
+                equality_node->right = right->LIST.nodes()[i];
 
                 auto result = eval_equality(equality_node);
                 if (result->BOOL.value == false)
@@ -2158,18 +2472,18 @@ std::shared_ptr<Node> Typechecker::eval_equality(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_and_or(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_and_or(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     
     if (left->type == NodeType::BOOL && !left->BOOL.value && node->OP.op_type == NodeType::AND)
     {
-        auto res = std::make_shared<Node>(*left);
+        auto res = make_pooled_node(*left);
         return res;
     }
 
     auto right = eval_node(node->right);
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     if (!left->TYPE.is_literal || !right->TYPE.is_literal)
     {
@@ -2196,13 +2510,13 @@ std::shared_ptr<Node> Typechecker::eval_and_or(std::shared_ptr<Node>& node)
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_copy(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_copy(Node_Ptr& node)
 {
     // node is the right operand of #
     // we set it as the node beforehand so we can recurse
 
     auto value = eval_node(node);
-    auto res = std::make_shared<Node>(*value);
+    auto res = make_pooled_node(*value);
 
     if (!value->TYPE.is_literal)
     {
@@ -2211,31 +2525,31 @@ std::shared_ptr<Node> Typechecker::eval_copy(std::shared_ptr<Node>& node)
 
     if (res->type == NodeType::LIST)
     {
-        for (int i = 0; i < value->LIST.nodes.size(); i++)
+        for (int i = 0; i < value->LIST.nodes().size(); i++)
         {
-            res->LIST.nodes[i] = eval_copy(value->LIST.nodes[i]);
+            res->LIST.nodes()[i] = eval_copy(value->LIST.nodes()[i]);
         }
     }
 
     if (res->type == NodeType::OBJECT)
     {
-        for (auto prop : value->OBJECT.properties)
+        for (auto prop : value->OBJECT->properties)
         {
-            res->OBJECT.properties[prop.first] = Object_Prop(prop.second.required, eval_copy(prop.second.value));
+            res->OBJECT->properties[prop.first] = Object_Prop(prop.second.required, eval_copy(prop.second.value));
         }
     }
 
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_dot(Node_Ptr& node)
 {
     if (node->left->type == NodeType::FUNC_CALL)
     {
         if (node->right->type == NodeType::LIST)
         {
             auto l = eval_node(node->left);
-            return eval_function_call(l, eval_node(node->right)->LIST.nodes);
+            return eval_function_call(l, eval_node(node->right)->LIST.nodes());
         }
     }
 
@@ -2251,30 +2565,30 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
     {
         auto res = make_pipe_list();
 
-        for (auto& elem : left->PIPE_LIST.nodes)
+        for (auto& elem : left->PIPE_LIST->nodes)
         {
-            auto dot = std::make_shared<Node>(NodeType::DOT);
+            auto dot = make_pooled_node(NodeType::DOT);
             dot->left = elem;
             dot->right = right;
             auto result = eval_dot(dot);
             if (result->type == NodeType::PIPE_LIST)
             {
-                for (auto& e : result->PIPE_LIST.nodes)
+                for (auto& e : result->PIPE_LIST->nodes)
                 {
-                    res->PIPE_LIST.nodes.push_back(e);
+                    res->PIPE_LIST->nodes.push_back(e);
                 }
             }
             else
             {
-                res->PIPE_LIST.nodes.push_back(result);
+                res->PIPE_LIST->nodes.push_back(result);
             }
         }
 
-        sort_and_unique(res->PIPE_LIST.nodes);
+        sort_and_unique(res->PIPE_LIST->nodes);
 
-        if (res->PIPE_LIST.nodes.size() == 1)
+        if (res->PIPE_LIST->nodes.size() == 1)
         {
-            return res->PIPE_LIST.nodes[0];
+            return res->PIPE_LIST->nodes[0];
         }
 
         return res;
@@ -2284,30 +2598,30 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
     {
         auto res = make_pipe_list();
 
-        for (auto& elem : right->PIPE_LIST.nodes)
+        for (auto& elem : right->PIPE_LIST->nodes)
         {
-            auto dot = std::make_shared<Node>(NodeType::DOT);
+            auto dot = make_pooled_node(NodeType::DOT);
             dot->left = left;
             dot->right = elem;
             auto result = eval_dot(dot);
             if (result->type == NodeType::PIPE_LIST)
             {
-                for (auto& e : result->PIPE_LIST.nodes)
+                for (auto& e : result->PIPE_LIST->nodes)
                 {
-                    res->PIPE_LIST.nodes.push_back(e);
+                    res->PIPE_LIST->nodes.push_back(e);
                 }
             }
             else
             {
-                res->PIPE_LIST.nodes.push_back(result);
+                res->PIPE_LIST->nodes.push_back(result);
             }
         }
 
-        sort_and_unique(res->PIPE_LIST.nodes);
+        sort_and_unique(res->PIPE_LIST->nodes);
 
-        if (res->PIPE_LIST.nodes.size() == 1)
+        if (res->PIPE_LIST->nodes.size() == 1)
         {
-            return res->PIPE_LIST.nodes[0];
+            return res->PIPE_LIST->nodes[0];
         }
 
         return res;
@@ -2321,40 +2635,40 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("List accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type != NodeType::INT)
             {
                 error_and_exit("List accessor expects an integer");
             }
 
-            return left->TYPE.allowed_type->LIST.nodes[0];
+            return left->TYPE.allowed_type->LIST.nodes()[0];
         }
 
         // List built-ins
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "flatten")
+            if (right->FUNC_CALL->name == "flatten")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
                 bool all = false;
 
-                if (right->FUNC_CALL.args.size() == 1)
+                if (right->FUNC_CALL->args.size() == 1)
                 {
-                    auto bool_node = eval_node(right->FUNC_CALL.args[0]);
+                    auto bool_node = eval_node(right->FUNC_CALL->args[0]);
                     if (bool_node->type != NodeType::BOOL)
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' a boolean argument");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' a boolean argument");
                     }
 
                     all = bool_node->BOOL.value;
@@ -2362,133 +2676,185 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "sort")
+            if (right->FUNC_CALL->name == "sort" || right->FUNC_CALL->name == "stable_sort")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
-                if (right->FUNC_CALL.args.size() == 0)
+                if (right->FUNC_CALL->args.size() == 0)
                 {
                     return left;
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function");
+                }
+
+                return left;
+            }
+            if (right->FUNC_CALL->name == "sort_by")
+            {
+                if (right->FUNC_CALL->args.size() != 1 && right->FUNC_CALL->args.size() != 2)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 or 2 arguments");
+                }
+
+                auto name_node = eval_node(right->FUNC_CALL->args[0]);
+
+                if (name_node->type != NodeType::STRING)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the first argument to be a string");
+                }
+
+                if (right->FUNC_CALL->args.size() == 2)
+                {
+                    auto bool_node = eval_node(right->FUNC_CALL->args[1]);
+
+                    if (bool_node->type != NodeType::BOOL)
+                    {
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the second argument to be a boolean");
+                    }
                 }
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "map")
+            if (right->FUNC_CALL->name == "top_k")
+            {
+                if (right->FUNC_CALL->args.size() != 1 && right->FUNC_CALL->args.size() != 2)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 or 2 arguments");
+                }
+
+                auto k_node = eval_node(right->FUNC_CALL->args[0]);
+
+                if (k_node->type != NodeType::INT)
+                {
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the first argument to be an int");
+                }
+
+                if (right->FUNC_CALL->args.size() == 2)
+                {
+                    auto func = eval_node(right->FUNC_CALL->args[1]);
+
+                    if (func->type != NodeType::FUNCTION)
+                    {
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects the second argument to be a function");
+                    }
+                }
+
+                return left;
+            }
+            if (right->FUNC_CALL->name == "map")
             {
                 auto res = make_list();
 
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 if (func->type == NodeType::PARTIAL_OP)
                 {
-                    auto arrow_node = std::make_shared<Node>(NodeType::OP);
+                    auto arrow_node = make_pooled_node(NodeType::OP);
                     arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
-                    arrow_node->left = left->LIST.nodes[0];
-                    arrow_node->right = std::make_shared<Node>(*func);
-                    res->LIST.nodes.push_back(eval_double_arrow(arrow_node));
+                    arrow_node->left = left->LIST.nodes()[0];
+                    arrow_node->right = make_pooled_node(*func);
+                    res->LIST.nodes().push_back(eval_double_arrow(arrow_node));
 
                     return res;
                 }
 
                 if (func->TYPE.is_literal)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
+                    std::vector<Node_Ptr> args;
 
-                    if (func->FUNCTION.params.size() == 0 || func->FUNCTION.params.size() > 3)
+                    if (func->FUNCTION->params.size() == 0 || func->FUNCTION->params.size() > 3)
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
 
-                    auto elem_type = eval_node(left->LIST.nodes[0]);
+                    auto elem_type = eval_node(left->LIST.nodes()[0]);
 
-                    func->FUNCTION.params[0]->ID.type = elem_type;
+                    func->FUNCTION->params[0]->ID.type = elem_type;
 
-                    if (func->FUNCTION.params.size() == 1)
+                    if (func->FUNCTION->params.size() == 1)
                     {
                         args = {elem_type};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = 0;
                         args = {elem_type, index_node};
 
-                        func->FUNCTION.params[1]->ID.type = make_int(0, false);
+                        func->FUNCTION->params[1]->ID.type = make_int(0, false);
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = 0;
                         args = {elem_type, index_node, left};
 
-                        func->FUNCTION.params[1]->ID.type = make_int(0, false);
-                        func->FUNCTION.params[2]->ID.type = left;
+                        func->FUNCTION->params[1]->ID.type = make_int(0, false);
+                        func->FUNCTION->params[2]->ID.type = left;
                     }
 
                     type_func(func);
 
-                    res->LIST.nodes.push_back(eval_function_call(func, args));
+                    res->LIST.nodes().push_back(eval_function_call(func, args));
                 }
                 else
                 {
-                    res->LIST.nodes.push_back(make_any());
+                    res->LIST.nodes().push_back(make_any());
                 }
 
                 res->TYPE.allowed_type = res;
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "flatmap")
+            if (right->FUNC_CALL->name == "flatmap")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
                 if (func->type == NodeType::PARTIAL_OP)
                 {
-                    auto arrow_node = std::make_shared<Node>(NodeType::OP);
+                    auto arrow_node = make_pooled_node(NodeType::OP);
                     arrow_node->OP.op_type = NodeType::DOUBLE_ARROW;
-                    arrow_node->left = left->TYPE.allowed_type->LIST.nodes[0];
-                    arrow_node->right = std::make_shared<Node>(*func);
+                    arrow_node->left = left->TYPE.allowed_type->LIST.nodes()[0];
+                    arrow_node->right = make_pooled_node(*func);
                     auto result = eval_double_arrow(arrow_node);
 
                     if (result->type == NodeType::LIST)
                     {
-                        res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+                        res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
                     }
                     else
                     {
-                        res->LIST.nodes.push_back(result);
+                        res->LIST.nodes().push_back(result);
                     }
 
                     res->TYPE.allowed_type = res;
@@ -2498,106 +2864,106 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 if (func->TYPE.is_literal)
                 {
-                    std::vector<std::shared_ptr<Node>> args;
+                    std::vector<Node_Ptr> args;
 
-                    if (func->FUNCTION.params.size() == 1)
+                    if (func->FUNCTION->params.size() == 1)
                     {
-                        args = {eval_node(left->LIST.nodes[0])};
+                        args = {eval_node(left->LIST.nodes()[0])};
                     }
-                    else if (func->FUNCTION.params.size() == 2)
+                    else if (func->FUNCTION->params.size() == 2)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = 0;
-                        args = {eval_node(left->LIST.nodes[0]), index_node};
+                        args = {eval_node(left->LIST.nodes()[0]), index_node};
                     }
-                    else if (func->FUNCTION.params.size() == 3)
+                    else if (func->FUNCTION->params.size() == 3)
                     {
-                        auto index_node = std::make_shared<Node>(NodeType::INT);
+                        auto index_node = make_pooled_node(NodeType::INT);
                         index_node->INT.value = 0;
-                        args = {eval_node(left->LIST.nodes[0]), index_node, left};
+                        args = {eval_node(left->LIST.nodes()[0]), index_node, left};
                     }
                     else
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
 
                     auto result = eval_function_call(func, args);
 
                     if (result->type == NodeType::LIST)
                     {
-                        res->LIST.nodes.insert(res->LIST.nodes.end(), result->LIST.nodes.begin(), result->LIST.nodes.end());
+                        res->LIST.nodes().insert(res->LIST.nodes().end(), result->LIST.nodes().begin(), result->LIST.nodes().end());
                     }
                     else
                     {
-                        res->LIST.nodes.push_back(result);
+                        res->LIST.nodes().push_back(result);
                     }
                 }
                 else
                 {
-                    res->LIST.nodes.push_back(make_any());
+                    res->LIST.nodes().push_back(make_any());
                 }
 
                 res->TYPE.allowed_type = res;
 
                 return res;
             }
-            if (right->FUNC_CALL.name == "filter")
+            if (right->FUNC_CALL->name == "filter")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION && func->type != NodeType::PARTIAL_OP)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function or a partial operator");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function or a partial operator");
                 }
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "foreach")
+            if (right->FUNC_CALL->name == "foreach")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto func = eval_node(right->FUNC_CALL.args[0]);
+                auto func = eval_node(right->FUNC_CALL->args[0]);
 
                 if (func->type != NodeType::FUNCTION)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects argument to be a function");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects argument to be a function");
                 }
 
                 auto res = make_list(left->TYPE.is_literal);
 
                 if (func->TYPE.is_literal)
                 {
-                    if (func->FUNCTION.params.size() > 3)
+                    if (func->FUNCTION->params.size() > 3)
                     {
-                        error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects function argument to have 1, 2 or 3 parameters");
+                        error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects function argument to have 1, 2 or 3 parameters");
                     }
                 }
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "append")
+            if (right->FUNC_CALL->name == "append")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2606,7 +2972,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2618,26 +2984,26 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "prepend")
+            if (right->FUNC_CALL->name == "prepend")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
                 if (typecheck)
                 {
-                    left->LIST.nodes.clear();
+                    left->LIST.nodes().clear();
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2646,7 +3012,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2658,23 +3024,23 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "insert")
+            if (right->FUNC_CALL->name == "insert")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 argument");
                 }
 
                 if (typecheck)
                 {
-                    left->LIST.nodes.clear();
+                    left->LIST.nodes().clear();
                 }
 
-                auto position_node = eval_node(right->FUNC_CALL.args[0]);
+                auto position_node = eval_node(right->FUNC_CALL->args[0]);
 
                 if (position_node->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects first argument to be an integer");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects first argument to be an integer");
                 }
                 
                 int position = position_node->INT.value;
@@ -2687,19 +3053,19 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 {
                     position = 0;
                 }
-                else if (position >= left->LIST.nodes.size())
+                else if (position >= left->LIST.nodes().size())
                 {
-                    position = left->LIST.nodes.size()-1;
+                    position = left->LIST.nodes().size()-1;
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[1]);
+                auto value = eval_node(right->FUNC_CALL->args[1]);
 
-                std::shared_ptr<Node> elem_type;
+                Node_Ptr elem_type;
 
                 if (left->TYPE.allowed_type == nullptr)
                 {
                     left->TYPE.allowed_type = make_list();
-                    left->TYPE.allowed_type->LIST.nodes.push_back(make_any());
+                    left->TYPE.allowed_type->LIST.nodes().push_back(make_any());
                 }
 
                 if (left->TYPE.allowed_type->type == NodeType::ANY)
@@ -2708,7 +3074,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 }
                 else
                 {
-                    elem_type = left->TYPE.allowed_type->LIST.nodes[0];
+                    elem_type = left->TYPE.allowed_type->LIST.nodes()[0];
                 }
 
                 auto match = match_types(elem_type, value);
@@ -2720,21 +3086,21 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "remove")
+            if (right->FUNC_CALL->name == "remove")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 1 integer argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 1 integer argument");
                 }
 
-                if (left->LIST.nodes.size() == 0)
+                if (left->LIST.nodes().size() == 0)
                 {
                     return left;
                 }
@@ -2746,40 +3112,40 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                     pos = 0;
                 }
 
-                if (pos >= left->LIST.nodes.size())
+                if (pos >= left->LIST.nodes().size())
                 {
-                    pos = left->LIST.nodes.size() - 1;
+                    pos = left->LIST.nodes().size() - 1;
                 }
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "clear")
+            if (right->FUNC_CALL->name == "clear")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 return left;
             }
-            if (right->FUNC_CALL.name == "subsection")
+            if (right->FUNC_CALL->name == "subsection")
             {
-                if (left->LIST.nodes.size() == 0)
+                if (left->LIST.nodes().size() == 0)
                 {
                     return left;
                 }
 
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto begin = eval_node(right->FUNC_CALL.args[0]);
-                auto end = eval_node(right->FUNC_CALL.args[1]);
+                auto begin = eval_node(right->FUNC_CALL->args[0]);
+                auto end = eval_node(right->FUNC_CALL->args[1]);
 
                 if (begin->type != NodeType::INT && end->type != NodeType::INT)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects 2 integer arguments");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects 2 integer arguments");
                 }
 
                 int _begin = begin->INT.value;
@@ -2790,14 +3156,14 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                     _begin = 0;
                 }
 
-                if (_begin >= left->LIST.nodes.size())
+                if (_begin >= left->LIST.nodes().size())
                 {
-                    _begin = left->LIST.nodes.size()-1;
+                    _begin = left->LIST.nodes().size()-1;
                 }
 
-                if (_end >= left->LIST.nodes.size())
+                if (_end >= left->LIST.nodes().size())
                 {
-                    _end = left->LIST.nodes.size()-1;
+                    _end = left->LIST.nodes().size()-1;
                 }
 
                 if (_end < 0)
@@ -2807,13 +3173,13 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 if (_begin > _end)
                 {
-                    error_and_exit("List built-in '" + right->FUNC_CALL.name + "' expects first argument to be less than or equal to second argument");
+                    error_and_exit("List built-in '" + right->FUNC_CALL->name + "' expects first argument to be less than or equal to second argument");
                 }
 
                 return left;
             }
 
-            error_and_exit("List does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("List does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         // List properties
@@ -2827,12 +3193,12 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
             }
             if (right->ID.value == "first")
             {
-                return left->TYPE.allowed_type->LIST.nodes[0];
+                return left->TYPE.allowed_type->LIST.nodes()[0];
             }
 
             if (right->ID.value == "last")
             {
-                return left->TYPE.allowed_type->LIST.nodes[0];
+                return left->TYPE.allowed_type->LIST.nodes()[0];
             }
             if (right->ID.value == "empty")
             {
@@ -2851,12 +3217,12 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("String accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (accessor->type != NodeType::INT)
             {
@@ -2870,52 +3236,52 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "chars")
+            if (right->FUNC_CALL->name == "chars")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 auto res = make_list();
-                res->LIST.nodes.push_back(make_string("", false));
+                res->LIST.nodes().push_back(make_string("", false));
 
                 return res;
             }
 
-            if (right->FUNC_CALL.name == "lower")
+            if (right->FUNC_CALL->name == "lower")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "upper")
+            if (right->FUNC_CALL->name == "upper")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "subsection")
+            if (right->FUNC_CALL->name == "subsection")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto begin = eval_node(right->FUNC_CALL.args[0]);
-                auto end = eval_node(right->FUNC_CALL.args[1]);
+                auto begin = eval_node(right->FUNC_CALL->args[0]);
+                auto end = eval_node(right->FUNC_CALL->args[1]);
 
                 if (begin->type != NodeType::INT && end->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 integer arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 integer arguments");
                 }
 
                 int _begin = begin->INT.value;
@@ -2943,35 +3309,35 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 if (_begin > _end)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be less than or equal to second argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be less than or equal to second argument");
                 }
 
-                auto subsection = std::make_shared<Node>(*left);
+                auto subsection = make_pooled_node(*left);
                 subsection->STRING.value.clear();
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "split")
+            if (right->FUNC_CALL->name == "split")
             {
-                if (right->FUNC_CALL.args.size() != 0 && right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 0 && right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 or 1 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 or 1 arguments");
                 }
 
                 std::string delim;
 
-                if (right->FUNC_CALL.args.size() == 0)
+                if (right->FUNC_CALL->args.size() == 0)
                 {
                     delim = " ";
                 }
                 else
                 {
-                    auto delim_node = eval_node(right->FUNC_CALL.args[0]);
+                    auto delim_node = eval_node(right->FUNC_CALL->args[0]);
 
                     if (delim_node->type != NodeType::STRING)
                     {
-                        error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                        error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                     }
 
                     delim = delim_node->STRING.value;
@@ -2986,73 +3352,73 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 std::string token;
 
                 auto res = make_list();
-                res->LIST.nodes.push_back(make_string("", false));
+                res->LIST.nodes().push_back(make_string("", false));
 
                 return res;
             }
 
-            if (right->FUNC_CALL.name == "trim")
+            if (right->FUNC_CALL->name == "trim")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 0 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 0 arguments");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "append")
+            if (right->FUNC_CALL->name == "append")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "prepend")
+            if (right->FUNC_CALL->name == "prepend")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto value = eval_node(right->FUNC_CALL.args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[0]);
 
                 if (value->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 string argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 string argument");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "insert")
+            if (right->FUNC_CALL->name == "insert")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
-                auto value_node = eval_node(right->FUNC_CALL.args[1]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
+                auto value_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be of type int");
                 }
 
                 if (value_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects second argument to be of type string");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects second argument to be of type string");
                 }
 
                 int pos = pos_node->INT.value;
@@ -3070,24 +3436,24 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace_at")
+            if (right->FUNC_CALL->name == "replace_at")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
-                auto value_node = eval_node(right->FUNC_CALL.args[1]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
+                auto value_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects first argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects first argument to be of type int");
                 }
 
                 if (value_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects second argument to be of type string");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects second argument to be of type string");
                 }
 
                 int pos = pos_node->INT.value;
@@ -3105,18 +3471,18 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "remove")
+            if (right->FUNC_CALL->name == "remove")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
-                auto pos_node = eval_node(right->FUNC_CALL.args[0]);
+                auto pos_node = eval_node(right->FUNC_CALL->args[0]);
 
                 if (pos_node->type != NodeType::INT)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects argument to be of type int");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects argument to be of type int");
                 }
 
                 if (left->STRING.value.length() == 0)
@@ -3139,50 +3505,50 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace")
+            if (right->FUNC_CALL->name == "replace")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 argument");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 argument");
                 }
 
-                auto from_node = eval_node(right->FUNC_CALL.args[0]);
-                auto to_node = eval_node(right->FUNC_CALL.args[1]);
+                auto from_node = eval_node(right->FUNC_CALL->args[0]);
+                auto to_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (from_node->type != NodeType::STRING && to_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 string arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 string arguments");
                 }
 
                 return left;
             }
 
-            if (right->FUNC_CALL.name == "replace_all")
+            if (right->FUNC_CALL->name == "replace_all")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 arguments");
                 }
 
-                auto from_node = eval_node(right->FUNC_CALL.args[0]);
-                auto to_node = eval_node(right->FUNC_CALL.args[1]);
+                auto from_node = eval_node(right->FUNC_CALL->args[0]);
+                auto to_node = eval_node(right->FUNC_CALL->args[1]);
 
                 if (from_node->type != NodeType::STRING && to_node->type != NodeType::STRING)
                 {
-                    error_and_exit("String built-in '" + right->FUNC_CALL.name + "' expects 2 string arguments");
+                    error_and_exit("String built-in '" + right->FUNC_CALL->name + "' expects 2 string arguments");
                 }
 
                 return left;
             }
 
-            error_and_exit("String does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("String does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         // String properties
 
         if (right->type == NodeType::ID)
         {
-            auto res = std::make_shared<Node>(*node);
+            auto res = make_pooled_node(*node);
 
             if (right->ID.value == "length")
             {
@@ -3225,18 +3591,18 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
     if (left->type == NodeType::OBJECT)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
 
         // Property access
 
         if (right->type == NodeType::LIST)
         {
-            if (right->LIST.nodes.size() != 1)
+            if (right->LIST.nodes().size() != 1)
             {
                 error_and_exit("Object accessor expects one value");
             }
             
-            auto accessor = eval_node(right->LIST.nodes[0]);
+            auto accessor = eval_node(right->LIST.nodes()[0]);
 
             if (!left->TYPE.is_literal)
             {
@@ -3255,17 +3621,17 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
             auto prop_name = accessor->STRING.value;
 
-            if (left->OBJECT.properties.find(prop_name) == left->OBJECT.properties.end())
+            if (left->OBJECT->properties.find(prop_name) == left->OBJECT->properties.end())
             {
                 res->type = NodeType::ANY;
                 return res;
             }
 
-            auto value = left->TYPE.allowed_type->OBJECT.properties[prop_name].value;
+            auto value = left->TYPE.allowed_type->OBJECT->properties[prop_name].value;
 
-            if (value->type == NodeType::FUNCTION && value->FUNCTION.is_type)
+            if (value->type == NodeType::FUNCTION && value->FUNCTION->is_type)
             {
-                return get_explicit_type(value->FUNCTION.params[0]);
+                return get_explicit_type(value->FUNCTION->params[0]);
             }
 
             return value;
@@ -3280,7 +3646,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
             if (prop_name == "_keys")
             {
                 res = make_list();
-                res->LIST.nodes.push_back(make_string("", false));
+                res->LIST.nodes().push_back(make_string("", false));
                 return res;
             }
 
@@ -3290,26 +3656,26 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
                 if (!left->TYPE.is_literal)
                 {
-                    res->LIST.nodes.push_back(make_any());
+                    res->LIST.nodes().push_back(make_any());
                     return res;
                 }
 
                 auto value = make_pipe_list();
 
-                for (auto prop : left->TYPE.allowed_type->OBJECT.properties)
+                for (auto prop : left->TYPE.allowed_type->OBJECT->properties)
                 {
-                    // value->PIPE_LIST.nodes.insert(res->LIST.nodes.begin(), prop.second.value);
-                    value->PIPE_LIST.nodes.insert(value->PIPE_LIST.nodes.begin(), prop.second.value);
+                    // value->PIPE_LIST->nodes.insert(res->LIST.nodes().begin(), prop.second.value);
+                    value->PIPE_LIST->nodes.insert(value->PIPE_LIST->nodes.begin(), prop.second.value);
                 }
 
-                sort_and_unique(value->PIPE_LIST.nodes);
+                sort_and_unique(value->PIPE_LIST->nodes);
 
-                if (value->PIPE_LIST.nodes.size() == 1)
+                if (value->PIPE_LIST->nodes.size() == 1)
                 {
-                    value = value->PIPE_LIST.nodes[0]; 
+                    value = value->PIPE_LIST->nodes[0]; 
                 }
 
-                res->LIST.nodes.push_back(value);
+                res->LIST.nodes().push_back(value);
 
                 return res;
             }
@@ -3321,31 +3687,31 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 if (!left->TYPE.is_literal)
                 {
                     auto elem = make_object();
-                    elem->OBJECT.properties["key"] = Object_Prop(true, make_string("", false));
-                    elem->OBJECT.properties["value"] = Object_Prop(true, make_any());
-                    res->LIST.nodes.push_back(elem);
+                    elem->OBJECT->properties["key"] = Object_Prop(true, make_string("", false));
+                    elem->OBJECT->properties["value"] = Object_Prop(true, make_any());
+                    res->LIST.nodes().push_back(elem);
                     return res;
                 }
 
                 auto elem = make_object();
-                elem->OBJECT.properties["key"] = Object_Prop(true, make_string("", false));
+                elem->OBJECT->properties["key"] = Object_Prop(true, make_string("", false));
                 auto value = make_pipe_list();
 
-                for (auto prop : left->TYPE.allowed_type->OBJECT.properties)
+                for (auto prop : left->TYPE.allowed_type->OBJECT->properties)
                 {
-                    value->PIPE_LIST.nodes.insert(value->PIPE_LIST.nodes.begin(), prop.second.value);
+                    value->PIPE_LIST->nodes.insert(value->PIPE_LIST->nodes.begin(), prop.second.value);
                 }
 
-                sort_and_unique(value->PIPE_LIST.nodes);
+                sort_and_unique(value->PIPE_LIST->nodes);
 
-                if (value->PIPE_LIST.nodes.size() == 1)
+                if (value->PIPE_LIST->nodes.size() == 1)
                 {
-                    elem->OBJECT.properties["value"] = Object_Prop(true, value->PIPE_LIST.nodes[0]); 
+                    elem->OBJECT->properties["value"] = Object_Prop(true, value->PIPE_LIST->nodes[0]); 
                 }
 
-                elem->OBJECT.properties["value"] = Object_Prop(true, value);
+                elem->OBJECT->properties["value"] = Object_Prop(true, value);
 
-                res->LIST.nodes.push_back(elem);
+                res->LIST.nodes().push_back(elem);
 
                 return res;
             }
@@ -3355,17 +3721,17 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
                 return make_any();
             }
 
-            if (left->OBJECT.properties.find(prop_name) == left->OBJECT.properties.end())
+            if (left->OBJECT->properties.find(prop_name) == left->OBJECT->properties.end())
             {
                 res->type = NodeType::EMPTY;
                 return res;
             }
 
-            auto value = left->OBJECT.properties[prop_name].value;
+            auto value = left->OBJECT->properties[prop_name].value;
 
-            if (value->type == NodeType::FUNCTION && value->FUNCTION.is_type)
+            if (value->type == NodeType::FUNCTION && value->FUNCTION->is_type)
             {
-                return get_explicit_type(value->FUNCTION.params[0]);
+                return get_explicit_type(value->FUNCTION->params[0]);
             }
 
             return value;
@@ -3373,18 +3739,18 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
         if (right->type == NodeType::FUNC_CALL)
         {
-            auto name = right->FUNC_CALL.name;
+            auto name = right->FUNC_CALL->name;
 
             // built-ins
 
             if (name == "delete")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
                     error_and_exit("Object function '" + name + "' expects 1 argument");
                 }
 
-                auto prop_name = eval_node(right->FUNC_CALL.args[0]);
+                auto prop_name = eval_node(right->FUNC_CALL->args[0]);
 
                 if (prop_name->type != NodeType::STRING)
                 {
@@ -3396,7 +3762,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
             if (name == "clear")
             {
-                if (right->FUNC_CALL.args.size() != 0)
+                if (right->FUNC_CALL->args.size() != 0)
                 {
                     error_and_exit("Object function '" + name + "' expects 0 arguments");
                 }
@@ -3405,13 +3771,13 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
             }
             if (name == "add")
             {
-                if (right->FUNC_CALL.args.size() != 2)
+                if (right->FUNC_CALL->args.size() != 2)
                 {
                     error_and_exit("Object function '" + name + "' expects 2 arguments");
                 }
 
-                auto prop_name = eval_node(right->FUNC_CALL.args[0]);
-                auto value = eval_node(right->FUNC_CALL.args[1]);
+                auto prop_name = eval_node(right->FUNC_CALL->args[0]);
+                auto value = eval_node(right->FUNC_CALL->args[1]);
 
                 if (prop_name->type != NodeType::STRING)
                 {
@@ -3423,16 +3789,16 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
 
             // function properties
 
-            if (left->TYPE.allowed_type->OBJECT.properties.find(name) == left->TYPE.allowed_type->OBJECT.properties.end())
+            if (left->TYPE.allowed_type->OBJECT->properties.find(name) == left->TYPE.allowed_type->OBJECT->properties.end())
             {
                 error_and_exit("Function '" + name + "' does not exist on object");
             }
 
-            auto function = left->TYPE.allowed_type->OBJECT.properties[name].value;
+            auto function = left->TYPE.allowed_type->OBJECT->properties[name].value;
 
             // call function
 
-            return eval_function_call(function, right->FUNC_CALL.args);
+            return eval_function_call(function, right->FUNC_CALL->args);
         }
     }
 
@@ -3440,17 +3806,17 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
     {
         if (right->type == NodeType::FUNC_CALL)
         {
-            if (right->FUNC_CALL.name == "patch")
+            if (right->FUNC_CALL->name == "patch")
             {
-                if (right->FUNC_CALL.args.size() != 1)
+                if (right->FUNC_CALL->args.size() != 1)
                 {
-                    error_and_exit("Function function '" + right->FUNC_CALL.name + "' expects 1 argument");
+                    error_and_exit("Function function '" + right->FUNC_CALL->name + "' expects 1 argument");
                 }
 
                 return left;
             }
 
-            error_and_exit("Function does not contain built-in function '" + right->FUNC_CALL.name + "'");
+            error_and_exit("Function does not contain built-in function '" + right->FUNC_CALL->name + "'");
         }
 
         if (right->type == NodeType::ID)
@@ -3463,7 +3829,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
             if (right->ID.value == "params")
             {
                 auto params = make_list();
-                params->LIST.nodes.push_back(make_string("", false));
+                params->LIST.nodes().push_back(make_string("", false));
                
                 return params;
             }
@@ -3471,7 +3837,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
             if (right->ID.value == "args")
             {
                 auto args = make_list();
-                args->LIST.nodes.push_back(make_any());
+                args->LIST.nodes().push_back(make_any());
                
                 return args;
             }
@@ -3483,7 +3849,7 @@ std::shared_ptr<Node> Typechecker::eval_dot(std::shared_ptr<Node>& node)
     error_and_exit("Cannot perform operation '" + node->repr() + "' on '" + left->repr() + "' and '" + right->repr() + "'");
 }
 
-std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_equal(Node_Ptr& node)
 {
     // check if ID first, because evaluating an ID could return an error
 
@@ -3503,7 +3869,7 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
 
             if (node->left->ID.type == nullptr)
             {
-                auto val = std::make_shared<Node>(*value);
+                auto val = make_pooled_node(*value);
 
                 // EXPERIMENTAL
 
@@ -3515,10 +3881,10 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
 
                 if (val->type == NodeType::FUNCTION)
                 {
-                    val->FUNCTION.name = node->left->ID.value;
+                    val->FUNCTION->name = node->left->ID.value;
 
-                    auto func_list = std::make_shared<Node>(NodeType::FUNC_LIST);
-                    func_list->FUNC_LIST.nodes.push_back(val);
+                    auto func_list = make_pooled_node(NodeType::FUNC_LIST);
+                    func_list->FUNC_LIST->nodes.push_back(val);
                     symbol_table[node->left->ID.value] = func_list;
                     return val;
                 }
@@ -3540,20 +3906,20 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
             if (explicit_type->type == NodeType::TYPE)
             {
                 value->TYPE.name = node->left->ID.value;
-                value->OBJECT.is_type = true;
-                value->FUNCTION.is_type = true;
+                value->OBJECT->is_type = true;
+                value->FUNCTION->is_type = true;
             }
 
             if (explicit_type->type == NodeType::FUNCTION)
             {
-                explicit_type->FUNCTION.is_type = true;
+                explicit_type->FUNCTION->is_type = true;
             }
 
             if (value->TYPE.name == "")
             {
                 if (explicit_type->type == NodeType::FUNCTION)
                 {
-                    value->TYPE.name = explicit_type->FUNCTION.name;
+                    value->TYPE.name = explicit_type->FUNCTION->name;
                 }
                 else if (explicit_type->type == NodeType::OBJECT)
                 {
@@ -3569,22 +3935,22 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
                 error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + explicit_type->repr() + "'. " + match.message );
             }
 
-            std::shared_ptr<Node> val;
+            Node_Ptr val;
 
             if (value->type == NodeType::LIST)
             {
-                val = std::make_shared<Node>(*explicit_type);
+                val = make_pooled_node(*explicit_type);
                 val->TYPE.allowed_type = val;
             }
             else
             {
-                val = std::make_shared<Node>(*value);
+                val = make_pooled_node(*value);
                 val->TYPE.allowed_type = explicit_type;
             }
 
             if (val->type == NodeType::FUNCTION)
             {
-                val->FUNCTION.name = node->left->ID.value;
+                val->FUNCTION->name = node->left->ID.value;
             }
 
             symbol_table[node->left->ID.value] = val;
@@ -3607,12 +3973,12 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
         // Check if we are adding a function to a multiple dispatch list
         if (var->type == NodeType::FUNC_LIST)
         {
-            auto val = std::make_shared<Node>(*value);
+            auto val = make_pooled_node(*value);
 
             if (val->type == NodeType::FUNCTION)
             {
-                val->FUNCTION.name = node->left->ID.value;
-                var->FUNC_LIST.nodes.push_back(val);
+                val->FUNCTION->name = node->left->ID.value;
+                var->FUNC_LIST->nodes.push_back(val);
                 symbol_table[node->left->ID.value] = var;
                 return val;
             }
@@ -3620,12 +3986,12 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
 
         // if (var->type == NodeType::PIPE_LIST)
         // {
-        //     auto val = std::make_shared<Node>(*value);
+        //     auto val = make_pooled_node(*value);
 
         //     if (val->type == NodeType::FUNCTION)
         //     {
-        //         val->FUNCTION.name = node->left->ID.value;
-        //         var->PIPE_LIST.nodes.push_back(val);
+        //         val->FUNCTION->name = node->left->ID.value;
+        //         var->PIPE_LIST->nodes.push_back(val);
         //         symbol_table[node->left->ID.value] = var;
         //         return val;
         //     }
@@ -3633,18 +3999,18 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
 
         if (var->TYPE.allowed_type == nullptr)
         {
-            // var->TYPE.allowed_type = std::make_shared<Node>(NodeType::ANY);
+            // var->TYPE.allowed_type = make_pooled_node(NodeType::ANY);
             var->TYPE.allowed_type = var;
         }
 
         // Check allowed types
         if (var->TYPE.allowed_type->type == NodeType::ANY)
         {
-            auto val = std::make_shared<Node>(*value);
+            auto val = make_pooled_node(*value);
 
             if (val->type == NodeType::FUNCTION)
             {
-                val->FUNCTION.name = node->left->ID.value;
+                val->FUNCTION->name = node->left->ID.value;
             }
 
             val->TYPE.allowed_type = var->TYPE.allowed_type;
@@ -3661,12 +4027,12 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
             error_and_exit("[TypeError] Cannot assign value of type '" + value->repr() + "' to variable of type '" + var->TYPE.allowed_type->repr() + "'. " + match.message);
         }
 
-        auto val = std::make_shared<Node>(*value);
+        auto val = make_pooled_node(*value);
         val->TYPE.allowed_type = var->TYPE.allowed_type;
 
         if (val->type == NodeType::FUNCTION)
         {
-            val->FUNCTION.name = node->left->ID.value;
+            val->FUNCTION->name = node->left->ID.value;
         }
 
         *var = *val;
@@ -3676,12 +4042,12 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
 
     if (node->left->type == NodeType::LIST)
     {
-        if (node->left->LIST.nodes.size() != 1)
+        if (node->left->LIST.nodes().size() != 1)
         {
             error_and_exit("Dynamic variable creation list expects 1 argument");
         }
 
-        auto name = eval_node(node->left->LIST.nodes[0]);
+        auto name = eval_node(node->left->LIST.nodes()[0]);
 
         if (name->type != NodeType::STRING)
         {
@@ -3691,7 +4057,7 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
         auto value = eval_node(node->right);
         value->TYPE.allowed_type = make_any();
 
-        symbol_table[name->STRING.value] = std::make_shared<Node>(*value);
+        symbol_table[name->STRING.value] = make_pooled_node(*value);
         return value;
     }
 
@@ -3712,12 +4078,12 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
             }
             else if (node->left->right->type == NodeType::LIST)
             {
-                if (node->left->right->LIST.nodes.size() == 0)
+                if (node->left->right->LIST.nodes().size() == 0)
                 {
                     error_and_exit("Cannot assign an empty property name");
                 }
 
-                auto prop_name_node = eval_node(node->left->right->LIST.nodes[0]);
+                auto prop_name_node = eval_node(node->left->right->LIST.nodes()[0]);
 
                 if (!node->left->left->TYPE.is_literal)
                 {
@@ -3750,33 +4116,33 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
                 return left;
             }
 
-            if (obj->TYPE.allowed_type->OBJECT.properties.find(prop_name) != obj->TYPE.allowed_type->OBJECT.properties.end())
+            if (obj->TYPE.allowed_type->OBJECT->properties.find(prop_name) != obj->TYPE.allowed_type->OBJECT->properties.end())
             {
                 if (left->type == NodeType::FUNC_LIST && right->type == NodeType::FUNCTION)
                 {
-                    right->FUNCTION.name = prop_name;
-                    left->FUNC_LIST.nodes.push_back(right);
-                    obj->OBJECT.properties[prop_name].value = left;
-                    obj->TYPE.allowed_type->OBJECT.properties[prop_name].value = left;
+                    right->FUNCTION->name = prop_name;
+                    left->FUNC_LIST->nodes.push_back(right);
+                    obj->OBJECT->properties[prop_name].value = left;
+                    obj->TYPE.allowed_type->OBJECT->properties[prop_name].value = left;
                     return left;
                 }
 
                 if (left->type == NodeType::FUNCTION && right->type == NodeType::FUNCTION)
                 {
-                    auto func_list = std::make_shared<Node>(NodeType::FUNC_LIST);
-                    func_list->FUNC_LIST.nodes.push_back(left);
-                    right->FUNCTION.name = prop_name;
-                    func_list->FUNC_LIST.nodes.push_back(right);
-                    obj->OBJECT.properties[prop_name].value = func_list;
-                    obj->TYPE.allowed_type->OBJECT.properties[prop_name].value = func_list;
+                    auto func_list = make_pooled_node(NodeType::FUNC_LIST);
+                    func_list->FUNC_LIST->nodes.push_back(left);
+                    right->FUNCTION->name = prop_name;
+                    func_list->FUNC_LIST->nodes.push_back(right);
+                    obj->OBJECT->properties[prop_name].value = func_list;
+                    obj->TYPE.allowed_type->OBJECT->properties[prop_name].value = func_list;
                     return left;
                 }
 
                 if (obj->TYPE.allowed_type != nullptr)
                 {
-                    if (!match_types(obj->TYPE.allowed_type->OBJECT.properties[prop_name].value, right).result)
+                    if (!match_types(obj->TYPE.allowed_type->OBJECT->properties[prop_name].value, right).result)
                     {
-                        error_and_exit("Cannot assign value of type '" + right->type_repr() + "' to object property of type '" + obj->TYPE.allowed_type->OBJECT.properties[prop_name].value->repr() + "'");
+                        error_and_exit("Cannot assign value of type '" + right->type_repr() + "' to object property of type '" + obj->TYPE.allowed_type->OBJECT->properties[prop_name].value->repr() + "'");
                     }
                 }
             }
@@ -3785,7 +4151,7 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
             {
                 if (obj->TYPE.allowed_type != nullptr)
                 {
-                    right->TYPE.allowed_type = obj->TYPE.allowed_type->OBJECT.properties[prop_name].value;
+                    right->TYPE.allowed_type = obj->TYPE.allowed_type->OBJECT->properties[prop_name].value;
                 }
                 else
                 {
@@ -3793,8 +4159,8 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
                 }
             }
 
-            obj->OBJECT.properties[prop_name] = Object_Prop(true, right);
-            obj->TYPE.allowed_type->OBJECT.properties[prop_name] = Object_Prop(true, get_type(right));
+            obj->OBJECT->properties[prop_name] = Object_Prop(true, right);
+            obj->TYPE.allowed_type->OBJECT->properties[prop_name] = Object_Prop(true, get_type(right));
 
             return left;
         }
@@ -3804,7 +4170,7 @@ std::shared_ptr<Node> Typechecker::eval_equal(std::shared_ptr<Node>& node)
     return left;
 }
 
-std::shared_ptr<Node> Typechecker::eval_double_dot(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_double_dot(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
     auto right = eval_node(node->right);
@@ -3815,11 +4181,11 @@ std::shared_ptr<Node> Typechecker::eval_double_dot(std::shared_ptr<Node>& node)
     }
 
     auto res = make_list();
-    res->LIST.nodes.push_back(make_int(0, false));
+    res->LIST.nodes().push_back(make_int(0, false));
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_double_arrow(Node_Ptr& node)
 {
     auto left = eval_node(node->left);
 
@@ -3830,11 +4196,11 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
         if (tc_builtin_functions.find(node->right->ID.value) != tc_builtin_functions.end())
         {
             auto func = tc_builtin_functions[node->right->ID.value];
-            std::vector<std::shared_ptr<Node>> args;
+            std::vector<Node_Ptr> args;
 
             if (left->type == NodeType::COMMA_LIST)
             {
-                args = left->COMMA_LIST.nodes;
+                args = left->COMMA_LIST->nodes;
             }
             else
             {
@@ -3847,15 +4213,15 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
 
     if (node->right->type == NodeType::FUNC_CALL)
     {
-        if (tc_builtin_functions.find(node->right->FUNC_CALL.name) != tc_builtin_functions.end())
+        if (tc_builtin_functions.find(node->right->FUNC_CALL->name) != tc_builtin_functions.end())
         {
-            auto func = tc_builtin_functions[node->right->FUNC_CALL.name];
+            auto func = tc_builtin_functions[node->right->FUNC_CALL->name];
 
-            std::vector<std::shared_ptr<Node>> args = node->right->FUNC_CALL.args;
+            std::vector<Node_Ptr> args = node->right->FUNC_CALL->args;
 
             if (left->type == NodeType::COMMA_LIST)
             {
-                for (auto arg : left->COMMA_LIST.nodes)
+                for (auto arg : left->COMMA_LIST->nodes)
                 {
                     args.push_back(arg);
                 }
@@ -3868,18 +4234,18 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
             return (this->*func)(args);
         }
 
-        auto func = eval_look_up(node->right->FUNC_CALL.name);
+        auto func = eval_look_up(node->right->FUNC_CALL->name);
 
         if (func->type == NodeType::ERROR)
         {
-            error_and_exit("Function '" + node->right->FUNC_CALL.name + "' is undefined");
+            error_and_exit("Function '" + node->right->FUNC_CALL->name + "' is undefined");
         }
 
-        auto args = node->right->FUNC_CALL.args;
+        auto args = node->right->FUNC_CALL->args;
 
         if (left->type == NodeType::COMMA_LIST)
         {
-            for (auto elem : left->COMMA_LIST.nodes)
+            for (auto elem : left->COMMA_LIST->nodes)
             {
                 args.push_back(eval_node(elem));
             }
@@ -3894,7 +4260,7 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
 
     auto right = eval_node(node->right);
 
-    auto res = std::make_shared<Node>(*right);
+    auto res = make_pooled_node(*right);
 
     if (right->type != NodeType::PARTIAL_OP && right->type != NodeType::FUNCTION && right->type != NodeType::FUNC_LIST)
     {
@@ -3921,7 +4287,7 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
 
         if (left->type == NodeType::COMMA_LIST)
         {
-            auto elements = left->COMMA_LIST.nodes;
+            auto elements = left->COMMA_LIST->nodes;
 
             if (elements.size() != 2)
             {
@@ -3958,11 +4324,11 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
         return eval_node(res);
     }
 
-    if (right->type == NodeType::FUNCTION || right->type == NodeType::FUNC_LIST && right->FUNC_LIST.nodes.size() == 1)
+    if (right->type == NodeType::FUNCTION || right->type == NodeType::FUNC_LIST && right->FUNC_LIST->nodes.size() == 1)
     {
         if (right->type == NodeType::FUNC_LIST)
         {
-            right = right->FUNC_LIST.nodes[0];
+            right = right->FUNC_LIST->nodes[0];
         }
 
         if (!right->TYPE.is_literal)
@@ -3970,16 +4336,16 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
             return make_any();
         }
 
-        auto args = right->FUNCTION.args;
+        auto args = right->FUNCTION->args;
 
         if (args.size() == 0)
         {
-            error_and_exit("Function '" + right->FUNCTION.name + "' expects 0 arguments, and cannot be injected");
+            error_and_exit("Function '" + right->FUNCTION->name + "' expects 0 arguments, and cannot be injected");
         }
         
         if (left->type == NodeType::COMMA_LIST)
         {
-            for (int i = 0; i < left->COMMA_LIST.nodes.size(); i++)
+            for (int i = 0; i < left->COMMA_LIST->nodes.size(); i++)
             {
                 int arg_index = 0;
 
@@ -3993,7 +4359,7 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
                     }
                 }
 
-                args[arg_index] = left->COMMA_LIST.nodes[i];
+                args[arg_index] = left->COMMA_LIST->nodes[i];
             }
         }
         else
@@ -4014,9 +4380,9 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
             args[arg_index] = left;
         }
 
-        std::vector<std::shared_ptr<Node>> flat_args;
+        std::vector<Node_Ptr> flat_args;
 
-        auto func_copy = std::make_shared<Node>(*right);
+        auto func_copy = make_pooled_node(*right);
 
         for (int i = 0; i < args.size(); i++)
         {
@@ -4024,7 +4390,7 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
             // it's going to get re-injected in
             // eval_function_call 
 
-            func_copy->FUNCTION.args[i] = nullptr;
+            func_copy->FUNCTION->args[i] = nullptr;
 
             if (args[i] != nullptr)
             {
@@ -4032,18 +4398,24 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
             }
         }
 
+        // Default values just evaluated moved line and column to where the
+        // function was defined; the call is here
+
+        line = node->line;
+        column = node->column;
+
         return eval_function_call(func_copy, flat_args);
     }
 
     if (right->type == NodeType::FUNC_LIST)
     {
-        std::vector<std::shared_ptr<Node>> args;
+        std::vector<Node_Ptr> args;
         
         if (left->type == NodeType::COMMA_LIST)
         {
-            for (int i = 0; i < left->COMMA_LIST.nodes.size(); i++)
+            for (int i = 0; i < left->COMMA_LIST->nodes.size(); i++)
             {
-                args.push_back(eval_node(left->COMMA_LIST.nodes[i]));
+                args.push_back(eval_node(left->COMMA_LIST->nodes[i]));
             }
         }
         else
@@ -4057,7 +4429,7 @@ std::shared_ptr<Node> Typechecker::eval_double_arrow(std::shared_ptr<Node>& node
 
 // --- END OPERATIONS --- //
 
-std::shared_ptr<Node>& Typechecker::eval_look_up(std::string name)
+Node_Ptr& Typechecker::eval_look_up(std::string name)
 {
     auto typechecker = std::make_shared<Typechecker>(*this);
 
@@ -4085,22 +4457,22 @@ std::shared_ptr<Node>& Typechecker::eval_look_up(std::string name)
     return res;
 }
 
-std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::match_function(Node_Ptr function, std::vector<Node_Ptr> args)
 {
-    auto func = std::make_shared<Node>(*function);
+    auto func = make_pooled_node(*function);
 
     if (func->type == NodeType::FUNCTION)
     {
         return func;
     }
 
-    std::vector<std::shared_ptr<Node>> potential_functions;
+    std::vector<Node_Ptr> potential_functions;
 
     if (function->type == NodeType::FUNC_LIST)
     {
-        if (function->FUNC_LIST.nodes.size() == 1)
+        if (function->FUNC_LIST->nodes.size() == 1)
         {
-            func = std::make_shared<Node>(*function->FUNC_LIST.nodes[0]);
+            func = make_pooled_node(*function->FUNC_LIST->nodes[0]);
             return func;
         }
 
@@ -4115,11 +4487,11 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
 
         int func_num = -1;
 
-        for (auto f : function->FUNC_LIST.nodes)
+        for (auto f : function->FUNC_LIST->nodes)
         {
             func_num++;
 
-            if (args.size() > f->FUNCTION.params.size())
+            if (args.size() > f->FUNCTION->params.size())
             {
                 continue;
             }
@@ -4128,31 +4500,31 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
 
             // Inject closure into symbol table
 
-            for (auto symbol : f->FUNCTION.closure)
+            for (auto symbol : f->FUNCTION->closure)
             {
                 tc.symbol_table[symbol.first] = symbol.second;
             }
 
             for (int i = 0; i < args.size(); i++)
             {
-                auto& param = f->FUNCTION.params[i];
+                auto& param = f->FUNCTION->params[i];
 
                 auto param_type = tc.get_explicit_type(param);
 
-                if (param_type->type == NodeType::PIPE_LIST && param_type->PIPE_LIST.nodes.size() == 1)
+                if (param_type->type == NodeType::PIPE_LIST && param_type->PIPE_LIST->nodes.size() == 1)
                 {
-                    param_type = param_type->PIPE_LIST.nodes[0];
+                    param_type = param_type->PIPE_LIST->nodes[0];
                 }
 
-                if (param_type->type == NodeType::FUNC_LIST && param_type->FUNC_LIST.nodes.size() == 1)
+                if (param_type->type == NodeType::FUNC_LIST && param_type->FUNC_LIST->nodes.size() == 1)
                 {
-                    param_type = param_type->FUNC_LIST.nodes[0];
+                    param_type = param_type->FUNC_LIST->nodes[0];
                 }
 
                 auto arg = tc.eval_node(args[i]);
 
                 if (arg->type == NodeType::ANY 
-                && func_num < function->FUNC_LIST.nodes.size()-1)
+                && func_num < function->FUNC_LIST->nodes.size()-1)
                 {
                     goto next;
                 }
@@ -4163,7 +4535,7 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
                 }
             }
 
-            for (auto& arg : f->FUNCTION.args)
+            for (auto& arg : f->FUNCTION->args)
             {
                 if (arg == nullptr)
                 {
@@ -4176,17 +4548,17 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
                 // if we match on something here, we assign and break
                 // no need to keep looking
 
-                func = std::make_shared<Node>(*f);
+                func = make_pooled_node(*f);
                 return func;
             }
 
-            potential_functions.push_back(std::make_shared<Node>(*f));
+            potential_functions.push_back(make_pooled_node(*f));
 
             next:
 
                 // Remove closure from symbol table
 
-                for (auto symbol : f->FUNCTION.closure)
+                for (auto symbol : f->FUNCTION->closure)
                 {
                     tc.symbol_table.erase(symbol.first);
                 }
@@ -4202,9 +4574,9 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
     {
         std::string potentials;
 
-        for (auto& func : function->FUNC_LIST.nodes)
+        for (auto& func : function->FUNC_LIST->nodes)
         {
-            potentials += func->FUNCTION.name + ": " + func->type_repr() + "\n";
+            potentials += func->FUNCTION->name + ": " + func->type_repr() + "\n";
         }
 
         std::string args_str = "[ ";
@@ -4230,7 +4602,7 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
 
         for (auto& func : potential_functions)
         {
-            potentials += func->FUNCTION.name + ": " + func->type_repr() + "\n";
+            potentials += func->FUNCTION->name + ": " + func->type_repr() + "\n";
         }
 
         error_and_exit("Ambiguous function call - there are " + std::to_string(potential_functions.size()) + " potential functions this call could refer to:\n\n" + potentials);
@@ -4239,7 +4611,7 @@ std::shared_ptr<Node> Typechecker::match_function(std::shared_ptr<Node> function
     return func;
 }
 
-std::shared_ptr<Node> Typechecker::clone_func(std::shared_ptr<Node> func)
+Node_Ptr Typechecker::clone_func(Node_Ptr func)
 {
     if (!func->TYPE.is_literal)
     {
@@ -4247,60 +4619,60 @@ std::shared_ptr<Node> Typechecker::clone_func(std::shared_ptr<Node> func)
     }
 
     auto function = make_function();
-    function->FUNCTION.name = func->FUNCTION.name;
-    for (auto param: func->FUNCTION.params)
+    function->FUNCTION->name = func->FUNCTION->name;
+    for (auto param: func->FUNCTION->params)
     {
         if (param->type == NodeType::ID)
         {
-            function->FUNCTION.params.push_back(std::make_shared<Node>(*param));
+            function->FUNCTION->params.push_back(make_pooled_node(*param));
         }
         else if (param->OP.op_type == NodeType::EQUAL)
         {
-            auto param_copy = std::make_shared<Node>(*param);
-            param_copy->left = std::make_shared<Node>(*param->left);
-            param_copy->right = std::make_shared<Node>(*param->left);
+            auto param_copy = make_pooled_node(*param);
+            param_copy->left = make_pooled_node(*param->left);
+            param_copy->right = make_pooled_node(*param->left);
 
-            function->FUNCTION.params.push_back(param_copy);
+            function->FUNCTION->params.push_back(param_copy);
         }
         else if (param->OP.op_type == NodeType::TRIPLE_DOT)
         {
-            auto param_copy = std::make_shared<Node>(*param);
-            param_copy->right = std::make_shared<Node>(*param->right);
+            auto param_copy = make_pooled_node(*param);
+            param_copy->right = make_pooled_node(*param->right);
 
-            function->FUNCTION.params.push_back(param_copy);
+            function->FUNCTION->params.push_back(param_copy);
         }
     }
 
-    for (auto arg: func->FUNCTION.args)
+    for (auto arg: func->FUNCTION->args)
     {
         if (arg == nullptr)
         {
-            function->FUNCTION.args.push_back(nullptr);
+            function->FUNCTION->args.push_back(nullptr);
         }
         else
         {
-            function->FUNCTION.args.push_back(std::make_shared<Node>(*arg));
+            function->FUNCTION->args.push_back(make_pooled_node(*arg));
         }
     }
-    for (auto elem: func->FUNCTION.closure)
+    for (auto elem: func->FUNCTION->closure)
     {
-        function->FUNCTION.closure[elem.first] = elem.second;
+        function->FUNCTION->closure[elem.first] = elem.second;
     }
 
-    if (func->FUNCTION.return_type != nullptr)
+    if (func->FUNCTION->return_type != nullptr)
     {
-        function->FUNCTION.return_type = std::make_shared<Node>(*func->FUNCTION.return_type);
+        function->FUNCTION->return_type = make_pooled_node(*func->FUNCTION->return_type);
     }
 
-    function->FUNCTION.body = std::make_shared<Node>(*func->FUNCTION.body);
+    function->FUNCTION->body = make_pooled_node(*func->FUNCTION->body);
 
-    function->FUNCTION.default_arg_indices = func->FUNCTION.default_arg_indices;
-    function->FUNCTION.is_type = func->FUNCTION.is_type;
+    function->FUNCTION->default_arg_indices = func->FUNCTION->default_arg_indices;
+    function->FUNCTION->is_type = func->FUNCTION->is_type;
 
     return function;
 }
 
-std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args)
+Node_Ptr Typechecker::eval_function_call(Node_Ptr function, std::vector<Node_Ptr> args)
 {
     if (function->type == NodeType::ANY)
     {
@@ -4311,14 +4683,14 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
     {
         auto returns = make_pipe_list();
 
-        for (auto func : function->PIPE_LIST.nodes)
+        for (auto func : function->PIPE_LIST->nodes)
         {
             auto func_copy = clone_func(func);
             auto res = eval_function_call(func_copy, args);
-            returns->PIPE_LIST.nodes.push_back(res);
+            returns->PIPE_LIST->nodes.push_back(res);
         }
 
-        sort_and_unique(returns->PIPE_LIST.nodes);
+        sort_and_unique(returns->PIPE_LIST->nodes);
 
         return returns;
     }
@@ -4328,7 +4700,13 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
         error_and_exit("Malformed function call - variable is not a function");
     }
 
-    auto func = std::make_shared<Node>(*function);
+    // Matching arguments to parameters moves line and column to each value
+    // checked, so where the call was made is kept for the body's errors
+
+    int call_line = line;
+    int call_column = column;
+
+    auto func = make_pooled_node(*function);
 
     if (func->type == NodeType::FUNC_LIST)
     {
@@ -4339,12 +4717,12 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
 
     if (!func->TYPE.is_literal)
     {
-        if (func->FUNCTION.return_type == nullptr)
+        if (func->FUNCTION->return_type == nullptr)
         {
             return make_any();
         }
 
-        return func->FUNCTION.return_type;
+        return func->FUNCTION->return_type;
     }
 
     Typechecker typechecker;
@@ -4352,7 +4730,8 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
     typechecker.builtins_path = builtins_path;
     typechecker.line = line;
     typechecker.column = column;
-    typechecker.file_name = file_name + "/" + func->FUNCTION.name;
+    typechecker.caller = this;
+    typechecker.file_name = file_name + "/" + func->FUNCTION->name;
     typechecker.builtins_names = builtins_names;
 
     for (auto symbol : symbol_table)
@@ -4363,7 +4742,7 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
         }
     }
 
-    for (auto symbol : func->FUNCTION.closure)
+    for (auto symbol : func->FUNCTION->closure)
     {
         if (symbol.second->type == NodeType::FUNC_LIST)
         {
@@ -4372,7 +4751,7 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
 
             if (typechecker.symbol_table.find(symbol.first) != typechecker.symbol_table.end())
             {
-                if (typechecker.symbol_table[symbol.first]->PIPE_LIST.nodes.size() < symbol.second->FUNC_LIST.nodes.size())
+                if (typechecker.symbol_table[symbol.first]->PIPE_LIST->nodes.size() < symbol.second->FUNC_LIST->nodes.size())
                 {
                     typechecker.symbol_table[symbol.first] = symbol.second;
                 }
@@ -4390,22 +4769,22 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
 
     for (int i = 0; i < args.size(); i++)
     {
-        if (i >= func->FUNCTION.args.size())
+        if (i >= func->FUNCTION->args.size())
         {
-            error_and_exit("Function '" + func->FUNCTION.name + "' expects " + std::to_string(func->FUNCTION.args.size()) + " arguments, but " + std::to_string(args.size()) + " were provided");
+            error_and_exit("Function '" + func->FUNCTION->name + "' expects " + std::to_string(func->FUNCTION->args.size()) + " arguments, but " + std::to_string(args.size()) + " were provided");
         }
 
-        if (func->FUNCTION.params[i]->OP.op_type == NodeType::TRIPLE_DOT)
+        if (func->FUNCTION->params[i]->OP.op_type == NodeType::TRIPLE_DOT)
         {
-            auto variable_arg = std::make_shared<Node>(NodeType::LIST);
+            auto variable_arg = make_pooled_node(NodeType::LIST);
 
             for (int j = i; j < args.size(); j++)
             {
-                variable_arg->LIST.nodes.push_back(eval_node(args[j]));
+                variable_arg->LIST.nodes().push_back(eval_node(args[j]));
             }
 
-            func->FUNCTION.args[i] = variable_arg;
-            // func->FUNCTION.params[i]->right->ID.type = variable_arg;
+            func->FUNCTION->args[i] = variable_arg;
+            // func->FUNCTION->params[i]->right->ID.type = variable_arg;
 
             break;
         }
@@ -4418,9 +4797,9 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
             int index;
             bool match = false;
 
-            for (int p = 0; p < func->FUNCTION.params.size(); p++)
+            for (int p = 0; p < func->FUNCTION->params.size(); p++)
             {
-                auto param = func->FUNCTION.params[p];
+                auto param = func->FUNCTION->params[p];
 
                 if (param->type == NodeType::ID)
                 {
@@ -4444,11 +4823,11 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
 
             if (!match)
             {
-                error_and_exit("Parameter '" + name + "' does not exist on function '" + func->FUNCTION.name + "'");
+                error_and_exit("Parameter '" + name + "' does not exist on function '" + func->FUNCTION->name + "'");
             }
 
-            func->FUNCTION.args[index] = value;
-            // func->FUNCTION.params[index]->left->ID.type = value;
+            func->FUNCTION->args[index] = value;
+            // func->FUNCTION->params[index]->left->ID.type = value;
         }
         else
         {
@@ -4456,13 +4835,13 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
             
             while (true)
             {
-                bool arg_is_default = std::find(func->FUNCTION.default_arg_indices.begin(), func->FUNCTION.default_arg_indices.end(), i) != func->FUNCTION.default_arg_indices.end();
+                bool arg_is_default = std::find(func->FUNCTION->default_arg_indices.begin(), func->FUNCTION->default_arg_indices.end(), i) != func->FUNCTION->default_arg_indices.end();
 
-                if (func->FUNCTION.args[i] == nullptr || arg_is_default)
+                if (func->FUNCTION->args[i] == nullptr || arg_is_default)
                 {
                     auto eval_arg = eval_node(args[current_index]);
-                    func->FUNCTION.args[i] = eval_arg;
-                    func->FUNCTION.params[i]->ID.type = eval_arg;
+                    func->FUNCTION->args[i] = eval_arg;
+                    func->FUNCTION->params[i]->ID.type = eval_arg;
                     break;
                 }
                 else
@@ -4473,59 +4852,59 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
         }
     }
 
-    for (int i = 0; i < func->FUNCTION.args.size(); i++)
+    for (int i = 0; i < func->FUNCTION->args.size(); i++)
     {
-        if (func->FUNCTION.args[i] == nullptr)
+        if (func->FUNCTION->args[i] == nullptr)
         {
             return func;
         }
         else
         {
-            auto param = func->FUNCTION.params[i];
+            auto param = func->FUNCTION->params[i];
             auto param_type = typechecker.get_explicit_type(param);
 
             if (param->type == NodeType::ID)
             {
-                typechecker.symbol_table[param->ID.value] = func->FUNCTION.args[i];
+                typechecker.symbol_table[param->ID.value] = func->FUNCTION->args[i];
             }
             else if (param->OP.op_type == NodeType::EQUAL)
             {
-                typechecker.symbol_table[param->left->ID.value] = func->FUNCTION.args[i];
+                typechecker.symbol_table[param->left->ID.value] = func->FUNCTION->args[i];
             }
             else if (param->OP.op_type == NodeType::TRIPLE_DOT)
             {
-                typechecker.symbol_table[param->right->ID.value] = func->FUNCTION.args[i];
+                typechecker.symbol_table[param->right->ID.value] = func->FUNCTION->args[i];
             }
 
             // Typecheck arg against param type
 
             Typechecker::Match_Result match;
 
-            if (func->FUNCTION.args[i]->type == NodeType::FUNCTION && func->FUNCTION.args[i]->FUNCTION.is_type)
+            if (func->FUNCTION->args[i]->type == NodeType::FUNCTION && func->FUNCTION->args[i]->FUNCTION->is_type)
             {
-                match = match_types(func->FUNCTION.args[i], param_type);
+                match = match_types(func->FUNCTION->args[i], param_type);
             }
             else
             {
-                match = match_types(param_type, func->FUNCTION.args[i]);
+                match = match_types(param_type, func->FUNCTION->args[i]);
             }
 
             if (!match.result)
             {
-                error_and_exit("[ArgTypeError] Function '" + func->FUNCTION.name + "': Cannot assign value of type '" + func->FUNCTION.args[i]->repr() + "' to parameter of type '" + param_type->repr() + "'. " + match.message);
+                error_and_exit("[ArgTypeError] Function '" + func->FUNCTION->name + "': Cannot assign value of type '" + func->FUNCTION->args[i]->repr() + "' to parameter of type '" + param_type->repr() + "'. " + match.message);
             }
         }
     }
 
     int arg_index = 0;
 
-    for (auto& param : func->FUNCTION.params)
+    for (auto& param : func->FUNCTION->params)
     {
-        auto arg = func->FUNCTION.args[arg_index];
+        auto arg = func->FUNCTION->args[arg_index];
 
-        if (arg->type == NodeType::FUNCTION && arg->FUNCTION.is_type)
+        if (arg->type == NodeType::FUNCTION && arg->FUNCTION->is_type)
         {
-            arg = arg->FUNCTION.params[0]->ID.type;
+            arg = arg->FUNCTION->params[0]->ID.type;
         }
 
         if (arg->type != NodeType::LIST && arg->type != NodeType::OBJECT && arg->type != NodeType::FUNCTION)
@@ -4560,52 +4939,55 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
     std::string token;
     while ((pos = s.find(delimiter)) != std::string::npos) {
         token = s.substr(pos + 1, s.size());
-        if (token == func->FUNCTION.name)
+        if (token == func->FUNCTION->name)
         {
-            return func->FUNCTION.return_type;
+            return func->FUNCTION->return_type;
         }
         s.erase(0, pos + delimiter.length());
     }
 
-    std::shared_ptr<Node> return_val;
+    line = call_line;
+    column = call_column;
 
-    if (func->FUNCTION.body->type == NodeType::BLOCK)
+    Node_Ptr return_val;
+
+    if (func->FUNCTION->body->type == NodeType::BLOCK)
     {
-        return_val = typechecker.eval_nodes(func->FUNCTION.body->BLOCK.nodes);
+        return_val = typechecker.eval_nodes(func->FUNCTION->body->BLOCK->nodes);
     }
     else
     {
-        return_val = typechecker.eval_node(func->FUNCTION.body);
+        return_val = typechecker.eval_node(func->FUNCTION->body);
     }
 
-    func->FUNCTION.return_type = return_val;
+    func->FUNCTION->return_type = return_val;
     func->TYPE.allowed_type = func;
 
-    return func->FUNCTION.return_type;
+    return func->FUNCTION->return_type;
 
-    // if (typecheck && !func->FUNCTION.is_type)
+    // if (typecheck && !func->FUNCTION->is_type)
     // {
-    //     return func->FUNCTION.return_type;
+    //     return func->FUNCTION->return_type;
     // }
 
-    // if (func->FUNCTION.is_type && !func->FUNCTION.args[0]->TYPE.is_literal)
+    // if (func->FUNCTION->is_type && !func->FUNCTION->args[0]->TYPE.is_literal)
     // {
     //     return make_bool(true);
     // }
 
-    // if (func->FUNCTION.body->type == NodeType::BLOCK)
+    // if (func->FUNCTION->body->type == NodeType::BLOCK)
     // {
-    //     auto eval_expr = std::make_shared<Node>(NodeType::EMPTY);
+    //     auto eval_expr = make_pooled_node(NodeType::EMPTY);
 
-    //     for (auto expr : func->FUNCTION.body->BLOCK.nodes)
+    //     for (auto expr : func->FUNCTION->body->BLOCK->nodes)
     //     {
     //         eval_expr = typechecker.eval_node(expr);
 
     //         if (eval_expr->type == NodeType::RETURN)
     //         {
-    //             if (func->FUNCTION.return_type->type != NodeType::EMPTY)
+    //             if (func->FUNCTION->return_type->type != NodeType::EMPTY)
     //             {
-    //                 eval_expr->right->TYPE.allowed_type = func->FUNCTION.return_type;
+    //                 eval_expr->right->TYPE.allowed_type = func->FUNCTION->return_type;
     //             }
     //             return eval_expr->right;
     //         }
@@ -4614,19 +4996,19 @@ std::shared_ptr<Node> Typechecker::eval_function_call(std::shared_ptr<Node> func
     //     return eval_expr;
     // }
 
-    // auto res = typechecker.eval_node(func->FUNCTION.body);
-    // if (func->FUNCTION.return_type->type != NodeType::EMPTY)
+    // auto res = typechecker.eval_node(func->FUNCTION->body);
+    // if (func->FUNCTION->return_type->type != NodeType::EMPTY)
     // {
-    //     res->TYPE.allowed_type = func->FUNCTION.return_type;
+    //     res->TYPE.allowed_type = func->FUNCTION->return_type;
     // }
     // return res;
 }
 
-std::shared_ptr<Node> Typechecker::eval_if_statement(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_if_statement(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
-    auto conditional = eval_node(res->IF_STATEMENT.conditional);
+    auto conditional = eval_node(res->IF_STATEMENT->conditional);
 
     Typechecker if_eval;
     if_eval.runtime = runtime;
@@ -4645,28 +5027,28 @@ std::shared_ptr<Node> Typechecker::eval_if_statement(std::shared_ptr<Node>& node
 
     if (conditional->BOOL.value)
     {
-        return if_eval.eval_nodes(node->IF_STATEMENT.body->BLOCK.nodes);
+        return if_eval.eval_nodes(node->IF_STATEMENT->body->BLOCK->nodes);
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-std::shared_ptr<Node> Typechecker::eval_if_block(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_if_block(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
 
     Typechecker if_eval;
     if_eval.runtime = runtime;
     if_eval.file_name = file_name;
     if_eval.outer_scope = std::make_shared<Typechecker>(*this);
 
-    for (auto _case : res->IF_BLOCK.cases)
+    for (auto _case : res->IF_BLOCK->cases)
     {
         if (_case->OP.op_type != NodeType::COLON)
         {
             if (_case->type == NodeType::BLOCK)
             {
-                return if_eval.eval_nodes(_case->BLOCK.nodes);
+                return if_eval.eval_nodes(_case->BLOCK->nodes);
             }
 
             return if_eval.eval_node(_case);
@@ -4683,7 +5065,7 @@ std::shared_ptr<Node> Typechecker::eval_if_block(std::shared_ptr<Node>& node)
         {
             if (_case->right->type == NodeType::BLOCK)
             {
-                return if_eval.eval_nodes(_case->right->BLOCK.nodes);
+                return if_eval.eval_nodes(_case->right->BLOCK->nodes);
             }
 
             return if_eval.eval_node(_case->right);
@@ -4692,10 +5074,10 @@ std::shared_ptr<Node> Typechecker::eval_if_block(std::shared_ptr<Node>& node)
         if_eval.symbol_table.clear();
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b)
+bool Typechecker::match_pattern(Node_Ptr a, Node_Ptr b)
 {
     if (a->OP.op_type == NodeType::DOUBLE_DOT)
     {
@@ -4727,42 +5109,42 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
             return false;
         }
 
-        auto left = std::make_shared<Node>(*a);
+        auto left = make_pooled_node(*a);
 
-        if (b->LIST.nodes.size() == 0)
+        if (b->LIST.nodes().size() == 0)
         {
-            return left->LIST.nodes.size() == 0;
+            return left->LIST.nodes().size() == 0;
         }
 
-        if (left->LIST.nodes.size() == 0)
+        if (left->LIST.nodes().size() == 0)
         {
-            return b->LIST.nodes.size() == 0;
+            return b->LIST.nodes().size() == 0;
         }
 
         int a_len = 0;
 
-        for (int i = 0; i < left->LIST.nodes.size(); i++)
+        for (int i = 0; i < left->LIST.nodes().size(); i++)
         {
             int index = 0;
 
-            if (i >= left->LIST.nodes.size())
+            if (i >= left->LIST.nodes().size())
             {
                 return false;
             }
 
-            auto elem_a = left->LIST.nodes[i];
+            auto elem_a = left->LIST.nodes()[i];
             if (elem_a->OP.op_type == NodeType::TRIPLE_DOT)
             {
                 auto list = make_list();
 
-                int num_elems_right = (a->LIST.nodes.size()-1) - i;
-                left->LIST.nodes[i] = make_any();
-                list->LIST.nodes.push_back(b->LIST.nodes[index]);
-                int num_to_insert = b->LIST.nodes.size() - num_elems_right-i-1;
+                int num_elems_right = (a->LIST.nodes().size()-1) - i;
+                left->LIST.nodes()[i] = make_any();
+                list->LIST.nodes().push_back(b->LIST.nodes()[index]);
+                int num_to_insert = b->LIST.nodes().size() - num_elems_right-i-1;
                 for (int j = 0; j < num_to_insert; j++)
                 {
-                    left->LIST.nodes.insert(left->LIST.nodes.begin() + i, make_any());
-                    list->LIST.nodes.push_back(b->LIST.nodes[index]);
+                    left->LIST.nodes().insert(left->LIST.nodes().begin() + i, make_any());
+                    list->LIST.nodes().push_back(b->LIST.nodes()[index]);
                 }
 
                 if (elem_a->right != nullptr)
@@ -4770,7 +5152,7 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
                     symbol_table[elem_a->right->ID.value] = list;
                 }
 
-                elem_a = left->LIST.nodes[i];
+                elem_a = left->LIST.nodes()[i];
             }
             if (elem_a->type == NodeType::ID)
             {
@@ -4785,18 +5167,18 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
                 }
                 else
                 {
-                    symbol_table[elem_a->ID.value] = b->TYPE.allowed_type->LIST.nodes[0];
-                    symbol_table[elem_a->ID.value]->TYPE.allowed_type = b->TYPE.allowed_type->LIST.nodes[0];
-                    elem_a = b->TYPE.allowed_type->LIST.nodes[0];
-                    elem_a->TYPE.allowed_type = b->TYPE.allowed_type->LIST.nodes[0];
+                    symbol_table[elem_a->ID.value] = b->TYPE.allowed_type->LIST.nodes()[0];
+                    symbol_table[elem_a->ID.value]->TYPE.allowed_type = b->TYPE.allowed_type->LIST.nodes()[0];
+                    elem_a = b->TYPE.allowed_type->LIST.nodes()[0];
+                    elem_a->TYPE.allowed_type = b->TYPE.allowed_type->LIST.nodes()[0];
                 }
             }
             else if (elem_a->type == NodeType::BLOCK)
             {
-                elem_a = eval_nodes(elem_a->BLOCK.nodes);
+                elem_a = eval_nodes(elem_a->BLOCK->nodes);
             }
 
-            bool match = match_pattern(b->LIST.nodes[index], elem_a);
+            bool match = match_pattern(b->LIST.nodes()[index], elem_a);
 
             if (!match)
             {
@@ -4806,7 +5188,7 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
             a_len++;
         }
 
-        if (a_len < b->LIST.nodes.size())
+        if (a_len < b->LIST.nodes().size())
         {
             return false;
         }
@@ -4830,7 +5212,7 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
             return true;
         }
 
-        for (auto prop : a->OBJECT.properties)
+        for (auto prop : a->OBJECT->properties)
         {
             auto value = prop.second.value;
             if (value->type != NodeType::TRIPLE_DOT)
@@ -4840,21 +5222,21 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
 
             // If prop doesn't exist, fail check
 
-            if (b->OBJECT.properties.find(prop.first) == b->OBJECT.properties.end())
+            if (b->OBJECT->properties.find(prop.first) == b->OBJECT->properties.end())
             {
                 return false;
             }
 
             bool match;
 
-            if (b->OBJECT.properties[prop.first].value->type == NodeType::FUNCTION)
+            if (b->OBJECT->properties[prop.first].value->type == NodeType::FUNCTION)
             {
-                b->OBJECT.properties[prop.first].value->FUNCTION.is_type = true;
-                match = match_pattern(b->OBJECT.properties[prop.first].value, value);
+                b->OBJECT->properties[prop.first].value->FUNCTION->is_type = true;
+                match = match_pattern(b->OBJECT->properties[prop.first].value, value);
             }
             else
             {
-                match = match_pattern(value, b->OBJECT.properties[prop.first].value);
+                match = match_pattern(value, b->OBJECT->properties[prop.first].value);
             }
 
             if (!match)
@@ -4873,30 +5255,30 @@ bool Typechecker::match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b
     return false;
 }
 
-std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node, std::string name)
+Node_Ptr Typechecker::eval_match_block(Node_Ptr& node, std::string name)
 {
-    auto res = std::make_shared<Node>(*node);
-    auto value = eval_node(res->MATCH_BLOCK.value);
+    auto res = make_pooled_node(*node);
+    auto value = eval_node(res->MATCH_BLOCK->value);
     auto type = get_type(value);
 
-    std::vector<std::shared_ptr<Node>> returns;
+    std::vector<Node_Ptr> returns;
 
     if (name == "")
     {
-        name = res->MATCH_BLOCK.value->ID.value;
+        name = res->MATCH_BLOCK->value->ID.value;
     }
 
     if (type->type == NodeType::PIPE_LIST)
     {
-        for (auto& elem : type->PIPE_LIST.nodes)
+        for (auto& elem : type->PIPE_LIST->nodes)
         {
             elem->is_type = true;
-            auto match_block = std::make_shared<Node>(*node);
-            match_block->MATCH_BLOCK.value = elem;
+            auto match_block = make_pooled_node(*node);
+            match_block->MATCH_BLOCK->value = elem;
             auto match = eval_match_block(match_block, name);
             if (match->type == NodeType::PIPE_LIST)
             {
-                for (auto elem : match->PIPE_LIST.nodes)
+                for (auto elem : match->PIPE_LIST->nodes)
                 {
                     returns.push_back(elem);
                 }
@@ -4920,7 +5302,7 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
         else
         {
             auto res = make_pipe_list();
-            res->PIPE_LIST.nodes = returns;
+            res->PIPE_LIST->nodes = returns;
             return res;
         }
     }
@@ -4928,11 +5310,11 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
     {
         bool has_empty_case = false;
         // Empty check
-        for (auto& _case : node->MATCH_BLOCK.cases)
+        for (auto& _case : node->MATCH_BLOCK->cases)
         {
             if (_case->OP.op_type == NodeType::COLON)
             {
-                if (_case->left->type == NodeType::LIST && _case->left->LIST.nodes.size() == 0)
+                if (_case->left->type == NodeType::LIST && _case->left->LIST.nodes().size() == 0)
                 {
                     has_empty_case = true;
                 }
@@ -4953,18 +5335,18 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
 
     if (type->type == NodeType::BOOL && !type->TYPE.is_literal)
     {
-        auto match_block_true = std::make_shared<Node>(*node);
-        match_block_true->MATCH_BLOCK.value = make_bool(true);
+        auto match_block_true = make_pooled_node(*node);
+        match_block_true->MATCH_BLOCK->value = make_bool(true);
         auto match_true = eval_match_block(match_block_true, name);
 
-        auto match_block_false = std::make_shared<Node>(*node);
-        match_block_false->MATCH_BLOCK.value = make_bool(true);
+        auto match_block_false = make_pooled_node(*node);
+        match_block_false->MATCH_BLOCK->value = make_bool(true);
         auto match_false = eval_match_block(match_block_false, name);
 
         return make_bool(true, false);
     }
 
-    for (auto _case : res->MATCH_BLOCK.cases)
+    for (auto _case : res->MATCH_BLOCK->cases)
     {
         if (_case->OP.op_type != NodeType::COLON)
         {
@@ -4985,13 +5367,13 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
 
             if (match)
             {
-                std::shared_ptr<Node> res = make_empty();
+                Node_Ptr res = make_empty();
 
                 symbol_table[name] = value;
 
                 if (_case->right->type == NodeType::BLOCK)
                 {
-                    res = eval_nodes(_case->right->BLOCK.nodes);
+                    res = eval_nodes(_case->right->BLOCK->nodes);
                     res->TYPE.is_literal = false;
                 }
                 else
@@ -5002,7 +5384,7 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
 
                 // Cleanup, in case of list pattern with bindings
 
-                for (auto elem : pattern->LIST.nodes)
+                for (auto elem : pattern->LIST.nodes())
                 {
                     if (elem->type == NodeType::ID)
                     {
@@ -5028,7 +5410,7 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
     else
     {
         auto res = make_pipe_list();
-        res->PIPE_LIST.nodes = returns;
+        res->PIPE_LIST->nodes = returns;
         return res;
     }
 
@@ -5038,11 +5420,14 @@ std::shared_ptr<Node> Typechecker::eval_match_block(std::shared_ptr<Node>& node,
     error_and_exit("Missing match case for type '" + value->repr() + "'");
 }
 
-std::shared_ptr<Node> Typechecker::eval_while_loop(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_while_loop(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
+
+    auto cond_node = node->WHILE_LOOP->conditional;
 
-    auto cond_node = node->WHILE_LOOP.conditional;
+    bool safe_point = loop_safe_point;
+    loop_safe_point = false;
 
     auto cond = eval_node(cond_node);
 
@@ -5058,7 +5443,7 @@ std::shared_ptr<Node> Typechecker::eval_while_loop(std::shared_ptr<Node>& node)
 
     while (while_eval.eval_node(cond_node)->BOOL.value)
     {
-        auto expr = while_eval.eval_nodes(node->WHILE_LOOP.body->BLOCK.nodes);
+        auto expr = while_eval.eval_nodes(node->WHILE_LOOP->body->BLOCK->nodes);
 
         if (expr->type == NodeType::BREAK)
         {
@@ -5076,19 +5461,36 @@ std::shared_ptr<Node> Typechecker::eval_while_loop(std::shared_ptr<Node>& node)
         }
 
         while_eval.symbol_table.clear();
+
+        if (safe_point)
+        {
+            Collector::get().safe_point();
+        }
     }
 
-    return std::make_shared<Node>(NodeType::EMPTY);
+    return make_pooled_node(NodeType::EMPTY);
 }
 
-std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_for_loop(Node_Ptr& node)
 {
-    auto res = std::make_shared<Node>(*node);
+    auto res = make_pooled_node(*node);
+
+    bool safe_point = loop_safe_point;
+    loop_safe_point = false;
 
-    auto init_list = res->FOR_LOOP.init_list->LIST.nodes;
+    auto init_list = res->FOR_LOOP->init_list->LIST.nodes();
 
     auto iter = eval_node(init_list[0]);
 
+    // A value only known at run time, such as parsed JSON, is checked as a
+    // list of anything
+
+    if (iter->type == NodeType::ANY)
+    {
+        iter = make_list();
+        iter->LIST.nodes().push_back(make_any());
+    }
+
     if (iter->type != NodeType::LIST && iter->type != NodeType::RANGE)
     {
         error_and_exit("For loop initialiser expects iterator of type list or range");
@@ -5099,7 +5501,7 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
 
     if (iter->type == NodeType::LIST)
     {
-        end = iter->LIST.nodes.size();
+        end = iter->LIST.nodes().size();
     }
     else
     {
@@ -5107,7 +5509,7 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
         end = iter->RANGE.end;
     }
 
-    auto body = res->FOR_LOOP.body->BLOCK.nodes;
+    auto body = res->FOR_LOOP->body->BLOCK->nodes;
 
     Typechecker for_eval;
     for_eval.runtime = runtime;
@@ -5136,9 +5538,14 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
     if (init_list.size() == 2)
     {
@@ -5175,11 +5582,16 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
         for_eval.symbol_table.erase(index_var_name);
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
     if (init_list.size() == 3)
     {
@@ -5196,13 +5608,13 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
 
         for (int i = begin; i < end; i++)
         {
-            auto index_node = std::make_shared<Node>(NodeType::INT);
+            auto index_node = make_pooled_node(NodeType::INT);
             index_node->INT.value = i;
             for_eval.symbol_table[index_var_name] = index_node;
 
             if (iter->type == NodeType::LIST)
             {
-                for_eval.symbol_table[elem_var_name] = iter->LIST.nodes[i];
+                for_eval.symbol_table[elem_var_name] = iter->LIST.nodes()[i];
             }
             else if (iter->type == NodeType::RANGE)
             {
@@ -5227,16 +5639,21 @@ std::shared_ptr<Node> Typechecker::eval_for_loop(std::shared_ptr<Node>& node)
             }
 
             for_eval.symbol_table.clear();
+
+            if (safe_point)
+            {
+                Collector::get().safe_point();
+            }
         }
 
         for_eval.symbol_table.erase(index_var_name);
         for_eval.symbol_table.erase(elem_var_name);
 
-        return std::make_shared<Node>(NodeType::EMPTY);
+        return make_pooled_node(NodeType::EMPTY);
     }
 }
 
-std::shared_ptr<Node> Typechecker::get_type(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::get_type(Node_Ptr& node)
 {
     if (node->TYPE.allowed_type != nullptr && node->TYPE.allowed_type->type != NodeType::TYPE)
     {
@@ -5245,64 +5662,64 @@ std::shared_ptr<Node> Typechecker::get_type(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::LIST)
     {
-        std::shared_ptr<Node> type = make_pipe_list();
+        Node_Ptr type = make_pipe_list();
         auto type_list = make_list();
 
-        if (node->LIST.nodes.size() == 0)
+        if (node->LIST.nodes().size() == 0)
         {
-            type_list->LIST.nodes.push_back(make_any());
+            type_list->LIST.nodes().push_back(make_any());
             return type_list;
         }
 
-        for (auto& elem : node->LIST.nodes)
+        for (auto& elem : node->LIST.nodes())
         {
-            type->PIPE_LIST.nodes.push_back(get_type(elem));
+            type->PIPE_LIST->nodes.push_back(get_type(elem));
         }
 
-        sort_and_unique(type->PIPE_LIST.nodes);
+        sort_and_unique(type->PIPE_LIST->nodes);
 
-        if (type->PIPE_LIST.nodes.size() == 1)
+        if (type->PIPE_LIST->nodes.size() == 1)
         {
-            type = type->PIPE_LIST.nodes[0];
+            type = type->PIPE_LIST->nodes[0];
         }
 
-        type_list->LIST.nodes.push_back(type);
+        type_list->LIST.nodes().push_back(type);
 
         return type_list;
     }
     else if (node->type == NodeType::OBJECT)
     {
         auto type = make_object();
-        type->OBJECT.is_type = true;
+        type->OBJECT->is_type = true;
         type->TYPE.name = node->TYPE.name;
 
-        for (auto& prop : node->OBJECT.properties)
+        for (auto& prop : node->OBJECT->properties)
         {
-            type->OBJECT.properties[prop.first] = Object_Prop(prop.second.required, get_type(prop.second.value));
+            type->OBJECT->properties[prop.first] = Object_Prop(prop.second.required, get_type(prop.second.value));
         }
 
         return type;
     }
     else if (node->type == NodeType::FUNCTION)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->TYPE.is_literal = false;
-        res->FUNCTION.is_type = true;
+        res->FUNCTION->is_type = true;
         return res;
     }
     else if (node->is_type)
     {
-        return std::make_shared<Node>(*node);
+        return make_pooled_node(*node);
     }
     else
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->TYPE.is_literal = false;
         return res;
     }
 }
 
-std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool explicit_ret)
+Node_Ptr Typechecker::type_node(Node_Ptr node, bool explicit_ret)
 {
     auto returns = make_pipe_list();
 
@@ -5313,18 +5730,18 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
     
     if (node->type == NodeType::IF_STATEMENT)
     {
-        auto cond = eval.eval_node(node->IF_STATEMENT.conditional);
+        auto cond = eval.eval_node(node->IF_STATEMENT->conditional);
 
-        if (node->IF_STATEMENT.conditional->type == NodeType::OP && (node->IF_STATEMENT.conditional->left->FUNC_CALL.name == "typeof" || node->IF_STATEMENT.conditional->left->FUNC_CALL.name == "__type__"))
+        if (node->IF_STATEMENT->conditional->type == NodeType::OP && (node->IF_STATEMENT->conditional->left->FUNC_CALL->name == "typeof" || node->IF_STATEMENT->conditional->left->FUNC_CALL->name == "__type__"))
         {
-            if (node->IF_STATEMENT.conditional->OP.op_type != NodeType::EQ_EQ)
+            if (node->IF_STATEMENT->conditional->OP.op_type != NodeType::EQ_EQ)
             {
                 goto no_auto_typing;
             }
-            if (node->IF_STATEMENT.conditional->left->FUNC_CALL.args[0]->type == NodeType::ID)
+            if (node->IF_STATEMENT->conditional->left->FUNC_CALL->args[0]->type == NodeType::ID)
             {
-                std::string name = node->IF_STATEMENT.conditional->left->FUNC_CALL.args[0]->ID.value;
-                std::string type = node->IF_STATEMENT.conditional->right->STRING.value;
+                std::string name = node->IF_STATEMENT->conditional->left->FUNC_CALL->args[0]->ID.value;
+                std::string type = node->IF_STATEMENT->conditional->right->STRING.value;
 
                 auto type_node = make_empty(false);
 
@@ -5372,16 +5789,16 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
 
         no_auto_typing:
 
-        for (auto if_expr : node->IF_STATEMENT.body->BLOCK.nodes)
+        for (auto if_expr : node->IF_STATEMENT->body->BLOCK->nodes)
         {
             auto eval_expr = eval.type_node(if_expr, explicit_ret);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (explicit_ret)
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                     }
@@ -5389,14 +5806,14 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                         else
                         {
-                            auto ret = std::make_shared<Node>(NodeType::RETURN);
+                            auto ret = make_pooled_node(NodeType::RETURN);
                             ret->right = expr;
-                            returns->PIPE_LIST.nodes.push_back(ret);
+                            returns->PIPE_LIST->nodes.push_back(ret);
                             break;
                         }
                     }
@@ -5405,19 +5822,19 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
     }
     else if (node->type == NodeType::IF_BLOCK)
     {
-        for (auto cond : node->IF_BLOCK.cases)
+        for (auto cond : node->IF_BLOCK->cases)
         {
             if (cond->type == NodeType::OP && cond->OP.op_type == NodeType::COLON)
             {
                 auto cond_expr = eval.eval_node(cond->left);
                 auto eval_expr = eval.type_node(cond->right, explicit_ret);
-                for (auto expr: eval_expr->PIPE_LIST.nodes)
+                for (auto expr: eval_expr->PIPE_LIST->nodes)
                 {
                     if (explicit_ret)
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                     }
@@ -5425,14 +5842,14 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                         else
                         {
-                            auto ret = std::make_shared<Node>(NodeType::RETURN);
+                            auto ret = make_pooled_node(NodeType::RETURN);
                             ret->right = expr;
-                            returns->PIPE_LIST.nodes.push_back(ret);
+                            returns->PIPE_LIST->nodes.push_back(ret);
                             break;
                         }
                     }
@@ -5441,13 +5858,13 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
             else
             {
                 auto eval_expr = eval.type_node(cond, explicit_ret);
-                for (auto expr: eval_expr->PIPE_LIST.nodes)
+                for (auto expr: eval_expr->PIPE_LIST->nodes)
                 {
                     if (explicit_ret)
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                     }
@@ -5455,14 +5872,14 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
                     {
                         if (expr->type == NodeType::RETURN)
                         {
-                            returns->PIPE_LIST.nodes.push_back(expr);
+                            returns->PIPE_LIST->nodes.push_back(expr);
                             break;
                         }
                         else
                         {
-                            auto ret = std::make_shared<Node>(NodeType::RETURN);
+                            auto ret = make_pooled_node(NodeType::RETURN);
                             ret->right = expr;
-                            returns->PIPE_LIST.nodes.push_back(ret);
+                            returns->PIPE_LIST->nodes.push_back(ret);
                             break;
                         }
                     }
@@ -5475,19 +5892,19 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
     else if (node->type == NodeType::FOR_LOOP)
     {    
         auto index_node = make_int(0);
-        auto init_list = node->FOR_LOOP.init_list->LIST.nodes;
+        auto init_list = node->FOR_LOOP->init_list->LIST.nodes();
         auto iter = eval.eval_node(init_list[0]);
         auto item_node = make_int(0);
         if (iter->type == NodeType::LIST)
         {
             auto type = get_type(iter);
-            if (type->LIST.nodes.size() == 0)
+            if (type->LIST.nodes().size() == 0)
             {
                 item_node = make_any();
             }
             else
             {
-                item_node = type->LIST.nodes[0];
+                item_node = type->LIST.nodes()[0];
             }
         }
 
@@ -5501,14 +5918,14 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
             eval.symbol_table[init_list[2]->ID.value] = item_node;
         }
 
-        for (auto for_expr : node->FOR_LOOP.body->BLOCK.nodes)
+        for (auto for_expr : node->FOR_LOOP->body->BLOCK->nodes)
         {
             auto eval_expr = eval.type_node(for_expr, explicit_ret);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(expr);
+                    returns->PIPE_LIST->nodes.push_back(expr);
                     break;
                 }
             }
@@ -5516,16 +5933,16 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
     }
     else if (node->type == NodeType::WHILE_LOOP)
     {
-        auto iter = eval.eval_node(node->WHILE_LOOP.conditional);
+        auto iter = eval.eval_node(node->WHILE_LOOP->conditional);
 
-        for (auto while_expr : node->WHILE_LOOP.body->BLOCK.nodes)
+        for (auto while_expr : node->WHILE_LOOP->body->BLOCK->nodes)
         {
             auto eval_expr = type_node(while_expr, explicit_ret);
-            for (auto expr: eval_expr->PIPE_LIST.nodes)
+            for (auto expr: eval_expr->PIPE_LIST->nodes)
             {
                 if (expr->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(expr);
+                    returns->PIPE_LIST->nodes.push_back(expr);
                     break;
                 }
             }
@@ -5541,26 +5958,26 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
 
         if (res->type == NodeType::PIPE_LIST)
         {
-            for (auto expr: res->PIPE_LIST.nodes)
+            for (auto expr: res->PIPE_LIST->nodes)
             {
                 if (explicit_ret)
                 {
                     if (expr->type == NodeType::RETURN)
                     {
-                        returns->PIPE_LIST.nodes.push_back(expr);
+                        returns->PIPE_LIST->nodes.push_back(expr);
                     }
                 }
                 else
                 {
                     if (expr->type == NodeType::RETURN)
                     {
-                        returns->PIPE_LIST.nodes.push_back(expr);
+                        returns->PIPE_LIST->nodes.push_back(expr);
                     }
                     else
                     {
-                        auto ret = std::make_shared<Node>(NodeType::RETURN);
+                        auto ret = make_pooled_node(NodeType::RETURN);
                         ret->right = expr;
-                        returns->PIPE_LIST.nodes.push_back(ret);
+                        returns->PIPE_LIST->nodes.push_back(ret);
                     }
                 }
             }
@@ -5571,20 +5988,20 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
             {
                 if (res->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(res);
+                    returns->PIPE_LIST->nodes.push_back(res);
                 }
             }
             else
             {
                 if (res->type == NodeType::RETURN)
                 {
-                    returns->PIPE_LIST.nodes.push_back(res);
+                    returns->PIPE_LIST->nodes.push_back(res);
                 }
                 else
                 {
-                    auto ret = std::make_shared<Node>(NodeType::RETURN);
+                    auto ret = make_pooled_node(NodeType::RETURN);
                     ret->right = res;
-                    returns->PIPE_LIST.nodes.push_back(ret);
+                    returns->PIPE_LIST->nodes.push_back(ret);
                 }
             }
         }
@@ -5592,20 +6009,20 @@ std::shared_ptr<Node> Typechecker::type_node(std::shared_ptr<Node> node, bool ex
     else
     {
         auto eval_expr = eval_node(node);
-        returns->PIPE_LIST.nodes.push_back(eval_expr);
+        returns->PIPE_LIST->nodes.push_back(eval_expr);
     }
 
-    // if (returns->PIPE_LIST.nodes.size() == 0)
+    // if (returns->PIPE_LIST->nodes.size() == 0)
     // {
-    //     auto ret = std::make_shared<Node>(NodeType::RETURN);
+    //     auto ret = make_pooled_node(NodeType::RETURN);
     //     ret->right = make_empty();
-    //     returns->PIPE_LIST.nodes.push_back(ret);
+    //     returns->PIPE_LIST->nodes.push_back(ret);
     // }
 
     return returns;
 }
 
-std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool literal_values)
+Node_Ptr Typechecker::type_func(Node_Ptr node, bool literal_values)
 {
     std::string s = file_name;
     std::string delimiter = "/";
@@ -5614,9 +6031,9 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
     std::string token;
     while ((pos = s.find(delimiter)) != std::string::npos) {
         token = s.substr(pos + 1, s.size());
-        if (token == node->FUNCTION.name)
+        if (token == node->FUNCTION->name)
         {
-            return node->FUNCTION.return_type;
+            return node->FUNCTION->return_type;
         }
         s.erase(0, pos + delimiter.length());
     }
@@ -5626,38 +6043,38 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
     func_eval.typecheck = true;
     func_eval.builtins_path = builtins_path;
     func_eval.builtins_names = builtins_names;
-    func_eval.file_name = file_name + "/" + node->FUNCTION.name;
+    func_eval.file_name = file_name + "/" + node->FUNCTION->name;
 
-    for (auto elem : node->FUNCTION.closure)
+    for (auto elem : node->FUNCTION->closure)
     {
         func_eval.symbol_table[elem.first] = elem.second;
     }
 
-    for (auto param : node->FUNCTION.params) 
+    for (auto param : node->FUNCTION->params) 
     {
         auto arg = get_explicit_type(param);
-        if (arg->type == NodeType::OBJECT && !arg->OBJECT.is_type)
+        if (arg->type == NodeType::OBJECT && !arg->OBJECT->is_type)
         {
             //error_and_exit("Cannot use literal objects as parameter types.");
             arg = get_type(arg);
         }
         if (arg->type == NodeType::PIPE_LIST)
         {
-            for (auto& t : arg->PIPE_LIST.nodes)
+            for (auto& t : arg->PIPE_LIST->nodes)
             {
-                if (t->type == NodeType::OBJECT && !t->OBJECT.is_type)
+                if (t->type == NodeType::OBJECT && !t->OBJECT->is_type)
                 {
                     //error_and_exit("Cannot use literal objects as parameter types.");
                     t = get_type(t);
                 }
             }
         }
-        if (arg->type == NodeType::FUNCTION && arg->FUNCTION.is_type)
+        if (arg->type == NodeType::FUNCTION && arg->FUNCTION->is_type)
         {
-            arg = get_explicit_type(arg->FUNCTION.params[0]);
+            arg = get_explicit_type(arg->FUNCTION->params[0]);
         }
 
-        arg->TYPE.allowed_type = std::make_shared<Node>(*arg);
+        arg->TYPE.allowed_type = make_pooled_node(*arg);
 
         if (param->type == NodeType::ID)
         {
@@ -5673,25 +6090,25 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
         }
     }
 
-    std::vector<std::shared_ptr<Node>> returns;
+    std::vector<Node_Ptr> returns;
 
     int index = 0;
-    int body_size = node->FUNCTION.body->BLOCK.nodes.size();
+    int body_size = node->FUNCTION->body->BLOCK->nodes.size();
     int num_if_exprs = 0;
-    std::shared_ptr<Node> last_expr = make_any();
+    Node_Ptr last_expr = make_any();
 
-    if (node->FUNCTION.body->type != NodeType::BLOCK)
+    if (node->FUNCTION->body->type != NodeType::BLOCK)
     {
         body_size = 1;
 
-        if (node->FUNCTION.body->type == NodeType::IF_STATEMENT || node->FUNCTION.body->type == NodeType::IF_BLOCK)
+        if (node->FUNCTION->body->type == NodeType::IF_STATEMENT || node->FUNCTION->body->type == NodeType::IF_BLOCK)
         {
             num_if_exprs = 1;
-            last_expr = node->FUNCTION.body;
+            last_expr = node->FUNCTION->body;
         }
 
-        auto res = func_eval.type_node(node->FUNCTION.body);
-        for (auto n : res->PIPE_LIST.nodes)
+        auto res = func_eval.type_node(node->FUNCTION->body);
+        for (auto n : res->PIPE_LIST->nodes)
         {
             if (n->type == NodeType::RETURN)
             {
@@ -5699,7 +6116,7 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
             }
             else
             {
-                auto ret = std::make_shared<Node>(NodeType::RETURN);
+                auto ret = make_pooled_node(NodeType::RETURN);
                 ret->right = n;
                 returns.push_back(ret);
             }
@@ -5707,13 +6124,13 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
     }
     else
     {
-        for (auto expr : node->FUNCTION.body->BLOCK.nodes)
+        for (auto expr : node->FUNCTION->body->BLOCK->nodes)
         {
             if (expr->type == NodeType::IF_STATEMENT)
             {
                 // if (literal_values)
                 // {
-                //     auto cond_check = func_eval.eval_node(expr->IF_STATEMENT.conditional);
+                //     auto cond_check = func_eval.eval_node(expr->IF_STATEMENT->conditional);
 
                 //     if (!cond_check->BOOL.value)
                 //     {
@@ -5731,7 +6148,7 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
                 }
 
                 auto ret = func_eval.type_node(expr, explicit_ret);
-                for (auto& n : ret->PIPE_LIST.nodes)
+                for (auto& n : ret->PIPE_LIST->nodes)
                 {
                     returns.push_back(n);
                 }
@@ -5748,7 +6165,7 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
                 }
 
                 auto ret = func_eval.type_node(expr, explicit_ret);
-                for (auto& n : ret->PIPE_LIST.nodes)
+                for (auto& n : ret->PIPE_LIST->nodes)
                 {
                     returns.push_back(n);
                 }
@@ -5764,7 +6181,7 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
                 }
 
                 auto ret = func_eval.type_node(expr, explicit_ret);
-                for (auto& n : ret->PIPE_LIST.nodes)
+                for (auto& n : ret->PIPE_LIST->nodes)
                 {
                     returns.push_back(n);
                 }
@@ -5772,13 +6189,13 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
             else
             {
                 auto eval_expr = func_eval.type_node(expr, true);
-                for (auto& n : eval_expr->PIPE_LIST.nodes)
+                for (auto& n : eval_expr->PIPE_LIST->nodes)
                 {
                     if (n->type == NodeType::RETURN || index == body_size-1)
                     {
                         if (n->type != NodeType::RETURN)
                         {
-                            auto ret = std::make_shared<Node>(NodeType::RETURN);
+                            auto ret = make_pooled_node(NodeType::RETURN);
                             ret->right = n;
                             returns.push_back(ret);
                             break;
@@ -5796,7 +6213,7 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
 
     if (num_if_exprs == body_size || last_expr->type == NodeType::IF_STATEMENT || last_expr->type == NodeType::IF_BLOCK)
     {
-        auto ret = std::make_shared<Node>(NodeType::RETURN);
+        auto ret = make_pooled_node(NodeType::RETURN);
         ret->right = make_empty();
         returns.push_back(ret);
     }
@@ -5811,75 +6228,75 @@ std::shared_ptr<Node> Typechecker::type_func(std::shared_ptr<Node> node, bool li
         }
         if (res->type == NodeType::ANY)
         {
-            pipe_list->PIPE_LIST.nodes.clear();
-            pipe_list->PIPE_LIST.nodes.push_back(res);
+            pipe_list->PIPE_LIST->nodes.clear();
+            pipe_list->PIPE_LIST->nodes.push_back(res);
             break;
         }
-        pipe_list->PIPE_LIST.nodes.push_back(res);
+        pipe_list->PIPE_LIST->nodes.push_back(res);
     }
 
-    sort_and_unique(pipe_list->PIPE_LIST.nodes);
+    sort_and_unique(pipe_list->PIPE_LIST->nodes);
 
-    for (auto& ret : pipe_list->PIPE_LIST.nodes)
+    for (auto& ret : pipe_list->PIPE_LIST->nodes)
     {
         if (ret->type == NodeType::OBJECT)
         {
-            if (ret->OBJECT.properties.size() == 0)
+            if (ret->OBJECT->properties.size() == 0)
             {
                 ret->TYPE.is_literal = false;
             }
         }
         if (ret->type == NodeType::LIST)
         {
-            if (ret->LIST.nodes.size() == 0)
+            if (ret->LIST.nodes().size() == 0)
             {
                 ret->TYPE.is_literal = false;
             }
         }
     }
 
-    if (pipe_list->PIPE_LIST.nodes.size() == 0)
+    if (pipe_list->PIPE_LIST->nodes.size() == 0)
     {
-        pipe_list->PIPE_LIST.nodes.push_back(make_empty(false));
+        pipe_list->PIPE_LIST->nodes.push_back(make_empty(false));
     }
 
-    if (pipe_list->PIPE_LIST.nodes.size() == 1)
+    if (pipe_list->PIPE_LIST->nodes.size() == 1)
     {
-        pipe_list = pipe_list->PIPE_LIST.nodes[0];
+        pipe_list = pipe_list->PIPE_LIST->nodes[0];
     }
 
-    if (node->FUNCTION.return_type != nullptr)
+    if (node->FUNCTION->return_type != nullptr)
     {
         // check that the actual type matches explicit type
-        if (pipe_list->type == NodeType::OBJECT && pipe_list->OBJECT.properties.size() == 1)
+        if (pipe_list->type == NodeType::OBJECT && pipe_list->OBJECT->properties.size() == 1)
         {
             int x = 12;
         }
-        auto match = match_types(node->FUNCTION.return_type, pipe_list);
+        auto match = match_types(node->FUNCTION->return_type, pipe_list);
         if (!match.result)
         {
-            error_and_exit("Function '" + node->FUNCTION.name + "' expects to return a value of type '" + node->FUNCTION.return_type->type_repr() + "' but instead returns value of type '" + pipe_list->type_repr() + "'");
+            error_and_exit("Function '" + node->FUNCTION->name + "' expects to return a value of type '" + node->FUNCTION->return_type->type_repr() + "' but instead returns value of type '" + pipe_list->type_repr() + "'");
         }
 
-        node->FUNCTION.return_type = pipe_list;       
+        node->FUNCTION->return_type = pipe_list;       
     }
     else
     {
-        node->FUNCTION.return_type = pipe_list;
+        node->FUNCTION->return_type = pipe_list;
     }
 
     auto ret_list = make_pipe_list();
-    auto ret = std::make_shared<Node>(NodeType::RETURN);
+    auto ret = make_pooled_node(NodeType::RETURN);
     ret->right = node;
-    ret_list->PIPE_LIST.nodes.push_back(ret);
+    ret_list->PIPE_LIST->nodes.push_back(ret);
 
-    node->FUNCTION.typechecked = true;
+    node->FUNCTION->typechecked = true;
     node->TYPE.allowed_type = node;
 
     return ret_list;
 }
 
-std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
+Node_Ptr Typechecker::eval_node(Node_Ptr& node)
 {
     if (node == nullptr)
     {
@@ -5896,18 +6313,18 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::INT || node->type == NodeType::FLOAT || node->type == NodeType::BOOL || node->type == NodeType::STRING || node->type == NodeType::EMPTY)
     {
-        return std::make_shared<Node>(*node);
+        return make_pooled_node(*node);
     }
 
     if (node->type == NodeType::OBJECT)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
 
-        for (auto& prop : res->OBJECT.properties)
+        for (auto& prop : res->OBJECT->properties)
         {
             if (prop.second.value->type == NodeType::FUNCTION)
             {
-                prop.second.value->FUNCTION.closure["this"] = res;
+                prop.second.value->FUNCTION->closure["this"] = res;
             }
 
             prop.second.value = eval_node(prop.second.value);
@@ -5923,9 +6340,9 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
         return res;
     }
 
-    if (node->type == NodeType::BLOCK && node->BLOCK.nodes.size() == 0)
+    if (node->type == NodeType::BLOCK && node->BLOCK->nodes.size() == 0)
     {
-        auto res = std::make_shared<Node>(*node);
+        auto res = make_pooled_node(*node);
         res->type = NodeType::OBJECT;
 
         return res;
@@ -5937,14 +6354,14 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
         if (!node->TYPE.is_literal)
         {
-            res->LIST.nodes.push_back(make_any());
+            res->LIST.nodes().push_back(make_any());
             res->TYPE.allowed_type = res;
             return res;
         }
 
         auto type = make_pipe_list();
 
-        for (auto elem : node->LIST.nodes)
+        for (auto elem : node->LIST.nodes())
         {
             auto eval_elem = eval_node(elem);
             if (eval_elem->type != NodeType::LIST && 
@@ -5953,22 +6370,22 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
             {
                 eval_elem->TYPE.is_literal = false;
             }
-            type->PIPE_LIST.nodes.push_back(eval_elem);
+            type->PIPE_LIST->nodes.push_back(eval_elem);
         }
 
-        sort_and_unique(type->PIPE_LIST.nodes);
+        sort_and_unique(type->PIPE_LIST->nodes);
 
-        if (type->PIPE_LIST.nodes.size() == 0)
+        if (type->PIPE_LIST->nodes.size() == 0)
         {
-            res->LIST.nodes.push_back(make_any());
+            res->LIST.nodes().push_back(make_any());
         }
-        else if (type->PIPE_LIST.nodes.size() == 1)
+        else if (type->PIPE_LIST->nodes.size() == 1)
         {
-            res->LIST.nodes.push_back(type->PIPE_LIST.nodes[0]);
+            res->LIST.nodes().push_back(type->PIPE_LIST->nodes[0]);
         }
         else
         {
-            res->LIST.nodes.push_back(type);
+            res->LIST.nodes().push_back(type);
         }
 
         res->TYPE.allowed_type = res;
@@ -5978,12 +6395,12 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::COMMA_LIST)
     {
-        auto res = std::make_shared<Node>(*node);
-        res->COMMA_LIST.nodes.clear();
+        auto res = make_pooled_node(*node);
+        res->COMMA_LIST->nodes.clear();
 
-        for (auto elem : node->COMMA_LIST.nodes)
+        for (auto elem : node->COMMA_LIST->nodes)
         {
-            res->COMMA_LIST.nodes.push_back(eval_node(elem));
+            res->COMMA_LIST->nodes.push_back(eval_node(elem));
         }
 
         return res;
@@ -5991,12 +6408,12 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::PIPE_LIST)
     {
-        auto res = std::make_shared<Node>(*node);
-        res->PIPE_LIST.nodes.clear();
+        auto res = make_pooled_node(*node);
+        res->PIPE_LIST->nodes.clear();
 
-        for (auto elem : node->PIPE_LIST.nodes)
+        for (auto elem : node->PIPE_LIST->nodes)
         {
-            res->PIPE_LIST.nodes.push_back(eval_node(elem));
+            res->PIPE_LIST->nodes.push_back(eval_node(elem));
         }
 
         return res;
@@ -6015,7 +6432,7 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
                 auto val = make_object();
                 val->TYPE.allowed_type = type;
                 val->TYPE.name = node->ID.value;
-                val->OBJECT.is_type = true;
+                val->OBJECT->is_type = true;
 
                 symbol_table[node->ID.value] = val;
                 return val;
@@ -6040,14 +6457,14 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
             }
         }
 
-        if (var->type == NodeType::PIPE_LIST && var->PIPE_LIST.nodes.size() == 1)
+        if (var->type == NodeType::PIPE_LIST && var->PIPE_LIST->nodes.size() == 1)
         {
-            return var->PIPE_LIST.nodes[0];
+            return var->PIPE_LIST->nodes[0];
         }
 
-        if (var->type == NodeType::FUNC_LIST && var->FUNC_LIST.nodes.size() == 1)
+        if (var->type == NodeType::FUNC_LIST && var->FUNC_LIST->nodes.size() == 1)
         {
-            return var->FUNC_LIST.nodes[0];
+            return var->FUNC_LIST->nodes[0];
         }
 
         return var;
@@ -6120,13 +6537,13 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
         }
         if (node->OP.op_type == NodeType::PLUS_EQ || node->OP.op_type == NodeType::MINUS_EQ)
         {
-            auto op_node = std::make_shared<Node>(NodeType::OP);
+            auto op_node = make_pooled_node(NodeType::OP);
             op_node->left = eval_node(node->left);
             op_node->right = eval_node(node->right);
 
             auto op_res = node->OP.op_type == NodeType::PLUS_EQ ? eval_add(op_node) : eval_sub(op_node);
 
-            auto equal_node = std::make_shared<Node>(NodeType::OP);
+            auto equal_node = make_pooled_node(NodeType::OP);
             equal_node->left = node->left;
             equal_node->right = op_res;
 
@@ -6144,20 +6561,20 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
         evaluator.line = line;
         evaluator.column = column;
         evaluator.file_name = file_name;
-        evaluator.nodes = node->BLOCK.nodes;
+        evaluator.nodes = node->BLOCK->nodes;
 
         evaluator.evaluate();
 
         if (evaluator.nodes.size() == 0)
         {
-            return std::make_shared<Node>(NodeType::EMPTY);
+            return make_pooled_node(NodeType::EMPTY);
         }
 
         return evaluator.nodes[evaluator.nodes.size()-1];
     }
     if (node->type == NodeType::FUNCTION)
     {
-        for (auto& arg : node->FUNCTION.args)
+        for (auto& arg : node->FUNCTION->args)
         {
             if (arg != nullptr)
             {
@@ -6165,7 +6582,7 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
             }
         }
 
-        for (auto& param : node->FUNCTION.params)
+        for (auto& param : node->FUNCTION->params)
         {
             if (param->type == NodeType::ID)
             {
@@ -6180,7 +6597,7 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
                 if (param->ID.value == "__type")
                 {
-                    node->FUNCTION.is_type = true;
+                    node->FUNCTION->is_type = true;
                 }
             }
             else if (param->type == NodeType::EQUAL)
@@ -6209,20 +6626,20 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
         for (auto symbol : symbol_table)
         {
-            node->FUNCTION.closure[symbol.first] = symbol.second;
+            node->FUNCTION->closure[symbol.first] = symbol.second;
         }
 
-        if (node->FUNCTION.closure.find(node->FUNCTION.name) != node->FUNCTION.closure.end())
+        if (node->FUNCTION->closure.find(node->FUNCTION->name) != node->FUNCTION->closure.end())
         {
-            if (node->FUNCTION.closure[node->FUNCTION.name]->type == NodeType::FUNC_LIST)
+            if (node->FUNCTION->closure[node->FUNCTION->name]->type == NodeType::FUNC_LIST)
             {
-                node->FUNCTION.closure[node->FUNCTION.name] = std::make_shared<Node>(*node->FUNCTION.closure[node->FUNCTION.name]);
-                node->FUNCTION.closure[node->FUNCTION.name]->FUNC_LIST.nodes.push_back(node);
+                node->FUNCTION->closure[node->FUNCTION->name] = make_pooled_node(*node->FUNCTION->closure[node->FUNCTION->name]);
+                node->FUNCTION->closure[node->FUNCTION->name]->FUNC_LIST->nodes.push_back(node);
             }
         }
         else
         {
-            node->FUNCTION.closure[node->FUNCTION.name] = node;
+            node->FUNCTION->closure[node->FUNCTION->name] = node;
         }
 
         if (!node->TYPE.is_literal)
@@ -6232,39 +6649,39 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
         type_func(node);
 
-        if (node->FUNCTION.return_type->PIPE_LIST.nodes.size() == 1)
+        if (node->FUNCTION->return_type->PIPE_LIST->nodes.size() == 1)
         {
-            node->FUNCTION.return_type = node->FUNCTION.return_type->PIPE_LIST.nodes[0];
+            node->FUNCTION->return_type = node->FUNCTION->return_type->PIPE_LIST->nodes[0];
         }
 
-        if (typecheck && node->FUNCTION.is_type)
+        if (typecheck && node->FUNCTION->is_type)
         {
-            return get_explicit_type(node->FUNCTION.params[0]);
+            return get_explicit_type(node->FUNCTION->params[0]);
         }
     }
     if (node->type == NodeType::FUNC_CALL)
     {
-        auto func_name = node->FUNC_CALL.name;
+        auto func_name = node->FUNC_CALL->name;
 
         // Built-in functions
 
         if (tc_builtin_functions.find(func_name) != tc_builtin_functions.end())
         {
             auto func = tc_builtin_functions[func_name];
-            return (this->*func)(node->FUNC_CALL.args);
+            return (this->*func)(node->FUNC_CALL->args);
         }
 
         auto func = eval_look_up(func_name);
 
         if (func->type == NodeType::ERROR)
         {
-            if (node->FUNC_CALL.caller->type == NodeType::FUNCTION)
+            if (node->FUNC_CALL->caller->type == NodeType::FUNCTION)
             {
-                func = eval_node(node->FUNC_CALL.caller);
+                func = eval_node(node->FUNC_CALL->caller);
             }
-            else if (node->FUNC_CALL.caller->OP.op_type == NodeType::DOT)
+            else if (node->FUNC_CALL->caller->OP.op_type == NodeType::DOT)
             {
-                func = eval_node(node->FUNC_CALL.caller);
+                func = eval_node(node->FUNC_CALL->caller);
             }
             else
             {
@@ -6275,11 +6692,11 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
         if (func_name == "import")
         {
             // typecheck only
-            eval_function_call(func, node->FUNC_CALL.args);
-            return builtin_import({node->FUNC_CALL.args});
+            eval_function_call(func, node->FUNC_CALL->args);
+            return builtin_import({node->FUNC_CALL->args});
         }
 
-        return eval_function_call(func, node->FUNC_CALL.args);
+        return eval_function_call(func, node->FUNC_CALL->args);
     }
     if (node->type == NodeType::IF_STATEMENT)
     {
@@ -6304,17 +6721,17 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
 
     if (node->type == NodeType::KEYWORD && node->ID.value == "break")
     {
-        auto res = std::make_shared<Node>(NodeType::BREAK);
+        auto res = make_pooled_node(NodeType::BREAK);
         return res;
     }
     if (node->type == NodeType::KEYWORD && node->ID.value == "continue")
     {
-        auto res = std::make_shared<Node>(NodeType::CONTINUE);
+        auto res = make_pooled_node(NodeType::CONTINUE);
         return res;
     }
     if (node->type == NodeType::KEYWORD && node->ID.value == "ret")
     {
-        auto res = std::make_shared<Node>(NodeType::RETURN);
+        auto res = make_pooled_node(NodeType::RETURN);
         res->right = eval_node(node->right);
         return res;
     }
@@ -6322,9 +6739,9 @@ std::shared_ptr<Node> Typechecker::eval_node(std::shared_ptr<Node>& node)
     return node;
 }
 
-std::shared_ptr<Node> Typechecker::eval_nodes(std::vector<std::shared_ptr<Node>> nodes)
+Node_Ptr Typechecker::eval_nodes(std::vector<Node_Ptr> nodes)
 {
-    auto eval_expr = std::make_shared<Node>(NodeType::EMPTY);
+    auto eval_expr = make_pooled_node(NodeType::EMPTY);
 
     for (auto expr : nodes)
     {
@@ -6355,8 +6772,26 @@ void Typechecker::evaluate()
 
         line = node->line;
         column = node->column;
+
+        loop_safe_point = collect_cycles && (node->type == NodeType::FOR_LOOP || node->type == NodeType::WHILE_LOOP);
         auto res = eval_node(node);
+        loop_safe_point = false;
+
+        if (collect_cycles)
+        {
+            Collector::get().safe_point();
+        }
+    }
+}
+
+void Typechecker::error_at_call(std::string message)
+{
+    if (caller != nullptr)
+    {
+        caller->error_and_exit(message);
     }
+
+    error_and_exit(message);
 }
 
 void Typechecker::error_and_exit(std::string message)
@@ -6364,6 +6799,7 @@ void Typechecker::error_and_exit(std::string message)
     std::string type = "Type";
 
     std::string error_message = "\n\n" + type + " Error in '" + file_name + "' @ (" + std::to_string(line) + ", " + std::to_string(column) + "): " + message;
+    Output::get().flush();
 	std::cout << error_message << "\n";
 
     if (outer_scope != nullptr)
@@ -7,6 +7,8 @@
 #include <cctype>
 #include <numeric>
 #include "../Parser/Parser.hpp"
+#include "../Node/Pool.hpp"
+#include "../Collector/Collector.hpp"
 
 class Typechecker
 {
@@ -14,78 +16,110 @@ class Typechecker
 public:
 
     std::string file_name;
-    std::unordered_map<std::string, std::shared_ptr<Node>> symbol_table;
+    std::unordered_map<std::string, Node_Ptr> symbol_table;
     std::shared_ptr<Typechecker> outer_scope = nullptr;
     int line, column;
 
+    // The typechecker a function call was made from, while the call runs
+    Typechecker* caller = nullptr;
+
     Typechecker() {}
-    Typechecker(std::string file_name, std::vector<std::shared_ptr<Node>> nodes) : file_name(file_name), nodes(nodes) {}
+    Typechecker(std::string file_name, std::vector<Node_Ptr> nodes) : file_name(file_name), nodes(nodes) {}
 
-    std::vector<std::shared_ptr<Node>> nodes;
+    std::vector<Node_Ptr> nodes;
 
     std::string builtins_path;
 
     bool runtime = true;
     bool typecheck = false;
 
-    std::shared_ptr<Node> eval_node(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_nodes(std::vector<std::shared_ptr<Node>> nodes);
-
-    std::shared_ptr<Node> eval_add(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_sub(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_mul(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_div(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_mod(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_dot(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_double_dot(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_pos_neg(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_not(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_and_or(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_equality(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_equal(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_double_arrow(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_if_statement(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_if_block(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_match_block(std::shared_ptr<Node>& node, std::string name="");
-    std::shared_ptr<Node> eval_while_loop(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_for_loop(std::shared_ptr<Node>& node);
-    std::shared_ptr<Node> eval_copy(std::shared_ptr<Node>& node);
-
-    std::shared_ptr<Node> eval_function_call(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args);
-
-    std::shared_ptr<Node> builtin_exit(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_error(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_range(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_print(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_delete(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_time(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_import(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_read(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_write(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_append(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_int(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_float(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_to_string(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_type(std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> builtin_shape(std::vector<std::shared_ptr<Node>> args);
-
-    void sort_and_unique(std::vector<std::shared_ptr<Node>>& list);
-    std::shared_ptr<Node> get_explicit_type(std::shared_ptr<Node>& node);
-
-    bool compare(const std::shared_ptr<Node> &lhs, const std::shared_ptr<Node> &rhs);
-    std::shared_ptr<Node> match_function(std::shared_ptr<Node> function, std::vector<std::shared_ptr<Node>> args);
-    std::shared_ptr<Node> get_type(std::shared_ptr<Node>& node);
-
-    std::shared_ptr<Node> type_func(std::shared_ptr<Node> node, bool literal_values = false);
-    std::shared_ptr<Node> type_node(std::shared_ptr<Node> node, bool explicit_ret = false);
-
-    std::shared_ptr<Node> clone_func(std::shared_ptr<Node> func);
+    // Set on the main program's typechecker: its statement boundaries, and
+    // the iterations of its top-level loops, are safe points for the cycle
+    // collector
+    bool collect_cycles = false;
+    bool loop_safe_point = false;
+
+    Node_Ptr eval_node(Node_Ptr& node);
+    Node_Ptr eval_nodes(std::vector<Node_Ptr> nodes);
+
+    Node_Ptr eval_add(Node_Ptr& node);
+    Node_Ptr eval_sub(Node_Ptr& node);
+    Node_Ptr eval_mul(Node_Ptr& node);
+    Node_Ptr eval_div(Node_Ptr& node);
+    Node_Ptr eval_mod(Node_Ptr& node);
+    Node_Ptr eval_dot(Node_Ptr& node);
+    Node_Ptr eval_double_dot(Node_Ptr& node);
+    Node_Ptr eval_pos_neg(Node_Ptr& node);
+    Node_Ptr eval_not(Node_Ptr& node);
+    Node_Ptr eval_and_or(Node_Ptr& node);
+    Node_Ptr eval_equality(Node_Ptr& node);
+    Node_Ptr eval_equal(Node_Ptr& node);
+    Node_Ptr eval_double_arrow(Node_Ptr& node);
+    Node_Ptr eval_if_statement(Node_Ptr& node);
+    Node_Ptr eval_if_block(Node_Ptr& node);
+    Node_Ptr eval_match_block(Node_Ptr& node, std::string name="");
+    Node_Ptr eval_while_loop(Node_Ptr& node);
+    Node_Ptr eval_for_loop(Node_Ptr& node);
+    Node_Ptr eval_copy(Node_Ptr& node);
+
+    Node_Ptr eval_function_call(Node_Ptr function, std::vector<Node_Ptr> args);
+
+    Node_Ptr builtin_exit(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_error(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_range(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_print(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_delete(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_time(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_import(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_read(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_lines(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_parse(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_stringify(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_read(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_json_each(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ndjson_lines(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ndjson_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_csv_load(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_column(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_group_rows(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_summarize(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_join(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_index(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_lookup(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_ref(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_reshape(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_extract(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_aggregate(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_append(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_flush(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_close(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_open(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_file_write(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_int(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_float(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_to_string(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_type(std::vector<Node_Ptr> args);
+    Node_Ptr builtin_shape(std::vector<Node_Ptr> args);
+
+    void sort_and_unique(std::vector<Node_Ptr>& list);
+    Node_Ptr get_explicit_type(Node_Ptr& node);
+
+    bool compare(const Node_Ptr &lhs, const Node_Ptr &rhs);
+    Node_Ptr match_function(Node_Ptr function, std::vector<Node_Ptr> args);
+    Node_Ptr get_type(Node_Ptr& node);
+
+    Node_Ptr type_func(Node_Ptr node, bool literal_values = false);
+    Node_Ptr type_node(Node_Ptr node, bool explicit_ret = false);
+
+    Node_Ptr clone_func(Node_Ptr func);
 
     void init(std::string builtins_path);
     std::vector<std::string> builtins_names;
     void evaluate();
 
-    std::shared_ptr<Node>& eval_look_up(std::string name);
+    Node_Ptr& eval_look_up(std::string name);
 
     // Dynamic Typing
 
@@ -95,21 +129,22 @@ public:
         std::string message;
     };
 
-    Match_Result match_types(std::shared_ptr<Node> a, std::shared_ptr<Node> b, bool match_name = true);
-    Match_Result match_values(std::shared_ptr<Node> a, std::shared_ptr<Node> b);
-    bool match_pattern(std::shared_ptr<Node> a, std::shared_ptr<Node> b);
+    Match_Result match_types(Node_Ptr a, Node_Ptr b, bool match_name = true);
+    Match_Result match_values(Node_Ptr a, Node_Ptr b);
+    bool match_pattern(Node_Ptr a, Node_Ptr b);
 
     // Node Helpers
-    std::shared_ptr<Node> make_int(long long value, bool literal = true);
-    std::shared_ptr<Node> make_float(double value, bool literal = true);
-    std::shared_ptr<Node> make_string(std::string value, bool literal = true);
-    std::shared_ptr<Node> make_bool(bool value, bool literal = true);
-    std::shared_ptr<Node> make_empty(bool literal = true);
-    std::shared_ptr<Node> make_any(bool literal = true);
-    std::shared_ptr<Node> make_list(bool literal = true);
-    std::shared_ptr<Node> make_pipe_list(bool literal = true);
-    std::shared_ptr<Node> make_object(bool literal = true);
-    std::shared_ptr<Node> make_function(bool literal = true);
+    Node_Ptr make_int(long long value, bool literal = true);
+    Node_Ptr make_float(double value, bool literal = true);
+    Node_Ptr make_string(std::string value, bool literal = true);
+    Node_Ptr make_bool(bool value, bool literal = true);
+    Node_Ptr make_empty(bool literal = true);
+    Node_Ptr make_any(bool literal = true);
+    Node_Ptr make_list(bool literal = true);
+    Node_Ptr make_pipe_list(bool literal = true);
+    Node_Ptr make_object(bool literal = true);
+    Node_Ptr make_function(bool literal = true);
 
     void error_and_exit(std::string message);
+    void error_at_call(std::string message);
 };
\ No newline at end of file
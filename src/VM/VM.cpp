@@ -0,0 +1,515 @@
+#include "VM.hpp"
+
+// --- Operations --- //
+
+// Each operation mirrors the int/float paths of its Evaluator counterpart
+// and leaves its result in place of the left operand, tagged with the
+// operator node so it boxes the same way. Anything else returns false and
+// the VM falls back to the tree-walker
+
+bool VM::arithmetic(OpCode op, Node* node, Value& left, Value& right)
+{
+    if (!left.is_number() || !right.is_number())
+    {
+        return false;
+    }
+
+    bool ints = left.type == Value_Type::INT && right.type == Value_Type::INT;
+
+    if (ints && op == OpCode::MOD && right.i == 0)
+    {
+        return false;
+    }
+
+    if (ints && op != OpCode::DIV)
+    {
+        long long a = left.i;
+        long long b = right.i;
+
+        switch (op)
+        {
+            case OpCode::ADD: left = Value::make_int(a + b, node); break;
+            case OpCode::SUB: left = Value::make_int(a - b, node); break;
+            case OpCode::MUL: left = Value::make_int(a * b, node); break;
+            default: left = Value::make_int(a % b, node); break;
+        }
+
+        return true;
+    }
+
+    double a = left.as_float();
+    double b = right.as_float();
+
+    switch (op)
+    {
+        case OpCode::ADD: left = Value::make_float(a + b, node); break;
+        case OpCode::SUB: left = Value::make_float(a - b, node); break;
+        case OpCode::MUL: left = Value::make_float(a * b, node); break;
+        case OpCode::DIV: left = Value::make_float(a / b, node); break;
+        default: left = Value::make_float(fmod(a, b), node); break;
+    }
+
+    return true;
+}
+
+bool VM::comparison(OpCode op, Node* node, Value& left, Value& right)
+{
+    if (!left.is_number() || !right.is_number())
+    {
+        return false;
+    }
+
+    bool res;
+
+    if (left.type == Value_Type::INT && right.type == Value_Type::INT)
+    {
+        long long a = left.i;
+        long long b = right.i;
+
+        switch (op)
+        {
+            case OpCode::LESS: res = a < b; break;
+            case OpCode::GREATER: res = a > b; break;
+            case OpCode::LESS_EQUAL: res = a <= b; break;
+            case OpCode::GREATER_EQUAL: res = a >= b; break;
+            case OpCode::EQUAL: res = a == b; break;
+            default: res = a != b; break;
+        }
+    }
+    else
+    {
+        double a = left.as_float();
+        double b = right.as_float();
+
+        switch (op)
+        {
+            case OpCode::LESS: res = a < b; break;
+            case OpCode::GREATER: res = a > b; break;
+            case OpCode::LESS_EQUAL: res = a <= b; break;
+            case OpCode::GREATER_EQUAL: res = a >= b; break;
+            case OpCode::EQUAL: res = a == b; break;
+            default: res = a != b; break;
+        }
+    }
+
+    left = Value::make_bool(res, node);
+    return true;
+}
+
+bool VM::unary(OpCode op, Node* node, Value& right)
+{
+    if (right.type == Value_Type::NODE)
+    {
+        return false;
+    }
+
+    if (op == OpCode::NOT)
+    {
+        if (right.type == Value_Type::INT)
+        {
+            right = Value::make_bool(!right.i, node);
+        }
+        else if (right.type == Value_Type::FLOAT)
+        {
+            right = Value::make_bool(!right.f, node);
+        }
+        else
+        {
+            right = Value::make_bool(!right.b, node);
+        }
+
+        return true;
+    }
+
+    bool neg = node->OP.op_type == NodeType::NEG;
+
+    if (right.type == Value_Type::INT)
+    {
+        right = Value::make_int(neg ? -right.i : +right.i, node);
+    }
+    else if (right.type == Value_Type::FLOAT)
+    {
+        right = Value::make_float(neg ? -right.f : +right.f, node);
+    }
+    else
+    {
+        right = Value::make_bool(neg ? -right.b : +right.b, node);
+    }
+
+    return true;
+}
+
+// --- Scopes --- //
+
+void VM::enter_scope()
+{
+    Frame frame;
+    frame.scope = std::make_unique<Evaluator>();
+    frame.scope->runtime = scope->runtime;
+    frame.scope->file_name = scope->file_name;
+    frame.scope->outer_scope = scope;
+
+    scope = frame.scope.get();
+    frames.push_back(std::move(frame));
+}
+
+void VM::leave_scope(int depth)
+{
+    while (frames.size() > (size_t)depth)
+    {
+        frames.pop_back();
+    }
+
+    scope = frames.empty() ? &evaluator : frames.back().scope.get();
+}
+
+// --- Execution --- //
+
+void VM::run()
+{
+    int ip = 0;
+
+    // The expression currently executing, so it can be re-run by the
+    // tree-walker if an operand turns out to need the general path
+
+    int expr_node = 0;
+    int expr_end = 0;
+    int expr_height = 0;
+
+    while (true)
+    {
+        Instruction& instruction = chunk.code[ip++];
+
+        switch (instruction.op)
+        {
+            case OpCode::CONST:
+            {
+                auto& node = chunk.constants[instruction.a];
+                scope->line = node->line;
+                scope->column = node->column;
+
+                // Scalar literals stay unboxed until something needs the node
+
+                if (node->type == NodeType::INT)
+                {
+                    stack.push_back(Value::make_int(node->INT.value, node.get()));
+                }
+                else if (node->type == NodeType::FLOAT)
+                {
+                    stack.push_back(Value::make_float(node->FLOAT.value, node.get()));
+                }
+                else if (node->type == NodeType::BOOL)
+                {
+                    stack.push_back(Value::make_bool(node->BOOL.value, node.get()));
+                }
+                else
+                {
+                    stack.push_back(Value::from_node(make_pooled_node(*node)));
+                }
+                break;
+            }
+            case OpCode::LOAD:
+            {
+                auto& node = chunk.constants[instruction.a];
+                scope->line = node->line;
+                scope->column = node->column;
+
+                auto& var = scope->eval_look_up(node->ID.value, node->ID.slot);
+
+                if (var->type == NodeType::ERROR)
+                {
+                    stack.resize(expr_height);
+                    stack.push_back(Value::from_node(scope->eval_node(chunk.constants[expr_node])));
+                    ip = expr_end;
+                }
+                else if (var->type == NodeType::PIPE_LIST && var->PIPE_LIST->nodes.size() == 1)
+                {
+                    stack.push_back(Value::from_node(var->PIPE_LIST->nodes[0]));
+                }
+                else if (var->type == NodeType::FUNC_LIST && var->FUNC_LIST->nodes.size() == 1)
+                {
+                    stack.push_back(Value::from_node(var->FUNC_LIST->nodes[0]));
+                }
+                else
+                {
+                    stack.push_back(Value::from_node(var));
+                }
+                break;
+            }
+            case OpCode::EXPR:
+            {
+                expr_node = instruction.a;
+                expr_end = instruction.b;
+                expr_height = stack.size();
+                break;
+            }
+            case OpCode::ADD:
+            case OpCode::SUB:
+            case OpCode::MUL:
+            case OpCode::DIV:
+            case OpCode::MOD:
+            case OpCode::LESS:
+            case OpCode::GREATER:
+            case OpCode::LESS_EQUAL:
+            case OpCode::GREATER_EQUAL:
+            case OpCode::EQUAL:
+            case OpCode::NOT_EQUAL:
+            {
+                auto right = std::move(stack.back());
+                stack.pop_back();
+                auto& left = stack.back();
+
+                bool ok = instruction.op <= OpCode::MOD
+                    ? arithmetic(instruction.op, chunk.constants[instruction.a].get(), left, right)
+                    : comparison(instruction.op, chunk.constants[instruction.a].get(), left, right);
+
+                if (!ok)
+                {
+                    stack.resize(expr_height);
+                    stack.push_back(Value::from_node(scope->eval_node(chunk.constants[expr_node])));
+                    ip = expr_end;
+                }
+                break;
+            }
+            case OpCode::POS_NEG:
+            case OpCode::NOT:
+            {
+                if (!unary(instruction.op, chunk.constants[instruction.a].get(), stack.back()))
+                {
+                    stack.resize(expr_height);
+                    stack.push_back(Value::from_node(scope->eval_node(chunk.constants[expr_node])));
+                    ip = expr_end;
+                }
+                break;
+            }
+            case OpCode::AND_SHORT:
+            {
+                auto& left = stack.back();
+
+                // && evaluates to a copy of a false left operand; an unboxed
+                // value is already a fresh copy once it is boxed
+
+                if (left.type == Value_Type::BOOL && !left.b)
+                {
+                    if (left.node != nullptr)
+                    {
+                        left = Value::from_node(make_pooled_node(*left.node));
+                    }
+
+                    ip = instruction.b;
+                }
+                break;
+            }
+            case OpCode::AND_OR:
+            {
+                auto right = std::move(stack.back());
+                stack.pop_back();
+                auto& left = stack.back();
+
+                auto node = chunk.constants[instruction.a].get();
+                bool res = false;
+
+                if (left.type == Value_Type::BOOL && right.type == Value_Type::BOOL)
+                {
+                    if (node->OP.op_type == NodeType::AND)
+                    {
+                        res = left.b && right.b;
+                    }
+                    else if (node->OP.op_type == NodeType::OR)
+                    {
+                        res = left.b || right.b;
+                    }
+                }
+
+                left = Value::make_bool(res, node);
+                break;
+            }
+            case OpCode::EVAL:
+            {
+                stack.push_back(Value::from_node(scope->eval_node(chunk.constants[instruction.a])));
+                break;
+            }
+            case OpCode::BIND:
+            {
+                auto& id = chunk.constants[instruction.a]->left;
+                bound.push_back(&scope->eval_look_up(id->ID.value, id->ID.slot));
+                break;
+            }
+            case OpCode::ASSIGN:
+            {
+                auto& var = *bound.back();
+                bound.pop_back();
+                stack.back() = Value::from_node(scope->eval_assign(chunk.constants[instruction.a], var, stack.back().box()));
+                break;
+            }
+            case OpCode::CONCAT:
+            {
+                auto& node = chunk.constants[instruction.a];
+                auto& var = *bound.back();
+
+                if (scope->can_append(node, var))
+                {
+                    bound.pop_back();
+                    stack.push_back(Value::from_node(scope->eval_append(node, var, scope->eval_node(node->right->right))));
+                    ip = instruction.b;
+                }
+                break;
+            }
+            case OpCode::POP:
+            {
+                stack.pop_back();
+                break;
+            }
+            case OpCode::SIGNAL:
+            {
+                auto res = std::move(stack.back());
+                stack.pop_back();
+
+                // Every VM state is held by counted handles, so statement
+                // boundaries are safe points for the cycle collector
+
+                if (evaluator.collect_cycles)
+                {
+                    Collector::get().safe_point();
+                }
+
+                if (res.type != Value_Type::NODE)
+                {
+                    break;
+                }
+
+                auto& target = chunk.targets[instruction.a];
+
+                if (res.node->type == NodeType::BREAK)
+                {
+                    leave_scope(target.break_depth);
+                    ip = target.break_ip;
+                }
+                else if (res.node->type == NodeType::CONTINUE)
+                {
+                    leave_scope(target.continue_depth);
+                    ip = target.continue_ip;
+                }
+                else if (res.node->type == NodeType::RETURN)
+                {
+                    leave_scope(0);
+                    ip = target.return_ip;
+                }
+                break;
+            }
+            case OpCode::CHECK_BOOL:
+            {
+                if (stack.back().type != Value_Type::BOOL)
+                {
+                    scope->error_and_exit(instruction.a == 0 ? "While loop expects a boolean conditional" : "If statement expects a boolean conditional");
+                }
+                break;
+            }
+            case OpCode::JUMP:
+            {
+                ip = instruction.a;
+                break;
+            }
+            case OpCode::JUMP_IF_FALSE:
+            {
+                auto& top = stack.back();
+                bool value = top.type == Value_Type::BOOL ? top.b : top.box()->BOOL.value;
+                stack.pop_back();
+
+                if (!value)
+                {
+                    ip = instruction.a;
+                }
+                break;
+            }
+            case OpCode::ENTER_SCOPE:
+            {
+                enter_scope();
+                break;
+            }
+            case OpCode::CLEAR_SCOPE:
+            {
+                scope->symbol_table.clear();
+
+                if (evaluator.collect_cycles)
+                {
+                    Collector::get().safe_point();
+                }
+                break;
+            }
+            case OpCode::LEAVE_SCOPE:
+            {
+                leave_scope(frames.size() - 1);
+                break;
+            }
+            case OpCode::FOR_INIT:
+            {
+                auto loop = chunk.constants[instruction.a];
+                auto& init_list = loop->FOR_LOOP->init_list->LIST.nodes();
+
+                auto iter = stack.back().box();
+                stack.pop_back();
+
+                if (iter->type != NodeType::LIST && iter->type != NodeType::RANGE)
+                {
+                    scope->error_and_exit("For loop initialiser expects iterator of type list or range");
+                }
+
+                enter_scope();
+
+                auto& frame = frames.back();
+                frame.loop = loop;
+                frame.iter = iter;
+
+                frame.cursor = Sequence_Cursor(iter);
+                frame.index = iter->type == NodeType::RANGE ? iter->RANGE.start : 0;
+                break;
+            }
+            case OpCode::FOR_NEXT:
+            {
+                auto& frame = frames.back();
+
+                if (!frame.cursor.next())
+                {
+                    ip = instruction.b;
+                    break;
+                }
+
+                auto& init_list = frame.loop->FOR_LOOP->init_list->LIST.nodes();
+
+                // Each iteration's index is a node of its own, so whatever
+                // keeps hold of it keeps that iteration's value
+
+                if (init_list.size() == 2)
+                {
+                    scope->symbol_table[init_list[1]->ID.value] = scope->make_int(frame.index);
+                }
+                else if (init_list.size() == 3)
+                {
+                    auto index_node = make_pooled_node(NodeType::INT);
+                    index_node->INT.value = frame.index;
+                    scope->symbol_table[init_list[1]->ID.value] = index_node;
+
+                    if (frame.iter->type == NodeType::LIST)
+                    {
+                        scope->symbol_table[init_list[2]->ID.value] = frame.cursor.value();
+                    }
+                    else
+                    {
+                        scope->symbol_table[init_list[2]->ID.value] = index_node;
+                    }
+                }
+                break;
+            }
+            case OpCode::FOR_STEP:
+            {
+                frames.back().index++;
+                break;
+            }
+            case OpCode::HALT:
+            {
+                return;
+            }
+        }
+    }
+}
@@ -0,0 +1,48 @@
+#pragma once
+#include "../Compiler/Compiler.hpp"
+#include "../Evaluator/Evaluator.hpp"
+#include "Value.hpp"
+
+// Stack machine for the instruction stream built by the Compiler. Scopes
+// are real Evaluators chained through outer_scope, exactly as the
+// tree-walker builds them, so EVAL can run any node in place and errors
+// report through the same chain. The operand stack holds unboxed Values,
+// so arithmetic and comparisons run without allocating.
+
+class VM
+{
+    struct Frame
+    {
+        std::unique_ptr<Evaluator> scope;
+        Node_Ptr loop;
+        Node_Ptr iter;
+        Sequence_Cursor cursor;
+        int index = 0;
+    };
+
+public:
+
+    Evaluator& evaluator;
+    Chunk& chunk;
+
+private:
+
+    std::vector<Frame> frames;
+    std::vector<Value> stack;
+    std::vector<Node_Ptr*> bound;
+
+    Evaluator* scope;
+
+public:
+
+    VM(Evaluator& evaluator, Chunk& chunk) : evaluator(evaluator), chunk(chunk), scope(&evaluator) {}
+
+    bool arithmetic(OpCode op, Node* node, Value& left, Value& right);
+    bool comparison(OpCode op, Node* node, Value& left, Value& right);
+    bool unary(OpCode op, Node* node, Value& right);
+
+    void enter_scope();
+    void leave_scope(int depth);
+
+    void run();
+};
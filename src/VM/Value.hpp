@@ -0,0 +1,133 @@
+#pragma once
+#include "../Node/Pool.hpp"
+
+// A runtime value on the VM stack. Ints, floats and bools are held inline,
+// so intermediate results of an expression never touch the heap; a value
+// is only boxed into a Node when it leaves the VM (assigned, handed to the
+// tree-walker). `node` is set when the value already lives in a Node, and
+// `origin` is the AST node a fresh box is copied from, which keeps boxed
+// results identical to the ones the tree-walker builds.
+
+enum class Value_Type : unsigned char
+{
+    INT,
+    FLOAT,
+    BOOL,
+    NODE
+};
+
+struct Value
+{
+    Value_Type type = Value_Type::NODE;
+
+    union
+    {
+        long long i;
+        double f;
+        bool b;
+    };
+
+    Node_Ptr node;
+    Node* origin = nullptr;
+
+    Value() : i(0) {}
+
+    static Value from_node(const Node_Ptr& node)
+    {
+        Value value;
+        value.node = node;
+
+        if (node->type == NodeType::INT)
+        {
+            value.type = Value_Type::INT;
+            value.i = node->INT.value;
+        }
+        else if (node->type == NodeType::FLOAT)
+        {
+            value.type = Value_Type::FLOAT;
+            value.f = node->FLOAT.value;
+        }
+        else if (node->type == NodeType::BOOL)
+        {
+            value.type = Value_Type::BOOL;
+            value.b = node->BOOL.value;
+        }
+
+        return value;
+    }
+
+    static Value make_int(long long i, Node* origin)
+    {
+        Value value;
+        value.type = Value_Type::INT;
+        value.i = i;
+        value.origin = origin;
+        return value;
+    }
+
+    static Value make_float(double f, Node* origin)
+    {
+        Value value;
+        value.type = Value_Type::FLOAT;
+        value.f = f;
+        value.origin = origin;
+        return value;
+    }
+
+    static Value make_bool(bool b, Node* origin)
+    {
+        Value value;
+        value.type = Value_Type::BOOL;
+        value.b = b;
+        value.origin = origin;
+        return value;
+    }
+
+    bool is_number() const
+    {
+        return type == Value_Type::INT || type == Value_Type::FLOAT;
+    }
+
+    double as_float() const
+    {
+        return type == Value_Type::INT ? (double)i : f;
+    }
+
+    // Literals box as a plain copy, operator results as a copy of the
+    // operator node carrying the result, like eval_add and friends
+
+    Node_Ptr box() const
+    {
+        if (node != nullptr)
+        {
+            return node;
+        }
+
+        auto res = make_pooled_node(*origin);
+
+        if (origin->type != NodeType::OP)
+        {
+            return res;
+        }
+
+        res->TYPE.is_literal = true;
+
+        if (type == Value_Type::INT)
+        {
+            res->type = NodeType::INT;
+            res->INT.value = i;
+        }
+        else if (type == Value_Type::FLOAT)
+        {
+            res->type = NodeType::FLOAT;
+            res->FLOAT.value = f;
+        }
+        else
+        {
+            res->type = NodeType::BOOL;
+            res->BOOL.value = b;
+        }
+
+        return res;
+    }
+};